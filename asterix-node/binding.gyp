@@ -72,6 +72,8 @@
             "../src/asterix/Category.cpp",
             "../src/asterix/DataBlock.cpp",
             "../src/asterix/DataRecord.cpp",
+            "../src/asterix/DecodePlan.cpp",
+            "../src/asterix/ItemProgram.cpp",
             "../src/asterix/DataItem.cpp",
             "../src/asterix/DataItemBits.cpp",
             "../src/asterix/DataItemDescription.cpp",
@@ -88,6 +90,7 @@
             "../src/asterix/UAPItem.cpp",
             "../src/asterix/Utils.cpp",
             "../src/asterix/XMLParser.cpp",
+            "../src/asterix/recorddecoder.cxx",
             "../src/engine/globals.cpp"
           ],
           "include_dirs": [
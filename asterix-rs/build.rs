@@ -154,6 +154,8 @@ fn compile_cpp_with_ffi_bridge() {
         "DataItemFormatRepetitive.cpp",
         "DataItemFormatVariable.cpp",
         "DataRecord.cpp",
+        "DecodePlan.cpp",
+        "ItemProgram.cpp",
         "InputParser.cpp",
         "Tracer.cpp",
         "UAP.cpp",
@@ -161,6 +163,7 @@ fn compile_cpp_with_ffi_bridge() {
         "Utils.cpp",
         "WiresharkWrapper.cpp",
         "XMLParser.cpp",
+        "recorddecoder.cxx",
     ];
 
     for source in &asterix_sources {
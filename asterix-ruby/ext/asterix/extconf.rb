@@ -61,6 +61,8 @@ asterix_sources = %w[
   DataItemFormatRepetitive.cpp
   DataItemFormatVariable.cpp
   DataRecord.cpp
+  DecodePlan.cpp
+  ItemProgram.cpp
   Tracer.cpp
   UAP.cpp
   UAPItem.cpp
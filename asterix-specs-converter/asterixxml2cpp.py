@@ -0,0 +1,359 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+"""Generate C++ record decoders from asterix category xml definitions.
+
+The generated decoder of a category resolves the data item of every FRN of
+every UAP with a switch, and computes the length of each data item with
+straight-line code in which byte offsets, lengths and FX/presence masks are
+compile-time constants. Values of data items are still formatted by the
+generic interpreter (DataItemFormat classes).
+
+Every decoder carries the structural signature of the definition it was
+generated from. At runtime (src/asterix/recorddecoder.cxx) the signature is
+computed from the loaded definition and the generated decoder is only used if
+both match, so edited or replaced xml files fall back to the interpreter.
+
+Definitions whose structure the interpreter reports as erroneous (e.g. FX bit
+outside of its part) are skipped with a warning.
+"""
+
+import sys
+import os
+import re
+import argparse
+import xml.etree.ElementTree as ET
+
+FORMATS = ('Fixed', 'Variable', 'Compound', 'Repetitive', 'Explicit', 'BDS')
+
+# interpreter limit of length of repetitive item (DataItemFormatRepetitive.cpp)
+MAX_ASTERIX_ITEM_SIZE = 65536
+
+
+class SkipCategory(Exception):
+    pass
+
+
+def atoi(text):
+    """Mirror C atoi() as used by XMLParser."""
+    m = re.match(r'\s*([+-]?\d+)', text or '')
+    return int(m.group(1)) if m else 0
+
+
+def formatChildren(element):
+    return [e for e in element if e.tag in FORMATS]
+
+
+class Bits(object):
+    def __init__(self, element):
+        self.frm = 0
+        self.fx = False
+        self.presence = 0
+        for name, value in element.attrib.items():
+            if name == 'bit' and atoi(value) >= 0:
+                self.frm = atoi(value)
+            elif name == 'from' and atoi(value) >= 0:
+                self.frm = atoi(value)
+            elif name == 'fx':
+                self.fx = atoi(value) != 0
+        presence = element.find('BitsPresence')
+        if presence is not None:
+            self.presence = atoi(presence.text)
+
+
+class Format(object):
+    def __init__(self, element):
+        self.tag = element.tag
+        self.length = 0
+        self.bits = []
+        self.subitems = []
+        if self.tag == 'Fixed':
+            if atoi(element.get('length')) >= 0:
+                self.length = atoi(element.get('length'))
+            self.bits = [Bits(e) for e in element if e.tag == 'Bits']
+        else:
+            self.subitems = [Format(e) for e in formatChildren(element)]
+
+    def signature(self):
+        """Structural signature, must match CRecordDecoder::Signature()."""
+        if self.tag == 'Fixed':
+            s = 'F{}'.format(self.length)
+            for b in self.bits:
+                if b.fx:
+                    s += 'x{}'.format(b.frm)
+                if b.presence != 0:
+                    s += 'p{}@{}'.format(b.presence, b.frm)
+            return s
+        if self.tag == 'BDS':
+            return 'B'
+        return '{}({})'.format(self.tag[0], ','.join(f.signature() for f in self.subitems))
+
+    def mask(self, frm):
+        """Byte offset and mask of bit in this Fixed part (DataItemFormatFixed)."""
+        if frm < 1 or frm > self.length * 8:
+            raise SkipCategory('bit {} out of Fixed length {}'.format(frm, self.length))
+        return self.length - 1 - (frm - 1) // 8, 1 << ((frm - 1) % 8)
+
+    def fxMask(self):
+        """FX bit of Variable part, None if this is the last part."""
+        for b in self.bits:
+            if b.fx:
+                return self.mask(b.frm)
+        return None
+
+    def presenceMask(self, part):
+        """Presence bit of secondary part in Compound primary, None if not present."""
+        for b in self.bits:
+            if b.presence == part:
+                return self.mask(b.frm)
+        return None
+
+
+class Generator(object):
+    def __init__(self):
+        self.functions = []
+        self.names = {}
+
+    def constLength(self, f):
+        if f.tag == 'Fixed':
+            return f.length
+        if f.tag == 'BDS':
+            return 8
+        return None
+
+    def call(self, f, p, n):
+        """Expression for length of format f at data p with n bytes left."""
+        length = self.constLength(f)
+        if length is not None:
+            return str(length)
+        return '{}({}, {})'.format(self.function(f), p, n)
+
+    def function(self, f):
+        """Name of function computing length of format f, formats with same code share function."""
+        body = ''.join('    ' + l + '\n' for l in getattr(self, 'gen' + f.tag)(f))
+        if body not in self.names:
+            self.names[body] = 'length{}'.format(len(self.names) + 1)
+            self.functions.append('long {}(const unsigned char *p, long n) {{\n{}}}\n'.format(self.names[body], body))
+        return self.names[body]
+
+    def genVariable(self, f):
+        if not f.subitems or any(part.tag != 'Fixed' for part in f.subitems):
+            raise SkipCategory('Variable must consist of Fixed parts')
+        body = []
+        offset = 0
+        for part in f.subitems[:-1]:
+            fx = part.fxMask()
+            if fx is None:
+                body.append('return {};'.format(offset + part.length))
+                return body
+            body.append('if (n < {}) return n + 1;'.format(offset + part.length))
+            body.append('if (!(p[{}] & 0x{:02X})) return {};'.format(offset + fx[0], fx[1], offset + part.length))
+            offset += part.length
+        last = f.subitems[-1]
+        fx = last.fxMask()
+        if fx is None:
+            body.append('return {};'.format(offset + last.length))
+            return body
+        # last part is repeated while FX bit is set
+        body.append('long len = {};'.format(offset))
+        body.append('while (true) {')
+        body.append('    if (n < len + {}) return n + 1;'.format(last.length))
+        body.append('    if (!(p[len + {}] & 0x{:02X})) return len + {};'.format(fx[0], fx[1], last.length))
+        body.append('    len += {};'.format(last.length))
+        body.append('}')
+        return body
+
+    def genCompound(self, f):
+        if not f.subitems or f.subitems[0].tag != 'Variable':
+            raise SkipCategory('Compound must start with Variable')
+        primary = f.subitems[0]
+        secondaries = f.subitems[1:]
+        if not secondaries:
+            raise SkipCategory('Compound without secondary parts')
+        body = ['long len = {};'.format(self.call(primary, 'p', 'n')),
+                'if (len > n) return n + 1;']
+        offset = 0
+        for nPart, part in enumerate(primary.subitems, 1):
+            for k, secondary in enumerate(secondaries, 1):
+                presence = part.presenceMask(k)
+                if presence is None:
+                    continue
+                body.append('if (p[{}] & 0x{:02X}) {{'.format(offset + presence[0], presence[1]))
+                length = self.constLength(secondary)
+                if length is not None:
+                    body.append('    if (n - len < {}) return n + 1;'.format(length))
+                    body.append('    len += {};'.format(length))
+                else:
+                    body.append('    l = {};'.format(self.call(secondary, 'p + len', 'n - len')))
+                    body.append('    if (l > n - len) return n + 1;')
+                    body.append('    len += l;')
+                body.append('}')
+            fx = part.fxMask()
+            if fx is None or nPart == len(primary.subitems):
+                break
+            body.append('if (!(p[{}] & 0x{:02X})) return len;'.format(offset + fx[0], fx[1]))
+            offset += part.length
+        body.append('return len;')
+        if any(line.startswith('    l = ') for line in body):
+            body.insert(2, 'long l;')
+        return body
+
+    def genRepetitive(self, f):
+        if not f.subitems:
+            raise SkipCategory('Repetitive without format')
+        body = ['if (n < 1) return n + 1;']
+        length = self.constLength(f.subitems[0])
+        if length is not None:
+            body.append('const long len = 1 + static_cast<long>(p[0]) * {};'.format(length))
+        else:
+            body.append('const long len = 1 + static_cast<long>(p[0]) * {};'.format(
+                self.call(f.subitems[0], 'p + 1', 'n - 1')))
+        if length is None or 1 + 255 * length > MAX_ASTERIX_ITEM_SIZE:
+            body.append('if (len > {}) return 0;'.format(MAX_ASTERIX_ITEM_SIZE))
+        body.append('return len;')
+        return body
+
+    def genExplicit(self, f):
+        return ['if (n < 1) return n + 1;',
+                'return p[0];']
+
+
+class Category(object):
+    def __init__(self, filename):
+        root = ET.parse(filename).getroot()
+        if root.tag != 'Category':
+            raise Exception('{}: not a category definition'.format(filename))
+        self.filename = filename
+        self.id = atoi(root.get('id'))
+        self.ver = root.get('ver', '')
+        self.items = {}
+        for item in root.findall('DataItem'):
+            itemId = item.get('id')
+            if itemId in self.items:
+                raise SkipCategory('duplicate item {}'.format(itemId))
+            fmt = item.find('DataItemFormat')
+            children = formatChildren(fmt) if fmt is not None else []
+            self.items[itemId] = Format(children[0]) if children else None
+        self.uaps = []
+        for uap in root.findall('UAP'):
+            frns = {}
+            for ui in uap.findall('UAPItem'):
+                frn = ui.get('frn')
+                if frn is None or frn == 'FX':
+                    continue
+                frn = atoi(frn)
+                if frn > 0 and frn not in frns:
+                    frns[frn] = ui.text or ''
+            self.uaps.append((atoi(uap.get('use_if_bit_set')), atoi(uap.get('use_if_byte_nr')),
+                              atoi(uap.get('is_set_to')) & 0xFF, sorted(frns.items())))
+
+    def signature(self):
+        """Structural signature, must match CRecordDecoder::Signature()."""
+        s = ''
+        referenced = []
+        for bitset, bytenr, isset, frns in self.uaps:
+            s += 'U{},{},{}['.format(bitset, bytenr, isset)
+            for frn, itemId in frns:
+                s += '{}={};'.format(frn, itemId)
+                if itemId not in referenced:
+                    referenced.append(itemId)
+            s += ']'
+        for itemId in referenced:
+            if itemId not in self.items:
+                sig = '?'
+            elif self.items[itemId] is None:
+                sig = '-'
+            else:
+                sig = self.items[itemId].signature()
+            s += 'I{}={};'.format(itemId, sig)
+        return s
+
+    def render(self):
+        gen = Generator()
+        uaps = []
+        for frns in (uap[3] for uap in self.uaps):
+            cases = []
+            for frn, itemId in frns:
+                f = self.items.get(itemId)
+                if f is not None:
+                    cases.append((frn, itemId, gen.call(f, 'p', 'n')))
+            uaps.append(cases)
+
+        name = 'cat{:03d}'.format(self.id)
+        signature = self.signature()
+        chunks = [signature[i:i + 100] for i in range(0, len(signature), 100)] or ['']
+        out = ['// {} (CAT{:03d} v{})'.format(os.path.basename(self.filename), self.id, self.ver),
+               'namespace {} {{'.format(name),
+               '',
+               'const char SIGNATURE[] =']
+        out += ['        "{}"'.format(c) for c in chunks[:-1]]
+        out.append('        "{}";'.format(chunks[-1]))
+        out.append('')
+        for function in gen.functions:
+            out.append(function)
+        out.append('long itemLength(int uap, int frn, const unsigned char *p, long n) {')
+        out.append('    switch (uap) {')
+        for nUAP, cases in enumerate(uaps):
+            out.append('    case {}:'.format(nUAP))
+            out.append('        switch (frn) {')
+            for frn, itemId, expr in cases:
+                out.append('        case {}: return {}; // I{}'.format(frn, expr, itemId))
+            out.append('        default: return 0;')
+            out.append('        }')
+        out.append('    default: return 0;')
+        out.append('    }')
+        out.append('}')
+        out.append('')
+        out.append('}} // namespace {}'.format(name))
+        out.append('')
+        return name, '\n'.join(out)
+
+
+HEADER = '''/*
+ * Generated by asterix-specs-converter/asterixxml2cpp.py, do not edit.
+ *
+ * Record decoders specialized for category definitions:
+{}
+ */
+
+#include "recorddecoder.hxx"
+
+namespace {{
+
+'''
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate C++ record decoders from asterix xml definitions.')
+    parser.add_argument('xml', nargs='+', help="input category xml file")
+    parser.add_argument('-o', '--outfile', nargs='?', type=argparse.FileType('wt'), default=sys.stdout)
+    args = parser.parse_args()
+
+    decoders = []
+    rendered = []
+    for filename in args.xml:
+        try:
+            cat = Category(filename)
+            name, text = cat.render()
+        except SkipCategory as e:
+            sys.stderr.write('{}: no decoder generated ({})\n'.format(filename, e))
+            continue
+        decoders.append((cat, name))
+        rendered.append(text)
+
+    out = args.outfile
+    out.write(HEADER.format('\n'.join(' *   {}'.format(os.path.basename(f)) for f in args.xml)))
+    out.write('\n'.join(rendered) + '\n')
+    out.write('} // namespace\n\n')
+    out.write('extern const SGeneratedDecoder gGeneratedDecoders[] = {\n')
+    for cat, name in decoders:
+        out.write('        {{{}, "{}", {}::SIGNATURE, {}::itemLength}},\n'.format(cat.id, cat.ver, name, name))
+    if not decoders:
+        out.write('        {0, "", "", nullptr},\n')
+    out.write('};\n\n')
+    out.write('extern const unsigned int gNGeneratedDecoders = {};\n'.format(len(decoders)))
+
+
+# main
+if __name__ == '__main__':
+    main()
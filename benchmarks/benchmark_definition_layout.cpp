@@ -0,0 +1,244 @@
+/*
+ *  ASTERIX Performance Benchmark - Definition Layout
+ *
+ *  Decodes raw ASTERIX files repeatedly with either the frozen definition
+ *  layout (contiguous arrays and lookup tables built after loading) or the
+ *  original pointer lists, so that both can be compared under perf stat.
+ *  With the frozen layout, --item-programs off measures item lengths by the
+ *  format classes instead of the compiled item programs:
+ *
+ *    perf stat -e cache-references,cache-misses,L1-dcache-load-misses \
+ *        ./bin/benchmark_definition_layout --layout frozen <files>
+ *    perf stat -e cache-references,cache-misses,L1-dcache-load-misses \
+ *        ./bin/benchmark_definition_layout --layout lists <files>
+ *
+ *  Unlike the other benchmarks this one links against the ASTERIX library.
+ */
+
+#include "benchmark_common.h"
+
+#include "AsterixData.h"
+#include "AsterixDefinition.h"
+#include "InputParser.h"
+#include "XMLParser.h"
+#include "asterixformat.hxx"
+
+#include <cstdio>
+
+struct LayoutBenchmarkConfig {
+    BenchmarkConfig base;
+    std::string ini_file = "../asterix/config/asterix.ini";
+    std::string layout = "frozen";  // frozen, lists
+    bool item_programs = true;
+    std::string output_format = "json";  // none, text, json
+    int passes = 100;
+    std::vector<std::string> input_files;
+};
+
+LayoutBenchmarkConfig parse_args(int argc, char** argv) {
+    LayoutBenchmarkConfig config;
+    config.base = parse_common_args(argc, argv);
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+
+        if (arg == "--layout" && i + 1 < argc) {
+            config.layout = argv[++i];
+        } else if (arg == "--item-programs" && i + 1 < argc) {
+            config.item_programs = std::string(argv[++i]) != "off";
+        } else if (arg == "--definitions" && i + 1 < argc) {
+            config.ini_file = argv[++i];
+        } else if (arg == "--format" && i + 1 < argc) {
+            config.output_format = argv[++i];
+        } else if (arg == "--passes" && i + 1 < argc) {
+            config.passes = std::atoi(argv[++i]);
+        } else if (arg == "--iterations" || arg == "--warmup" || arg == "--output" ||
+                   arg == "--baseline" || arg == "--threshold") {
+            i++;
+        } else if (arg == "--help" || arg == "-h") {
+            print_help(argv[0], "[OPTIONS] <raw_file>...");
+            std::cout << "\nDefinition Layout Benchmark Options:\n";
+            std::cout << "  --layout <layout>   Definition layout: frozen|lists (default: frozen)\n";
+            std::cout << "  --item-programs <on|off>  Item lengths by compiled item programs of the\n";
+            std::cout << "                      frozen layout (default: on)\n";
+            std::cout << "  --definitions <f>   asterix.ini listing the XML definitions\n";
+            std::cout << "                      (default: ../asterix/config/asterix.ini)\n";
+            std::cout << "  --format <fmt>      Output format: none|text|json (default: json)\n";
+            std::cout << "  --passes <n>        Decodes of every file per iteration (default: 100)\n";
+            exit(0);
+        } else if (arg[0] != '-') {
+            config.input_files.push_back(arg);
+        }
+    }
+
+    if (config.input_files.empty()) {
+        std::cerr << "ERROR: No input file specified\n";
+        std::cerr << "Usage: " << argv[0] << " [OPTIONS] <raw_file>...\n";
+        exit(1);
+    }
+    if (config.layout != "frozen" && config.layout != "lists") {
+        std::cerr << "ERROR: Unknown layout: " << config.layout << "\n";
+        exit(1);
+    }
+
+    return config;
+}
+
+bool load_definitions(const std::string& ini_file, AsterixDefinition* definition) {
+    std::ifstream ini(ini_file);
+    if (!ini.is_open()) {
+        std::cerr << "ERROR: Could not open definitions file: " << ini_file << "\n";
+        return false;
+    }
+
+    std::string dir;
+    size_t slash = ini_file.find_last_of('/');
+    if (slash != std::string::npos) {
+        dir = ini_file.substr(0, slash + 1);
+    }
+
+    std::string line;
+    while (std::getline(ini, line)) {
+        line.erase(line.find_last_not_of(" \t\r\n") + 1);
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::string path = dir + line;
+        FILE* f = fopen(path.c_str(), "r");
+        if (f == nullptr) {
+            std::cerr << "ERROR: Could not open definition: " << path << "\n";
+            return false;
+        }
+        XMLParser parser;
+        bool ok = parser.Parse(f, definition, path.c_str());
+        fclose(f);
+        if (!ok) {
+            std::cerr << "ERROR: Could not parse definition: " << path << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<unsigned char> read_file(const std::string& filename) {
+    std::ifstream input(filename, std::ios::binary);
+    return std::vector<unsigned char>((std::istreambuf_iterator<char>(input)),
+                                      std::istreambuf_iterator<char>());
+}
+
+struct DecodeResult {
+    size_t bytes_processed = 0;
+    size_t output_bytes = 0;
+    double elapsed_seconds = 0.0;
+
+    double throughput_mbps() const {
+        if (elapsed_seconds <= 0.0) return 0.0;
+        return (bytes_processed / (1024.0 * 1024.0)) / elapsed_seconds;
+    }
+};
+
+DecodeResult run_decode(const LayoutBenchmarkConfig& config, InputParser& parser,
+                        const std::vector<std::vector<unsigned char>>& inputs) {
+    DecodeResult result;
+    unsigned int formatType = CAsterixFormat::EJSON;
+    if (config.output_format == "text") {
+        formatType = CAsterixFormat::ETxt;
+    }
+
+    Timer timer;
+    timer.start();
+
+    std::string text;
+    for (int pass = 0; pass < config.passes; pass++) {
+        for (const auto& data : inputs) {
+            AsterixData* pData = parser.parsePacket(data.data(), static_cast<unsigned int>(data.size()), 0.0);
+            if (pData != nullptr) {
+                if (config.output_format != "none") {
+                    text.clear();
+                    pData->getText(text, formatType);
+                    result.output_bytes += text.size();
+                }
+                delete pData;
+            }
+            result.bytes_processed += data.size();
+        }
+    }
+
+    timer.stop();
+    result.elapsed_seconds = timer.elapsed_seconds();
+    return result;
+}
+
+int main(int argc, char** argv) {
+    LayoutBenchmarkConfig config = parse_args(argc, argv);
+    BenchmarkResults results("definition_layout");
+
+    AsterixDefinition definition;
+    definition.setFreezeCategories(config.layout == "frozen");
+    definition.setItemPrograms(config.item_programs);
+    if (!load_definitions(config.ini_file, &definition)) {
+        return 1;
+    }
+
+    std::vector<std::vector<unsigned char>> inputs;
+    size_t input_size = 0;
+    for (const auto& file : config.input_files) {
+        inputs.push_back(read_file(file));
+        if (inputs.back().empty()) {
+            std::cerr << "ERROR: Could not read input file: " << file << "\n";
+            return 1;
+        }
+        input_size += inputs.back().size();
+    }
+
+    InputParser parser(&definition);
+    // measure the interpreter, not the generated decoders
+    parser.setGeneratedDecoders(false);
+
+    std::cout << "ASTERIX Definition Layout Benchmark\n";
+    std::cout << "===================================\n";
+    std::cout << "Layout: " << config.layout << "\n";
+    std::cout << "Item programs: " << (config.item_programs && config.layout == "frozen" ? "on" : "off") << "\n";
+    std::cout << "Input files: " << inputs.size() << " (" << format_bytes(input_size) << ")\n";
+    std::cout << "Output format: " << config.output_format << "\n";
+    std::cout << "Passes per iteration: " << config.passes << "\n";
+    std::cout << "Iterations: " << config.base.iterations << "\n";
+    std::cout << std::endl;
+
+    for (int i = 0; i < config.base.warmup_iterations; i++) {
+        run_decode(config, parser, inputs);
+    }
+
+    Statistics throughput_stats;
+    for (int i = 0; i < config.base.iterations; i++) {
+        DecodeResult iter_result = run_decode(config, parser, inputs);
+        throughput_stats.add(iter_result.throughput_mbps());
+
+        if (config.base.verbose) {
+            std::cout << "  Iteration " << (i + 1) << ": "
+                     << std::fixed << std::setprecision(2)
+                     << iter_result.throughput_mbps() << " MB/s, "
+                     << format_bytes(iter_result.output_bytes) << " output\n";
+        }
+    }
+
+    results.add_metric("input_bytes", input_size);
+    results.add_metric("frozen_layout", config.layout == "frozen" ? 1 : 0);
+    results.add_metric("item_programs", config.item_programs && config.layout == "frozen" ? 1 : 0);
+    results.add_metric("throughput_mbps_mean", throughput_stats.mean());
+    results.add_metric("throughput_mbps_median", throughput_stats.median());
+    results.add_metric("throughput_mbps_p95", throughput_stats.percentile(0.95));
+    results.add_metric("throughput_mbps_stddev", throughput_stats.stddev());
+    results.add_metric("iterations", config.base.iterations);
+
+    results.finalize();
+    results.print_summary();
+
+    if (!config.base.output_file.empty()) {
+        if (results.save_json(config.base.output_file)) {
+            std::cout << "Results saved to: " << config.base.output_file << "\n";
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,296 @@
+/*
+ *  ASTERIX Performance Benchmark - Unix Domain Socket vs UDP Loopback
+ *
+ *  Measures same-host packet transport cost for the transports supported by
+ *  the asterix devices:
+ *  - UDP over loopback (udp device)
+ *  - AF_UNIX datagram socket (unix device, dgram mode)
+ *  - AF_UNIX stream socket (unix device, stream mode)
+ *
+ *  For each transport a sender thread pushes synthetic ASTERIX packets as fast
+ *  as possible (or at --rate) and the receiver reports throughput, packet loss
+ *  and one-way latency percentiles (send timestamp is embedded in the packet).
+ */
+
+#include "benchmark_common.h"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <errno.h>
+#include <thread>
+#include <atomic>
+
+struct UnixBenchmarkConfig {
+    BenchmarkConfig base;
+    size_t packets = 200000;
+    int packet_size = 256;
+    int target_rate_pps = 0;  // 0 = as fast as possible
+    int port = 21113;
+    std::string socket_path = "/tmp/asterix_bench.sock";
+};
+
+UnixBenchmarkConfig parse_args(int argc, char** argv) {
+    UnixBenchmarkConfig config;
+    config.base = parse_common_args(argc, argv);
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+
+        if (arg == "--packets" && i + 1 < argc) {
+            config.packets = std::strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--packet-size" && i + 1 < argc) {
+            config.packet_size = std::atoi(argv[++i]);
+        } else if (arg == "--rate" && i + 1 < argc) {
+            config.target_rate_pps = std::atoi(argv[++i]);
+        } else if (arg == "--port" && i + 1 < argc) {
+            config.port = std::atoi(argv[++i]);
+        } else if (arg == "--path" && i + 1 < argc) {
+            config.socket_path = argv[++i];
+        } else if (arg == "--help" || arg == "-h") {
+            print_help(argv[0], "[OPTIONS]");
+            std::cout << "\nUnix Socket Benchmark Options:\n";
+            std::cout << "  --packets <n>          Packets per transport and iteration (default: 200000)\n";
+            std::cout << "  --packet-size <bytes>  Packet size (default: 256)\n";
+            std::cout << "  --rate <pps>           Target packets per second (default: 0 = unlimited)\n";
+            std::cout << "  --port <port>          UDP loopback port (default: 21113)\n";
+            std::cout << "  --path <path>          Unix socket path (default: /tmp/asterix_bench.sock)\n";
+            exit(0);
+        }
+    }
+
+    if (config.packet_size < 16) {
+        config.packet_size = 16;
+    }
+    return config;
+}
+
+enum class Transport { UdpLoopback, UnixDgram, UnixStream };
+
+static const char* transport_name(Transport t) {
+    switch (t) {
+        case Transport::UdpLoopback: return "udp_loopback";
+        case Transport::UnixDgram:   return "unix_dgram";
+        case Transport::UnixStream:  return "unix_stream";
+    }
+    return "unknown";
+}
+
+struct TransportResult {
+    size_t packets_received = 0;
+    size_t bytes_received = 0;
+    double elapsed_seconds = 0.0;
+    Statistics latency_us;
+};
+
+static int64_t now_ns() {
+    return duration_cast<std::chrono::nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+// Create bound receiver and connected sender sockets
+static bool open_pair(Transport t, const UnixBenchmarkConfig& config, int& rx, int& tx) {
+    rx = tx = -1;
+
+    if (t == Transport::UdpLoopback) {
+        struct sockaddr_in addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = htons(config.port);
+
+        rx = socket(AF_INET, SOCK_DGRAM, 0);
+        int rcvbuf = 4 * 1024 * 1024;
+        setsockopt(rx, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+        if (bind(rx, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+            std::cerr << "ERROR: Could not bind UDP port " << config.port << "\n";
+            return false;
+        }
+        tx = socket(AF_INET, SOCK_DGRAM, 0);
+        return connect(tx, (struct sockaddr*)&addr, sizeof(addr)) == 0;
+    }
+
+    const int type = (t == Transport::UnixDgram) ? SOCK_DGRAM : SOCK_STREAM;
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, config.socket_path.c_str(), sizeof(addr.sun_path) - 1);
+    unlink(config.socket_path.c_str());
+
+    int srv = socket(AF_UNIX, type, 0);
+    if (bind(srv, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+        std::cerr << "ERROR: Could not bind " << config.socket_path << "\n";
+        close(srv);
+        return false;
+    }
+    if (type == SOCK_STREAM) {
+        listen(srv, 1);
+    }
+
+    tx = socket(AF_UNIX, type, 0);
+    if (connect(tx, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+        std::cerr << "ERROR: Could not connect " << config.socket_path << "\n";
+        close(srv);
+        return false;
+    }
+
+    if (type == SOCK_STREAM) {
+        rx = accept(srv, nullptr, nullptr);
+        close(srv);
+    } else {
+        rx = srv;
+    }
+    return rx >= 0;
+}
+
+static void sender(int tx, const UnixBenchmarkConfig& config) {
+    std::vector<unsigned char> packet(config.packet_size, 0);
+    // ASTERIX header: CAT=048, LEN
+    packet[0] = 48;
+    packet[1] = (config.packet_size >> 8) & 0xFF;
+    packet[2] = config.packet_size & 0xFF;
+
+    const int64_t interval_ns = config.target_rate_pps > 0 ? 1000000000LL / config.target_rate_pps : 0;
+    int64_t next_send = now_ns();
+
+    for (uint64_t seq = 0; seq < config.packets; seq++) {
+        if (interval_ns) {
+            while (now_ns() < next_send) {
+                std::this_thread::yield();
+            }
+            next_send += interval_ns;
+        }
+
+        int64_t ts = now_ns();
+        memcpy(&packet[3], &ts, sizeof(ts));
+        if (send(tx, packet.data(), packet.size(), MSG_NOSIGNAL) < 0) {
+            if (errno == ENOBUFS || errno == EAGAIN) {
+                continue;  // dropped by sender, counted as loss
+            }
+            break;
+        }
+    }
+}
+
+static TransportResult run_transport(Transport t, const UnixBenchmarkConfig& config) {
+    TransportResult result;
+    int rx, tx;
+    if (!open_pair(t, config, rx, tx)) {
+        if (rx >= 0) close(rx);
+        if (tx >= 0) close(tx);
+        return result;
+    }
+
+    // Receiver gives up when no packet arrives for a while (lost UDP tail)
+    struct timeval timeout = {0, 200000};
+    setsockopt(rx, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    const bool stream = (t == Transport::UnixStream);
+    std::vector<unsigned char> buffer(65536);
+    size_t stream_pending = 0;  // bytes of current packet already received
+
+    Timer timer;
+    timer.start();
+    std::thread tx_thread(sender, tx, std::cref(config));
+
+    while (result.packets_received < config.packets) {
+        size_t want = stream ? config.packet_size - stream_pending : buffer.size();
+        ssize_t len = recv(rx, buffer.data() + (stream ? stream_pending : 0), want, 0);
+        if (len <= 0) {
+            break;  // timeout or closed
+        }
+
+        if (stream) {
+            stream_pending += len;
+            if (stream_pending < static_cast<size_t>(config.packet_size)) {
+                continue;
+            }
+            stream_pending = 0;
+            len = config.packet_size;
+        }
+
+        int64_t ts;
+        memcpy(&ts, &buffer[3], sizeof(ts));
+        result.latency_us.add((now_ns() - ts) / 1000.0);
+        result.packets_received++;
+        result.bytes_received += len;
+    }
+
+    timer.stop();
+    tx_thread.join();
+    result.elapsed_seconds = timer.elapsed_seconds();
+
+    close(tx);
+    close(rx);
+    if (t != Transport::UdpLoopback) {
+        unlink(config.socket_path.c_str());
+    }
+    return result;
+}
+
+int main(int argc, char** argv) {
+    UnixBenchmarkConfig config = parse_args(argc, argv);
+    BenchmarkResults results("unix_socket");
+
+    std::cout << "ASTERIX Unix Domain Socket vs UDP Loopback Benchmark\n";
+    std::cout << "====================================================\n";
+    std::cout << "Packets: " << config.packets << " per transport\n";
+    std::cout << "Packet Size: " << config.packet_size << " bytes\n";
+    std::cout << "Rate: " << (config.target_rate_pps ? std::to_string(config.target_rate_pps) + " pps" : "unlimited") << "\n";
+    std::cout << std::endl;
+
+    const Transport transports[] = {Transport::UdpLoopback, Transport::UnixDgram, Transport::UnixStream};
+    double udp_pps = 0.0;
+
+    for (Transport t : transports) {
+        const std::string name = transport_name(t);
+        Statistics pps;
+        Statistics loss;
+        TransportResult last;
+
+        for (int i = 0; i < config.base.warmup_iterations + config.base.iterations; i++) {
+            TransportResult r = run_transport(t, config);
+            if (i < config.base.warmup_iterations) {
+                continue;
+            }
+            if (r.elapsed_seconds > 0.0) {
+                pps.add(r.packets_received / r.elapsed_seconds);
+            }
+            loss.add(1.0 - static_cast<double>(r.packets_received) / config.packets);
+            last = std::move(r);
+        }
+
+        std::cout << name << ": " << static_cast<size_t>(pps.mean()) << " pps, loss "
+                  << loss.mean() * 100.0 << "%, p50 " << last.latency_us.percentile(0.50)
+                  << " us, p99 " << last.latency_us.percentile(0.99) << " us\n";
+
+        results.add_metric(name + "_packets_per_sec", pps.mean());
+        results.add_metric(name + "_throughput_mbps",
+                           pps.mean() * config.packet_size / (1024.0 * 1024.0));
+        results.add_metric(name + "_packet_loss_rate", loss.mean());
+        results.add_metric(name + "_latency_p50_us", last.latency_us.percentile(0.50));
+        results.add_metric(name + "_latency_p99_us", last.latency_us.percentile(0.99));
+
+        if (t == Transport::UdpLoopback) {
+            udp_pps = pps.mean();
+        } else if (udp_pps > 0.0) {
+            results.add_metric(name + "_speedup_vs_udp", pps.mean() / udp_pps);
+        }
+    }
+
+    std::cout << std::endl;
+
+    // Finalize and display
+    results.finalize();
+    results.print_summary();
+
+    // Save to file if requested
+    if (!config.base.output_file.empty()) {
+        if (results.save_json(config.base.output_file)) {
+            std::cout << "Results saved to: " << config.base.output_file << "\n";
+        }
+    }
+
+    return 0;
+}
@@ -315,6 +315,51 @@ run_udp_benchmark() {
     print_success "UDP benchmark complete"
 }
 
+# Run Unix domain socket vs UDP loopback benchmark
+run_unix_benchmark() {
+    print_info "Running Unix socket benchmark..."
+
+    local output_file="${CURRENT_RESULTS_DIR}/benchmark_unix_socket.json"
+    local cmd="${BUILD_DIR}/bin/benchmark_unix_socket"
+
+    cmd="${cmd} --iterations ${ITERATIONS}"
+    cmd="${cmd} --output ${output_file}"
+
+    if [[ "${VERBOSE}" == "true" ]]; then
+        cmd="${cmd} --verbose"
+    fi
+
+    eval "${cmd}"
+    print_success "Unix socket benchmark complete"
+}
+
+# Run frozen vs list definition layout benchmark (only built against libasterix.a)
+run_layout_benchmark() {
+    local cmd="${BUILD_DIR}/bin/benchmark_definition_layout"
+    if [[ ! -x "${cmd}" ]]; then
+        print_warning "benchmark_definition_layout not built (ASTERIX library not found), skipping"
+        return
+    fi
+
+    print_info "Running definition layout benchmark..."
+
+    local layout
+    for layout in frozen lists; do
+        local output_file="${CURRENT_RESULTS_DIR}/benchmark_definition_layout_${layout}.json"
+        local run="${cmd} --layout ${layout}"
+        run="${run} --definitions ${ASTERIX_ROOT}/asterix/config/asterix.ini"
+        run="${run} --iterations ${ITERATIONS} --warmup ${WARMUP}"
+        run="${run} --output ${output_file}"
+
+        if [[ "${VERBOSE}" == "true" ]]; then
+            run="${run} --verbose"
+        fi
+
+        eval "${run} ${ASTERIX_ROOT}/asterix/sample_data/cat048.raw ${ASTERIX_ROOT}/asterix/sample_data/cat062cat065.raw"
+    done
+    print_success "Definition layout benchmark complete"
+}
+
 # Generate summary report
 generate_summary() {
     print_info "Generating summary report..."
@@ -418,6 +463,12 @@ main() {
     run_udp_benchmark
     echo ""
 
+    run_unix_benchmark
+    echo ""
+
+    run_layout_benchmark
+    echo ""
+
     # Generate reports
     generate_summary
 
@@ -175,6 +175,8 @@ asterix_module = Extension('_asterix',
                                     './src/asterix/Category.cpp',
                                     './src/asterix/DataBlock.cpp',
                                     './src/asterix/DataRecord.cpp',
+                                    './src/asterix/DecodePlan.cpp',
+                                    './src/asterix/ItemProgram.cpp',
                                     './src/asterix/DataItem.cpp',
                                     './src/asterix/DataItemBits.cpp',
                                     './src/asterix/DataItemDescription.cpp',
@@ -191,6 +193,7 @@ asterix_module = Extension('_asterix',
                                     './src/asterix/UAPItem.cpp',
                                     './src/asterix/Utils.cpp',
                                     './src/asterix/XMLParser.cpp',
+                                    './src/asterix/recorddecoder.cxx',
                                     ],
 
                            include_dirs=expat_include_dirs,
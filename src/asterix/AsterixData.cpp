@@ -52,6 +52,19 @@ bool AsterixData::getText(std::string &strResult, const unsigned int formatType)
     return true;
 }
 
+/*
+ * appends binary Asterix data blocks passing the filter to result
+ */
+bool AsterixData::getBinary(std::vector<unsigned char> &result) const {
+    bool bAppended = false;
+    for (const auto* db : m_lDataBlocks) {
+        if (db != nullptr && db->getBinary(result)) {
+            bAppended = true;
+        }
+    }
+    return bAppended;
+}
+
 
 #if defined(WIRESHARK_WRAPPER) || defined(ETHEREAL_WRAPPER)
 fulliautomatix_data* AsterixData::getData()
@@ -322,6 +322,18 @@ public:
      */
     bool
     getText(std::string &strResult, const unsigned int formatType);
+
+    /**
+     * @brief Append binary ASTERIX data (as in raw format) of all blocks passing the filter
+     *
+     * Used to write raw and PCAP output. Blocks and records filtered out
+     * (see DataBlock::getBinary()) are left out, the others are written
+     * as received.
+     *
+     * @param[out] result Buffer to which the data blocks are appended
+     * @return true if at least one data block was appended
+     */
+    bool getBinary(std::vector<unsigned char> &result) const;
 };
 
 #endif /* ASTERIXDATA_H_ */
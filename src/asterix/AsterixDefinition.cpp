@@ -22,6 +22,12 @@
  */
 
 #include "AsterixDefinition.h"
+#include "DataItemFormatFixed.h"
+#include "DataItemBits.h"
+#include "XMLParser.h"
+#include "Tracer.h"
+#include <cstdlib>
+#include <utility>
 
 AsterixDefinition::AsterixDefinition() {
     for (int i = 0; i < MAX_CATEGORIES; i++) {
@@ -38,9 +44,12 @@ AsterixDefinition::~AsterixDefinition() {
 }
 
 Category *AsterixDefinition::getCategory(int i) {
-    if (i >= MAX_CATEGORIES)
+    if (i < 0 || i >= MAX_CATEGORIES)
         return nullptr;
 
+    loadCategory(i);
+
+    std::lock_guard<std::mutex> lock(m_mutexCategory);
     if (m_pCategory[i] == nullptr) {
         m_pCategory[i] = new Category(i);
     }
@@ -50,15 +59,90 @@ Category *AsterixDefinition::getCategory(int i) {
 
 void AsterixDefinition::setCategory(Category *newCategory) {
     if (newCategory != nullptr) {
+        if (!newCategory->m_bFrozen) {
+            freezeCategory(newCategory);
+        }
+        std::lock_guard<std::mutex> lock(m_mutexCategory);
         if (m_pCategory[newCategory->m_id] != nullptr) {
             delete m_pCategory[newCategory->m_id];
         }
         m_pCategory[newCategory->m_id] = newCategory;
+        m_bCategoryPending[newCategory->m_id].store(false, std::memory_order_release);
+        m_nRevision++;
+    }
+}
+
+void AsterixDefinition::freezeCategory(Category *pCategory) const {
+    if (m_bFreezeCategories) {
+        pCategory->freeze(m_bItemPrograms);
+    }
+}
+
+void AsterixDefinition::registerCategoryFile(int i, const std::string &file) {
+    if (i < 0 || i >= MAX_CATEGORIES)
+        return;
+
+    std::lock_guard<std::recursive_mutex> lock(m_mutexLoad);
+    if (m_pCategory[i] == nullptr) {
+        m_strCategoryFile[i] = file;
+        m_bCategoryPending[i].store(true, std::memory_order_release);
+    }
+}
+
+bool AsterixDefinition::loadCategory(int i) {
+    if (i < 0 || i >= MAX_CATEGORIES)
+        return false;
+
+    if (m_bCategoryPending[i].load(std::memory_order_acquire)) {
+        std::lock_guard<std::recursive_mutex> lock(m_mutexLoad);
+        // a file being loaded by this thread may ask for its own category
+        if (m_bCategoryPending[i].load(std::memory_order_relaxed) && !m_bCategoryLoading[i]) {
+            m_bCategoryLoading[i] = true;
+            const std::string &file = m_strCategoryFile[i];
+            FILE *fp = fopen(file.c_str(), "rt");
+            if (fp == nullptr) {
+                Tracer::Error("Failed to open definitions file: %s", file.c_str());
+            } else {
+                XMLParser parser;
+                if (!parser.Parse(fp, this, file.c_str())) {
+                    Tracer::Error("Failed to parse definitions file: %s", file.c_str());
+                }
+                fclose(fp);
+            }
+            m_bCategoryLoading[i] = false;
+            m_bCategoryPending[i].store(false, std::memory_order_release);
+        }
     }
+    return m_pCategory[i] != nullptr;
+}
+
+void AsterixDefinition::loadAllCategories() {
+    for (int i = 0; i < MAX_CATEGORIES; i++) {
+        loadCategory(i);
+    }
+}
+
+bool AsterixDefinition::CategoryAvailable(int i) const {
+    return i >= 0 && i < MAX_CATEGORIES &&
+           (m_pCategory[i] != nullptr || m_bCategoryPending[i].load(std::memory_order_acquire));
+}
+
+bool AsterixDefinition::CategoryLoaded(int i) const {
+    // pending is cleared after the category is set
+    return i >= 0 && i < MAX_CATEGORIES && !m_bCategoryPending[i].load(std::memory_order_acquire) &&
+           m_pCategory[i] != nullptr;
+}
+
+void AsterixDefinition::setFreezeCategories(bool bFreeze) {
+    m_bFreezeCategories = bFreeze;
+}
+
+void AsterixDefinition::setItemPrograms(bool bCompile) {
+    m_bItemPrograms = bCompile;
 }
 
 bool AsterixDefinition::CategoryDefined(int i) {
-    return i >= 0 && i < MAX_CATEGORIES && m_pCategory[i] != nullptr;
+    return loadCategory(i);
 }
 
 std::string AsterixDefinition::printDescriptors() {
@@ -96,3 +180,94 @@ const char *AsterixDefinition::getDescription(int category, const char *item = n
     }
     return nullptr;
 }
+
+// first field named name in pFormat and its sub-items
+static const DataItemBits *findBits(const DataItemFormat *pFormat, const std::string &name) {
+    if (pFormat == nullptr) {
+        return nullptr;
+    }
+    if (pFormat->isBits()) {
+        const auto *bits = static_cast<const DataItemBits *>(pFormat);
+        return bits->m_strShortName == name ? bits : nullptr;
+    }
+    std::vector<DataItemFormat *> buffer;
+    for (const auto *subItem : pFormat->getSubItems(buffer)) {
+        if (const DataItemBits *bits = findBits(subItem, name)) {
+            return bits;
+        }
+    }
+    return nullptr;
+}
+
+FieldPath AsterixDefinition::compile(const std::string &path) {
+    FieldPath result;
+
+    const size_t slash = path.find('/');
+    const size_t dot = path.find('.', slash == std::string::npos ? 0 : slash);
+    if (slash == std::string::npos || slash == 0 || dot == std::string::npos) {
+        return result;
+    }
+    char *end = nullptr;
+    const long cat = strtol(path.c_str(), &end, 10);
+    if (end != path.c_str() + slash || cat < 0 || cat >= MAX_CATEGORIES || !loadCategory(static_cast<int>(cat))) {
+        return result;
+    }
+    const DataItemDescription *pDescription =
+            m_pCategory[cat]->findDataItemDescription(path.substr(slash + 1, dot - slash - 1));
+    if (pDescription == nullptr || pDescription->m_pFormat == nullptr) {
+        return result;
+    }
+
+    const DataItemFormat *pFormat = pDescription->m_pFormat;
+    std::string field = path.substr(dot + 1);
+    const DataItemBits *pBits = nullptr;
+    if (pFormat->isCompound()) {
+        // secondary parts, selected by the presence bit named by the first component
+        std::vector<DataItemFormat *> buffer;
+        const std::vector<DataItemFormat *> &subItems = pFormat->getSubItems(buffer);
+        const size_t sub = field.find('.');
+        if (sub != std::string::npos && !subItems.empty()) {
+            const DataItemBits *presence = findBits(subItems[0], field.substr(0, sub));
+            field = field.substr(sub + 1);
+            if (presence != nullptr && presence->m_nPresenceOfField > 0 &&
+                static_cast<size_t>(presence->m_nPresenceOfField) < subItems.size()) {
+                pBits = findBits(subItems[presence->m_nPresenceOfField], field);
+            }
+        } else {
+            for (size_t i = 1; i < subItems.size() && pBits == nullptr; i++) {
+                pBits = findBits(subItems[i], field);
+            }
+        }
+    } else {
+        pBits = findBits(pFormat, field);
+    }
+    if (pBits == nullptr) {
+        return result;
+    }
+
+    result.m_nCategory = static_cast<int>(cat);
+    result.m_pDescription = pDescription;
+    result.m_pBits = pBits;
+
+    // fields of a Fixed item or of the first part of a Variable item are at a constant position
+    const DataItemFormat *pFirst = pFormat;
+    if (pFormat->isVariable()) {
+        pFirst = !pFormat->m_lSubItems.empty() ? pFormat->m_lSubItems.front() : nullptr;
+    }
+    if (pFirst != nullptr && pFirst->isFixed()) {
+        const int partLength = static_cast<const DataItemFormatFixed *>(pFirst)->m_nLength;
+        int from = pBits->m_nFrom;
+        int to = pBits->m_nTo;
+        if (from > to) {
+            std::swap(from, to);
+        }
+        for (const auto *subItem : pFirst->m_lSubItems) {
+            if (subItem == pBits && from >= 1 && to <= partLength * 8) {
+                result.m_nPartLength = partLength;
+                result.m_nFrom = from;
+                result.m_nTo = to;
+            }
+        }
+    }
+    return result;
+}
@@ -33,6 +33,10 @@
 #define ASTERIXDEFINITION_H_
 
 #include "Category.h"
+#include "FieldPath.h"
+#include <atomic>
+#include <mutex>
+#include <string>
 
 /**
  * @brief Maximum number of ASTERIX categories (0-255 plus BDS at 256)
@@ -61,11 +65,18 @@
  * initialized at program startup via InputParser::init().
  *
  * @par Thread Safety
- * **WARNING: This class is NOT thread-safe.**
+ * Loading definitions (XMLParser, setCategory, filterOutItem) is NOT thread-safe
+ * and must be completed before parsing starts.
  *
- * The global singleton pattern means all parsing operations share the same
- * category definitions. Concurrent access from multiple threads will cause
- * race conditions. See the Rust bindings documentation for thread-safe usage patterns.
+ * Once loaded, a definition may be shared by several InputParser instances
+ * running on different threads (see CConverterEngine multi-input mode):
+ * getCategory() serializes the lazy creation of unknown categories and record
+ * parsing only performs read-only lookups.
+ *
+ * Categories registered with registerCategoryFile() are parsed by the first
+ * getCategory() or CategoryDefined() asking for them, which may happen on any
+ * parsing thread: loading is serialized and other threads asking for the same
+ * category wait until it is loaded.
  *
  * @par Initialization
  * Categories are loaded from XML files via XMLParser during initialization:
@@ -130,6 +141,7 @@ public:
      *
      * @note The returned pointer is owned by AsterixDefinition.
      *       Do not delete it.
+     * @note A registered category (registerCategoryFile()) is loaded first.
      *
      * @par Example
      * @code
@@ -163,9 +175,83 @@ public:
      */
     void setCategory(Category *newCategory);
 
+    /**
+     * @brief Freeze a category as setCategory() does, before it is set
+     *
+     * Lets the thread which parsed the category do the work (item programs,
+     * UAP lookup tables); setCategory() does not freeze it again.
+     *
+     * @param pCategory Category not set yet
+     */
+    void freezeCategory(Category *pCategory) const;
+
+    /**
+     * @brief Enable or disable freezing of categories in setCategory() (enabled by default)
+     *
+     * Frozen categories (Category::freeze()) are decoded from contiguous
+     * arrays and lookup tables. Disabling it keeps decoding on the lists of
+     * the definition tree, e.g. to compare both layouts.
+     */
+    void setFreezeCategories(bool bFreeze);
+
+    /**
+     * @brief Enable or disable item programs of frozen categories (enabled by default)
+     *
+     * Item formats of frozen categories are compiled into linear programs
+     * (ItemProgram) used to compute item lengths. Disabling it keeps all
+     * items on the format classes, e.g. to compare both.
+     */
+    void setItemPrograms(bool bCompile);
+
+    /**
+     * @brief Register the definition file of a category for loading on first use
+     *
+     * The file is parsed (XMLParser) the first time getCategory(),
+     * CategoryDefined() or loadCategory() asks for category i, so categories
+     * not seen in the data are never loaded. Registering a category again
+     * replaces the file if it was not loaded yet.
+     *
+     * @param i    Category number (0-255, or 256 for BDS)
+     * @param file Path of the XML definition file of the category
+     *
+     * @see XMLParser::ReadCategoryId() to get the category of a file
+     */
+    void registerCategoryFile(int i, const std::string &file);
+
+    /**
+     * @brief Parse the registered definition file of a category if not loaded yet
+     *
+     * @param i Category number (0-255, or 256 for BDS)
+     * @return true if the category is defined
+     */
+    bool loadCategory(int i);
+
+    /**
+     * @brief Parse all registered definition files not loaded yet (eager loading)
+     */
+    void loadAllCategories();
+
+    /**
+     * @brief Check if a category is defined or registered, without loading it
+     *
+     * @param i Category number to check (0-255, or 256 for BDS)
+     */
+    bool CategoryAvailable(int i) const;
+
+    /**
+     * @brief Check if a category is loaded, without loading it
+     *
+     * Safe while another thread loads categories.
+     *
+     * @param i Category number to check (0-255, or 256 for BDS)
+     */
+    bool CategoryLoaded(int i) const;
+
     /**
      * @brief Check if a category is loaded
      *
+     * A registered category (registerCategoryFile()) is loaded first.
+     *
      * @param i Category number to check (0-255, or 256 for BDS)
      * @return true if the category is defined (not nullptr), false otherwise
      *
@@ -178,6 +264,14 @@ public:
      */
     bool CategoryDefined(int i);
 
+    /**
+     * @brief Revision of definitions, incremented by every setCategory()
+     *
+     * Lets holders of pointers into category definitions (e.g. InputParser
+     * with bound generated decoders) detect that a category was replaced.
+     */
+    unsigned int getRevision() const { return m_nRevision; }
+
     /**
      * @brief Generate a printable list of all loaded category descriptors
      *
@@ -236,6 +330,29 @@ public:
      */
     const char *getDescription(int category, const char *item, const char *field, const char *value);
 
+    /**
+     * @brief Resolve a field name to a FieldPath for DataRecord::get()
+     *
+     * @param path Field as "CAT/ITEM.FIELD" (e.g. "062/105.LAT"), fields of
+     *             compound items optionally as "CAT/ITEM.SUBITEM.FIELD" where
+     *             SUBITEM is the name of its presence bit (e.g. "062/380.ADR.ADR").
+     *             Without SUBITEM the first field of that name in the secondary
+     *             parts of a compound item is taken.
+     * @return Resolved path, or a path whose isValid() is false if the category,
+     *         item or field is not defined
+     *
+     * @note A registered category (registerCategoryFile()) is loaded first.
+     *
+     * @par Example
+     * @code
+     * const FieldPath lat = globalDef.compile("062/105.LAT");
+     * if (lat.isValid()) {
+     *     double latitude = record.get<double>(lat);
+     * }
+     * @endcode
+     */
+    FieldPath compile(const std::string &path);
+
 private:
     /**
      * @brief Array of category pointers indexed by category number
@@ -247,6 +364,47 @@ private:
      * All non-null entries are owned by AsterixDefinition and deleted in destructor.
      */
     Category *m_pCategory[MAX_CATEGORIES];
+
+    /**
+     * @brief Guards lazy creation of entries in m_pCategory by getCategory()
+     */
+    std::mutex m_mutexCategory;
+
+    /**
+     * @brief Definition files registered by registerCategoryFile()
+     */
+    std::string m_strCategoryFile[MAX_CATEGORIES];
+
+    /**
+     * @brief True while the registered file of a category is not loaded
+     */
+    std::atomic<bool> m_bCategoryPending[MAX_CATEGORIES]{};
+
+    /**
+     * @brief True while the registered file of a category is parsed (guarded by m_mutexLoad)
+     */
+    bool m_bCategoryLoading[MAX_CATEGORIES]{};
+
+    /**
+     * @brief Serializes loading of registered files; recursive because a
+     *        category may load the BDS definitions it refers to
+     */
+    std::recursive_mutex m_mutexLoad;
+
+    /**
+     * @brief Incremented when a category is replaced by setCategory()
+     */
+    std::atomic<unsigned int> m_nRevision{0};
+
+    /**
+     * @brief Freeze categories passed to setCategory()
+     */
+    bool m_bFreezeCategories{true};
+
+    /**
+     * @brief Compile item programs when freezing categories
+     */
+    bool m_bItemPrograms{true};
 };
 
 #endif /* ASTERIXDEFINITION_H_ */
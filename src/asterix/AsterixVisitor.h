@@ -0,0 +1,133 @@
+/*
+ *  Copyright (c) 2013 Croatia Control Ltd. (www.crocontrol.hr)
+ *
+ *  This file is part of Asterix.
+ *
+ *  Asterix is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Asterix is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Asterix.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * AUTHORS: Damir Salantic, Croatia Control Ltd.
+ *
+ */
+
+/**
+ * @file AsterixVisitor.h
+ * @brief Callbacks of InputParser::visit()
+ *
+ * InputParser::visit() decodes a buffer without building the AsterixData,
+ * DataBlock, DataRecord and DataItem tree. It pushes each block, record,
+ * item and bit field to an AsterixVisitor as it walks the data. Everything
+ * passed points into the buffer or the definition, so nothing is allocated
+ * per record.
+ */
+
+#ifndef ASTERIXVISITOR_H_
+#define ASTERIXVISITOR_H_
+
+#include "ItemProgram.h"
+
+class Category;
+class DataItemDescription;
+
+/**
+ * @class AsterixVisitor
+ * @brief Receives decoded data from InputParser::visit()
+ *
+ * Override the callbacks of interest. Callbacks returning bool can skip what
+ * is nested in them by returning false. Pointers passed are only valid
+ * during the call.
+ *
+ * @par Example - Collect I062/105 latitudes
+ * @code
+ * class LatitudeVisitor : public AsterixVisitor {
+ * public:
+ *     std::vector<double> latitudes;
+ *     bool onBlock(const Category &category, const unsigned char *, unsigned long, double) override {
+ *         return category.m_id == 62;
+ *     }
+ *     bool onItem(const DataItemDescription &item, const unsigned char *, long) override {
+ *         return item.m_strID == "105";
+ *     }
+ *     void onField(const DataItemDescription &, const ItemField &field) override {
+ *         if (field.m_pBits->m_strShortName == "LAT") {
+ *             latitudes.push_back(field.getValue());
+ *         }
+ *     }
+ * };
+ * @endcode
+ */
+class AsterixVisitor {
+public:
+    virtual ~AsterixVisitor() = default;
+
+    /**
+     * @brief Data block of category
+     *
+     * @param category   Category of the block
+     * @param pData      Records of the block (after category and length)
+     * @param nLength    Length of records in bytes
+     * @param nTimestamp Timestamp passed to InputParser::visit()
+     * @return false to skip the records of the block
+     */
+    virtual bool onBlock([[maybe_unused]] const Category &category, [[maybe_unused]] const unsigned char *pData,
+                         [[maybe_unused]] unsigned long nLength, [[maybe_unused]] double nTimestamp) {
+        return true;
+    }
+
+    /**
+     * @brief End of a data block whose onBlock() returned true
+     */
+    virtual void onBlockEnd([[maybe_unused]] const Category &category) {}
+
+    /**
+     * @brief Data record, called once all its items were found
+     *
+     * @param pData   Record data (starts with FSPEC)
+     * @param nLength Length of record in bytes
+     * @return false to skip the items of the record
+     */
+    virtual bool onRecord([[maybe_unused]] const Category &category, [[maybe_unused]] const unsigned char *pData,
+                          [[maybe_unused]] unsigned long nLength) {
+        return true;
+    }
+
+    /**
+     * @brief End of a data record whose onRecord() returned true
+     */
+    virtual void onRecordEnd([[maybe_unused]] const Category &category) {}
+
+    /**
+     * @brief Data item of the record, in FSPEC order
+     *
+     * @param item    Description of the item
+     * @param pData   Item data
+     * @param nLength Length of item in bytes
+     * @return false to skip the fields of the item
+     */
+    virtual bool onItem([[maybe_unused]] const DataItemDescription &item, [[maybe_unused]] const unsigned char *pData,
+                        [[maybe_unused]] long nLength) {
+        return true;
+    }
+
+    /**
+     * @brief Bit field of the item, as emitted by ItemProgram::decode()
+     *
+     * Only items with an item program (DataItemDescription::m_pProgram) have
+     * fields. ItemField gives the raw, signed and scaled value, the encoding
+     * (m_pBits->m_eEncoding) and the value meaning (getMeaning()).
+     */
+    virtual void onField([[maybe_unused]] const DataItemDescription &item, [[maybe_unused]] const ItemField &field) {}
+};
+
+#endif /* ASTERIXVISITOR_H_ */
@@ -30,7 +30,7 @@ namespace {
 }
 
 Category::Category(int id)
-        : m_id(id), m_bFiltered(false) {
+        : m_id(id), m_bFiltered(false), m_bFrozen(false) {
 }
 
 Category::~Category() {
@@ -48,10 +48,56 @@ DataItemDescription *Category::getDataItemDescription(std::string id) {
     // create new DataItemDescription
     auto* di = new DataItemDescription(id);
     m_lDataItems.push_back(di);
+    m_bFrozen = false;
 
     return di;
 }
 
+DataItemDescription *Category::findDataItemDescription(const std::string &id) const {
+    for (auto* di : m_lDataItems) {
+        if (di->m_strID == id) {
+            return di;
+        }
+    }
+    return nullptr;
+}
+
+DataItemDescription *Category::findDataItemDescription(const UAP *pUAP, int frn) const {
+    if (m_bFrozen) {
+        const std::vector<DataItemDescription *> &items = pUAP->m_vFRNItems;
+        return frn > 0 && static_cast<size_t>(frn) < items.size() ? items[frn] : nullptr;
+    }
+    return findDataItemDescription(pUAP->getDataItemIDByUAPfrn(frn));
+}
+
+void Category::freeze(bool bItemPrograms) {
+    for (auto* di : m_lDataItems) {
+        if (di->m_pFormat != nullptr) {
+            di->m_pFormat->freeze();
+        }
+        di->m_pProgram = bItemPrograms ? ItemProgram::compile(di->m_pFormat) : nullptr;
+    }
+
+    m_vUAPs.assign(m_lUAPs.begin(), m_lUAPs.end());
+    for (auto* uap : m_vUAPs) {
+        if (uap == nullptr) {
+            continue;
+        }
+        // resolve as getDataItemIDByUAPfrn() does, first UAPItem with FRN wins
+        int maxFRN = 0;
+        for (const auto* ui : uap->m_lUAPItems) {
+            if (ui != nullptr && ui->m_nFRN > maxFRN) {
+                maxFRN = ui->m_nFRN;
+            }
+        }
+        uap->m_vFRNItems.assign(maxFRN + 1, nullptr);
+        for (int frn = 1; frn <= maxFRN; frn++) {
+            uap->m_vFRNItems[frn] = findDataItemDescription(uap->getDataItemIDByUAPfrn(frn));
+        }
+    }
+    m_bFrozen = true;
+}
+
 const char *Category::getDescription(const char *item, const char *field, const char *value) const {
     std::string item_number = format("%s", &item[1]);
 
@@ -70,6 +116,7 @@ const char *Category::getDescription(const char *item, const char *field, const
 UAP *Category::newUAP() {
     UAP *uap = new UAP();
     m_lUAPs.push_back(uap);
+    m_bFrozen = false;
     return uap;
 }
 
@@ -83,8 +130,8 @@ static unsigned long skipFSPEC(const unsigned char *data, unsigned long len) {
 }
 
 // Helper: Check if a specific bit is set in data after FSPEC
-static bool isBitSetAfterFSPEC(const unsigned char *data, unsigned long len, unsigned long bittomatch) {
-    unsigned long pos = skipFSPEC(data, len);
+static bool isBitSetAfterFSPEC(const unsigned char *data, unsigned long len, unsigned long pos,
+                               unsigned long bittomatch) {
     pos += (bittomatch - 1) / 8;
 
     if (pos >= len) {
@@ -97,9 +144,8 @@ static bool isBitSetAfterFSPEC(const unsigned char *data, unsigned long len, uns
 }
 
 // Helper: Check if a specific byte matches expected value after FSPEC
-static bool isByteMatchAfterFSPEC(const unsigned char *data, unsigned long len,
-                                   unsigned long byteNr, unsigned char expectedValue) {
-    unsigned long pos = skipFSPEC(data, len);
+static bool isByteMatchAfterFSPEC(const unsigned char *data, unsigned long len, unsigned long pos,
+                                  unsigned long byteNr, unsigned char expectedValue) {
     pos += byteNr - 1;
 
     if (pos >= len) {
@@ -108,30 +154,40 @@ static bool isByteMatchAfterFSPEC(const unsigned char *data, unsigned long len,
     return data[pos] == expectedValue;
 }
 
+// Helper: Check if UAP selection condition matches data, pos is the position after FSPEC
+static bool isUAPSelected(const UAP *uap, const unsigned char *data, unsigned long len, unsigned long pos) {
+    // Check if bit matches
+    if (uap->m_nUseIfBitSet) {
+        return isBitSetAfterFSPEC(data, len, pos, uap->m_nUseIfBitSet);
+    }
+
+    // Check if byte matches
+    if (uap->m_nUseIfByteNr) {
+        return isByteMatchAfterFSPEC(data, len, pos, uap->m_nUseIfByteNr, uap->m_nIsSetTo);
+    }
+
+    // No condition - use this UAP
+    return true;
+}
+
 UAP *Category::getUAP(const unsigned char *data, unsigned long len) const {
-    for (auto* uap : m_lUAPs) {
-        if (!uap) {
-            continue;  // Early continue reduces nesting (SonarCloud)
-        }
+    return getUAP(data, len, skipFSPEC(data, len));
+}
 
-        // Check if bit matches
-        if (uap->m_nUseIfBitSet) {
-            if (isBitSetAfterFSPEC(data, len, uap->m_nUseIfBitSet)) {
+UAP *Category::getUAP(const unsigned char *data, unsigned long len, unsigned long nFSPECLength) const {
+    if (m_bFrozen) {
+        for (auto* uap : m_vUAPs) {
+            if (uap && isUAPSelected(uap, data, len, nFSPECLength)) {
                 return uap;
             }
-            continue;
         }
+        return nullptr;
+    }
 
-        // Check if byte matches
-        if (uap->m_nUseIfByteNr) {
-            if (isByteMatchAfterFSPEC(data, len, uap->m_nUseIfByteNr, uap->m_nIsSetTo)) {
-                return uap;
-            }
-            continue;
+    for (auto* uap : m_lUAPs) {
+        if (uap && isUAPSelected(uap, data, len, nFSPECLength)) {
+            return uap;
         }
-
-        // No condition - return this UAP
-        return uap;
     }
     return nullptr;
 }
@@ -158,7 +214,10 @@ bool Category::filterOutItem(std::string item, const char *name) {
         if (di->m_strID == item) {
             if (di->m_pFormat == nullptr)
                 return false;
-            return di->m_pFormat->filterOutItem(name);
+            if (!di->m_pFormat->filterOutItem(name))
+                return false;
+            di->m_bFiltered = true;
+            return true;
         }
     }
     return false;
@@ -37,6 +37,7 @@
 #include "UAP.h"
 #include <string>
 #include <list>
+#include <vector>
 
 #if defined(WIRESHARK_WRAPPER) || defined(ETHEREAL_WRAPPER)
 #include "WiresharkWrapper.h"
@@ -162,6 +163,30 @@ public:
      */
     std::list<UAP *> m_lUAPs;
 
+    /**
+     * @brief UAPs in m_lUAPs order, built by freeze()
+     */
+    std::vector<UAP *> m_vUAPs;
+
+    /**
+     * @brief True after freeze() until the definition is changed again
+     *
+     * Adding UAPs or data item descriptions unfreezes the category.
+     */
+    bool m_bFrozen;
+
+    /**
+     * @brief Compact the definition tree for decoding
+     *
+     * Builds contiguous arrays of UAPs, per-UAP FRN to item description tables
+     * and freezes all item formats (DataItemFormat::freeze()). Called by
+     * AsterixDefinition::setCategory() once the category is loaded.
+     *
+     * @param bItemPrograms Also compile item formats into linear programs
+     *                      (DataItemDescription::m_pProgram)
+     */
+    void freeze(bool bItemPrograms = true);
+
     /**
      * @brief Get or create a data item description by ID
      *
@@ -175,6 +200,32 @@ public:
     DataItemDescription *
     getDataItemDescription(std::string id);
 
+    /**
+     * @brief Look up a data item description by ID without creating it
+     *
+     * @param id Data item ID without category prefix (e.g., "010" for I062/010)
+     * @return Pointer to DataItemDescription, or nullptr if not defined
+     *
+     * @note Unlike getDataItemDescription() this never modifies the category,
+     *       so it may be called concurrently from several parsing threads once
+     *       the definitions are loaded.
+     */
+    DataItemDescription *
+    findDataItemDescription(const std::string &id) const;
+
+    /**
+     * @brief Look up the data item description of FRN in UAP
+     *
+     * @param pUAP UAP of this category
+     * @param frn  Field Reference Number
+     * @return Pointer to DataItemDescription, or nullptr if not defined
+     *
+     * @note Uses the FRN table of a frozen category, otherwise the UAP
+     *       items and data item descriptions are searched.
+     */
+    DataItemDescription *
+    findDataItemDescription(const UAP *pUAP, int frn) const;
+
     /**
      * @brief Create and return a new UAP for this category
      *
@@ -198,6 +249,16 @@ public:
      */
     UAP *getUAP(const unsigned char *data, unsigned long len) const;
 
+    /**
+     * @brief Select the UAP of a record whose FSPEC length is already known
+     *
+     * @param data         Pointer to record data (starts with FSPEC)
+     * @param len          Length of record data in bytes
+     * @param nFSPECLength Length of the FSPEC in bytes
+     * @return Pointer to the matching UAP, or nullptr if no match
+     */
+    UAP *getUAP(const unsigned char *data, unsigned long len, unsigned long nFSPECLength) const;
+
     /**
      * @brief Generate a printable list of all item descriptors
      *
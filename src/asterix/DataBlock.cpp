@@ -28,7 +28,8 @@
 
 extern bool gFiltering;
 
-DataBlock::DataBlock(Category *cat, unsigned long len, const unsigned char *data, double nTimestamp)
+DataBlock::DataBlock(Category *cat, unsigned long len, const unsigned char *data, double nTimestamp,
+                     const CRecordDecoder *pDecoder, DecodePlanCache *pPlans)
         : m_pCategory(cat), m_nLength(len), m_nTimestamp(nTimestamp), m_bFormatOK(false) {
     const unsigned char *m_pItemDataStart = data;
     long nUnparsed = len;
@@ -40,7 +41,7 @@ DataBlock::DataBlock(Category *cat, unsigned long len, const unsigned char *data
     }
 
     while (nUnparsed > 0) {
-        DataRecord *dr = new DataRecord(cat, counter++, nUnparsed, m_pItemDataStart, nTimestamp);
+        DataRecord *dr = new DataRecord(cat, counter++, nUnparsed, m_pItemDataStart, nTimestamp, pDecoder, pPlans);
 
         if (!dr) {
             Tracer::Error("Error DataBlock format.");
@@ -103,6 +104,32 @@ bool DataBlock::getText(std::string &strResult, const unsigned int formatType) {
     return true;
 }
 
+bool DataBlock::getBinary(std::vector<unsigned char> &result) const {
+    if ((gFiltering && !m_pCategory->m_bFiltered) || !m_bFormatOK) {
+        return false;
+    }
+
+    const size_t start = result.size();
+    result.push_back(static_cast<unsigned char>(m_pCategory->m_id));
+    result.push_back(0);
+    result.push_back(0);
+
+    for (const auto* dr : m_lDataRecords) {
+        if (dr != nullptr) {
+            dr->getBinary(result);
+        }
+    }
+
+    const size_t len = result.size() - start;
+    if (len == 3) {
+        result.resize(start);
+        return false;
+    }
+    result[start + 1] = static_cast<unsigned char>((len >> 8) & 0xff);
+    result[start + 2] = static_cast<unsigned char>(len & 0xff);
+    return true;
+}
+
 #if defined(WIRESHARK_WRAPPER) || defined(ETHEREAL_WRAPPER)
 fulliautomatix_data* DataBlock::getData(int byteoffset)
 {
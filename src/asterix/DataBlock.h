@@ -100,6 +100,10 @@ public:
      *                   Must contain at least len bytes.
      * @param nTimestamp Capture timestamp in Unix epoch seconds (default: 0.0).
      *                   Typically from PCAP or system clock.
+     * @param pDecoder   Generated record decoder bound to cat, or nullptr to
+     *                   decode records with the interpreter (default).
+     * @param pPlans     Decode plans of cat memoized by FSPEC, or nullptr to
+     *                   resolve every record from its FSPEC (default).
      *
      * @note After construction, check m_bFormatOK to verify successful parsing.
      *       If m_bFormatOK is false, the block data was malformed.
@@ -115,7 +119,8 @@ public:
      * }
      * @endcode
      */
-    DataBlock(Category *cat, unsigned long len, const unsigned char *data, double nTimestamp = 0.0);
+    DataBlock(Category *cat, unsigned long len, const unsigned char *data, double nTimestamp = 0.0,
+              const CRecordDecoder *pDecoder = nullptr, DecodePlanCache *pPlans = nullptr);
 
     /**
      * @brief Destructor - frees all data records
@@ -192,6 +197,18 @@ public:
     bool
     getText(std::string &strResult, const unsigned int formatType);
 
+    /**
+     * @brief Append the binary data block with records passing the filter to result
+     *
+     * Writes the 3-byte header (category and length) followed by the records
+     * for which DataRecord::getBinary() succeeds. Nothing is appended if the
+     * category is filtered out or no record passes.
+     *
+     * @param[out] result Buffer to which the data block is appended
+     * @return true if the data block was appended
+     */
+    bool getBinary(std::vector<unsigned char> &result) const;
+
 #if defined(WIRESHARK_WRAPPER) || defined(ETHEREAL_WRAPPER)
     /**
      * @brief Get Wireshark dissector data structure (Wireshark plugin only)
@@ -100,7 +100,16 @@ long DataItem::parse(const unsigned char *pData, long len) {
         return 0;
     }
 
-    m_nLength = m_pDescription->m_pFormat->getLength(pData);
+    // program does not read beyond len, 0 if it cannot tell the length
+    long itemLength = m_pDescription->m_pProgram ? m_pDescription->m_pProgram->getLength(pData, len) : 0;
+    if (itemLength == 0) {
+        itemLength = m_pDescription->m_pFormat->getLength(pData);
+    }
+    return parse(pData, len, itemLength);
+}
+
+long DataItem::parse(const unsigned char *pData, long len, long itemLength) {
+    m_nLength = itemLength;
 
     if (m_nLength > len) {
         // Print unparsed bytes
@@ -35,6 +35,7 @@
 
 #include "DataItemDescription.h"
 #include <string>
+#include <vector>
 #include <memory>  // For std::unique_ptr
 
 /**
@@ -181,6 +182,17 @@ public:
      */
     long parse(const unsigned char *pData, long len);
 
+    /**
+     * @brief Parse item of known length (computed by generated record decoder)
+     *
+     * @param[in] pData      Pointer to binary ASTERIX data buffer
+     * @param[in] len        Number of bytes available in pData buffer
+     * @param[in] itemLength Length of this item in pData
+     *
+     * @return itemLength, the item is only copied if 0 < itemLength <= len
+     */
+    long parse(const unsigned char *pData, long len, long itemLength);
+
     /**
      * @brief Get the length in bytes of the parsed data item
      *
@@ -191,6 +203,22 @@ public:
      */
     long getLength() const { return m_nLength; }
 
+    /**
+     * @brief Get the binary data of the parsed item (m_nLength bytes), nullptr if not parsed
+     */
+    const unsigned char *getBinaryData() const { return m_pData.get(); }
+
+    /**
+     * @brief Append the binary data of the parsed item (as received) to result
+     *
+     * @param[out] result Buffer to which the m_nLength item bytes are appended
+     */
+    void getBinary(std::vector<unsigned char> &result) const {
+        if (m_pData && m_nLength > 0) {
+            result.insert(result.end(), m_pData.get(), m_pData.get() + m_nLength);
+        }
+    }
+
 #if defined(WIRESHARK_WRAPPER) || defined(ETHEREAL_WRAPPER)
     /**
      * @brief Get Wireshark dissector data structure (Wireshark plugin only)
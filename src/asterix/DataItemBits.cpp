@@ -28,6 +28,7 @@
 #include "asterixformat.hxx"
 #include <sstream>  // PERFORMANCE: For efficient string building
 #include <memory>   // For std::unique_ptr
+#include <algorithm>
 
 extern bool gFiltering;
 
@@ -68,12 +69,12 @@ static const char SIXBITCODE[] = {' ', 'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', '
 DataItemBits::DataItemBits(int id)
         : DataItemFormat(id), m_nFrom(0), m_nTo(0), m_eEncoding(DATAITEM_ENCODING_UNSIGNED), m_bIsConst(false),
           m_nConst(0), m_dScale(0.0), m_bMaxValueSet(false), m_dMaxValue(0.0), m_bMinValueSet(false), m_dMinValue(0.0),
-          m_bExtension(false), m_nPresenceOfField(0), m_bFiltered(false) {
+          m_bExtension(false), m_nPresenceOfField(0), m_bFiltered(false), m_bValueTable(false) {
 
 }
 
 DataItemBits::DataItemBits(const DataItemBits &obj)
-        : DataItemFormat(obj.m_nID) {
+        : DataItemFormat(obj.m_nID), m_bValueTable(false) {
     for (const auto* subItem : obj.m_lSubItems) {
         m_lSubItems.push_back(subItem->clone());
     }
@@ -594,8 +595,41 @@ void DataItemBits::appendClosingTag(std::ostringstream& ss, const unsigned int f
     }
 }
 
+void DataItemBits::freeze() {
+    DataItemFormat::freeze();
+
+    m_vValueDescription.clear();
+    m_bValueTable = false;
+    int maxValue = -1;
+    for (const auto* bv : m_lValue) {
+        if (bv->m_nVal < 0 || bv->m_nVal > MAX_VALUE_TABLE) {
+            return;
+        }
+        maxValue = std::max(maxValue, bv->m_nVal);
+    }
+    m_vValueDescription.resize(maxValue + 1, nullptr);
+    // first definition of a value wins, as in m_lValue lookup
+    for (const auto* bv : m_lValue) {
+        if (m_vValueDescription[bv->m_nVal] == nullptr) {
+            m_vValueDescription[bv->m_nVal] = bv->m_strDescription.c_str();
+        }
+    }
+    m_bValueTable = true;
+}
+
 // Helper function to find value description
 const char* DataItemBits::findValueDescription(unsigned long long value, bool& found) const {
+    if (m_bValueTable) {
+        const int nVal = static_cast<int>(value);
+        if (nVal >= 0 && static_cast<size_t>(nVal) < m_vValueDescription.size() &&
+            m_vValueDescription[nVal] != nullptr) {
+            found = true;
+            return m_vValueDescription[nVal];
+        }
+        found = false;
+        return "??????";
+    }
+
     for (auto it = m_lValue.begin(); it != m_lValue.end(); ++it) {
         BitsValue* bv = *it;
         if (bv->m_nVal == static_cast<int>(value)) {
@@ -317,7 +317,30 @@ public:
      */
     long getLength(const unsigned char *pData);
 
+    /**
+     * @brief Build table of value descriptions indexed by value
+     * @note Only if all values in m_lValue are within 0..MAX_VALUE_TABLE,
+     *       otherwise descriptions are looked up in m_lValue
+     */
+    void freeze() override;
+
+    /**
+     * @brief Description of a value of this field from the definition
+     * @return Description, or nullptr if the value has none
+     */
+    const char *getValueDescription(unsigned long long value) const {
+        bool found = false;
+        const char *description = findValueDescription(value, found);
+        return found ? description : nullptr;
+    }
+
 private:
+    static const int MAX_VALUE_TABLE = 255;  //!< Largest value kept in m_vValueDescription
+
+    //! Description of each value (nullptr if not defined), built by freeze()
+    std::vector<const char *> m_vValueDescription;
+    bool m_bValueTable;  //!< True if m_vValueDescription replaces m_lValue lookups
+
     // Helper methods for getText() to reduce cognitive complexity
     void appendOpeningTag(std::ostringstream& ss, const unsigned int formatType) const;
     void appendClosingTag(std::ostringstream& ss, const unsigned int formatType) const;
@@ -370,6 +393,8 @@ private:
      */
     unsigned char *getBits(unsigned char *pData, int bytes, int frombit, int tobit);
 
+public:
+    // value extraction, also the reference for ItemField values
     /**
      * @brief Extract unsigned integer value from bit range
      * @param pData Pointer to binary data buffer
@@ -403,6 +428,8 @@ private:
      */
     signed long getSigned(unsigned char *pData, int bytes, int frombit, int tobit);
 
+private:
+
     /**
      * @brief Extract 6-bit character string (ICAO alphabet)
      * @param pData Pointer to binary data buffer
@@ -25,7 +25,7 @@
 #include <cstdlib>
 
 DataItemDescription::DataItemDescription(std::string id)
-        : m_strID(id), m_pFormat(nullptr), m_eRule(DATAITEM_UNKNOWN) {
+        : m_strID(id), m_pFormat(nullptr), m_eRule(DATAITEM_UNKNOWN), m_bFiltered(false) {
     m_nID = strtol(id.c_str(), nullptr, 16);
 }
 
@@ -34,6 +34,8 @@
 #define DATAITEMDESCRIPTION_H_
 
 #include "DataItemFormat.h"
+#include "ItemProgram.h"
+#include <memory>
 
 /**
  * @class DataItemDescription
@@ -199,6 +201,14 @@ public:
      */
     DataItemFormat *m_pFormat;
 
+    /**
+     * @brief Format compiled into a linear program by Category::freeze()
+     *
+     * nullptr if the category is not frozen, item programs are disabled or
+     * the format cannot be compiled; the item is then decoded by m_pFormat.
+     */
+    std::unique_ptr<ItemProgram> m_pProgram;
+
     /**
      * @brief Enumeration of data item rule types
      *
@@ -219,6 +229,14 @@ public:
      */
     _eRule m_eRule;
 
+    /**
+     * @brief True if a bit field of this item is listed in the output filter
+     *
+     * Set by Category::filterOutItem(). With filtering on, binary (raw or PCAP)
+     * output keeps only records containing at least one such item.
+     */
+    bool m_bFiltered;
+
 };
 
 #endif /* DATAITEMDESCRIPTION_H_ */
@@ -29,7 +29,7 @@ int DataItemFormat::m_nLastPID = PID_LAST;
 #endif
 
 DataItemFormat::DataItemFormat(int id)
-        : m_pParentFormat(nullptr), m_nID(id) {
+        : m_bFrozen(false), m_pParentFormat(nullptr), m_nID(id) {
 #if defined(WIRESHARK_WRAPPER) || defined(ETHEREAL_WRAPPER)
     m_nPID = m_nLastPID++;
 #endif
@@ -38,3 +38,13 @@ DataItemFormat::DataItemFormat(int id)
 DataItemFormat::~DataItemFormat() {
     deleteAndClear(m_lSubItems);
 }
+
+void DataItemFormat::freeze() {
+    m_vSubItems.assign(m_lSubItems.begin(), m_lSubItems.end());
+    for (auto *pSubItem : m_vSubItems) {
+        if (pSubItem != nullptr) {
+            pSubItem->freeze();
+        }
+    }
+    m_bFrozen = true;
+}
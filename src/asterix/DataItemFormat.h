@@ -42,6 +42,7 @@
 
 #include <string>
 #include <list>
+#include <vector>
 #include "Utils.h"
 
 #if defined(WIRESHARK_WRAPPER) || defined(ETHEREAL_WRAPPER)
@@ -144,6 +145,19 @@ public:
      */
     std::list<DataItemFormat *> m_lSubItems;
 
+    /**
+     * @brief Contiguous copy of m_lSubItems built by freeze()
+     *
+     * Empty until the format is frozen. m_lSubItems remains the owner of the
+     * sub-items; once frozen, parsing and formatting iterate this array.
+     */
+    std::vector<DataItemFormat *> m_vSubItems;
+
+    /**
+     * @brief True once freeze() was called, sub-items must not change afterwards
+     */
+    bool m_bFrozen;
+
     /**
      * @brief Pointer to parent format (used during XML parsing)
      *
@@ -187,6 +201,29 @@ public:
     virtual DataItemFormat *clone() const = 0;
 #endif
 
+    /**
+     * @brief Compact sub-items into contiguous arrays used for decoding
+     *
+     * Called for every item when a category is loaded (Category::freeze()).
+     * Derived formats additionally precompute their lookup tables. Formats
+     * which are not frozen (e.g. built by hand) are decoded from the lists.
+     */
+    virtual void freeze();
+
+    /**
+     * @brief Get sub-items as an array
+     *
+     * @param buffer Storage for the copy of m_lSubItems if not frozen
+     * @return m_vSubItems once frozen, otherwise buffer filled from m_lSubItems
+     */
+    const std::vector<DataItemFormat *> &getSubItems(std::vector<DataItemFormat *> &buffer) const {
+        if (m_bFrozen) {
+            return m_vSubItems;
+        }
+        buffer.assign(m_lSubItems.begin(), m_lSubItems.end());
+        return buffer;
+    }
+
     /**
      * @brief Calculate the length of a data item from binary data
      *
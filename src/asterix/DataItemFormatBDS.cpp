@@ -60,7 +60,8 @@ bool DataItemFormatBDS::getText(std::string &strResult, std::string &strHeader,
     int BDSid = pData[7];
 
     // Find BDS register
-    for (auto* subItem : m_lSubItems) {
+    std::vector<DataItemFormat *> buffer;
+    for (auto* subItem : getSubItems(buffer)) {
         auto *pFixed = static_cast<DataItemFormatFixed *>(subItem);
         if (pFixed->m_nID == BDSid || pFixed->m_nID == 0) {
             std::string item_str;
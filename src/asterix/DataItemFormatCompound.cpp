@@ -54,16 +54,15 @@ DataItemFormatCompound::~DataItemFormatCompound() {
 
 long DataItemFormatCompound::getLength(const unsigned char *pData) {
     long totalLength = 0;
-    std::list<DataItemFormat *>::iterator it2;
-    it2 = m_lSubItems.begin();
-    // Security fix: Check iterator validity before dereferencing
-    if (it2 == m_lSubItems.end() || !*it2) {
+    std::vector<DataItemFormat *> buffer;
+    const std::vector<DataItemFormat *> &subItems = getSubItems(buffer);
+    // Security fix: Check primary subfield before dereferencing
+    if (subItems.empty() || !subItems[0]) {
         Tracer::Error("Missing primary subfield of Compound");
         return 0;
     }
-    auto *pCompoundPrimary = static_cast<DataItemFormatVariable *>(*it2);
-    ++it2;
-    if (it2 == m_lSubItems.end()) {
+    auto *pCompoundPrimary = static_cast<DataItemFormatVariable *>(subItems[0]);
+    if (subItems.size() < 2) {
         Tracer::Error("Missing secondary subfields of Compound");
         return 0;
     }
@@ -72,23 +71,18 @@ long DataItemFormatCompound::getLength(const unsigned char *pData) {
     const unsigned char *pSecData = pData + primaryPartLength;
     totalLength += primaryPartLength;
 
-    for (auto it = pCompoundPrimary->m_lSubItems.begin(); it != pCompoundPrimary->m_lSubItems.end(); ++it) {
-        int secondaryPart = 1;
-        it2 = m_lSubItems.begin();
-        ++it2; // skip primary part
-
-        auto *dip = static_cast<DataItemFormatFixed *>(*it);
+    std::vector<DataItemFormat *> primaryBuffer;
+    for (auto *part : pCompoundPrimary->getSubItems(primaryBuffer)) {
+        auto *dip = static_cast<DataItemFormatFixed *>(part);
         bool lastPart = dip->isLastPart(pData);
 
-        while (it2 != m_lSubItems.end()) { // parse secondary parts
+        // parse secondary parts, subItems[0] is primary part
+        for (int secondaryPart = 1; static_cast<size_t>(secondaryPart) < subItems.size(); secondaryPart++) {
             if (dip->isSecondaryPartPresent(pData, secondaryPart)) {
-                auto *dip2 = *it2;  // Already DataItemFormat*
-                int skip = dip2->getLength(pSecData);
+                int skip = subItems[secondaryPart]->getLength(pSecData);
                 pSecData += skip;
                 totalLength += skip;
             }
-            ++it2;
-            secondaryPart++;
         }
         pData += dip->getLength();
 
@@ -102,17 +96,15 @@ long DataItemFormatCompound::getLength(const unsigned char *pData) {
 bool DataItemFormatCompound::getText(std::string &strResult, std::string &strHeader, const unsigned int formatType,
                                      unsigned char *pData, long) {
     bool ret = false;
-    std::list<DataItemFormat *>::iterator it;
-    std::list<DataItemFormat *>::iterator it2;
-    it2 = m_lSubItems.begin();
-    // Security fix: Check iterator validity before dereferencing
-    if (it2 == m_lSubItems.end() || !*it2) {
+    std::vector<DataItemFormat *> buffer;
+    const std::vector<DataItemFormat *> &subItems = getSubItems(buffer);
+    // Security fix: Check primary subfield before dereferencing
+    if (subItems.empty() || !subItems[0]) {
         Tracer::Error("Missing primary subfield of Compound");
         return false;
     }
-    auto *pCompoundPrimary = static_cast<DataItemFormatVariable *>(*it2);
-    ++it2;
-    if (it2 == m_lSubItems.end()) {
+    auto *pCompoundPrimary = static_cast<DataItemFormatVariable *>(subItems[0]);
+    if (subItems.size() < 2) {
         Tracer::Error("Missing secondary subfields of Compound");
         return false;
     }
@@ -129,17 +121,15 @@ bool DataItemFormatCompound::getText(std::string &strResult, std::string &strHea
     int primaryPartLength = pCompoundPrimary->getLength(pData);
     unsigned char *pSecData = pData + primaryPartLength;
 
-    for (auto it = pCompoundPrimary->m_lSubItems.begin(); it != pCompoundPrimary->m_lSubItems.end(); ++it) {
-        int secondaryPart = 1;
-        it2 = m_lSubItems.begin();
-        ++it2; // skip primary part
-
-        auto *dip = static_cast<DataItemFormatFixed *>(*it);
+    std::vector<DataItemFormat *> primaryBuffer;
+    for (auto *part : pCompoundPrimary->getSubItems(primaryBuffer)) {
+        auto *dip = static_cast<DataItemFormatFixed *>(part);
         bool lastPart = dip->isLastPart(pData);
 
-        while (it2 != m_lSubItems.end()) { // parse secondary parts
+        // parse secondary parts, subItems[0] is primary part
+        for (int secondaryPart = 1; static_cast<size_t>(secondaryPart) < subItems.size(); secondaryPart++) {
             if (dip->isSecondaryPartPresent(pData, secondaryPart)) {
-                auto *dip2 = *it2;  // Already DataItemFormat*
+                auto *dip2 = subItems[secondaryPart];
                 int skip = 0;
                 std::string tmpStr;
 
@@ -175,8 +165,6 @@ bool DataItemFormatCompound::getText(std::string &strResult, std::string &strHea
                         break;
                 }
             }
-            ++it2;
-            secondaryPart++;
         }
 
         pData += dip->getLength();
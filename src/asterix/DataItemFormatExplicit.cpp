@@ -59,7 +59,9 @@ bool DataItemFormatExplicit::getText(std::string &strResult, std::string &strHea
     pData++; // skip explicit length byte (it is already in nLength)
 
     // calculate the size of all sub items
-    for (auto* di : m_lSubItems) {
+    std::vector<DataItemFormat *> buffer;
+    const std::vector<DataItemFormat *> &subItems = getSubItems(buffer);
+    for (auto* di : subItems) {
         bodyLength += di->getLength(pData + bodyLength); // calculate length of body
     }
 
@@ -84,7 +86,7 @@ bool DataItemFormatExplicit::getText(std::string &strResult, std::string &strHea
     }
 
     for (int i = 0; i < nFullLength; i += bodyLength) {
-        for (auto* di : m_lSubItems) {
+        for (auto* di : subItems) {
             ret |= di->getText(tmpStr, strHeader, formatType, pData, bodyLength);
             pData += bodyLength;
 
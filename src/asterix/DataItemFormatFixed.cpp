@@ -27,11 +27,11 @@
 #include "asterixformat.hxx"
 
 DataItemFormatFixed::DataItemFormatFixed(int id)
-        : DataItemFormat(id), m_nLength(0) {
+        : DataItemFormat(id), m_nLength(0), m_bFrozenMasks(false), m_nFXByte(0), m_nFXMask(0) {
 }
 
 DataItemFormatFixed::DataItemFormatFixed(const DataItemFormatFixed &obj)
-        : DataItemFormat(obj.m_nID), m_nLength(obj.m_nLength) {
+        : DataItemFormat(obj.m_nID), m_nLength(obj.m_nLength), m_bFrozenMasks(false), m_nFXByte(0), m_nFXMask(0) {
     // Use const_iterator to avoid casting away const
     for (const auto* di : obj.m_lSubItems) {
         m_lSubItems.push_back(di->clone());
@@ -52,10 +52,57 @@ long DataItemFormatFixed::getLength(const unsigned char *) {
     return m_nLength;
 }
 
+// Secondary parts of compound items above this are looked up by walking the bits
+static const int MAX_PRESENCE_PART = 255;
+
+void DataItemFormatFixed::freeze() {
+    DataItemFormat::freeze();
+
+    // bits are searched in order, first FX bit and first bit of each part win
+    m_bFrozenMasks = false;
+    m_nFXByte = 0;
+    m_nFXMask = 0;
+    m_vPresence.clear();
+    bool bFX = false;
+    for (const auto *subItem : m_vSubItems) {
+        if (subItem == nullptr) {
+            return;
+        }
+        const auto *bit = static_cast<const DataItemBits *>(subItem);
+        const int part = bit->m_nPresenceOfField;
+        const bool bPresence = part > 0 && (static_cast<size_t>(part) >= m_vPresence.size() ||
+                                            m_vPresence[part].second == 0);
+        if ((!bit->m_bExtension || bFX) && !bPresence) {
+            continue;
+        }
+        if (bit->m_nFrom < 1 || bit->m_nFrom > m_nLength * 8 || part > MAX_PRESENCE_PART) {
+            return;
+        }
+        const int bytenr = m_nLength - 1 - (bit->m_nFrom - 1) / 8;
+        const auto mask = static_cast<unsigned char>(0x01 << ((bit->m_nFrom - 1) % 8));
+        if (bit->m_bExtension && !bFX) {
+            m_nFXByte = bytenr;
+            m_nFXMask = mask;
+            bFX = true;
+        }
+        if (bPresence) {
+            if (static_cast<size_t>(part) >= m_vPresence.size()) {
+                m_vPresence.resize(part + 1, std::make_pair(0, static_cast<unsigned char>(0)));
+            }
+            m_vPresence[part] = std::make_pair(bytenr, mask);
+        }
+    }
+    m_bFrozenMasks = true;
+}
+
 /*
  * Check FX bit to see if this is last part of variable item.
  */
 bool DataItemFormatFixed::isLastPart(const unsigned char *pData) const {
+    if (m_bFrozenMasks) {
+        return m_nFXMask == 0 || !(pData[m_nFXByte] & m_nFXMask);
+    }
+
     // go through all bits and find which is FX
     for (auto* subItem : m_lSubItems) {
         // Security fix: Check pointer before casting
@@ -113,6 +160,13 @@ std::string &DataItemFormatFixed::getPartName(int part) {
 }
 
 bool DataItemFormatFixed::isSecondaryPartPresent(const unsigned char *pData, int part) const {
+    if (m_bFrozenMasks) {
+        if (part < 0 || static_cast<size_t>(part) >= m_vPresence.size() || m_vPresence[part].second == 0) {
+            return false;
+        }
+        return (pData[m_vPresence[part].first] & m_vPresence[part].second) != 0;
+    }
+
     // go through all bits and find which has BitsPresence set to part
     for (auto* subItem : m_lSubItems) {
         // Security fix: Check pointer before casting
@@ -165,7 +219,8 @@ bool DataItemFormatFixed::getText(std::string &strResult, std::string &strHeader
     }
 
     bool ret = false;
-    for (auto* subItem : m_lSubItems) {
+    std::vector<DataItemFormat *> buffer;
+    for (auto* subItem : getSubItems(buffer)) {
         auto *bv = static_cast<DataItemBits *>(subItem);
         ret |= bv->getText(strResult, strHeader, formatType, pData, m_nLength);
     }
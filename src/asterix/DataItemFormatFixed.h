@@ -205,6 +205,43 @@ public:
      */
     int m_nLength;
 
+    /**
+     * @brief Compact sub-items and precompute FX and presence bit masks
+     *
+     * If the bits definition is erroneous (missing bits, bit outside of
+     * m_nLength), isLastPart() and isSecondaryPartPresent() keep walking
+     * the bits so errors are reported as before.
+     */
+    void freeze() override;
+
+    /**
+     * @brief True if freeze() computed the FX and presence bit masks
+     */
+    bool hasFrozenMasks() const { return m_bFrozenMasks; }
+
+    /**
+     * @brief Byte offset and mask of FX bit, mask 0 if this is always the last part
+     *
+     * @note Only valid if hasFrozenMasks()
+     */
+    int getFXByte() const { return m_nFXByte; }
+    unsigned char getFXMask() const { return m_nFXMask; }
+
+    /**
+     * @brief Byte offset and mask of presence bit of a secondary part
+     *
+     * @return false if no bit of this part signals the secondary part
+     * @note Only valid if hasFrozenMasks()
+     */
+    bool getPresenceBit(int part, int &bytenr, unsigned char &mask) const {
+        if (part < 0 || static_cast<size_t>(part) >= m_vPresence.size() || m_vPresence[part].second == 0) {
+            return false;
+        }
+        bytenr = m_vPresence[part].first;
+        mask = m_vPresence[part].second;
+        return true;
+    }
+
     /**
      * @brief Create a deep copy of this Fixed format object
      *
@@ -479,6 +516,23 @@ public:
      */
     void insertToDict(PyObject* p, unsigned char* pData, long nLength, int verbose);
 #endif
+
+private:
+    /**
+     * @brief Bit masks valid, set by freeze()
+     */
+    bool m_bFrozenMasks;
+
+    /**
+     * @brief Byte offset and mask of FX bit (mask 0 if this is always the last part)
+     */
+    int m_nFXByte;
+    unsigned char m_nFXMask;
+
+    /**
+     * @brief Byte offset and mask of presence bit indexed by secondary part (mask 0 if none)
+     */
+    std::vector<std::pair<int, unsigned char>> m_vPresence;
 };
 
 #endif /* DATAITEMFORMATFIXED_H_ */
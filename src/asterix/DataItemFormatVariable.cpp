@@ -56,24 +56,22 @@ DataItemFormatVariable::~DataItemFormatVariable() {
 
 long DataItemFormatVariable::getLength(const unsigned char *pData) {
     long length = 0;
-    std::list<DataItemFormat *>::iterator it;
     bool lastPart = false;
-    it = m_lSubItems.begin();
-
-    auto *dip = static_cast<DataItemFormatFixed *>(*it);
+    std::vector<DataItemFormat *> buffer;
+    const std::vector<DataItemFormat *> &parts = getSubItems(buffer);
+    size_t nPart = 0;
 
     do {
+        // last part repeats while its FX bit is set
+        auto *dip = static_cast<DataItemFormatFixed *>(parts[nPart]);
         lastPart = dip->isLastPart(pData);
         long partlen = dip->getLength();
 
         length += partlen;
         pData += partlen;
 
-        if (it != m_lSubItems.end()) {
-            ++it;
-            if (it != m_lSubItems.end()) {
-                dip = static_cast<DataItemFormatFixed *>(*it);
-            }
+        if (nPart + 1 < parts.size()) {
+            nPart++;
         }
     } while (!lastPart);
 
@@ -84,18 +82,19 @@ bool DataItemFormatVariable::getText(std::string &strResult, std::string &strHea
                                      unsigned char *pData, long nLength) {
     bool ret = false;
 
-    std::list<DataItemFormat *>::iterator it;
     bool lastPart = false;
+    std::vector<DataItemFormat *> buffer;
+    const std::vector<DataItemFormat *> &parts = getSubItems(buffer);
+    size_t nPart = 0;
 
     // If Variable item definition contains 1 Fixed subitem, show items in list
     bool listOfSubItems = false;
-    if (m_lSubItems.size() == 1)
+    if (parts.size() == 1)
         listOfSubItems = true;
 
-    it = m_lSubItems.begin();
     std::string tmpResult;
 
-    auto *dip = static_cast<DataItemFormatFixed *>(*it);
+    auto *dip = static_cast<DataItemFormatFixed *>(parts[nPart]);
 
     switch (formatType) {
         case CAsterixFormat::EJSON:
@@ -138,11 +137,8 @@ bool DataItemFormatVariable::getText(std::string &strResult, std::string &strHea
         pData += dip->getLength();
         nLength -= dip->getLength();
 
-        if (it != m_lSubItems.end()) {
-            ++it;
-            if (it != m_lSubItems.end()) {
-                dip = static_cast<DataItemFormatFixed *>(*it);
-            }
+        if (nPart + 1 < parts.size()) {
+            dip = static_cast<DataItemFormatFixed *>(parts[++nPart]);
         }
     } while (!lastPart && nLength > 0);
 
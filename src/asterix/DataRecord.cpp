@@ -23,53 +23,78 @@
 
 #include "Category.h"
 #include "DataRecord.h"
+#include "DecodePlan.h"
 #include "Tracer.h"
 #include "Utils.h"
 #include "asterixformat.hxx"
+#include "recorddecoder.hxx"
 
-DataRecord::DataRecord(Category *cat, int nID, unsigned long len, const unsigned char *data, double nTimestamp)
+extern bool gFiltering;
+
+DataRecord::DataRecord(Category *cat, int nID, unsigned long len, const unsigned char *data, double nTimestamp,
+                       const CRecordDecoder *pDecoder, DecodePlanCache *pPlans)
         : m_pCategory(cat), m_nID(nID), m_nLength(len), m_nFSPECLength(0), m_pFSPECData(nullptr), m_nTimestamp(nTimestamp),
           m_nCrc(0), m_pHexData(nullptr), m_bFormatOK(false) {
     const unsigned char *m_pItemDataStart = data;
     long nUnparsed = len;
 
-    UAP *pUAP = m_pCategory->getUAP(data, len);
+    // memoized items of this FSPEC pattern
+    const DecodePlan *pPlan = pPlans != nullptr ? pPlans->find(data, len) : nullptr;
+
+    UAP *pUAP = pPlan != nullptr ? pPlan->m_pUAP : m_pCategory->getUAP(data, len);
     if (!pUAP) {
         Tracer::Error("UAP not found for category %d", m_pCategory->m_id);
         return;
     }
 
-    // parse FSPEC
-    unsigned int nFSPEC = 0;
-    int nFRN = 1;
-    bool lastFSPEC = false;
-    do {
-        unsigned bitmask = 0x80;
-        unsigned char FSPEC = *m_pItemDataStart;
-        lastFSPEC = (FSPEC & 0x01) ? false : true;
-
-        while (bitmask > 1) {
-            if (FSPEC & bitmask) {
-                DataItemDescription *dataitemdesc = m_pCategory->getDataItemDescription(
-                        pUAP->getDataItemIDByUAPfrn(nFRN));
-                if (dataitemdesc) {
-                    DataItem *di = new DataItem(dataitemdesc);
-                    m_lDataItems.push_back(di);
-                } else {
-                    Tracer::Error("Description of UAP FRN %d in category %03d not found", nFRN, m_pCategory->m_id);
-                    return;
+    // generated decoder resolves items and their lengths by UAP and FRN
+    const int nUAP = pDecoder != nullptr ? pDecoder->GetUAPIndex(pUAP) : -1;
+    std::vector<int> itemFRNs;
+
+    if (pPlan != nullptr) {
+        for (auto *dataitemdesc : pPlan->m_vItems) {
+            m_lDataItems.push_back(new DataItem(dataitemdesc));
+        }
+        if (nUAP >= 0) {
+            itemFRNs = pPlan->m_vFRNs;
+        }
+        m_nFSPECLength = pPlan->m_nFSPECLength;
+        m_pItemDataStart += m_nFSPECLength;
+        nUnparsed -= m_nFSPECLength;
+    } else {
+        // parse FSPEC
+        int nFRN = 1;
+        bool lastFSPEC = false;
+        do {
+            unsigned bitmask = 0x80;
+            unsigned char FSPEC = *m_pItemDataStart;
+            lastFSPEC = (FSPEC & 0x01) ? false : true;
+
+            while (bitmask > 1) {
+                if (FSPEC & bitmask) {
+                    DataItemDescription *dataitemdesc = nUAP >= 0 ? pDecoder->GetDescription(nUAP, nFRN)
+                                                                  : m_pCategory->findDataItemDescription(pUAP, nFRN);
+                    if (dataitemdesc) {
+                        DataItem *di = new DataItem(dataitemdesc);
+                        m_lDataItems.push_back(di);
+                        if (nUAP >= 0) {
+                            itemFRNs.push_back(nFRN);
+                        }
+                    } else {
+                        Tracer::Error("Description of UAP FRN %d in category %03d not found", nFRN, m_pCategory->m_id);
+                        return;
+                    }
                 }
+                bitmask >>= 1;
+                bitmask &= 0x7F;
+                nFRN++;
             }
-            bitmask >>= 1;
-            bitmask &= 0x7F;
-            nFRN++;
-        }
 
-        m_pItemDataStart++;
-        nFSPEC++;
-        m_nFSPECLength++;
-        nUnparsed--;
-    } while (!lastFSPEC && nUnparsed > 0);
+            m_pItemDataStart++;
+            m_nFSPECLength++;
+            nUnparsed--;
+        } while (!lastFSPEC && nUnparsed > 0);
+    }
 
     // Use std::unique_ptr for automatic memory management (RAII)
     m_pFSPECData = std::make_unique<unsigned char[]>(m_nFSPECLength);
@@ -84,7 +109,7 @@ DataRecord::DataRecord(Category *cat, int nID, unsigned long len, const unsigned
 
     // parse DataItems
     auto it = m_lDataItems.begin();
-    for (; it != m_lDataItems.end(); ++it) {
+    for (size_t nItem = 0; it != m_lDataItems.end(); ++it, ++nItem) {
         auto *di = *it;
 
         // Security fix: Check di pointer before dereferencing
@@ -94,7 +119,16 @@ DataRecord::DataRecord(Category *cat, int nID, unsigned long len, const unsigned
             break;
         }
 
-        long usedbytes = di->parse(m_pItemDataStart, nUnparsed);
+        long usedbytes;
+        if (pPlan != nullptr && nItem < pPlan->getNFixedItems()) {
+            usedbytes = di->parse(m_pItemDataStart, nUnparsed,
+                                  pPlan->m_vFixedOffsets[nItem + 1] - pPlan->m_vFixedOffsets[nItem]);
+        } else if (nUAP >= 0) {
+            usedbytes = di->parse(m_pItemDataStart, nUnparsed,
+                                  pDecoder->ItemLength(nUAP, itemFRNs[nItem], m_pItemDataStart, nUnparsed));
+        } else {
+            usedbytes = di->parse(m_pItemDataStart, nUnparsed);
+        }
         if (usedbytes <= 0 || usedbytes > nUnparsed) {
             Tracer::Error("Wrong length in DataItem format for CAT%03d/I%s", cat->m_id,
                           di->m_pDescription->m_strID.c_str());
@@ -248,6 +282,74 @@ DataItem *DataRecord::getItem(std::string itemid) {
     return nullptr;
 }
 
+bool DataRecord::getField(const FieldPath &path, ItemField &field) const {
+    if (path.m_pDescription == nullptr) {
+        return false;
+    }
+    for (const auto* di : m_lDataItems) {
+        if (di == nullptr || di->m_pDescription != path.m_pDescription) {
+            continue;
+        }
+        const unsigned char *pData = di->getBinaryData();
+        const long len = di->getLength();
+        if (pData == nullptr) {
+            return false;
+        }
+        if (path.m_nPartLength > 0) {
+            if (len < path.m_nPartLength) {
+                return false;
+            }
+            field = {path.m_pBits, pData, path.m_nPartLength, path.m_nFrom, path.m_nTo};
+            return true;
+        }
+        const ItemProgram *pProgram = di->m_pDescription->m_pProgram.get();
+        if (pProgram == nullptr) {
+            return false;
+        }
+        // reused per thread, records of several parsers may be read concurrently
+        thread_local std::vector<ItemField> fields;
+        fields.clear();
+        if (pProgram->decode(pData, len, fields) != len) {
+            return false;
+        }
+        for (const auto &decoded : fields) {
+            if (decoded.m_pBits == path.m_pBits) {
+                field = decoded;
+                return true;
+            }
+        }
+        return false;
+    }
+    return false;
+}
+
+bool DataRecord::getBinary(std::vector<unsigned char> &result) const {
+    if (!m_bFormatOK || !m_pFSPECData) {
+        return false;
+    }
+
+    if (gFiltering) {
+        bool bFiltered = false;
+        for (const auto* di : m_lDataItems) {
+            if (di && di->m_pDescription && di->m_pDescription->m_bFiltered) {
+                bFiltered = true;
+                break;
+            }
+        }
+        if (!bFiltered) {
+            return false;
+        }
+    }
+
+    result.insert(result.end(), m_pFSPECData.get(), m_pFSPECData.get() + m_nFSPECLength);
+    for (const auto* di : m_lDataItems) {
+        if (di != nullptr) {
+            di->getBinary(result);
+        }
+    }
+    return true;
+}
+
 #if defined(WIRESHARK_WRAPPER) || defined(ETHEREAL_WRAPPER)
 fulliautomatix_data* DataRecord::getData(int byteoffset)
 {
@@ -34,7 +34,12 @@
 #define DATARECORD_H_
 
 #include "DataItem.h"
+#include "FieldPath.h"
 #include <memory>  // For std::unique_ptr
+#include <type_traits>
+
+class CRecordDecoder;
+class DecodePlanCache;
 
 /**
  * @class DataRecord
@@ -114,6 +119,10 @@ public:
      *                   Must contain at least len bytes.
      * @param nTimestamp Capture timestamp in Unix epoch seconds.
      *                   Typically inherited from parent DataBlock.
+     * @param pDecoder   Generated record decoder bound to cat, or nullptr to
+     *                   resolve items and lengths with the interpreter.
+     * @param pPlans     Decode plans of cat memoized by FSPEC, or nullptr to
+     *                   resolve the UAP and items of every record from its FSPEC.
      *
      * @note After construction, check m_bFormatOK to verify successful parsing.
      *       If m_bFormatOK is false, the record data was malformed.
@@ -129,7 +138,8 @@ public:
      * }
      * @endcode
      */
-    DataRecord(Category *cat, int id, unsigned long len, const unsigned char *data, double nTimestamp);
+    DataRecord(Category *cat, int id, unsigned long len, const unsigned char *data, double nTimestamp,
+               const CRecordDecoder *pDecoder = nullptr, DecodePlanCache *pPlans = nullptr);
 
     /**
      * @brief Destructor - frees all data items and internal buffers
@@ -277,6 +287,63 @@ public:
      */
     DataItem *getItem(std::string itemid);
 
+    /**
+     * @brief Locate the field of a compiled path in this record
+     *
+     * @param path  Field compiled by AsterixDefinition::compile()
+     * @param field Set to the field, pointing into the item data of this record
+     * @return true if the item is present and holds the field; false otherwise,
+     *         also for fields outside the first fixed part of items without
+     *         item program (DataItemDescription::m_pProgram)
+     */
+    bool getField(const FieldPath &path, ItemField &field) const;
+
+    /**
+     * @brief Get the value of a field read directly from the item bytes
+     *
+     * Floating-point types get the scaled value (ItemField::getValue()),
+     * integral types the raw value, sign-extended for signed fields read
+     * as signed types.
+     *
+     * @param path         Field compiled by AsterixDefinition::compile()
+     * @param defaultValue Returned if the field is not present (see getField())
+     *
+     * @par Example
+     * @code
+     * static const FieldPath lat = globalDef.compile("062/105.LAT");
+     * static const FieldPath track = globalDef.compile("062/040.TN");
+     * double latitude = record.get<double>(lat);
+     * uint32_t trackNumber = record.get<uint32_t>(track);
+     * @endcode
+     */
+    template <typename T>
+    T get(const FieldPath &path, T defaultValue = T()) const {
+        static_assert(std::is_arithmetic_v<T>, "DataRecord::get() reads numeric values");
+        ItemField field{};
+        if (!getField(path, field)) {
+            return defaultValue;
+        }
+        if constexpr (std::is_floating_point_v<T>) {
+            return static_cast<T>(field.getValue());
+        } else if constexpr (std::is_signed_v<T>) {
+            return static_cast<T>(field.isSigned() ? field.getSigned() : static_cast<int64_t>(field.getUnsigned()));
+        } else {
+            return static_cast<T>(field.getUnsigned());
+        }
+    }
+
+    /**
+     * @brief Append the binary record (FSPEC followed by data items) to result
+     *
+     * The record is appended only if it was parsed without error and, when
+     * filtering is on (gFiltering), at least one of its items is listed in
+     * the filter (DataItemDescription::m_bFiltered).
+     *
+     * @param[out] result Buffer to which the record is appended
+     * @return true if the record was appended
+     */
+    bool getBinary(std::vector<unsigned char> &result) const;
+
 #if defined(WIRESHARK_WRAPPER) || defined(ETHEREAL_WRAPPER)
     /**
      * @brief Get Wireshark dissector data structure (Wireshark plugin only)
@@ -0,0 +1,117 @@
+/*
+ *  Copyright (c) 2013 Croatia Control Ltd. (www.crocontrol.hr)
+ *
+ *  This file is part of Asterix.
+ *
+ *  Asterix is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Asterix is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Asterix.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * AUTHORS: Damir Salantic, Croatia Control Ltd.
+ *
+ */
+
+#include "DecodePlan.h"
+#include "Category.h"
+#include "DataItemFormatFixed.h"
+
+DecodePlan::DecodePlan()
+        : m_pUAP(nullptr), m_nFSPECLength(0) {
+}
+
+DecodePlanCache::DecodePlanCache(Category *pCategory)
+        : m_pCategory(pCategory), m_pUnconditionalUAP(nullptr), m_nPlans(0) {
+    // the first UAP without condition is selected for every record
+    if (!m_pCategory->m_vUAPs.empty()) {
+        UAP *pUAP = m_pCategory->m_vUAPs.front();
+        if (pUAP != nullptr && pUAP->m_nUseIfBitSet == 0 && pUAP->m_nUseIfByteNr == 0) {
+            m_pUnconditionalUAP = pUAP;
+        }
+    }
+}
+
+const DecodePlan *DecodePlanCache::find(const unsigned char *data, unsigned long len) {
+    // key is the FSPEC itself, its last byte is the first without FX bit
+    uint64_t key = 0;
+    unsigned long nFSPECLength = 0;
+    bool lastFSPEC = false;
+    while (!lastFSPEC) {
+        if (nFSPECLength >= len || nFSPECLength >= MAX_FSPEC_LENGTH) {
+            return nullptr;
+        }
+        key = (key << 8) | data[nFSPECLength];
+        lastFSPEC = (data[nFSPECLength] & 0x01) == 0;
+        nFSPECLength++;
+    }
+    key <<= 8 * (MAX_FSPEC_LENGTH - nFSPECLength);
+
+    UAP *pUAP = m_pUnconditionalUAP != nullptr ? m_pUnconditionalUAP
+                                               : m_pCategory->getUAP(data, len, nFSPECLength);
+    if (pUAP == nullptr) {
+        return nullptr;
+    }
+
+    auto it = m_mPlans.find(key);
+    if (it != m_mPlans.end()) {
+        for (const DecodePlan &plan : it->second) {
+            if (plan.m_pUAP == pUAP) {
+                return &plan;
+            }
+        }
+    }
+
+    DecodePlan plan;
+    if (!build(plan, pUAP, data, nFSPECLength)) {
+        return nullptr;
+    }
+
+    if (m_nPlans >= MAX_PLANS) {
+        m_mPlans.clear();
+        m_nPlans = 0;
+    }
+    std::vector<DecodePlan> &plans = m_mPlans[key];
+    plans.push_back(std::move(plan));
+    m_nPlans++;
+    return &plans.back();
+}
+
+bool DecodePlanCache::build(DecodePlan &plan, UAP *pUAP, const unsigned char *data,
+                            unsigned long nFSPECLength) const {
+    plan.m_pUAP = pUAP;
+    plan.m_nFSPECLength = nFSPECLength;
+
+    int nFRN = 1;
+    for (unsigned long i = 0; i < nFSPECLength; i++) {
+        for (unsigned char bitmask = 0x80; bitmask > 1; bitmask >>= 1, nFRN++) {
+            if (data[i] & bitmask) {
+                DataItemDescription *pDescription = m_pCategory->findDataItemDescription(pUAP, nFRN);
+                if (pDescription == nullptr) {
+                    return false;
+                }
+                plan.m_vItems.push_back(pDescription);
+                plan.m_vFRNs.push_back(nFRN);
+            }
+        }
+    }
+
+    long offset = 0;
+    plan.m_vFixedOffsets.push_back(offset);
+    for (auto *pDescription : plan.m_vItems) {
+        if (pDescription->m_pFormat == nullptr || !pDescription->m_pFormat->isFixed()) {
+            break;
+        }
+        offset += static_cast<DataItemFormatFixed *>(pDescription->m_pFormat)->getLength();
+        plan.m_vFixedOffsets.push_back(offset);
+    }
+    return true;
+}
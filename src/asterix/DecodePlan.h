@@ -0,0 +1,164 @@
+/*
+ *  Copyright (c) 2013 Croatia Control Ltd. (www.crocontrol.hr)
+ *
+ *  This file is part of Asterix.
+ *
+ *  Asterix is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Asterix is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Asterix.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * AUTHORS: Damir Salantic, Croatia Control Ltd.
+ *
+ */
+
+/**
+ * @file DecodePlan.h
+ * @brief Decode plans of data records memoized by FSPEC
+ *
+ * Within one feed the same few FSPEC patterns repeat for every record. A
+ * DecodePlan keeps what DataRecord resolves from the FSPEC (selected UAP,
+ * item descriptions, offsets of the leading fixed length items), so that
+ * it is done once per pattern instead of once per record.
+ */
+
+#ifndef DECODEPLAN_H_
+#define DECODEPLAN_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class Category;
+class DataItemDescription;
+class UAP;
+
+/**
+ * @class DecodePlan
+ * @brief Resolved items of one FSPEC pattern and UAP
+ */
+class DecodePlan {
+public:
+    DecodePlan();
+
+    /**
+     * @brief UAP the plan was resolved with
+     */
+    UAP *m_pUAP;
+
+    /**
+     * @brief Length of the FSPEC in bytes
+     */
+    unsigned long m_nFSPECLength;
+
+    /**
+     * @brief Descriptions of present items in FSPEC order
+     */
+    std::vector<DataItemDescription *> m_vItems;
+
+    /**
+     * @brief FRN of each item in m_vItems
+     */
+    std::vector<int> m_vFRNs;
+
+    /**
+     * @brief Offsets of the leading fixed length items from the first item byte
+     *
+     * Holds one entry per leading fixed length item and a last entry with the
+     * offset of the first item whose length depends on data (or the total
+     * length of the items if all are fixed). Only items from that one on need
+     * DataItemFormat::getLength() while decoding.
+     */
+    std::vector<long> m_vFixedOffsets;
+
+    /**
+     * @brief Number of leading fixed length items
+     */
+    size_t getNFixedItems() const { return m_vFixedOffsets.size() - 1; }
+};
+
+/**
+ * @class DecodePlanCache
+ * @brief Decode plans of one category keyed by FSPEC bytes
+ *
+ * Records with an FSPEC up to MAX_FSPEC_LENGTH bytes are looked up in a hash
+ * map keyed by the FSPEC bytes. Each key holds a plan per UAP seen with it;
+ * the UAP is only selected again when the category has UAPs with a condition.
+ * When the cache holds MAX_PLANS plans it is cleared and refilled from the
+ * current traffic.
+ *
+ * @par Thread Safety
+ * Not thread-safe. InputParser keeps one cache per category, so a cache is
+ * used by one parser (thread) only.
+ *
+ * @note The category must be frozen (Category::freeze()) and must not change
+ *       while the cache is in use.
+ */
+class DecodePlanCache {
+public:
+    /**
+     * @brief Longest FSPEC in bytes for which plans are cached
+     */
+    static constexpr unsigned long MAX_FSPEC_LENGTH = 8;
+
+    /**
+     * @brief Plans kept before the cache is cleared
+     */
+    static constexpr size_t MAX_PLANS = 256;
+
+    /**
+     * @param pCategory Frozen category of the records. Not owned.
+     */
+    explicit DecodePlanCache(Category *pCategory);
+
+    /**
+     * @brief Get the decode plan of the record at data
+     *
+     * @param data Record data (starts with FSPEC)
+     * @param len  Length of record data in bytes
+     * @return Plan, valid until the next call, or nullptr if the record cannot
+     *         be planned (FSPEC longer than MAX_FSPEC_LENGTH or than len, no
+     *         UAP selected, or an FRN without item description). Such records
+     *         are decoded without a plan, which also reports their errors.
+     */
+    const DecodePlan *find(const unsigned char *data, unsigned long len);
+
+    /**
+     * @brief Number of cached plans
+     */
+    size_t size() const { return m_nPlans; }
+
+private:
+    /**
+     * @brief Resolve the plan of FSPEC at data with UAP
+     *
+     * @return false if an FRN has no item description
+     */
+    bool build(DecodePlan &plan, UAP *pUAP, const unsigned char *data, unsigned long nFSPECLength) const;
+
+    Category *m_pCategory;
+
+    /**
+     * @brief UAP used for all records, or nullptr if UAPs have a condition
+     */
+    UAP *m_pUnconditionalUAP;
+
+    /**
+     * @brief Plans per UAP keyed by FSPEC bytes (big endian, zero padded)
+     */
+    std::unordered_map<uint64_t, std::vector<DecodePlan>> m_mPlans;
+
+    size_t m_nPlans;
+};
+
+#endif /* DECODEPLAN_H_ */
@@ -0,0 +1,90 @@
+/*
+ *  Copyright (c) 2013 Croatia Control Ltd. (www.crocontrol.hr)
+ *
+ *  This file is part of Asterix.
+ *
+ *  Asterix is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Asterix is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Asterix.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * AUTHORS: Damir Salantic, Croatia Control Ltd.
+ *
+ */
+
+/**
+ * @file FieldPath.h
+ * @brief Precompiled reference to one bit field of a data item
+ */
+
+#ifndef FIELDPATH_H_
+#define FIELDPATH_H_
+
+class DataItemBits;
+class DataItemDescription;
+
+/**
+ * @struct FieldPath
+ * @brief Field of a category item resolved once by AsterixDefinition::compile()
+ *
+ * Names such as "062/105.LAT" are resolved to the definition of the item and
+ * field, so reading the field from a record (DataRecord::get()) needs no
+ * string compare and no text conversion.
+ *
+ * Fields in the first fixed part of an item (Fixed items, first part of
+ * Variable items) are always at the same bit position and are read directly
+ * from the item bytes. Fields of other parts are located by the item program
+ * (ItemProgram::decode()).
+ *
+ * @warning Valid as long as the category it was compiled from; compile again
+ *          after the category is replaced.
+ *
+ * @par Example
+ * @code
+ * const FieldPath lat = definition.compile("062/105.LAT");
+ * const FieldPath trackNumber = definition.compile("062/040.TN");
+ * double latitude = record.get<double>(lat);
+ * uint32_t track = record.get<uint32_t>(trackNumber);
+ * @endcode
+ */
+struct FieldPath {
+    /**
+     * @brief Category of the item, -1 if not compiled
+     */
+    int m_nCategory{-1};
+
+    /**
+     * @brief Definition of the item, compared with DataItem::m_pDescription
+     */
+    const DataItemDescription *m_pDescription{nullptr};
+
+    /**
+     * @brief Definition of the field, nullptr if the path could not be resolved
+     */
+    const DataItemBits *m_pBits{nullptr};
+
+    /**
+     * @brief Length of the fixed part at the start of the item holding the
+     *        field, 0 if the field is not at a constant position
+     */
+    int m_nPartLength{0};
+
+    /**
+     * @brief Bit range of the field in that part (as ItemField)
+     */
+    int m_nFrom{0};
+    int m_nTo{0};
+
+    bool isValid() const { return m_pBits != nullptr; }
+};
+
+#endif /* FIELDPATH_H_ */
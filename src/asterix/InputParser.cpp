@@ -28,7 +28,77 @@
 #include "InputParser.h"
 
 InputParser::InputParser(AsterixDefinition *pDefinition)
-        : m_pDefinition(pDefinition) {
+        : m_pDefinition(pDefinition), m_bGeneratedDecoders(true), m_bDecoderBound(),
+          m_nDecoderRevision(pDefinition != nullptr ? pDefinition->getRevision() : 0), m_bDecodePlans(true) {
+}
+
+void InputParser::setGeneratedDecoders(bool bEnable) {
+    m_bGeneratedDecoders = bEnable;
+}
+
+void InputParser::setDecodePlans(bool bEnable) {
+    m_bDecodePlans = bEnable;
+    if (!bEnable) {
+        for (auto &pPlanCache : m_pPlanCache) {
+            pPlanCache.reset();
+        }
+    }
+}
+
+void InputParser::setDefinition(AsterixDefinition *pDefinition) {
+    releaseDecoders();
+    m_pDefinition = pDefinition;
+    m_nDecoderRevision = pDefinition != nullptr ? pDefinition->getRevision() : 0;
+}
+
+void InputParser::checkRevision() {
+    // categories replaced since decoders and plans were bound
+    const unsigned int revision = m_pDefinition->getRevision();
+    if (revision != m_nDecoderRevision) {
+        releaseDecoders();
+        m_nDecoderRevision = revision;
+    }
+}
+
+void InputParser::releaseDecoders() {
+    for (int i = 0; i < 256; i++) {
+        m_pDecoder[i].reset();
+        m_bDecoderBound[i] = false;
+        m_pPlanCache[i].reset();
+    }
+}
+
+const CRecordDecoder *InputParser::getDecoder(int nCategory, Category *pCategory) {
+    if (!m_bGeneratedDecoders || pCategory == nullptr) {
+        return nullptr;
+    }
+
+    checkRevision();
+
+    if (!m_bDecoderBound[nCategory]) {
+        m_pDecoder[nCategory].reset(CRecordDecoder::Create(pCategory));
+        m_bDecoderBound[nCategory] = true;
+    }
+    return m_pDecoder[nCategory].get();
+}
+
+DecodePlanCache *InputParser::getPlanCache(int nCategory, Category *pCategory) {
+    if (!m_bDecodePlans || pCategory == nullptr) {
+        return nullptr;
+    }
+
+    checkRevision();
+
+    // plans hold pointers into the definition, which may only change while unfrozen
+    if (!pCategory->m_bFrozen) {
+        m_pPlanCache[nCategory].reset();
+        return nullptr;
+    }
+
+    if (!m_pPlanCache[nCategory]) {
+        m_pPlanCache[nCategory] = std::make_unique<DecodePlanCache>(pCategory);
+    }
+    return m_pPlanCache[nCategory].get();
 }
 
 /*
@@ -100,7 +170,9 @@ InputParser::parsePacket(const unsigned char *m_pBuffer, unsigned int m_nBufferS
             hexString.erase(hexString.size() - 1);
             LOGDEBUG(1, "[%s]\n", hexString.c_str());
 #endif
-            DataBlock *db = new DataBlock(m_pDefinition->getCategory(nCategory), dataLen, m_pData, nTimestamp);
+            Category *pCategory = m_pDefinition->getCategory(nCategory);
+            DataBlock *db = new DataBlock(pCategory, dataLen, m_pData, nTimestamp,
+                                          getDecoder(nCategory, pCategory), getPlanCache(nCategory, pCategory));
 
             // SECURITY FIX (VULN-004): Verify DataBlock created successfully before advancing pointers
             if (!db || !db->m_bFormatOK) {
@@ -117,6 +189,117 @@ InputParser::parsePacket(const unsigned char *m_pBuffer, unsigned int m_nBufferS
     return pAsterixData;
 }
 
+unsigned long InputParser::visit(const unsigned char *pBuffer, unsigned int nBufferSize, AsterixVisitor &visitor,
+                                double nTimestamp) {
+    unsigned long nRecords = 0;
+    unsigned int nPos = 0;
+
+    while (nBufferSize - nPos > 3) {
+        const unsigned char nCategory = pBuffer[nPos];
+        const unsigned int dataLen = (pBuffer[nPos + 1] << 8) | pBuffer[nPos + 2];
+        if (dataLen <= 3) {
+            Tracer::Error("Invalid ASTERIX data length (%d) - too small", dataLen);
+            break;
+        }
+        if (dataLen > nBufferSize - nPos) {
+            Tracer::Error("Invalid ASTERIX data length (%d) exceeds available data (%d)", dataLen,
+                          nBufferSize - nPos);
+            break;
+        }
+        const unsigned char *pData = pBuffer + nPos + 3;
+        const unsigned long nLength = dataLen - 3;
+        nPos += dataLen;
+
+        if (!m_pDefinition->CategoryDefined(nCategory)) {
+            Tracer::Error("Category %d not defined", nCategory);
+            continue;
+        }
+        Category *pCategory = m_pDefinition->getCategory(nCategory);
+        if (!visitor.onBlock(*pCategory, pData, nLength, nTimestamp)) {
+            continue;
+        }
+        unsigned long nRecordPos = 0;
+        while (nRecordPos < nLength) {
+            unsigned long nRecordLength = 0;
+            if (!visitRecord(pCategory, pData + nRecordPos, nLength - nRecordPos, visitor, nRecordLength)) {
+                break;
+            }
+            nRecordPos += nRecordLength;
+            nRecords++;
+        }
+        visitor.onBlockEnd(*pCategory);
+    }
+    if (nPos < nBufferSize && nBufferSize - nPos <= 3) {
+        Tracer::Error("Not enough data for Asterix header (%d)", nBufferSize - nPos);
+    }
+    return nRecords;
+}
+
+bool InputParser::visitRecord(Category *pCategory, const unsigned char *pData, unsigned long nLength,
+                              AsterixVisitor &visitor, unsigned long &nRecordLength) {
+    unsigned long nFSPECLength = 0;
+    do {
+        if (nFSPECLength >= nLength) {
+            Tracer::Error("Wrong FSPEC in data block");
+            return false;
+        }
+    } while (pData[nFSPECLength++] & 0x01);
+
+    UAP *pUAP = pCategory->getUAP(pData, nLength, nFSPECLength);
+    if (pUAP == nullptr) {
+        Tracer::Error("UAP not found for category %d", pCategory->m_id);
+        return false;
+    }
+
+    // find all items first, so the record is only visited if it can be decoded
+    m_vVisitItems.clear();
+    long offset = static_cast<long>(nFSPECLength);
+    int nFRN = 1;
+    for (unsigned long i = 0; i < nFSPECLength; i++) {
+        for (unsigned char bitmask = 0x80; bitmask > 1; bitmask >>= 1, nFRN++) {
+            if (!(pData[i] & bitmask)) {
+                continue;
+            }
+            DataItemDescription *pDescription = pCategory->findDataItemDescription(pUAP, nFRN);
+            if (pDescription == nullptr || pDescription->m_pFormat == nullptr) {
+                Tracer::Error("Description of UAP FRN %d in category %03d not found", nFRN, pCategory->m_id);
+                return false;
+            }
+            const long nUnparsed = static_cast<long>(nLength) - offset;
+            long itemLength = pDescription->m_pProgram ? pDescription->m_pProgram->getLength(pData + offset, nUnparsed)
+                                                       : 0;
+            if (itemLength == 0 && nUnparsed > 0) {
+                itemLength = pDescription->m_pFormat->getLength(pData + offset);
+            }
+            if (itemLength <= 0 || itemLength > nUnparsed) {
+                Tracer::Error("Wrong length in DataItem format for CAT%03d/I%s", pCategory->m_id,
+                              pDescription->m_strID.c_str());
+                return false;
+            }
+            m_vVisitItems.push_back({pDescription, offset, itemLength});
+            offset += itemLength;
+        }
+    }
+    nRecordLength = static_cast<unsigned long>(offset);
+
+    if (!visitor.onRecord(*pCategory, pData, nRecordLength)) {
+        return true;
+    }
+    for (const VisitItem &item : m_vVisitItems) {
+        const unsigned char *pItemData = pData + item.m_nOffset;
+        if (!visitor.onItem(*item.m_pDescription, pItemData, item.m_nLength) || !item.m_pDescription->m_pProgram) {
+            continue;
+        }
+        m_vVisitFields.clear();
+        item.m_pDescription->m_pProgram->decode(pItemData, item.m_nLength, m_vVisitFields);
+        for (const ItemField &field : m_vVisitFields) {
+            visitor.onField(*item.m_pDescription, field);
+        }
+    }
+    visitor.onRecordEnd(*pCategory);
+    return true;
+}
+
 DataBlock *
 InputParser::parse_next_data_block(const unsigned char *m_pData, unsigned int &m_nPos, [[maybe_unused]] unsigned int m_nBufferSize,
                                    double nTimestamp, unsigned int &m_nDataLength)
@@ -173,7 +356,9 @@ InputParser::parse_next_data_block(const unsigned char *m_pData, unsigned int &m
     hexString.erase(hexString.size() - 1);
     LOGDEBUG(1, "[%s]\n", hexString.c_str());
 #endif
-    DataBlock *db = new DataBlock(m_pDefinition->getCategory(nCategory), dataLen, m_pData, nTimestamp);
+    Category *pCategory = m_pDefinition->getCategory(nCategory);
+    DataBlock *db = new DataBlock(pCategory, dataLen, m_pData, nTimestamp,
+                                  getDecoder(nCategory, pCategory), getPlanCache(nCategory, pCategory));
     m_pData += dataLen;
     m_nPos += dataLen;
     m_nDataLength -= dataLen;
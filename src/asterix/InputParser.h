@@ -70,7 +70,10 @@
 
 #include "AsterixDefinition.h"
 #include "AsterixData.h"
+#include "AsterixVisitor.h"
 #include "DataBlock.h"
+#include "DecodePlan.h"
+#include "recorddecoder.hxx"
 #include <ios>
 #include <iostream>
 #include <iomanip>
@@ -285,6 +288,36 @@ public:
      */
     AsterixData *parsePacket(const unsigned char *m_pBuffer, unsigned int m_nBufferSize, double nTimestamp = 0.0);
 
+    /**
+     * @brief Decode a buffer of ASTERIX data blocks into visitor callbacks
+     *
+     * Walks the same data as parsePacket() but builds no AsterixData tree:
+     * blocks, records, items and bit fields are passed to the visitor while
+     * decoding. Item lengths and fields come from the item programs of
+     * frozen categories (ItemProgram), so after the first records nothing
+     * is allocated. Categories are visited regardless of filtering.
+     *
+     * @param pBuffer     Raw ASTERIX data blocks
+     * @param nBufferSize Size of the buffer in bytes
+     * @param visitor     Receives the decoded data
+     * @param nTimestamp  Timestamp passed to AsterixVisitor::onBlock()
+     * @return Number of records visited
+     *
+     * @par Error Handling
+     * Errors are logged via Tracer::Error(). A block header not matching the
+     * buffer stops decoding; a record which cannot be decoded (no UAP, FRN
+     * without description, item beyond the block) ends its block, which is
+     * not visited further. Blocks of undefined categories are skipped.
+     *
+     * @par Example
+     * @code
+     * LatitudeVisitor visitor;  // see AsterixVisitor
+     * parser.visit(buffer, bufferSize, visitor);
+     * @endcode
+     */
+    unsigned long visit(const unsigned char *pBuffer, unsigned int nBufferSize, AsterixVisitor &visitor,
+                        double nTimestamp = 0.0);
+
     /**
      * @brief Parse the next single ASTERIX data block from a buffer
      *
@@ -429,7 +462,66 @@ public:
      */
     bool isFiltered(int cat, std::string item, const char *name);
 
+    /**
+     * @brief Enable or disable generated record decoders (enabled by default)
+     *
+     * Categories for which a decoder was generated at build time
+     * (asterix-specs-converter/asterixxml2cpp.py) are decoded with it if the
+     * loaded definition matches the one it was generated from. When disabled,
+     * or for other categories, records are decoded by the interpreter.
+     */
+    void setGeneratedDecoders(bool bEnable);
+
+    /**
+     * @brief Enable or disable decode plans memoized by FSPEC (enabled by default)
+     *
+     * Each frozen category gets a DecodePlanCache which keeps the UAP, item
+     * descriptions and fixed item offsets resolved for each FSPEC pattern seen.
+     */
+    void setDecodePlans(bool bEnable);
+
+    /**
+     * @brief Parse with another definition (e.g. reloaded), releasing decoders and plans
+     *
+     * AsterixData returned by parsePacket() before refers to the previous
+     * definition and must not be used after it is deleted.
+     */
+    void setDefinition(AsterixDefinition *pDefinition);
+
 private:
+    /**
+     * @brief Release decoders and plans if categories were replaced since they were bound
+     */
+    void checkRevision();
+
+    /**
+     * @brief Release decoders and plans bound to categories of m_pDefinition
+     */
+    void releaseDecoders();
+
+    /**
+     * @brief Generated decoder for category, bound on first use
+     *
+     * @return nullptr if no generated decoder matches the category definition
+     */
+    const CRecordDecoder *getDecoder(int nCategory, Category *pCategory);
+
+    /**
+     * @brief Decode plan cache of category, created on first use
+     *
+     * @return nullptr if plans are disabled or the category is not frozen
+     */
+    DecodePlanCache *getPlanCache(int nCategory, Category *pCategory);
+
+    /**
+     * @brief Find the items of the record at pData and pass them to visitor
+     *
+     * @param nRecordLength [out] Length of the record
+     * @return false if the record cannot be decoded
+     */
+    bool visitRecord(Category *pCategory, const unsigned char *pData, unsigned long nLength, AsterixVisitor &visitor,
+                     unsigned long &nRecordLength);
+
     /**
      * @brief Reference to global category definitions registry
      *
@@ -443,6 +535,39 @@ private:
      */
     AsterixDefinition *m_pDefinition;
 
+    bool m_bGeneratedDecoders;
+
+    /**
+     * @brief Generated decoders per category (nullptr if none matches)
+     *
+     * Bound lazily, m_bDecoderBound marks categories already checked.
+     * All are released when m_pDefinition revision changes.
+     */
+    std::unique_ptr<CRecordDecoder> m_pDecoder[256];
+    bool m_bDecoderBound[256];
+    unsigned int m_nDecoderRevision;
+
+    bool m_bDecodePlans;
+
+    /**
+     * @brief Decode plans per category, released with the decoders
+     */
+    std::unique_ptr<DecodePlanCache> m_pPlanCache[256];
+
+    /**
+     * @brief Item of the record being visited
+     */
+    struct VisitItem {
+        DataItemDescription *m_pDescription;
+        long m_nOffset;
+        long m_nLength;
+    };
+
+    /**
+     * @brief Items and fields of the record being visited, kept to reuse their storage
+     */
+    std::vector<VisitItem> m_vVisitItems;
+    std::vector<ItemField> m_vVisitFields;
 };
 
 #endif /* INPUTPARSER_H_ */
@@ -0,0 +1,510 @@
+/*
+ *  Copyright (c) 2013 Croatia Control Ltd. (www.crocontrol.hr)
+ *
+ *  This file is part of Asterix.
+ *
+ *  Asterix is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Asterix is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Asterix.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * AUTHORS: Damir Salantic, Croatia Control Ltd.
+ *
+ */
+
+#include "ItemProgram.h"
+#include "DataItemFormatFixed.h"
+#include "DataItemBits.h"
+#include <utility>
+
+// same limit as DataItemFormatRepetitive::getLength()
+static const long MAX_REPETITIVE_ITEM_SIZE = 65536;
+
+uint64_t ItemField::getUnsigned() const {
+    const int nBits = getNBits();
+    if (nBits < 1 || nBits > 64) {
+        return 0;
+    }
+    // bytes of the part holding bits m_nTo down to m_nFrom
+    const int first = m_nPartLength - 1 - (m_nTo - 1) / 8;
+    const int last = m_nPartLength - 1 - (m_nFrom - 1) / 8;
+    const int shift = (m_nFrom - 1) % 8;
+    const bool bNineBytes = last - first >= 8;
+
+    uint64_t value = 0;
+    for (int i = bNineBytes ? last - 7 : first; i <= last; i++) {
+        value = (value << 8) | m_pPart[i];
+    }
+    value >>= shift;
+    if (bNineBytes) {
+        value |= static_cast<uint64_t>(m_pPart[first]) << (64 - shift);
+    }
+    if (nBits < 64) {
+        value &= (static_cast<uint64_t>(1) << nBits) - 1;
+    }
+    return value;
+}
+
+int64_t ItemField::getSigned() const {
+    const int nBits = getNBits();
+    uint64_t value = getUnsigned();
+    if (nBits < 64 && ((value >> (nBits - 1)) & 1)) {
+        value |= ~((static_cast<uint64_t>(1) << nBits) - 1);
+    }
+    return static_cast<int64_t>(value);
+}
+
+bool ItemField::isSigned() const {
+    return m_pBits->m_eEncoding == DataItemBits::DATAITEM_ENCODING_SIGNED;
+}
+
+double ItemField::getValue() const {
+    const double value = isSigned() ? static_cast<double>(getSigned()) : static_cast<double>(getUnsigned());
+    return m_pBits->m_dScale != 0 ? value * m_pBits->m_dScale : value;
+}
+
+const char *ItemField::getMeaning() const {
+    return m_pBits->getValueDescription(getUnsigned());
+}
+
+/**
+ * Emits the instructions of one format tree, walking it as the getLength()
+ * and getText() methods of the format classes do.
+ */
+class ItemProgram::Compiler {
+public:
+    Compiler(ItemProgram &program, std::vector<ItemInstruction> &code, bool bDecode)
+            : m_program(program), m_code(code), m_bDecode(bDecode), m_nRegisters(0) {
+    }
+
+    bool compile(DataItemFormat *pFormat) {
+        if (!item(pFormat)) {
+            return false;
+        }
+        emit(OP_END);
+        return true;
+    }
+
+private:
+    size_t emit(Op op, int reg = 0, int arg = 0, unsigned char mask = 0, int jump = 0) {
+        m_code.push_back({static_cast<unsigned char>(op), static_cast<unsigned char>(reg), mask, arg, jump});
+        return m_code.size() - 1;
+    }
+
+    // jump of instruction at to the next instruction emitted
+    void patch(size_t at) { m_code[at].m_nJump = static_cast<int>(m_code.size()); }
+
+    bool allocRegister(int &reg) {
+        if (m_nRegisters >= MAX_REGISTERS) {
+            return false;
+        }
+        reg = m_nRegisters++;
+        return true;
+    }
+
+    void releaseRegister() { m_nRegisters--; }
+
+    static bool isFrozenPart(const DataItemFormat *pFormat) {
+        return pFormat != nullptr && pFormat->isFixed() &&
+               static_cast<const DataItemFormatFixed *>(pFormat)->hasFrozenMasks() &&
+               static_cast<const DataItemFormatFixed *>(pFormat)->m_nLength > 0;
+    }
+
+    void fields(const DataItemFormatFixed *pFixed, int reg, int partLength) {
+        std::vector<DataItemFormat *> buffer;
+        for (const auto *subItem : pFixed->getSubItems(buffer)) {
+            if (subItem == nullptr || !subItem->isBits()) {
+                continue;
+            }
+            const auto *bits = static_cast<const DataItemBits *>(subItem);
+            int from = bits->m_nFrom;
+            int to = bits->m_nTo;
+            if (from > to) {
+                std::swap(from, to);
+            }
+            if (from < 1 || to > partLength * 8) {
+                continue;
+            }
+            m_program.m_vFields.push_back({bits, from, to});
+            emit(OP_FIELD, reg, static_cast<int>(m_program.m_vFields.size() - 1), 0, partLength);
+        }
+    }
+
+    bool item(DataItemFormat *pFormat) {
+        if (pFormat == nullptr) {
+            return false;
+        }
+        if (pFormat->isFixed()) {
+            return fixed(static_cast<DataItemFormatFixed *>(pFormat));
+        }
+        if (pFormat->isVariable()) {
+            return variable(pFormat);
+        }
+        if (pFormat->isCompound()) {
+            return compound(pFormat);
+        }
+        if (pFormat->isRepetitive()) {
+            return repetitive(pFormat);
+        }
+        if (pFormat->isExplicit()) {
+            return explicitItem(pFormat);
+        }
+        if (pFormat->isBDS()) {
+            return bds(pFormat);
+        }
+        return false;
+    }
+
+    bool fixed(const DataItemFormatFixed *pFixed) {
+        if (pFixed->m_nLength <= 0) {
+            return false;
+        }
+        if (!m_bDecode) {
+            emit(OP_ADVANCE, 0, pFixed->m_nLength);
+            return true;
+        }
+        int reg;
+        if (!allocRegister(reg)) {
+            return false;
+        }
+        emit(OP_MARK, reg);
+        emit(OP_ADVANCE, 0, pFixed->m_nLength);
+        fields(pFixed, reg, pFixed->m_nLength);
+        releaseRegister();
+        return true;
+    }
+
+    // parts follow while FX bit is set, the last part repeats
+    bool variable(const DataItemFormat *pFormat) {
+        std::vector<DataItemFormat *> buffer;
+        const std::vector<DataItemFormat *> &parts = pFormat->getSubItems(buffer);
+        if (parts.empty()) {
+            return false;
+        }
+        for (const auto *part : parts) {
+            if (!isFrozenPart(part)) {
+                return false;
+            }
+        }
+        int reg;
+        if (!allocRegister(reg)) {
+            return false;
+        }
+        std::vector<size_t> toEnd;
+        for (size_t i = 0; i < parts.size(); i++) {
+            const auto *pFixed = static_cast<const DataItemFormatFixed *>(parts[i]);
+            const int start = static_cast<int>(m_code.size());
+            emit(OP_MARK, reg);
+            emit(OP_ADVANCE, 0, pFixed->m_nLength);
+            if (m_bDecode) {
+                fields(pFixed, reg, pFixed->m_nLength);
+            }
+            if (i + 1 < parts.size()) {
+                toEnd.push_back(pFixed->getFXMask() != 0
+                                ? emit(OP_JUMP_IF_CLEAR, reg, pFixed->getFXByte(), pFixed->getFXMask())
+                                : emit(OP_JUMP));
+            } else if (pFixed->getFXMask() != 0) {
+                emit(OP_JUMP_IF_SET, reg, pFixed->getFXByte(), pFixed->getFXMask(), start);
+            }
+        }
+        for (size_t at : toEnd) {
+            patch(at);
+        }
+        releaseRegister();
+        return true;
+    }
+
+    // primary part, then secondary parts whose presence bit is set in the primary
+    bool compound(const DataItemFormat *pFormat) {
+        std::vector<DataItemFormat *> buffer;
+        const std::vector<DataItemFormat *> &subItems = pFormat->getSubItems(buffer);
+        if (subItems.size() < 2 || subItems[0] == nullptr || !subItems[0]->isVariable()) {
+            return false;
+        }
+        int primary;
+        if (!allocRegister(primary)) {
+            return false;
+        }
+        emit(OP_MARK, primary);
+        if (!variable(subItems[0])) {
+            return false;
+        }
+
+        std::vector<DataItemFormat *> primaryBuffer;
+        const std::vector<DataItemFormat *> &parts = subItems[0]->getSubItems(primaryBuffer);
+        std::vector<size_t> toEnd;
+        int offset = 0;
+        for (size_t i = 0; i < parts.size(); i++) {
+            const auto *pFixed = static_cast<const DataItemFormatFixed *>(parts[i]);
+            for (size_t secondaryPart = 1; secondaryPart < subItems.size(); secondaryPart++) {
+                int bytenr;
+                unsigned char mask;
+                if (pFixed->getPresenceBit(static_cast<int>(secondaryPart), bytenr, mask)) {
+                    const size_t skip = emit(OP_JUMP_IF_CLEAR, primary, offset + bytenr, mask);
+                    if (!item(subItems[secondaryPart])) {
+                        return false;
+                    }
+                    patch(skip);
+                }
+            }
+            if (i + 1 < parts.size()) {
+                toEnd.push_back(pFixed->getFXMask() != 0
+                                ? emit(OP_JUMP_IF_CLEAR, primary, offset + pFixed->getFXByte(), pFixed->getFXMask())
+                                : emit(OP_JUMP));
+            }
+            offset += pFixed->m_nLength;
+        }
+        for (size_t at : toEnd) {
+            patch(at);
+        }
+        releaseRegister();
+        return true;
+    }
+
+    // repetition count, then count times the first sub-item
+    bool repetitive(const DataItemFormat *pFormat) {
+        const DataItemFormat *pElement = !pFormat->m_lSubItems.empty() ? pFormat->m_lSubItems.front() : nullptr;
+        if (pElement == nullptr) {
+            return false;
+        }
+        int elementLength;
+        if (pElement->isFixed()) {
+            elementLength = static_cast<const DataItemFormatFixed *>(pElement)->m_nLength;
+        } else if (pElement->isBDS()) {
+            elementLength = 8;
+        } else {
+            // length of other elements depends on data
+            return false;
+        }
+        if (elementLength <= 0) {
+            return false;
+        }
+        if (!m_bDecode) {
+            emit(OP_REPEAT_FIXED, 0, elementLength);
+            return true;
+        }
+        int counter;
+        if (!allocRegister(counter)) {
+            return false;
+        }
+        const size_t repeat = emit(OP_REPEAT, counter, elementLength);
+        const int loop = static_cast<int>(m_code.size());
+        if (!item(const_cast<DataItemFormat *>(pElement))) {
+            return false;
+        }
+        emit(OP_LOOP, counter, 0, 0, loop);
+        patch(repeat);
+        releaseRegister();
+        return true;
+    }
+
+    // length byte, then the sub-items repeated up to the length
+    bool explicitItem(const DataItemFormat *pFormat) {
+        if (!m_bDecode) {
+            emit(OP_EXPLICIT);
+            return true;
+        }
+        std::vector<DataItemFormat *> buffer;
+        const std::vector<DataItemFormat *> &subItems = pFormat->getSubItems(buffer);
+        if (subItems.empty()) {
+            return false;
+        }
+        int end;
+        if (!allocRegister(end)) {
+            return false;
+        }
+        const size_t begin = emit(OP_EXPLICIT_BEGIN, end);
+        const int loop = static_cast<int>(m_code.size());
+        for (auto *subItem : subItems) {
+            if (!item(subItem)) {
+                return false;
+            }
+        }
+        emit(OP_EXPLICIT_LOOP, end, 0, 0, loop);
+        patch(begin);
+        releaseRegister();
+        return true;
+    }
+
+    // 8 bytes, fields of the register selected by the last byte
+    bool bds(const DataItemFormat *pFormat) {
+        if (!m_bDecode) {
+            emit(OP_ADVANCE, 0, 8);
+            return true;
+        }
+        int reg;
+        if (!allocRegister(reg)) {
+            return false;
+        }
+        emit(OP_MARK, reg);
+        emit(OP_ADVANCE, 0, 8);
+        std::vector<DataItemFormat *> buffer;
+        std::vector<size_t> toEnd;
+        for (const auto *subItem : pFormat->getSubItems(buffer)) {
+            if (subItem == nullptr || !subItem->isFixed()) {
+                return false;
+            }
+            const auto *pFixed = static_cast<const DataItemFormatFixed *>(subItem);
+            const bool bAny = pFixed->m_nID == 0;
+            const size_t skip = bAny ? 0 : emit(OP_BDS_SKIP, reg, pFixed->m_nID);
+            fields(pFixed, reg, 8);
+            if (bAny) {
+                break;
+            }
+            toEnd.push_back(emit(OP_JUMP));
+            patch(skip);
+        }
+        for (size_t at : toEnd) {
+            patch(at);
+        }
+        releaseRegister();
+        return true;
+    }
+
+    ItemProgram &m_program;
+    std::vector<ItemInstruction> &m_code;
+    const bool m_bDecode;
+    int m_nRegisters;
+};
+
+std::unique_ptr<ItemProgram> ItemProgram::compile(DataItemFormat *pFormat) {
+    if (pFormat == nullptr || !pFormat->m_bFrozen) {
+        return nullptr;
+    }
+    std::unique_ptr<ItemProgram> program(new ItemProgram());
+    if (!Compiler(*program, program->m_vLength, false).compile(pFormat) ||
+        !Compiler(*program, program->m_vDecode, true).compile(pFormat)) {
+        return nullptr;
+    }
+    return program;
+}
+
+long ItemProgram::run(const ItemInstruction *pProgram, const unsigned char *pData, long len,
+                      std::vector<ItemField> *pFields) const {
+    long reg[MAX_REGISTERS];
+    long pos = 0;
+    const ItemInstruction *pc = pProgram;
+
+    for (;;) {
+        const ItemInstruction &in = *pc++;
+        switch (in.m_nOp) {
+            case OP_END:
+                return pos;
+            case OP_MARK:
+                reg[in.m_nReg] = pos;
+                break;
+            case OP_ADVANCE:
+                pos += in.m_nArg;
+                if (pos > len) {
+                    return pos;
+                }
+                break;
+            case OP_JUMP:
+                pc = pProgram + in.m_nJump;
+                break;
+            case OP_JUMP_IF_CLEAR:
+                if (!(pData[reg[in.m_nReg] + in.m_nArg] & in.m_nMask)) {
+                    pc = pProgram + in.m_nJump;
+                }
+                break;
+            case OP_JUMP_IF_SET:
+                if (pData[reg[in.m_nReg] + in.m_nArg] & in.m_nMask) {
+                    pc = pProgram + in.m_nJump;
+                }
+                break;
+            case OP_REPEAT_FIXED: {
+                if (pos >= len) {
+                    return pos + 1;
+                }
+                const long total = 1 + static_cast<long>(pData[pos]) * in.m_nArg;
+                if (total > MAX_REPETITIVE_ITEM_SIZE) {
+                    return 0;
+                }
+                pos += total;
+                if (pos > len) {
+                    return pos;
+                }
+                break;
+            }
+            case OP_REPEAT:
+                if (pos >= len) {
+                    return pos + 1;
+                }
+                reg[in.m_nReg] = pData[pos++];
+                if (1 + reg[in.m_nReg] * in.m_nArg > MAX_REPETITIVE_ITEM_SIZE) {
+                    return 0;
+                }
+                if (reg[in.m_nReg] == 0) {
+                    pc = pProgram + in.m_nJump;
+                }
+                break;
+            case OP_LOOP:
+                if (--reg[in.m_nReg] > 0) {
+                    pc = pProgram + in.m_nJump;
+                }
+                break;
+            case OP_EXPLICIT:
+                if (pos >= len) {
+                    return pos + 1;
+                }
+                if (pData[pos] == 0) {
+                    return 0;
+                }
+                pos += pData[pos];
+                if (pos > len) {
+                    return pos;
+                }
+                break;
+            case OP_EXPLICIT_BEGIN:
+                if (pos >= len) {
+                    return pos + 1;
+                }
+                if (pData[pos] == 0) {
+                    return 0;
+                }
+                reg[in.m_nReg] = pos + pData[pos];
+                if (reg[in.m_nReg] > len) {
+                    return reg[in.m_nReg];
+                }
+                if (pData[pos] == 1) {
+                    // no body
+                    pos = reg[in.m_nReg];
+                    pc = pProgram + in.m_nJump;
+                } else {
+                    pos++;
+                }
+                break;
+            case OP_EXPLICIT_LOOP:
+                if (pos < reg[in.m_nReg]) {
+                    pc = pProgram + in.m_nJump;
+                } else if (pos > reg[in.m_nReg]) {
+                    // body does not fit the explicit length
+                    return 0;
+                }
+                break;
+            case OP_BDS_SKIP:
+                if (pData[reg[in.m_nReg] + 7] != in.m_nArg) {
+                    pc = pProgram + in.m_nJump;
+                }
+                break;
+            case OP_FIELD:
+                if (pFields != nullptr) {
+                    const FieldSpec &field = m_vFields[in.m_nArg];
+                    pFields->push_back({field.m_pBits, pData + reg[in.m_nReg], in.m_nJump, field.m_nFrom,
+                                        field.m_nTo});
+                }
+                break;
+            default:
+                return 0;
+        }
+    }
+}
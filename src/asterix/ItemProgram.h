@@ -0,0 +1,223 @@
+/*
+ *  Copyright (c) 2013 Croatia Control Ltd. (www.crocontrol.hr)
+ *
+ *  This file is part of Asterix.
+ *
+ *  Asterix is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Asterix is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Asterix.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * AUTHORS: Damir Salantic, Croatia Control Ltd.
+ *
+ */
+
+/**
+ * @file ItemProgram.h
+ * @brief Data item definitions compiled into linear programs
+ *
+ * The DataItemFormat tree of an item (Fixed, Variable, Compound, Repetitive,
+ * Explicit, BDS) is walked once per item with virtual calls and recursion.
+ * ItemProgram flattens the tree of one item into a short list of
+ * instructions (advance N bytes, test FX or presence bit and jump, read
+ * repetition count, read explicit length, emit field) which one loop
+ * executes without virtual dispatch or recursion. Programs are compiled
+ * when a category is frozen (Category::freeze()).
+ */
+
+#ifndef ITEMPROGRAM_H_
+#define ITEMPROGRAM_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class DataItemBits;
+class DataItemFormat;
+
+/**
+ * @struct ItemField
+ * @brief Bit field of a decoded item, as emitted by ItemProgram::decode()
+ *
+ * Points into the decoded data, so it is valid as long as that data is.
+ */
+struct ItemField {
+    /**
+     * @brief Definition of the field
+     */
+    const DataItemBits *m_pBits;
+
+    /**
+     * @brief First byte and length of the fixed part holding the field
+     */
+    const unsigned char *m_pPart;
+    int m_nPartLength;
+
+    /**
+     * @brief Bit range in the part, 1 is the last bit of the part, m_nFrom <= m_nTo
+     */
+    int m_nFrom;
+    int m_nTo;
+
+    int getNBits() const { return m_nTo - m_nFrom + 1; }
+
+    /**
+     * @brief True if the field is encoded as two's complement (DATAITEM_ENCODING_SIGNED)
+     */
+    bool isSigned() const;
+
+    /**
+     * @brief Raw value of the field, 0 if it has more than 64 bits
+     */
+    uint64_t getUnsigned() const;
+
+    /**
+     * @brief Raw value of the field as two's complement, 0 if it has more than 64 bits
+     */
+    int64_t getSigned() const;
+
+    /**
+     * @brief Value of the field by its encoding (signed or unsigned) multiplied by its scale
+     */
+    double getValue() const;
+
+    /**
+     * @brief Description of the raw value from the definition, nullptr if none
+     */
+    const char *getMeaning() const;
+};
+
+/**
+ * @struct ItemInstruction
+ * @brief One instruction of an ItemProgram, see ItemProgram::Op for the operands
+ */
+struct ItemInstruction {
+    unsigned char m_nOp;
+    unsigned char m_nReg;
+    unsigned char m_nMask;
+    int m_nArg;
+    int m_nJump;
+};
+
+/**
+ * @class ItemProgram
+ * @brief Linear program of one data item definition
+ *
+ * Each item gets two programs: one only computing the item length, one also
+ * emitting its bit fields. Both work on a byte position in the item and a
+ * few registers holding positions or counters of enclosing parts.
+ *
+ * Lengths are the same as DataItemFormat::getLength() returns. Unlike the
+ * format classes the programs never read beyond the data passed, and stop
+ * with the length needed so far instead.
+ *
+ * @par Thread Safety
+ * Programs are not changed after compile(), so they can be run from several
+ * threads at the same time.
+ */
+class ItemProgram {
+public:
+    /**
+     * @brief Operations, pos is the byte position in the item and reg[] the registers
+     */
+    enum Op : unsigned char {
+        OP_END,               //!< item ends at pos
+        OP_MARK,              //!< reg[m_nReg] = pos
+        OP_ADVANCE,           //!< pos += m_nArg
+        OP_JUMP,              //!< continue at m_nJump
+        OP_JUMP_IF_CLEAR,     //!< if !(data[reg[m_nReg] + m_nArg] & m_nMask) continue at m_nJump
+        OP_JUMP_IF_SET,       //!< if (data[reg[m_nReg] + m_nArg] & m_nMask) continue at m_nJump
+        OP_REPEAT_FIXED,      //!< pos += 1 + data[pos] * m_nArg
+        OP_REPEAT,            //!< reg[m_nReg] = data[pos++], if 0 continue at m_nJump
+        OP_LOOP,              //!< if --reg[m_nReg] > 0 continue at m_nJump
+        OP_EXPLICIT,          //!< pos += data[pos]
+        OP_EXPLICIT_BEGIN,    //!< reg[m_nReg] = pos + data[pos], pos++, if no body continue at m_nJump
+        OP_EXPLICIT_LOOP,     //!< if pos < reg[m_nReg] continue at m_nJump
+        OP_BDS_SKIP,          //!< if data[reg[m_nReg] + 7] != m_nArg continue at m_nJump
+        OP_FIELD              //!< emit field m_nArg of part at reg[m_nReg] with length m_nJump
+    };
+
+    /**
+     * @brief Registers available to a program (nesting depth of parts)
+     */
+    static constexpr int MAX_REGISTERS = 16;
+
+    /**
+     * @brief Compile the definition of an item
+     *
+     * @param pFormat Frozen format of the item (DataItemFormat::freeze())
+     * @return Program, or nullptr if the definition cannot be compiled
+     *         (e.g. erroneous bits, parts not frozen, nesting too deep).
+     *         Such items are decoded by the format classes only.
+     */
+    static std::unique_ptr<ItemProgram> compile(DataItemFormat *pFormat);
+
+    /**
+     * @brief Get length of the item at pData
+     *
+     * @param pData Item data
+     * @param len   Bytes available at pData
+     * @return Item length; more than len if the item does not fit (bytes needed
+     *         as far as known); 0 if the length cannot be told by the program
+     *         (zero explicit length, repetitive item above maximum size), in
+     *         which case DataItemFormat::getLength() reports the error.
+     */
+    long getLength(const unsigned char *pData, long len) const {
+        return run(m_vLength.data(), pData, len, nullptr);
+    }
+
+    /**
+     * @brief Decode the item at pData into its bit fields
+     *
+     * Fields of all parts (including FX and presence bits) are appended in
+     * data order, for repetitive and explicit items once per repetition, for
+     * BDS items those of the selected register. Fields not within their part
+     * are left out.
+     *
+     * @param pData  Item data
+     * @param len    Bytes available at pData
+     * @param fields Appended fields, reuse to avoid allocations
+     * @return Item length as getLength(), or 0 if the item is malformed
+     *         (explicit length not matching its body)
+     */
+    long decode(const unsigned char *pData, long len, std::vector<ItemField> &fields) const {
+        return run(m_vDecode.data(), pData, len, &fields);
+    }
+
+    /**
+     * @brief Instructions of the length and decode programs
+     */
+    const std::vector<ItemInstruction> &getLengthProgram() const { return m_vLength; }
+    const std::vector<ItemInstruction> &getDecodeProgram() const { return m_vDecode; }
+
+private:
+    struct FieldSpec {
+        const DataItemBits *m_pBits;
+        int m_nFrom;
+        int m_nTo;
+    };
+
+    class Compiler;
+
+    long run(const ItemInstruction *pProgram, const unsigned char *pData, long len,
+             std::vector<ItemField> *pFields) const;
+
+    std::vector<ItemInstruction> m_vLength;
+    std::vector<ItemInstruction> m_vDecode;
+
+    /**
+     * @brief Fields referenced by OP_FIELD
+     */
+    std::vector<FieldSpec> m_vFields;
+};
+
+#endif /* ITEMPROGRAM_H_ */
@@ -34,6 +34,9 @@
 #define UAP_H_
 
 #include "UAPItem.h"
+#include <vector>
+
+class DataItemDescription;
 
 /**
  * @class UAP
@@ -157,6 +160,14 @@ public:
      */
     std::list<UAPItem *> m_lUAPItems;
 
+    /**
+     * @brief Data item description of each FRN, built by Category::freeze()
+     *
+     * Indexed by FRN (index 0 unused), nullptr if no item is defined for FRN.
+     * Descriptions are owned by the Category.
+     */
+    std::vector<DataItemDescription *> m_vFRNItems;
+
     /**
      * @brief Create and add a new UAP item to this UAP
      *
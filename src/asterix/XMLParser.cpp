@@ -23,8 +23,11 @@
 
 #include "XMLParser.h"
 #include "Tracer.h"
+#include <algorithm>
+#include <atomic>
 #include <cstdio>
 #include <cstring>
+#include <thread>
 
 /*!
  * Handling of CDATA
@@ -546,7 +549,11 @@ void XMLParser::handleUAPItemStart(const char **attr) {
 
 void XMLParser::handleCategoryEnd() {
     if (m_pCategory) {
-        m_pDef->setCategory(m_pCategory);
+        if (m_pCategories) {
+            m_pCategories->push_back(m_pCategory);
+        } else {
+            m_pDef->setCategory(m_pCategory);
+        }
         m_pCategory = nullptr;
     } else {
         Error("Closing unopened tag: ", "Category");
@@ -737,7 +744,8 @@ void XMLParser::ElementHandlerEnd(void *data, const char *el) {
  */
 XMLParser::XMLParser()
         : m_bErrorDetectedStopParsing(false), m_pDef(nullptr), m_pCategory(nullptr), m_pDataItem(nullptr), m_pFormat(nullptr),
-          m_pBitsValue(nullptr), m_pUAPItem(nullptr), m_pUAP(nullptr), m_pstrCData(nullptr), m_pintCData(nullptr), m_pFileName(nullptr) {
+          m_pBitsValue(nullptr), m_pUAPItem(nullptr), m_pUAP(nullptr), m_pstrCData(nullptr), m_pintCData(nullptr), m_pFileName(nullptr),
+          m_pCategories(nullptr) {
     m_Parser = XML_ParserCreate(nullptr);
     if (!m_Parser) {
 #ifdef PYTHON_WRAPPER
@@ -765,6 +773,55 @@ XMLParser::~XMLParser() {
 /*!
  * Parse XML file and fill definition object
  */
+namespace {
+    struct SCategoryId {
+        XML_Parser parser;
+        int id;
+    };
+
+    void XMLCALL CategoryIdHandler(void *data, const char *el, const char **attr) {
+        auto *pCategoryId = static_cast<SCategoryId *>(data);
+        if (strcmp(el, "Category") == 0) {
+            for (int i = 0; attr[i]; i += 2) {
+                if (strcmp(attr[i], "id") == 0) {
+                    const int id = strcmp(attr[i + 1], "BDS") == 0 ? BDS_CAT_ID : atoi(attr[i + 1]);
+                    if (id >= 0 && id < MAX_CATEGORIES) {
+                        pCategoryId->id = id;
+                    }
+                }
+            }
+        }
+        // the Category element is the root, nothing else to look for
+        XML_StopParser(pCategoryId->parser, XML_FALSE);
+    }
+}
+
+int XMLParser::ReadCategoryId(const char *filename) {
+    FILE *pFile = fopen(filename, "rt");
+    if (pFile == nullptr) {
+        return -1;
+    }
+    SCategoryId categoryId = {XML_ParserCreate(nullptr), -1};
+    if (categoryId.parser == nullptr) {
+        fclose(pFile);
+        return -1;
+    }
+    XML_SetUserData(categoryId.parser, &categoryId);
+    XML_SetStartElementHandler(categoryId.parser, CategoryIdHandler);
+
+    char buffer[BUFFSIZE];
+    while (true) {
+        const int len = static_cast<int>(fread(buffer, 1, sizeof(buffer), pFile));
+        const int done = feof(pFile) || ferror(pFile);
+        if (XML_Parse(categoryId.parser, buffer, len, done) != XML_STATUS_OK || done) {
+            break;
+        }
+    }
+    XML_ParserFree(categoryId.parser);
+    fclose(pFile);
+    return categoryId.id;
+}
+
 bool XMLParser::Parse(FILE *pFile, AsterixDefinition *pDefinition, const char *filename) {
     m_pDef = pDefinition;
     m_pFileName = filename;
@@ -797,3 +854,97 @@ bool XMLParser::Parse(FILE *pFile, AsterixDefinition *pDefinition, const char *f
 
     return !m_bErrorDetectedStopParsing;
 }
+
+bool XMLParser::ParseCategories(FILE *pFile, AsterixDefinition *pDefinition, const char *filename,
+                                std::vector<Category *> &categories) {
+    m_pCategories = &categories;
+    const bool ok = Parse(pFile, pDefinition, filename);
+    m_pCategories = nullptr;
+    return ok;
+}
+
+namespace {
+    struct SParsedFile {
+        std::vector<Category *> categories;
+        bool ok;
+    };
+
+    SParsedFile parseFile(const std::string &file, AsterixDefinition *pDefinition) {
+        SParsedFile parsed = {{}, false};
+        FILE *fp = fopen(file.c_str(), "rt");
+        if (fp == nullptr) {
+            Tracer::Error("Failed to open definitions file: %s", file.c_str());
+            return parsed;
+        }
+        XMLParser parser;
+        parsed.ok = parser.ParseCategories(fp, pDefinition, file.c_str(), parsed.categories);
+        fclose(fp);
+        if (!parsed.ok) {
+            Tracer::Error("Failed to parse definitions file: %s", file.c_str());
+        }
+        for (Category *pCategory : parsed.categories) {
+            pDefinition->freezeCategory(pCategory);
+        }
+        return parsed;
+    }
+}
+
+bool XMLParser::ParseFiles(const std::vector<std::string> &files, AsterixDefinition *pDefinition,
+                           unsigned int nThreads) {
+    bool ok = true;
+    std::vector<size_t> pending;
+    for (size_t i = 0; i < files.size(); i++) {
+        if (ReadCategoryId(files[i].c_str()) == BDS_CAT_ID) {
+            FILE *fp = fopen(files[i].c_str(), "rt");
+            if (fp == nullptr) {
+                Tracer::Error("Failed to open definitions file: %s", files[i].c_str());
+                ok = false;
+                continue;
+            }
+            XMLParser parser;
+            if (!parser.Parse(fp, pDefinition, files[i].c_str())) {
+                Tracer::Error("Failed to parse definitions file: %s", files[i].c_str());
+                ok = false;
+            }
+            fclose(fp);
+        } else {
+            pending.push_back(i);
+        }
+    }
+
+#ifdef PYTHON_WRAPPER
+    // errors are raised as Python exceptions, which needs the interpreter lock
+    nThreads = 1;
+#endif
+    if (nThreads == 0) {
+        nThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    nThreads = static_cast<unsigned int>(std::min<size_t>(nThreads, pending.size()));
+
+    // files are taken in list order, each result is written by one thread only
+    std::vector<SParsedFile> parsed(pending.size());
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        size_t n;
+        while ((n = next.fetch_add(1)) < pending.size()) {
+            parsed[n] = parseFile(files[pending[n]], pDefinition);
+        }
+    };
+    Tracer::GetLogLevel(); // create the tracer before threads report errors
+    std::vector<std::thread> threads;
+    for (unsigned int i = 1; i < nThreads; i++) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    for (SParsedFile &file : parsed) {
+        for (Category *pCategory : file.categories) {
+            pDefinition->setCategory(pCategory);
+        }
+        ok = ok && file.ok;
+    }
+    return ok;
+}
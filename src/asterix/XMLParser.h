@@ -137,6 +137,8 @@
 #ifndef XMLPARSER_H_
 #define XMLPARSER_H_
 
+#include <string>
+#include <vector>
 #include "AsterixDefinition.h"
 #include "expat.h"
 #include "DataItemFormatFixed.h"
@@ -347,6 +349,53 @@ public:
      */
     bool Parse(FILE *pFile, AsterixDefinition *pDefinition, const char *filename);
 
+    /**
+     * @brief Read the category number of a definition file without parsing it
+     *
+     * Reads the file only up to its Category element, e.g. to register it
+     * for loading on first use (AsterixDefinition::registerCategoryFile()).
+     *
+     * @param filename Path of the XML category file
+     * @return Category number (BDS_CAT_ID for BDS definitions), or -1 if the
+     *         file cannot be read or has no valid Category element
+     */
+    static int ReadCategoryId(const char *filename);
+
+    /**
+     * @brief Parse ASTERIX category definitions from XML file without adding them
+     *
+     * As Parse(), but parsed categories are appended to categories (owned by
+     * the caller, e.g. to pass them to AsterixDefinition::setCategory()).
+     * pDefinition is only read, for the BDS registers of BDS formats, so
+     * files can be parsed in parallel, each by its own XMLParser.
+     *
+     * @param pFile Open file pointer to XML category file (must be readable)
+     * @param pDefinition Definitions providing BDS registers
+     * @param filename Filename for error reporting
+     * @param categories [out] Categories defined in the file
+     * @return true if parsing succeeded without errors
+     */
+    bool ParseCategories(FILE *pFile, AsterixDefinition *pDefinition, const char *filename,
+                         std::vector<Category *> &categories);
+
+    /**
+     * @brief Parse definition files in parallel and add their categories
+     *
+     * BDS register files are parsed first, since other categories copy their
+     * registers. The other files are parsed on a pool of threads, each file
+     * into its own categories, which are frozen by the parsing thread
+     * (AsterixDefinition::freezeCategory()) and then set in the order of the
+     * files, as if the files were parsed one after another with Parse().
+     *
+     * @param files Paths of the XML category files
+     * @param pDefinition AsterixDefinition container to store parsed categories
+     * @param nThreads Number of threads (0 = number of cores)
+     * @return false if a file cannot be opened or parsed (its categories
+     *         parsed without error are still added)
+     */
+    static bool ParseFiles(const std::vector<std::string> &files, AsterixDefinition *pDefinition,
+                           unsigned int nThreads = 0);
+
     bool m_bErrorDetectedStopParsing; //!< Flag set to true when parsing error occurs (stops further processing)
 
     AsterixDefinition *m_pDef; //!< Pointer to AsterixDefinition container (non-owning)
@@ -549,6 +598,8 @@ public:
 private:
     XML_Parser m_Parser; //!< Expat XML parser instance (created during Parse())
 
+    std::vector<Category *> *m_pCategories; //!< Parsed categories are added here if set (ParseCategories())
+
     char m_pBuff[BUFFSIZE]; //!< Buffer for reading XML file in chunks (8 KB)
 
     /**
@@ -32,28 +32,7 @@
   #define read _read
   #define write _write
   #define getpid _getpid
-
-  // Windows compatibility layer for POSIX time functions
-  typedef unsigned long useconds_t;
-
-  inline int gettimeofday(struct timeval* tp, void* tzp) {
-    FILETIME ft;
-    GetSystemTimeAsFileTime(&ft);
-
-    unsigned long long t = (static_cast<unsigned long long>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime;
-    t -= 116444736000000000ULL;
-    t /= 10;
-
-    tp->tv_sec = static_cast<long>(t / 1000000UL);
-    tp->tv_usec = static_cast<long>(t % 1000000UL);
-    return 0;
-  }
-
-  inline void usleep(useconds_t usec) {
-    Sleep(static_cast<DWORD>(usec / 1000));
-  }
 #else
-  #include <sys/time.h>
   #include <unistd.h>
 #endif
 #include "asterix.h"
@@ -65,12 +44,11 @@
 #include "InputParser.h"
 
 extern bool gSynchronous;
+extern double gReplaySpeed;
 
 bool CAsterixFinalSubformat::ReadPacket(CBaseFormatDescriptor &formatDescriptor, CBaseDevice &device, [[maybe_unused]] bool &discard) {
     struct sFinalRecordHeader finalRecordHeader;
     char padding[4];
-    static unsigned long lastFileTimeMSec = 0;
-    static unsigned long lastMyTimeMSec = 0;
 
     auto &Descriptor = static_cast<CAsterixFormatDescriptor &>(formatDescriptor);
 
@@ -99,21 +77,7 @@ bool CAsterixFinalSubformat::ReadPacket(CBaseFormatDescriptor &formatDescriptor,
     }
 
     if (gSynchronous) { // In synchronous mode make delays between packets to simulate real tempo
-        struct timeval currTime;
-        if (gettimeofday(&currTime, nullptr) == 0) {
-            unsigned int currTimeMsec = currTime.tv_sec * 1000 + currTime.tv_usec / 1000;
-            if (lastMyTimeMSec != 0 && lastFileTimeMSec != 0) {
-                unsigned int diffFile = nTimestamp - lastFileTimeMSec;
-                unsigned int diffMy = currTimeMsec - lastMyTimeMSec;
-
-                if (diffFile > diffMy) { // sleep for a time difference
-                    usleep((diffFile - diffMy) * 1000);
-                }
-            }
-
-            lastFileTimeMSec = nTimestamp;
-            lastMyTimeMSec = currTimeMsec;
-        }
+        Descriptor.WaitForReplay(nTimestamp / 1000.0, gReplaySpeed, device.GetFileName());
     }
 
     unsigned char *pBuffer = Descriptor.GetNewBuffer(neededLen);
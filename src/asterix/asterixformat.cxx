@@ -24,6 +24,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <memory>
+#include <vector>
 #ifdef _WIN32
   #include <io.h>
   #include <process.h>
@@ -46,10 +47,43 @@
 #include "asterixformatdescriptor.hxx"
 #include "asterixhdlcsubformat.hxx"
 #include "asterixgpssubformat.hxx"
+#include "definitioncache.hxx"
+#include "definitionreloader.hxx"
 
 #include "Tracer.h"
 #include "XMLParser.h"
 
+extern bool gValidate;
+
+namespace {
+    /*
+     * Validate data of raw or PCAP packet (--validate), packet is not decoded
+     */
+    bool validatePacket(CBaseFormatDescriptor &formatDescriptor, CBaseDevice &device, bool pcap) {
+        auto &Descriptor = static_cast<CAsterixFormatDescriptor &>(formatDescriptor);
+        if (!gValidate || Descriptor.m_pPacketData == nullptr) {
+            return true;
+        }
+
+        if (!Descriptor.m_pValidator) {
+            const char *name = device.GetFileName();
+            Descriptor.m_pValidator = std::make_unique<CAsterixValidator>(Descriptor.m_pDefinition,
+                                                                          name ? name : "input");
+        }
+
+        // PCAP errors are located by packet number, raw file errors by file offset
+        const unsigned int len = Descriptor.m_nPacketDataLen;
+        if (Descriptor.m_pValidator->Validate(Descriptor.m_pPacketData, len, pcap ? Descriptor.m_nPcapPacketNo : 0) > 0 &&
+            !pcap && !device.IsPacketDevice()) {
+            int64_t position = 0;
+            if (device.IoCtrl(CBaseDevice::EGetPosition, &position, sizeof(position))) {
+                Descriptor.m_pValidator->SetInputOffset(position - len);
+            }
+        }
+        return true;
+    }
+}
+
 // Supported Asterix format names
 const char *CAsterixFormat::_FormatName[CAsterixFormat::ETotalFormats] =
         {
@@ -75,6 +109,13 @@ const char *CAsterixFormat::_FormatName[CAsterixFormat::ETotalFormats] =
 bool
 CAsterixFormat::ReadPacket(CBaseFormatDescriptor &formatDescriptor, CBaseDevice &device, const unsigned int formatType,
                            bool &discard) {
+    // data of the previous packet is no longer valid
+    auto &Descriptor = static_cast<CAsterixFormatDescriptor &>(formatDescriptor);
+    Descriptor.UpdateDefinition();
+    Descriptor.m_pPacketData = nullptr;
+    Descriptor.m_nPacketDataLen = 0;
+    Descriptor.m_PcapFrameHeader.clear();
+
     switch (formatType) {
         case ERaw:
             return CAsterixRawSubformat::ReadPacket(formatDescriptor, device, discard);
@@ -111,13 +152,13 @@ CAsterixFormat::WritePacket(CBaseFormatDescriptor &formatDescriptor, CBaseDevice
 
     switch (formatType) {
         case ERaw:
-            return CAsterixRawSubformat::WritePacket(formatDescriptor, device, discard); //TODO
+            return CAsterixRawSubformat::WritePacket(formatDescriptor, device, discard);
         case EPcap:
-            return CAsterixPcapSubformat::WritePacket(formatDescriptor, device, discard);//TODO
+            return CAsterixPcapSubformat::WritePacket(formatDescriptor, device, discard);
         case EOradisRaw:
-            return CAsterixRawSubformat::WritePacket(formatDescriptor, device, discard, true); //TODO
+            return CAsterixRawSubformat::WritePacket(formatDescriptor, device, discard, true);
         case EOradisPcap:
-            return CAsterixPcapSubformat::WritePacket(formatDescriptor, device, discard, true);//TODO
+            return CAsterixPcapSubformat::WritePacket(formatDescriptor, device, discard, true);
         case EFinal:
             return CAsterixFinalSubformat::WritePacket(formatDescriptor, device, discard); // TODO
         case EHDLC:
@@ -161,9 +202,11 @@ bool CAsterixFormat::ProcessPacket(CBaseFormatDescriptor &formatDescriptor, CBas
 
     switch (formatType) {
         case ERaw:
-            return CAsterixRawSubformat::ProcessPacket(formatDescriptor, device, discard);
+            return CAsterixRawSubformat::ProcessPacket(formatDescriptor, device, discard) &&
+                   validatePacket(formatDescriptor, device, false);
         case EPcap:
-            return CAsterixPcapSubformat::ProcessPacket(formatDescriptor, device, discard);
+            return CAsterixPcapSubformat::ProcessPacket(formatDescriptor, device, discard) &&
+                   validatePacket(formatDescriptor, device, true);
         case EOradisRaw:
             return CAsterixRawSubformat::ProcessPacket(formatDescriptor, device, discard, true);
         case EOradisPcap:
@@ -193,6 +236,9 @@ bool CAsterixFormat::HeartbeatProcessing(
         CBaseFormatDescriptor &formatDescriptor,
         CBaseDevice &device,
         const unsigned int formatType) {
+    // outputs of several inputs get no packets on this descriptor, reloaded definitions are taken here
+    static_cast<CAsterixFormatDescriptor &>(formatDescriptor).UpdateDefinition();
+
     switch (formatType) {
         case ERaw:
             return CAsterixRawSubformat::Heartbeat(formatDescriptor, device);
@@ -245,79 +291,146 @@ static void debug_trace(char const *format, ...) {
     LOGERROR(1, "%s", buffer);
 }
 
-CBaseFormatDescriptor *CAsterixFormat::CreateFormatDescriptor
-        ([[maybe_unused]] const unsigned int formatType, [[maybe_unused]] const char *sFormatDescriptor) {
-    if (!m_pFormatDescriptor) {
-        char inputFile[256];
+/*
+ * Load definitions listed in gAsterixDefinitionsFile, registered for loading
+ * on first use unless gEagerDefinitions is set
+ * @param bComplete [out] false if a definitions file could not be read
+ * @return nullptr if the list of definitions files cannot be read
+ */
+static AsterixDefinition *loadDefinitions(bool &bComplete) {
+    bComplete = true;
+    // Use unique_ptr for exception safety and clear ownership
+    auto pDefinition = std::make_unique<AsterixDefinition>();
+
+    char inputFile[256];
+
+    // open asterix.ini file
+    FILE *fpini = fopen(gAsterixDefinitionsFile, "rt");
+    if (!fpini) {
+        LOGERROR(1, "Failed to open definitions file");
+        return nullptr;
+    }
 
-        Tracer::Configure(debug_trace);
+    // extract ini file path
+    std::string strInifile = gAsterixDefinitionsFile;
+    std::string strInifilePath;
+    int index = strInifile.find_last_of('\\');
+    if (index < 0)
+        index = strInifile.find_last_of('/');
+    if (index > 0) {
+        strInifilePath = strInifile.substr(0, index + 1);
+    }
 
-        // initialize Fulliautomatix engine
-        // Use unique_ptr for exception safety and clear ownership
-        auto pDefinition = std::make_unique<AsterixDefinition>();
-
-        // open asterix.ini file
-        FILE *fpini = fopen(gAsterixDefinitionsFile, "rt");
-        if (!fpini) {
-            LOGERROR(1, "Failed to open definitions file");
-            return nullptr;  // unique_ptr handles cleanup
-        }
+    std::vector<std::string> definitionFiles;
+    while (fgets(inputFile, sizeof(inputFile), fpini)) {
+        std::string strInputFile;
 
-        // extract ini file path
-        std::string strInifile = gAsterixDefinitionsFile;
-        std::string strInifilePath;
-        int index = strInifile.find_last_of('\\');
-        if (index < 0)
-            index = strInifile.find_last_of('/');
-        if (index > 0) {
-            strInifilePath = strInifile.substr(0, index + 1);
+        // remove trailing /n from filename (strnlen for bounded length)
+        int lastChar = static_cast<int>(strnlen(inputFile, sizeof(inputFile))) - 1;
+        while (lastChar >= 0 && (inputFile[lastChar] == '\r' || inputFile[lastChar] == '\n')) {
+            inputFile[lastChar] = 0;
+            lastChar--;
         }
+        if (lastChar <= 0)
+            continue;
 
-        while (fgets(inputFile, sizeof(inputFile), fpini)) {
-            std::string strInputFile;
+        strInputFile = inputFile;
 
-            // remove trailing /n from filename (strnlen for bounded length)
-            int lastChar = static_cast<int>(strnlen(inputFile, sizeof(inputFile))) - 1;
-            while (lastChar >= 0 && (inputFile[lastChar] == '\r' || inputFile[lastChar] == '\n')) {
-                inputFile[lastChar] = 0;
-                lastChar--;
+        FILE *fp = fopen(strInputFile.c_str(), "rt");
+        if (!fp) {
+            // try in folder where is ini file
+            if (!strInifilePath.empty()) {
+                strInputFile = strInifilePath + inputFile;
+                fp = fopen(strInputFile.c_str(), "rt");
             }
-            if (lastChar <= 0)
-                continue;
 
-            strInputFile = inputFile;
-
-            FILE *fp = fopen(strInputFile.c_str(), "rt");
             if (!fp) {
-                // try in folder where is ini file
-                if (!strInifilePath.empty()) {
-                    std::string strfilepath = strInifilePath + strInputFile;
-                    fp = fopen(strfilepath.c_str(), "rt");
-                }
-
-                if (!fp) {
-                    LOGERROR(1, "Failed to open definitions file: %s\n", inputFile);
-                    continue;
-                }
+                LOGERROR(1, "Failed to open definitions file: %s\n", inputFile);
+                bComplete = false;
+                continue;
             }
-
-            // parse format file
-            XMLParser Parser;
-            if (!Parser.Parse(fp, pDefinition.get(), inputFile)) {
+        }
+        fclose(fp);
+        definitionFiles.push_back(strInputFile);
+    };
+
+    fclose(fpini);
+
+    // binary cache of definitions, valid while the XML files are unchanged
+    uint64_t cacheKey = 0;
+    const bool bCache = gEagerDefinitions && gDefinitionsCacheFile != nullptr && *gDefinitionsCacheFile &&
+                        CDefinitionCache::ComputeKey(definitionFiles, cacheKey);
+    if (!gEagerDefinitions) {
+        // files are parsed when their category is first received
+        for (const std::string &strInputFile: definitionFiles) {
+            const int nCategory = XMLParser::ReadCategoryId(strInputFile.c_str());
+            if (nCategory < 0) {
                 LOGERROR(1, "Failed to parse definitions file: %s\n", strInputFile.c_str());
+                bComplete = false;
+                continue;
             }
+            pDefinition->registerCategoryFile(nCategory, strInputFile);
+        }
+    } else if (!bCache || !CDefinitionCache::Load(gDefinitionsCacheFile, cacheKey, pDefinition.get())) {
+        // files are parsed in parallel
+        const bool bParsed = XMLParser::ParseFiles(definitionFiles, pDefinition.get());
+        if (!bParsed) {
+            bComplete = false;
+        }
 
-            fclose(fp);
-        };
+        if (bCache && bParsed) {
+            CDefinitionCache::Save(gDefinitionsCacheFile, cacheKey, pDefinition.get());
+        }
+    }
 
-        fclose(fpini);
+    return pDefinition.release();
+}
 
-        // Transfer ownership to the descriptor
-        m_pFormatDescriptor = new CAsterixFormatDescriptor(pDefinition.release());
+CBaseFormatDescriptor *CAsterixFormat::CreateFormatDescriptor
+        ([[maybe_unused]] const unsigned int formatType, [[maybe_unused]] const char *sFormatDescriptor) {
+    if (!m_pFormatDescriptor) {
+        Tracer::Configure(debug_trace);
+
+        // initialize Fulliautomatix engine
+        bool bComplete;
+        AsterixDefinition *pDefinition = loadDefinitions(bComplete);
+        if (pDefinition == nullptr) {
+            return nullptr;
+        }
+
+        // definitions are owned by the reloader, reloads with errors keep the loaded ones
+        auto pReloader = std::make_shared<CDefinitionReloader>(pDefinition, []() -> AsterixDefinition * {
+            bool bReloaded;
+            std::unique_ptr<AsterixDefinition> pReloaded(loadDefinitions(bReloaded));
+            return bReloaded ? pReloaded.release() : nullptr;
+        });
+        pReloader->Start();
+
+        CDefinitionReloader::CReader *pReader = pReloader->AddReader(pDefinition);
+        auto *pDescriptor = new CAsterixFormatDescriptor(pDefinition, false);
+        pDescriptor->SetReloader(pReloader, pReader);
+        m_pFormatDescriptor = pDescriptor;
     }
     return m_pFormatDescriptor;
 }
 
+CBaseFormatDescriptor *CAsterixFormat::CreatePrivateFormatDescriptor
+        (const unsigned int formatType, const char *sFormatDescriptor) {
+    // make sure definitions are loaded
+    auto *pShared = static_cast<CAsterixFormatDescriptor *>(CreateFormatDescriptor(formatType, sFormatDescriptor));
+    if (pShared == nullptr) {
+        return nullptr;
+    }
+
+    // definition is shared (read-only while parsing), buffers and parsed data are not
+    AsterixDefinition *pDefinition = nullptr;
+    CDefinitionReloader::CReader *pReader = pShared->m_pReloader->AddReader(pDefinition);
+    auto *pDescriptor = new CAsterixFormatDescriptor(pDefinition, false);
+    pDescriptor->SetReloader(pShared->m_pReloader, pReader);
+    m_lPrivateFormatDescriptors.push_back(pDescriptor);
+    return pDescriptor;
+}
+
 
 bool CAsterixFormat::GetFormatNo(const char *formatName, unsigned int &formatType) {
     bool found = false;
@@ -24,6 +24,8 @@
 #ifndef ASTERIXFORMAT_HXX__
 #define ASTERIXFORMAT_HXX__
 
+#include <list>
+
 #include "baseformat.hxx"
 #include "baseformatdescriptor.hxx"
 
@@ -77,7 +79,12 @@ public:
     /**
      * Default class destructor.
      */
-    ~CAsterixFormat() override { delete m_pFormatDescriptor; }
+    ~CAsterixFormat() override {
+        for (auto *desc : m_lPrivateFormatDescriptors) {
+            delete desc;
+        }
+        delete m_pFormatDescriptor;
+    }
 
     bool ReadPacket(CBaseFormatDescriptor &formatDescriptor, CBaseDevice &device,
                     const unsigned int formatType, bool &discard) override;
@@ -94,6 +101,9 @@ public:
     CBaseFormatDescriptor *CreateFormatDescriptor
             (const unsigned int formatType, const char *sFormatDescriptor) override;
 
+    CBaseFormatDescriptor *CreatePrivateFormatDescriptor
+            (const unsigned int formatType, const char *sFormatDescriptor) override;
+
     bool GetFormatNo(const char *formatName, unsigned int &formatNo) override;
 
     int GetStatus(CBaseDevice &device,
@@ -111,6 +121,8 @@ private:
 
     CBaseFormatDescriptor *m_pFormatDescriptor;
 
+    // Descriptors of additional input channels, sharing definitions with m_pFormatDescriptor
+    std::list<CBaseFormatDescriptor *> m_lPrivateFormatDescriptors;
 
 };
 
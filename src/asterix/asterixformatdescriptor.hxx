@@ -23,11 +23,23 @@
 #ifndef ASTERIXPCAPFORMATDESCRIPTOR_HXX__
 #define ASTERIXPCAPFORMATDESCRIPTOR_HXX__
 
+#include <bitset>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
 #include "baseformatdescriptor.hxx"
 #include "InputParser.h"
+#include "asterixvalidator.hxx"
+#include "definitionreloader.hxx"
+#include "ipreassembly.hxx"
+#include "replayscheduler.hxx"
+#include "streamframer.hxx"
 
 class AsterixDefinition;
 
+extern uint64_t gValidationErrors;
+
 #define DELETE_BUFFER_IF_LARGER 64*1024
 
 /**
@@ -43,12 +55,20 @@ public:
     /**
      * Constructor
      */
-    explicit CAsterixFormatDescriptor(AsterixDefinition *pDefinition) :
+    explicit CAsterixFormatDescriptor(AsterixDefinition *pDefinition, bool bOwnDefinition = true) :
             m_pDefinition(pDefinition),
+            m_bOwnDefinition(bOwnDefinition),
             m_InputParser(pDefinition),
             m_pAsterixData(nullptr),
             m_ePcapNetworkType(CAsterixFormatDescriptor::ePcapNetworkType(0)),
             m_bInvertByteOrder(true),
+            m_bPcapNanoseconds(false),
+            m_bPcapNg(false),
+            m_nPcapPacketNo(0),
+            m_dPcapStartTime(0),
+            m_dPcapEndTime(0),
+            m_pPacketData(nullptr),
+            m_nPacketDataLen(0),
             m_pBuffer(nullptr),
             m_nBufferSize(0),
             m_nDataSize(0),
@@ -59,14 +79,80 @@ public:
      * Pure virtual destructor.
      */
     ~CAsterixFormatDescriptor() override {
+        if (m_pReplay) {
+            m_pReplay->Report();
+        }
+        if (m_pValidator) {
+            m_pValidator->Report(stdout);
+            gValidationErrors += m_pValidator->GetNMalformed();
+        }
         delete[] m_pBuffer;
         delete m_pAsterixData;
         // FIXED: Delete the AsterixDefinition that was allocated in CreateFormatDescriptor
         // The InputParser doesn't own this pointer, the format descriptor does
-        delete m_pDefinition;
+        if (m_bOwnDefinition) {
+            delete m_pDefinition;
+        }
+        if (m_pReloader) {
+            m_pReloader->RemoveReader(m_pReader);
+        }
+    }
+
+    /**
+     * @brief Take definitions from reloader (owned by it), replaced when it reloads them
+     * @param pReader Reader registered by AddReader() for m_pDefinition
+     */
+    void SetReloader(std::shared_ptr<CDefinitionReloader> pReloader, CDefinitionReloader::CReader *pReader) {
+        m_pReloader = std::move(pReloader);
+        m_pReader = pReader;
     }
 
-    AsterixDefinition *m_pDefinition;  // Owned pointer - must be deleted in destructor
+    /**
+     * @brief Switch to definitions published by the reloader since the last
+     *        call, called between packets (never blocks)
+     */
+    void UpdateDefinition() {
+        if (m_pReloader) {
+            m_pReloader->Update(*m_pReader, [this](AsterixDefinition *pDefinition) { SetDefinition(pDefinition); });
+        }
+    }
+
+    /**
+     * @brief Decode following packets with another definition, data of the
+     *        last packet is dropped
+     */
+    void SetDefinition(AsterixDefinition *pDefinition) {
+        delete m_pAsterixData;
+        m_pAsterixData = nullptr;
+        m_pDefinition = pDefinition;
+        m_InputParser.setDefinition(pDefinition);
+        if (m_pValidator) {
+            m_pValidator->SetDefinition(pDefinition);
+        }
+        if (m_pFramer) {
+            m_pFramer->SetCategories(FramedCategories());
+        }
+    }
+
+    /**
+     * @brief Categories accepted by the stream framer: defined ones (without
+     *        loading them), all if nothing is defined
+     */
+    std::bitset<256> FramedCategories() const {
+        std::bitset<256> categories;
+        for (int i = 1; i < 256; i++) {
+            categories[i] = m_pDefinition->CategoryAvailable(i);
+        }
+        if (categories.none()) {
+            categories.set();
+        }
+        return categories;
+    }
+
+    std::shared_ptr<CDefinitionReloader> m_pReloader; // owner of definitions if set (hot reload)
+    CDefinitionReloader::CReader *m_pReader{nullptr};
+    AsterixDefinition *m_pDefinition;  // Owned pointer (unless shared, see m_bOwnDefinition)
+    bool m_bOwnDefinition; // false for additional input descriptors sharing the definition
     InputParser m_InputParser;
     AsterixData *m_pAsterixData;
 
@@ -117,8 +203,8 @@ public:
         m_nDataSize = len;
     }
 
-    // used only when format is GPS
-    double GetTimeStamp() {
+    // set by GPS and PCAP formats
+    double GetTimeStamp() override {
         return m_nTimeStamp;
     }
 
@@ -126,19 +212,63 @@ public:
         m_nTimeStamp = ts;
     }
 
+    // synchronous replay of recorded input, created on first packet in synchronous mode
+    std::unique_ptr<CReplayScheduler> m_pReplay;
+
+    /**
+     * @brief Wait until a recorded packet is due in synchronous mode
+     * @param captureTime Capture time of the packet in seconds
+     * @param speed Replay speed factor (used when the scheduler is created)
+     * @param name Input name used in timing statistics
+     */
+    void WaitForReplay(double captureTime, double speed, const char *name) {
+        if (!m_pReplay) {
+            m_pReplay = std::make_unique<CReplayScheduler>(speed, name ? name : "input");
+        }
+        m_pReplay->WaitFor(captureTime);
+    }
+
     // used only in PCAP (TODO)
     typedef enum {
         NET_ETHERNET = 0,
-        NET_LINUX = 1
+        NET_LINUX = 1,   // Linux cooked capture (SLL)
+        NET_LINUX2 = 2   // Linux cooked capture v2 (SLL2)
     } ePcapNetworkType;
 
     ePcapNetworkType m_ePcapNetworkType;
     bool m_bInvertByteOrder;
+    bool m_bPcapNanoseconds; // classic PCAP with nanosecond timestamps
+
+    // used only in PCAPNG, interfaces described in current section
+    typedef struct {
+        bool bSupported;            // link type is Ethernet or Linux cooked (v1 or v2)
+        ePcapNetworkType eNetworkType;
+        uint64_t nTsRate;           // timestamp units per second
+        int64_t nTsOffset;          // seconds added to timestamps
+    } SPcapNgInterface;
+
+    bool m_bPcapNg;
+    std::vector<SPcapNgInterface> m_PcapNgInterfaces;
+    unsigned long m_nPcapPacketNo; // number of packets read since the start of PCAP file
+    double m_dPcapStartTime; // capture time range to read from PCAP file (0 = not limited)
+    double m_dPcapEndTime;
+    std::unique_ptr<CIpReassembly> m_pIpReassembly; // created on first IP fragment
+    std::vector<unsigned char> m_PcapFrameHeader; // Ethernet, IP and UDP headers of the last packet read
+    std::unique_ptr<CStreamFramer> m_pFramer; // raw input from stream devices, created on first read
+    std::unique_ptr<CAsterixValidator> m_pValidator; // structure statistics (--validate), created on first packet
+
+    // ASTERIX data of the last packet read from raw or PCAP input, written as is to raw or PCAP
+    // output if nothing is filtered (points into input, IP reassembly or framer buffer, valid until next read)
+    const unsigned char *m_pPacketData;
+    unsigned int m_nPacketDataLen;
+    std::vector<unsigned char> m_WriteBuffer; // raw output packet or PCAP payload, reused
+    std::vector<unsigned char> m_FrameBuffer; // PCAP output record, reused
 
     std::string printDescriptor() override { return m_InputParser.printDefinition(); }
 
     bool filterOutItem(int cat, std::string item, const char *name) override {
-        return m_InputParser.filterOutItem(cat, item, name);
+        // kept by the reloader for reloaded definitions
+        return m_pReloader ? m_pReloader->FilterOutItem(cat, item, name) : m_InputParser.filterOutItem(cat, item, name);
     }
 
     bool isFiltered(int cat, std::string item, const char *name) { return m_InputParser.isFiltered(cat, item, name); }
@@ -21,6 +21,7 @@
  *
  */
 
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 #ifdef _WIN32
@@ -32,33 +33,7 @@
   #define read _read
   #define write _write
   #define getpid _getpid
-
-  // Windows compatibility layer for POSIX time functions
-  typedef unsigned long useconds_t;
-
-  // Implement gettimeofday for Windows
-  inline int gettimeofday(struct timeval* tp, void* tzp) {
-    // Note: some versions of Windows have gettimeofday in <sys/time.h>
-    // but we need to implement it for MSVC
-    FILETIME ft;
-    GetSystemTimeAsFileTime(&ft);
-
-    // Convert FILETIME to Unix epoch (microseconds since 1970)
-    unsigned long long t = (static_cast<unsigned long long>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime;
-    t -= 116444736000000000ULL; // Convert from Windows epoch to Unix epoch
-    t /= 10; // Convert 100-nanosecond intervals to microseconds
-
-    tp->tv_sec = static_cast<long>(t / 1000000UL);
-    tp->tv_usec = static_cast<long>(t % 1000000UL);
-    return 0;
-  }
-
-  // Implement usleep for Windows (usleep takes microseconds, Sleep takes milliseconds)
-  inline void usleep(useconds_t usec) {
-    Sleep(static_cast<DWORD>(usec / 1000)); // Convert microseconds to milliseconds
-  }
 #else
-  #include <sys/time.h>
   #include <unistd.h>
 #endif
 
@@ -66,13 +41,88 @@
 #include "asterixformat.hxx"
 #include "asterixformatdescriptor.hxx"
 #include "asterixpcapsubformat.hxx"
+#include "asterixrawsubformat.hxx"
 
 #include "AsterixDefinition.h"
 #include "InputParser.h"
+#include "pcapindex.hxx"
 
+extern bool gDecodeInput;
+extern int64_t gResumeOffset;
 extern bool gSynchronous;
+extern double gReplaySpeed;
+extern double gStartTime;
+extern double gEndTime;
+extern unsigned long gFirstPacket;
+extern unsigned long gLastPacket;
+
+static bool isRangeSet() {
+    return gStartTime > 0 || gEndTime > 0 || gFirstPacket > 0 || gLastPacket > 0;
+}
+
+namespace {
+    unsigned int swap32(unsigned int in) {
+        return ((in & 0xFF) << 24) | ((in & 0xFF00) << 8) | ((in >> 8) & 0xFF00) | (in >> 24);
+    }
+
+    // Read PCAPNG fields in section byte order
+    unsigned short get16(const unsigned char *p, bool invert) {
+        unsigned short v;
+        memcpy(&v, p, sizeof(v));
+        return invert ? static_cast<unsigned short>((v << 8) | (v >> 8)) : v;
+    }
+
+    unsigned int get32(const unsigned char *p, bool invert) {
+        unsigned int v;
+        memcpy(&v, p, sizeof(v));
+        return invert ? swap32(v) : v;
+    }
+
+    // Read network byte order fields
+    unsigned short net16(const unsigned char *p) {
+        return static_cast<unsigned short>((p[0] << 8) | p[1]);
+    }
+
+    unsigned int net32(const unsigned char *p) {
+        return (static_cast<unsigned int>(p[0]) << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+    }
+
+    // Internet checksum, ones' complement sum of 16-bit words (not yet complemented)
+    unsigned int onesSum(const unsigned char *p, size_t len, unsigned int sum = 0) {
+        for (; len > 1; p += 2, len -= 2) {
+            sum += net16(p);
+        }
+        if (len > 0) {
+            sum += static_cast<unsigned int>(p[0]) << 8;
+        }
+        while (sum >> 16) {
+            sum = (sum & 0xFFFF) + (sum >> 16);
+        }
+        return sum;
+    }
+
+    bool isVlanTag(unsigned short protoType) {
+        return protoType == 0x8100 || protoType == 0x88A8 || protoType == 0x9100;
+    }
+
+    // Fraction of a second in units of 1/rate to microseconds (rounded down), for decimal and binary rates
+    unsigned int toMicroseconds(uint64_t frac, uint64_t rate) {
+        if (frac <= UINT64_MAX / 1000000) {
+            return static_cast<unsigned int>(frac * 1000000 / rate);
+        }
+        // rates above 2^44, frac * 1000000 does not fit 64 bits
+        const auto usec = static_cast<unsigned int>(static_cast<long double>(frac) * 1000000 / rate);
+        return usec < 1000000 ? usec : 999999;
+    }
 
-// Helper: Read and validate PCAP file header
+    uint64_t get64(const unsigned char *p, bool invert) {
+        uint64_t v;
+        memcpy(&v, p, sizeof(v));
+        return invert ? (static_cast<uint64_t>(swap32(static_cast<unsigned int>(v))) << 32) | swap32(static_cast<unsigned int>(v >> 32)) : v;
+    }
+}
+
+// Helper: Read and validate PCAP file header (or PCAPNG Section Header Block)
 bool CAsterixPcapSubformat::readPcapFileHeader(CAsterixFormatDescriptor &Descriptor, CBaseDevice &device) {
     pcap_hdr_t pcapFileHeader;
 
@@ -81,22 +131,41 @@ bool CAsterixPcapSubformat::readPcapFileHeader(CAsterixFormatDescriptor &Descrip
         return false;
     }
 
-    // Determine byte order from magic number
+    Descriptor.m_bPcapNg = false;
+    Descriptor.m_bPcapNanoseconds = false;
+
+    if (pcapFileHeader.magic_number == PCAPNG_SHB) {
+        return readPcapNgSectionHeader(Descriptor, device, reinterpret_cast<const unsigned char *>(&pcapFileHeader),
+                                       sizeof(pcapFileHeader));
+    }
+
+    // Determine byte order and timestamp resolution from magic number
     if (pcapFileHeader.magic_number == 0xA1B2C3D4) {
         Descriptor.m_bInvertByteOrder = false;
     } else if (pcapFileHeader.magic_number == 0xD4C3B2A1) {
         Descriptor.m_bInvertByteOrder = true;
-        pcapFileHeader.network = convert_long(pcapFileHeader.network);
+    } else if (pcapFileHeader.magic_number == 0xA1B23C4D) {
+        Descriptor.m_bInvertByteOrder = false;
+        Descriptor.m_bPcapNanoseconds = true;
+    } else if (pcapFileHeader.magic_number == 0x4D3CB2A1) {
+        Descriptor.m_bInvertByteOrder = true;
+        Descriptor.m_bPcapNanoseconds = true;
     } else {
         LOGERROR(1, "Unknown input file format");
         return false;
     }
 
+    if (Descriptor.m_bInvertByteOrder) {
+        pcapFileHeader.network = swap32(pcapFileHeader.network);
+    }
+
     // Determine network type
     if (pcapFileHeader.network == 1) {
         Descriptor.m_ePcapNetworkType = CAsterixFormatDescriptor::NET_ETHERNET;
     } else if (pcapFileHeader.network == 113) {
         Descriptor.m_ePcapNetworkType = CAsterixFormatDescriptor::NET_LINUX;
+    } else if (pcapFileHeader.network == 276) {
+        Descriptor.m_ePcapNetworkType = CAsterixFormatDescriptor::NET_LINUX2;
     } else {
         LOGERROR(1, "Unknown network type in PCAP format");
         return false;
@@ -105,123 +174,336 @@ bool CAsterixPcapSubformat::readPcapFileHeader(CAsterixFormatDescriptor &Descrip
     return true;
 }
 
-// Helper: Handle synchronous playback delay
-void CAsterixPcapSubformat::handleSynchronousDelay(const pcaprec_hdr_t &recHeader,
-                                                   time_t &lastFileTimeSec, useconds_t &lastFileTimeUSec,
-                                                   time_t &lastMyTimeSec, useconds_t &lastMyTimeUSec) {
-    struct timeval currTime;
-    if (gettimeofday(&currTime, nullptr) != 0) {
-        return;
+// Helper: Start new PCAPNG section, pStart holds already read beginning of the block (at least 12 bytes)
+bool CAsterixPcapSubformat::readPcapNgSectionHeader(CAsterixFormatDescriptor &Descriptor, CBaseDevice &device,
+                                                    const unsigned char *pStart, unsigned int startLen) {
+    const unsigned int byteOrderMagic = get32(pStart + 8, false);
+    if (byteOrderMagic == 0x1A2B3C4D) {
+        Descriptor.m_bInvertByteOrder = false;
+    } else if (byteOrderMagic == 0x4D3C2B1A) {
+        Descriptor.m_bInvertByteOrder = true;
+    } else {
+        LOGERROR(1, "Invalid PCAPNG section header\n");
+        return false;
     }
 
-    if (lastMyTimeSec != 0 && lastFileTimeSec != 0) {
-        unsigned int diffFile = (recHeader.ts_sec - lastFileTimeSec) * 1000000 +
-                                recHeader.ts_usec - lastFileTimeUSec;
-        unsigned int diffMy = (currTime.tv_sec - lastMyTimeSec) * 1000000 +
-                              currTime.tv_usec - lastMyTimeUSec;
+    const unsigned int blockLen = get32(pStart + 4, Descriptor.m_bInvertByteOrder);
+    if (blockLen < 28 || blockLen % 4 != 0 || blockLen > PCAPNG_MAX_BLOCK_SIZE || blockLen < startLen) {
+        LOGERROR(1, "Invalid PCAPNG section header length %u\n", blockLen);
+        return false;
+    }
+
+    // Skip rest of the block (version, section length and options)
+    if (blockLen > startLen && !device.Read(Descriptor.GetNewBuffer(blockLen - startLen), blockLen - startLen)) {
+        LOGERROR(1, "Couldn't read PCAPNG section header.\n");
+        return false;
+    }
+
+    Descriptor.m_bPcapNg = true;
+    Descriptor.m_PcapNgInterfaces.clear();
+    return true;
+}
+
+// Helper: Add interface from PCAPNG Interface Description Block
+void CAsterixPcapSubformat::parsePcapNgInterface(CAsterixFormatDescriptor &Descriptor, const unsigned char *pBody,
+                                                 unsigned int bodyLen) {
+    const bool invert = Descriptor.m_bInvertByteOrder;
+    CAsterixFormatDescriptor::SPcapNgInterface iface = {false, CAsterixFormatDescriptor::NET_ETHERNET, 1000000, 0};
+
+    const unsigned short linkType = bodyLen >= 8 ? get16(pBody, invert) : 0;
+    if (linkType == 1) {
+        iface.bSupported = true;
+    } else if (linkType == 113) {
+        iface.bSupported = true;
+        iface.eNetworkType = CAsterixFormatDescriptor::NET_LINUX;
+    } else if (linkType == 276) {
+        iface.bSupported = true;
+        iface.eNetworkType = CAsterixFormatDescriptor::NET_LINUX2;
+    } else {
+        // Report once, sections are read again in loop mode
+        static thread_local bool reported = false;
+        LOGWARNING(!reported, "Unknown network type %u of PCAPNG interface %zu, its packets are skipped\n",
+                   linkType, Descriptor.m_PcapNgInterfaces.size());
+        reported = true;
+    }
 
-        if (diffFile > diffMy) {
-            usleep(diffFile - diffMy);
+    // Options: code (2) + length (2) + value padded to 32 bits
+    unsigned int pos = 8;
+    while (pos + 4 <= bodyLen) {
+        const unsigned short code = get16(pBody + pos, invert);
+        const unsigned short len = get16(pBody + pos + 2, invert);
+        pos += 4;
+        if (code == 0 || pos + len > bodyLen) {
+            break; // opt_endofopt
         }
+
+        if (code == 9 && len == 1) { // if_tsresol
+            const bool binary = (pBody[pos] & 0x80) != 0;
+            const unsigned char exp = pBody[pos] & 0x7F;
+            iface.nTsRate = 1;
+            for (unsigned int i = 0; i < exp && i < (binary ? 63u : 19u); i++) {
+                iface.nTsRate *= binary ? 2 : 10;
+            }
+        } else if (code == 14 && len == 8) { // if_tsoffset
+            iface.nTsOffset = static_cast<int64_t>(get64(pBody + pos, invert));
+        }
+        pos += (len + 3) & ~3u;
     }
 
-    lastFileTimeSec = recHeader.ts_sec;
-    lastFileTimeUSec = recHeader.ts_usec;
-    lastMyTimeSec = currTime.tv_sec;
-    lastMyTimeUSec = currTime.tv_usec;
+    Descriptor.m_PcapNgInterfaces.push_back(iface);
 }
 
-// Helper: Parse network header (Ethernet or Linux cooked) and return pointer to protocol type
-unsigned char* CAsterixPcapSubformat::parseNetworkHeader(unsigned char *pPacketBuffer,
-                                                         CAsterixFormatDescriptor &Descriptor,
-                                                         bool &bIPInvertByteOrder) {
-    unsigned char *pPacketPtr = pPacketBuffer;
+// Helper: Read PCAPNG blocks up to the next packet
+bool CAsterixPcapSubformat::readPcapNgBlock(CAsterixFormatDescriptor &Descriptor, CBaseDevice &device,
+                                            pcaprec_hdr_t &recHeader, unsigned char *&pPacket, double &packetTime) {
+    for (;;) {
+        unsigned char blockHeader[12];
+        if (!device.Read(blockHeader, 8)) {
+            LOGERROR(1, "Couldn't read PCAPNG block header.\n");
+            return false;
+        }
 
-    if (Descriptor.m_ePcapNetworkType == CAsterixFormatDescriptor::NET_ETHERNET) {
-        pPacketPtr += 12; // Destination MAC (6) + Source MAC (6)
-    } else if (Descriptor.m_ePcapNetworkType == CAsterixFormatDescriptor::NET_LINUX) {
-        pPacketPtr += 14; // Packet type(2) + Address type(2) + Address length(2) + Source(8)
+        const unsigned int blockType = get32(blockHeader, Descriptor.m_bInvertByteOrder);
+        if (blockType == PCAPNG_SHB) {
+            // New section, byte order may change
+            if (!device.Read(blockHeader + 8, 4) ||
+                !readPcapNgSectionHeader(Descriptor, device, blockHeader, sizeof(blockHeader))) {
+                return false;
+            }
+        } else {
+            const unsigned int blockLen = get32(blockHeader + 4, Descriptor.m_bInvertByteOrder);
+            if (blockLen < 12 || blockLen % 4 != 0 || blockLen > PCAPNG_MAX_BLOCK_SIZE) {
+                LOGERROR(1, "Invalid PCAPNG block length %u\n", blockLen);
+                return false;
+            }
+
+            unsigned char *pBody = Descriptor.GetNewBuffer(blockLen - 8);
+            if (!device.Read(pBody, blockLen - 8)) {
+                LOGERROR(1, "Couldn't read PCAPNG block.\n");
+                return false;
+            }
+            const unsigned int bodyLen = blockLen - 12; // without trailing block length
+
+            const bool invert = Descriptor.m_bInvertByteOrder;
+            unsigned int ifaceId = 0;
+            uint64_t ts = 0;
+            bool hasTime = true;
+            unsigned int dataOffset = 0;
+            unsigned int capLen = 0;
+            unsigned int origLen = 0;
+
+            switch (blockType) {
+                case PCAPNG_IDB:
+                    parsePcapNgInterface(Descriptor, pBody, bodyLen);
+                    break;
+                case PCAPNG_EPB:
+                    if (bodyLen >= 20) {
+                        ifaceId = get32(pBody, invert);
+                        ts = (static_cast<uint64_t>(get32(pBody + 4, invert)) << 32) | get32(pBody + 8, invert);
+                        capLen = get32(pBody + 12, invert);
+                        origLen = get32(pBody + 16, invert);
+                        dataOffset = 20;
+                    }
+                    break;
+                case PCAPNG_OPB:
+                    if (bodyLen >= 20) {
+                        ifaceId = get16(pBody, invert);
+                        ts = (static_cast<uint64_t>(get32(pBody + 4, invert)) << 32) | get32(pBody + 8, invert);
+                        capLen = get32(pBody + 12, invert);
+                        origLen = get32(pBody + 16, invert);
+                        dataOffset = 20;
+                    }
+                    break;
+                case PCAPNG_SPB:
+                    // No timestamp, packet is captured on the first interface
+                    if (bodyLen >= 4) {
+                        origLen = get32(pBody, invert);
+                        capLen = origLen < bodyLen - 4 ? origLen : bodyLen - 4;
+                        dataOffset = 4;
+                        hasTime = false;
+                    }
+                    break;
+                default:
+                    // Name resolution, statistics, secrets and custom blocks are not needed
+                    break;
+            }
+
+            if (dataOffset > 0 && capLen <= bodyLen - dataOffset && ifaceId < Descriptor.m_PcapNgInterfaces.size() &&
+                Descriptor.m_PcapNgInterfaces[ifaceId].bSupported) {
+                const CAsterixFormatDescriptor::SPcapNgInterface &iface = Descriptor.m_PcapNgInterfaces[ifaceId];
+                Descriptor.m_ePcapNetworkType = iface.eNetworkType;
+
+                if (hasTime) {
+                    const uint64_t sec = ts / iface.nTsRate;
+                    const uint64_t frac = ts % iface.nTsRate;
+                    recHeader.ts_sec = static_cast<unsigned int>(static_cast<int64_t>(sec) + iface.nTsOffset);
+                    recHeader.ts_usec = toMicroseconds(frac, iface.nTsRate);
+                    packetTime = recHeader.ts_sec + static_cast<double>(frac) / static_cast<double>(iface.nTsRate);
+                } else {
+                    packetTime = Descriptor.GetTimeStamp();
+                    recHeader.ts_sec = static_cast<unsigned int>(packetTime);
+                    recHeader.ts_usec = static_cast<unsigned int>((packetTime - recHeader.ts_sec) * 1000000);
+                }
+                recHeader.incl_len = capLen;
+                recHeader.orig_len = origLen;
+                pPacket = pBody + dataOffset;
+                return true;
+            }
+        }
+
+        if (!device.IsOpened() || device.IsOnStart()) {
+            return false; // end of file after non-packet blocks
+        }
     }
+}
 
-    unsigned short protoType = *reinterpret_cast<unsigned short *>(pPacketPtr);
-    pPacketPtr += 2;
+// Helper: Read next packet record, header fields are returned in host byte order
+bool CAsterixPcapSubformat::readPcapRecord(CAsterixFormatDescriptor &Descriptor, CBaseDevice &device,
+                                           pcaprec_hdr_t &recHeader, unsigned char *&pPacket, double &packetTime) {
+    if (Descriptor.m_bPcapNg) {
+        return readPcapNgBlock(Descriptor, device, recHeader, pPacket, packetTime);
+    }
+
+    if (!device.Read(&recHeader, sizeof(recHeader))) {
+        LOGERROR(1, "Couldn't read PCAP header.\n");
+        return false;
+    }
 
     if (Descriptor.m_bInvertByteOrder) {
-        protoType = convert_short(protoType);
+        recHeader.ts_sec = swap32(recHeader.ts_sec);
+        recHeader.ts_usec = swap32(recHeader.ts_usec);
+        recHeader.incl_len = swap32(recHeader.incl_len);
+        recHeader.orig_len = swap32(recHeader.orig_len);
     }
 
-    // Determine IP byte order based on protocol type
-    bIPInvertByteOrder = Descriptor.m_bInvertByteOrder;
-    if (protoType == 0x8) {
-        bIPInvertByteOrder = !Descriptor.m_bInvertByteOrder;
-    } else if (protoType != 0x800) {
-        LOGERROR(1, "Unknown protocol type (%x)\n", protoType);
-        return nullptr;
+    if (Descriptor.m_bPcapNanoseconds) {
+        packetTime = recHeader.ts_sec + recHeader.ts_usec / 1000000000.0;
+        recHeader.ts_usec /= 1000;
+    } else {
+        packetTime = recHeader.ts_sec + recHeader.ts_usec / 1000000.0;
     }
 
-    return pPacketPtr;
+    pPacket = Descriptor.GetNewBuffer(recHeader.incl_len);
+    if (!device.Read(pPacket, recHeader.incl_len)) {
+        LOGERROR(1, "Couldn't read PCAP packet.\n");
+        return false;
+    }
+    return true;
 }
 
-// Helper: Parse IP header, returns false on failure
-bool CAsterixPcapSubformat::parseIPHeader(unsigned char *&pPacketPtr, bool bIPInvertByteOrder,
-                                          unsigned short &IPtotalLength) {
-    unsigned char IPheaderLength = (*pPacketPtr) & 0x0F;
-    pPacketPtr++; // Version + IHL
-
-    pPacketPtr += 1; // TOS
+// Helper: Skip link layer header (Ethernet with optional VLAN/QinQ tags, Linux cooked v1 or v2),
+// returns pointer to IPv4 header and its length
+const unsigned char* CAsterixPcapSubformat::parseNetworkHeader(const unsigned char *pPacketBuffer,
+                                                               unsigned int packetLen,
+                                                               CAsterixFormatDescriptor &Descriptor,
+                                                               unsigned int &ipLen) {
+    unsigned int pos;
+    unsigned int protoPos;
+    if (Descriptor.m_ePcapNetworkType == CAsterixFormatDescriptor::NET_LINUX) {
+        protoPos = 14; // Packet type(2) + Address type(2) + Address length(2) + Source(8)
+        pos = 16;
+    } else if (Descriptor.m_ePcapNetworkType == CAsterixFormatDescriptor::NET_LINUX2) {
+        protoPos = 0;  // Protocol(2) + Reserved(2) + Interface(4) + ARPHRD(2) + Packet type(1) + Address length(1) + Source(8)
+        pos = 20;
+    } else {
+        protoPos = 12; // Destination MAC (6) + Source MAC (6)
+        while (protoPos + 2 <= packetLen && isVlanTag(net16(pPacketBuffer + protoPos))) {
+            protoPos += 4; // 802.1Q / 802.1ad tag: TPID(2) + TCI(2)
+        }
+        pos = protoPos + 2;
+    }
 
-    IPtotalLength = *reinterpret_cast<unsigned short *>(pPacketPtr);
-    pPacketPtr += 2;
+    if (pos > packetLen) {
+        LOGERROR(1, "Truncated network header (%u bytes)\n", packetLen);
+        return nullptr;
+    }
 
-    if (bIPInvertByteOrder) {
-        IPtotalLength = convert_short(IPtotalLength);
+    const unsigned short protoType = net16(pPacketBuffer + protoPos);
+    if (protoType != 0x0800) {
+        LOGERROR(1, "Unknown protocol type (%x)\n", protoType);
+        return nullptr;
     }
 
-    pPacketPtr += 5; // ID(2) + Flags(1) + Fragment Offset(2) + TTL(1) - actually 5 bytes to get to protocol
+    ipLen = packetLen - pos;
+    return pPacketBuffer + pos;
+}
 
-    unsigned char protocol = *pPacketPtr;
-    pPacketPtr++;
+// Helper: Parse IPv4 header and return pointer to its payload. Unfragmented datagrams are used in place,
+// fragments are collected in the reassembly table and the whole payload is returned with the last one.
+// Returns nullptr with bPending set while the datagram is incomplete.
+const unsigned char* CAsterixPcapSubformat::parseIPHeader(CAsterixFormatDescriptor &Descriptor,
+                                                          const unsigned char *pPacketPtr, unsigned int ipLen,
+                                                          double packetTime, unsigned int &payloadLen,
+                                                          bool &bPending) {
+    bPending = false;
+    if (ipLen < 20) {
+        LOGERROR(1, "Truncated IP header\n");
+        return nullptr;
+    }
 
+    const unsigned int IPheaderLength = (pPacketPtr[0] & 0x0F) * 4;
+    const unsigned int IPtotalLength = net16(pPacketPtr + 2);
+    if (IPheaderLength < 20 || IPtotalLength < IPheaderLength || IPtotalLength > ipLen) {
+        LOGERROR(1, "Wrong IP packet length (%u of %u captured)\n", IPtotalLength, ipLen);
+        return nullptr;
+    }
+
+    const unsigned char protocol = pPacketPtr[9];
     if (protocol != 17) { // Only UDP supported
         LOGERROR(1, "Unsupported protocol type (%x)", protocol);
-        return false;
+        return nullptr;
     }
 
-    pPacketPtr += 2; // Checksum
-    pPacketPtr += 4; // Source IP
-    pPacketPtr += 4; // Destination IP
-    pPacketPtr += IPheaderLength * 4 - 20; // Options
+    // Ethernet padding after the datagram is ignored
+    payloadLen = IPtotalLength - IPheaderLength;
 
-    IPtotalLength -= IPheaderLength * 4;
-    return true;
-}
+    const unsigned short flagsOffset = net16(pPacketPtr + 6);
+    const bool moreFragments = (flagsOffset & 0x2000) != 0;
+    const unsigned int fragmentOffset = (flagsOffset & 0x1FFF) * 8;
+    if (!moreFragments && fragmentOffset == 0) {
+        return pPacketPtr + IPheaderLength;
+    }
 
-// Helper: Parse UDP header
-bool CAsterixPcapSubformat::parseUDPHeader(unsigned char *&pPacketPtr, bool bIPInvertByteOrder,
-                                           unsigned short IPtotalLength, unsigned short &dataLength) {
-    pPacketPtr += 2; // Source port
-    pPacketPtr += 2; // Destination port
+    if (!Descriptor.m_pIpReassembly) {
+        Descriptor.m_pIpReassembly = std::make_unique<CIpReassembly>();
+    }
 
-    dataLength = *reinterpret_cast<unsigned short *>(pPacketPtr);
-    pPacketPtr += 2;
+    unsigned int totalLen = 0;
+    const unsigned char *pPayload = Descriptor.m_pIpReassembly->AddFragment(
+            net32(pPacketPtr + 12), net32(pPacketPtr + 16), protocol, net16(pPacketPtr + 4),
+            fragmentOffset, moreFragments, pPacketPtr + IPheaderLength, payloadLen, packetTime, totalLen);
+    if (pPayload == nullptr) {
+        bPending = true;
+        return nullptr;
+    }
+
+    payloadLen = totalLen;
+    return pPayload;
+}
 
-    if (bIPInvertByteOrder) {
-        dataLength = convert_short(dataLength);
+// Helper: Parse UDP header
+bool CAsterixPcapSubformat::parseUDPHeader(const unsigned char *&pPacketPtr, unsigned int payloadLen,
+                                           unsigned short &dataLength) {
+    if (payloadLen < 8) {
+        LOGERROR(1, "Truncated UDP header");
+        return false;
     }
 
-    if (IPtotalLength != dataLength) {
+    // Source port(2) + Destination port(2) + Length(2) + Checksum(2)
+    const unsigned int udpLength = net16(pPacketPtr + 4);
+    if (udpLength != payloadLen) {
         LOGERROR(1, "Wrong UDP data length");
         return false;
     }
 
-    pPacketPtr += 2; // Checksum
-    dataLength -= 8; // Subtract UDP header size
+    pPacketPtr += 8;
+    dataLength = static_cast<unsigned short>(udpLength - 8);
     return true;
 }
 
 // Helper: Parse ORADIS-wrapped ASTERIX data
 void CAsterixPcapSubformat::parseOradisData(CAsterixFormatDescriptor &Descriptor,
-                                            unsigned char *pPacketPtr, unsigned short dataLength,
+                                            const unsigned char *pPacketPtr, unsigned short dataLength,
                                             unsigned long nTimestamp) {
     while (dataLength > 0) {
         // Parse ORADIS header (6 bytes): ByteCount(2) + Time(4)
@@ -249,89 +531,356 @@ void CAsterixPcapSubformat::parseOradisData(CAsterixFormatDescriptor &Descriptor
     }
 }
 
+// Helper: Convert requested time range to capture time, time of day is taken relative to the first packet
+void CAsterixPcapSubformat::resolveRange(CAsterixFormatDescriptor &Descriptor, double firstTime) {
+    const double day = static_cast<double>(static_cast<long long>(firstTime) / 86400 * 86400);
+
+    Descriptor.m_dPcapStartTime = gStartTime;
+    if (gStartTime > 0 && gStartTime < 86400) {
+        Descriptor.m_dPcapStartTime = day + gStartTime;
+        if (Descriptor.m_dPcapStartTime + 1 < firstTime) {
+            Descriptor.m_dPcapStartTime += 86400; // next day
+        }
+    }
+
+    Descriptor.m_dPcapEndTime = gEndTime;
+    if (gEndTime > 0 && gEndTime < 86400) {
+        Descriptor.m_dPcapEndTime = day + gEndTime;
+        if (Descriptor.m_dPcapEndTime < firstTime || Descriptor.m_dPcapEndTime < Descriptor.m_dPcapStartTime) {
+            Descriptor.m_dPcapEndTime += 86400;
+        }
+    }
+}
+
+// Helper: Use index file to seek to the first requested packet
+void CAsterixPcapSubformat::seekToRange(CAsterixFormatDescriptor &Descriptor, CBaseDevice &device) {
+    const char *fileName = device.GetFileName();
+    CPcapIndex index;
+    if (fileName == nullptr || !index.Load(fileName)) {
+        LOGINFO(gVerbose, "No index for %s, reading from the start (create it with --index)\n",
+                fileName ? fileName : "input");
+        return;
+    }
+
+    resolveRange(Descriptor, index.GetFirstTime());
+
+    const CPcapIndex::SCheckpoint *checkpoint = nullptr;
+    if (gFirstPacket > 1) {
+        checkpoint = index.LookupPacket(gFirstPacket - 1);
+    }
+    if (Descriptor.m_dPcapStartTime > 0) {
+        const CPcapIndex::SCheckpoint *byTime = index.LookupTime(Descriptor.m_dPcapStartTime);
+        if (checkpoint == nullptr || (byTime != nullptr && byTime->offset > checkpoint->offset)) {
+            checkpoint = byTime;
+        }
+    }
+
+    if (checkpoint != nullptr && checkpoint->packetNo > 0) {
+        const int64_t offset = static_cast<int64_t>(checkpoint->offset);
+        if (device.IoCtrl(CBaseDevice::ESeek, &offset, sizeof(offset))) {
+            Descriptor.m_nPcapPacketNo = static_cast<unsigned long>(checkpoint->packetNo);
+            LOGINFO(gVerbose, "Seek to packet %lu using index\n", Descriptor.m_nPcapPacketNo + 1);
+        }
+    }
+}
+
+// Helper: Continue resumed conversion after the file header was read. Packet blocks of pcapng
+// are read up to the offset, so interface descriptions in between are not missed.
+bool CAsterixPcapSubformat::seekToResume(CAsterixFormatDescriptor &Descriptor, CBaseDevice &device) {
+    const int64_t offset = gResumeOffset;
+    gResumeOffset = 0;
+
+    if (!Descriptor.m_bPcapNg) {
+        if (!device.IoCtrl(CBaseDevice::ESeek, &offset, sizeof(offset))) {
+            LOGERROR(1, "Cannot resume reading at offset %lld\n", static_cast<long long>(offset));
+            return false;
+        }
+    } else {
+        int64_t position = 0;
+        pcaprec_hdr_t recHeader;
+        unsigned char *pPacket;
+        double packetTime;
+        while (device.IoCtrl(CBaseDevice::EGetPosition, &position, sizeof(position)) && position < offset) {
+            if (!readPcapRecord(Descriptor, device, recHeader, pPacket, packetTime)) {
+                LOGERROR(1, "Cannot resume reading at offset %lld\n", static_cast<long long>(offset));
+                return false;
+            }
+        }
+    }
+
+    LOGNOTIFY(gVerbose, "Resuming input at offset %lld\n", static_cast<long long>(offset));
+    return true;
+}
+
+// Helper: Check packet against requested range, returns -1 if before, 0 if inside and 1 if after the range
+int CAsterixPcapSubformat::checkRange(CAsterixFormatDescriptor &Descriptor, double packetTime) {
+    const unsigned long packetNo = ++Descriptor.m_nPcapPacketNo; // 1 based
+
+    if ((gLastPacket > 0 && packetNo > gLastPacket) ||
+        (Descriptor.m_dPcapEndTime > 0 && packetTime > Descriptor.m_dPcapEndTime)) {
+        return 1;
+    }
+    if ((gFirstPacket > 0 && packetNo < gFirstPacket) ||
+        (Descriptor.m_dPcapStartTime > 0 && packetTime < Descriptor.m_dPcapStartTime)) {
+        return -1;
+    }
+    return 0;
+}
+
 bool CAsterixPcapSubformat::ReadPacket(CBaseFormatDescriptor &formatDescriptor, CBaseDevice &device,
                                        [[maybe_unused]] bool &discard, [[maybe_unused]] bool oradis) {
     auto &Descriptor = static_cast<CAsterixFormatDescriptor &>(formatDescriptor);
-    static time_t lastFileTimeSec = 0;
-    static useconds_t lastFileTimeUSec = 0;
-    static time_t lastMyTimeSec = 0;
-    static useconds_t lastMyTimeUSec = 0;
 
     // Read file header on first packet
     if (device.IsOnStart()) {
-        lastFileTimeSec = 0;
-        lastFileTimeUSec = 0;
+        if (Descriptor.m_pReplay) {
+            Descriptor.m_pReplay->Reset();
+        }
         if (!readPcapFileHeader(Descriptor, device)) {
             return false;
         }
+
+        Descriptor.m_nPcapPacketNo = 0;
+        Descriptor.m_dPcapStartTime = Descriptor.m_dPcapEndTime = 0;
+        Descriptor.m_pIpReassembly.reset(); // fragments do not continue across files or loops
+        if (isRangeSet()) {
+            seekToRange(Descriptor, device);
+        }
+        if (gResumeOffset > 0 && !seekToResume(Descriptor, device)) {
+            return false;
+        }
     }
 
-    // Read PCAP packet header
+    // Read PCAP packet header and data, skipping packets before requested range
+    // and fragments of not yet complete datagrams
     pcaprec_hdr_t pcapRecHeader;
-    if (!device.Read(&pcapRecHeader, sizeof(pcapRecHeader))) {
-        LOGERROR(1, "Couldn't read PCAP header.\n");
-        return false;
+    unsigned char *pPacketBuffer;
+    double packetTime;
+    const unsigned char *pPacketPtr;
+    unsigned short dataLength = 0;
+    for (;;) {
+        if (!readPcapRecord(Descriptor, device, pcapRecHeader, pPacketBuffer, packetTime)) {
+            return false;
+        }
+
+        if (isRangeSet()) {
+            if (Descriptor.m_nPcapPacketNo == 0 && Descriptor.m_dPcapStartTime == 0 && Descriptor.m_dPcapEndTime == 0) {
+                resolveRange(Descriptor, packetTime); // no index, first packet of the file
+            }
+
+            const int range = checkRange(Descriptor, packetTime);
+            if (range > 0) {
+                // past the requested range, end (or in loop mode restart) reading the file
+                device.IoCtrl(CBaseDevice::EEndOfInput);
+                return false;
+            }
+            if (range < 0) {
+                if (!device.IsOpened() || device.IsOnStart()) {
+                    return false; // end of file reached before the requested range
+                }
+                continue;
+            }
+        }
+
+        // Parse network, IP and UDP headers
+        unsigned int ipLen = 0;
+        const unsigned char *pIPHeader = parseNetworkHeader(pPacketBuffer, pcapRecHeader.incl_len, Descriptor, ipLen);
+        if (pIPHeader == nullptr) {
+            return false;
+        }
+
+        bool bPending = false;
+        unsigned int payloadLen = 0;
+        pPacketPtr = parseIPHeader(Descriptor, pIPHeader, ipLen, packetTime, payloadLen, bPending);
+        if (pPacketPtr != nullptr) {
+            const unsigned char *pUDPHeader = pPacketPtr;
+            if (!parseUDPHeader(pPacketPtr, payloadLen, dataLength)) {
+                return false;
+            }
+            storeFrameHeader(Descriptor, pPacketBuffer, pIPHeader, pUDPHeader);
+            break;
+        }
+        if (!bPending || !device.IsOpened() || device.IsOnStart()) {
+            return false;
+        }
     }
 
     // Calculate timestamp (milliseconds since midnight)
     unsigned long nTimestamp = (pcapRecHeader.ts_sec % 86400) * 1000 + pcapRecHeader.ts_usec / 1000;
 
+    // Keep full capture time, used to order packets when merging several inputs
+    Descriptor.SetTimeStamp(packetTime);
+
     // Handle synchronous playback
     if (gSynchronous) {
-        handleSynchronousDelay(pcapRecHeader, lastFileTimeSec, lastFileTimeUSec,
-                               lastMyTimeSec, lastMyTimeUSec);
+        Descriptor.WaitForReplay(packetTime, gReplaySpeed, device.GetFileName());
     }
 
-    // Read PCAP packet data
-    unsigned long nPacketBufferSize = pcapRecHeader.incl_len;
-    if (Descriptor.m_bInvertByteOrder) {
-        nPacketBufferSize = convert_long(nPacketBufferSize);
+    // Clean up old data
+    if (Descriptor.m_pAsterixData) {
+        delete Descriptor.m_pAsterixData;
+        Descriptor.m_pAsterixData = nullptr;
     }
 
-    unsigned char *pPacketBuffer = Descriptor.GetNewBuffer(nPacketBufferSize);
-    if (!device.Read(pPacketBuffer, nPacketBufferSize)) {
-        LOGERROR(1, "Couldn't read PCAP packet.\n");
-        return false;
+    // Parse ASTERIX data
+    if (oradis) {
+        parseOradisData(Descriptor, pPacketPtr, dataLength, nTimestamp);
+    } else {
+        Descriptor.m_pPacketData = pPacketPtr;
+        Descriptor.m_nPacketDataLen = dataLength;
+        if (gDecodeInput) {
+            Descriptor.m_pAsterixData = Descriptor.m_InputParser.parsePacket(pPacketPtr, dataLength, nTimestamp);
+        }
     }
 
-    // Parse network header
-    bool bIPInvertByteOrder = false;
-    unsigned char *pPacketPtr = parseNetworkHeader(pPacketBuffer, Descriptor, bIPInvertByteOrder);
-    if (pPacketPtr == nullptr) {
-        return false;
+    return true;
+}
+
+// Helper: Keep headers of the packet for PCAP output. Linux cooked capture header is replaced with
+// Ethernet one, so packets of all inputs can be written with the same link type.
+void CAsterixPcapSubformat::storeFrameHeader(CAsterixFormatDescriptor &Descriptor, const unsigned char *pPacketBuffer,
+                                             const unsigned char *pIPHeader, const unsigned char *pUDPHeader) {
+    std::vector<unsigned char> &header = Descriptor.m_PcapFrameHeader;
+    const unsigned int IPheaderLength = (pIPHeader[0] & 0x0F) * 4;
+
+    if (Descriptor.m_ePcapNetworkType == CAsterixFormatDescriptor::NET_ETHERNET) {
+        header.assign(pPacketBuffer, pIPHeader + IPheaderLength);
+    } else {
+        header.assign(ETHERNET_HEADER_SIZE, 0);
+        header[12] = 0x08; // IPv4
+        header.insert(header.end(), pIPHeader, pIPHeader + IPheaderLength);
     }
+    // UDP header is in reassembly buffer if the datagram was fragmented
+    header.insert(header.end(), pUDPHeader, pUDPHeader + UDP_HEADER_SIZE);
+}
 
-    // Parse IP header
-    unsigned short IPtotalLength = 0;
-    if (!parseIPHeader(pPacketPtr, bIPInvertByteOrder, IPtotalLength)) {
-        return false;
+// Helper: Append Ethernet, IPv4 and UDP headers, of the packet read if known, otherwise default ones.
+// Returns offset of IPv4 header in buffer.
+size_t CAsterixPcapSubformat::appendFrameHeader(const CAsterixFormatDescriptor &Descriptor,
+                                                std::vector<unsigned char> &buffer) {
+    const std::vector<unsigned char> &header = Descriptor.m_PcapFrameHeader;
+    const size_t start = buffer.size();
+
+    if (!header.empty()) {
+        buffer.insert(buffer.end(), header.begin(), header.end());
+        size_t protoPos = start + 12;
+        while (isVlanTag(net16(&buffer[protoPos]))) {
+            protoPos += 4;
+        }
+        return protoPos + 2;
     }
 
-    // Parse UDP header
-    unsigned short dataLength = 0;
-    if (!parseUDPHeader(pPacketPtr, bIPInvertByteOrder, IPtotalLength, dataLength)) {
+    // Input is not PCAP: localhost to localhost, UDP port 8600 (decoded as ASTERIX by Wireshark)
+    static const unsigned char defaultHeader[] = {
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x08, 0x00,     // Ethernet
+            0x45, 0, 0, 0, 0, 0, 0x40, 0, 64, 17, 0, 0,         // IPv4, don't fragment, TTL 64, UDP
+            127, 0, 0, 1, 127, 0, 0, 1,
+            0x21, 0x98, 0x21, 0x98, 0, 0, 0, 0                  // UDP
+    };
+    buffer.insert(buffer.end(), defaultHeader, defaultHeader + sizeof(defaultHeader));
+    return start + ETHERNET_HEADER_SIZE;
+}
+
+/*
+ * Write the last packet read as PCAP record with Ethernet link type. Headers and capture time
+ * of PCAP input are kept, lengths and IP checksum are updated for the filtered data.
+ * File header, record header and packet are written with a single write. With split output
+ * each group of data blocks is written as its own record.
+ */
+bool CAsterixPcapSubformat::WritePacket(CBaseFormatDescriptor &formatDescriptor, CBaseDevice &device,
+                                        [[maybe_unused]] bool &discard, bool oradis) {
+    auto &Descriptor = static_cast<CAsterixFormatDescriptor &>(formatDescriptor);
+
+    if (oradis) {
+        LOGERROR(1, "Writing ORADIS format is not supported.\n");
         return false;
     }
 
-    // Clean up old data
-    if (Descriptor.m_pAsterixData) {
-        delete Descriptor.m_pAsterixData;
-        Descriptor.m_pAsterixData = nullptr;
+    std::vector<unsigned char> &data = Descriptor.m_WriteBuffer;
+    data.clear();
+    if (!CAsterixRawSubformat::AppendPacketData(Descriptor, data)) {
+        return true; // everything filtered out
     }
 
-    // Parse ASTERIX data
-    if (oradis) {
-        parseOradisData(Descriptor, pPacketPtr, dataLength, nTimestamp);
-    } else {
-        Descriptor.m_pAsterixData = Descriptor.m_InputParser.parsePacket(pPacketPtr, dataLength, nTimestamp);
+    return CAsterixRawSubformat::WriteSplit(device, data.data(), data.size(),
+                                            [&Descriptor, &device](const unsigned char *p, size_t n) {
+                                                return writeRecord(Descriptor, device, p, n);
+                                            });
+}
+
+/*
+ * Write one PCAP record (and file header at start of output) with given ASTERIX data
+ */
+bool CAsterixPcapSubformat::writeRecord(CAsterixFormatDescriptor &Descriptor, CBaseDevice &device,
+                                        const unsigned char *pData, size_t dataLen) {
+    std::vector<unsigned char> &buffer = Descriptor.m_FrameBuffer;
+    buffer.clear();
+
+    if (device.IsOnStart()) {
+        pcap_hdr_t fileHeader;
+        fileHeader.magic_number = 0xA1B2C3D4;
+        fileHeader.version_major = 2;
+        fileHeader.version_minor = 4;
+        fileHeader.thiszone = 0;
+        fileHeader.sigfigs = 0;
+        fileHeader.snaplen = 65535;
+        fileHeader.network = 1; // Ethernet
+        const unsigned char *p = reinterpret_cast<const unsigned char *>(&fileHeader);
+        buffer.insert(buffer.end(), p, p + sizeof(fileHeader));
     }
 
-    return true;
-}
+    const size_t recPos = buffer.size();
+    buffer.resize(recPos + sizeof(pcaprec_hdr_t));
+    const size_t ipPos = appendFrameHeader(Descriptor, buffer);
+    const size_t udpPos = buffer.size() - UDP_HEADER_SIZE;
+
+    buffer.insert(buffer.end(), pData, pData + dataLen);
+
+    const size_t udpLength = buffer.size() - udpPos;
+    const size_t ipLength = buffer.size() - ipPos;
+    if (ipLength > 65535) {
+        LOGERROR(1, "Packet too big for PCAP output (%u bytes)\n", static_cast<unsigned int>(ipLength));
+        return false;
+    }
+
+    // IPv4 header: total length, fragmentation cleared (data is written reassembled), checksum
+    unsigned char *pIP = &buffer[ipPos];
+    const unsigned int IPheaderLength = (pIP[0] & 0x0F) * 4;
+    pIP[2] = static_cast<unsigned char>(ipLength >> 8);
+    pIP[3] = static_cast<unsigned char>(ipLength);
+    pIP[6] &= 0x40; // keep only don't fragment flag
+    pIP[7] = 0;
+    pIP[10] = pIP[11] = 0;
+    const unsigned int ipSum = ~onesSum(pIP, IPheaderLength) & 0xFFFF;
+    pIP[10] = static_cast<unsigned char>(ipSum >> 8);
+    pIP[11] = static_cast<unsigned char>(ipSum);
+
+    // UDP header: length and checksum (with pseudo header of source, destination, protocol and length)
+    unsigned char *pUDP = &buffer[udpPos];
+    pUDP[4] = static_cast<unsigned char>(udpLength >> 8);
+    pUDP[5] = static_cast<unsigned char>(udpLength);
+    pUDP[6] = pUDP[7] = 0;
+    unsigned int udpSum = onesSum(pIP + 12, 8, 17 + static_cast<unsigned int>(udpLength));
+    udpSum = ~onesSum(pUDP, udpLength, udpSum) & 0xFFFF;
+    if (udpSum == 0) {
+        udpSum = 0xFFFF;
+    }
+    pUDP[6] = static_cast<unsigned char>(udpSum >> 8);
+    pUDP[7] = static_cast<unsigned char>(udpSum);
+
+    // Record header with capture time in microseconds
+    const double packetTime = Descriptor.GetTimeStamp();
+    pcaprec_hdr_t recHeader;
+    recHeader.ts_sec = static_cast<unsigned int>(packetTime);
+    recHeader.ts_usec = static_cast<unsigned int>((packetTime - recHeader.ts_sec) * 1000000 + 0.5);
+    if (recHeader.ts_usec >= 1000000) {
+        recHeader.ts_sec++;
+        recHeader.ts_usec -= 1000000;
+    }
+    recHeader.incl_len = recHeader.orig_len = static_cast<unsigned int>(buffer.size() - recPos - sizeof(recHeader));
+    memcpy(&buffer[recPos], &recHeader, sizeof(recHeader));
 
-bool CAsterixPcapSubformat::WritePacket([[maybe_unused]] CBaseFormatDescriptor &formatDescriptor, [[maybe_unused]] CBaseDevice &device, [[maybe_unused]] bool &discard,
-                                        [[maybe_unused]] bool oradis) {
-    return false; //TODO
+    return device.Write(buffer.data(), buffer.size());
 }
 
 bool CAsterixPcapSubformat::ProcessPacket([[maybe_unused]] CBaseFormatDescriptor &formatDescriptor, [[maybe_unused]] CBaseDevice &device, [[maybe_unused]] bool &discard,
@@ -25,9 +25,7 @@
 #define ASTERIXPCAPSUBFORMAT_HXX__
 
 #include <ctime>
-#ifdef _WIN32
-typedef unsigned long useconds_t;
-#endif
+#include <vector>
 
 class CBaseDevice;
 
@@ -42,6 +40,9 @@ class InputParser;
  * @brief Asterix pcap sub-format
  *
  * Specifies format of Asterix message.
+ * Reads classic libpcap files (microsecond and nanosecond resolution, either byte order)
+ * and pcapng files (SHB/IDB/EPB/SPB blocks, several interfaces and sections), one block at a time.
+ * Writes classic libpcap files (Ethernet link type), keeping capture time and headers of the packets read.
  *
  */
 class CAsterixPcapSubformat {
@@ -77,41 +78,48 @@ private:
         unsigned int orig_len;       /* actual length of packet */
     } pcaprec_hdr_t;
 
+    // PCAPNG block types
+    enum {
+        PCAPNG_IDB = 0x00000001,    // Interface Description Block
+        PCAPNG_OPB = 0x00000002,    // Packet Block (obsolete)
+        PCAPNG_SPB = 0x00000003,    // Simple Packet Block
+        PCAPNG_EPB = 0x00000006,    // Enhanced Packet Block
+        PCAPNG_SHB = 0x0A0D0D0A     // Section Header Block
+    };
+
+    static const unsigned int PCAPNG_MAX_BLOCK_SIZE = 16 * 1024 * 1024;
+    static const unsigned int ETHERNET_HEADER_SIZE = 14;
+    static const unsigned int UDP_HEADER_SIZE = 8;
+
     // Helper methods to reduce cognitive complexity of ReadPacket
     static bool readPcapFileHeader(CAsterixFormatDescriptor &Descriptor, CBaseDevice &device);
-    static void handleSynchronousDelay(const pcaprec_hdr_t &recHeader,
-                                       time_t &lastFileTimeSec, useconds_t &lastFileTimeUSec,
-                                       time_t &lastMyTimeSec, useconds_t &lastMyTimeUSec);
-    static unsigned char* parseNetworkHeader(unsigned char *pPacketBuffer,
-                                             CAsterixFormatDescriptor &Descriptor,
-                                             bool &bIPInvertByteOrder);
-    static bool parseIPHeader(unsigned char *&pPacketPtr, bool bIPInvertByteOrder,
-                              unsigned short &IPtotalLength);
-    static bool parseUDPHeader(unsigned char *&pPacketPtr, bool bIPInvertByteOrder,
-                               unsigned short IPtotalLength, unsigned short &dataLength);
+    static bool readPcapRecord(CAsterixFormatDescriptor &Descriptor, CBaseDevice &device,
+                               pcaprec_hdr_t &recHeader, unsigned char *&pPacket, double &packetTime);
+    static bool readPcapNgSectionHeader(CAsterixFormatDescriptor &Descriptor, CBaseDevice &device,
+                                        const unsigned char *pStart, unsigned int startLen);
+    static bool readPcapNgBlock(CAsterixFormatDescriptor &Descriptor, CBaseDevice &device,
+                                pcaprec_hdr_t &recHeader, unsigned char *&pPacket, double &packetTime);
+    static void parsePcapNgInterface(CAsterixFormatDescriptor &Descriptor, const unsigned char *pBody,
+                                     unsigned int bodyLen);
+    static const unsigned char* parseNetworkHeader(const unsigned char *pPacketBuffer, unsigned int packetLen,
+                                                   CAsterixFormatDescriptor &Descriptor, unsigned int &ipLen);
+    static const unsigned char* parseIPHeader(CAsterixFormatDescriptor &Descriptor,
+                                              const unsigned char *pPacketPtr, unsigned int ipLen,
+                                              double packetTime, unsigned int &payloadLen, bool &bPending);
+    static bool parseUDPHeader(const unsigned char *&pPacketPtr, unsigned int payloadLen,
+                               unsigned short &dataLength);
     static void parseOradisData(CAsterixFormatDescriptor &Descriptor,
-                                unsigned char *pPacketPtr, unsigned short dataLength,
+                                const unsigned char *pPacketPtr, unsigned short dataLength,
                                 unsigned long nTimestamp);
-
-    static short convert_short(short in) {
-        short out;
-        auto* p_in = reinterpret_cast<char*>(&in);
-        auto* p_out = reinterpret_cast<char*>(&out);
-        p_out[0] = p_in[1];
-        p_out[1] = p_in[0];
-        return out;
-    }
-
-    static long convert_long(long in) {
-        long out;
-        auto* p_in = reinterpret_cast<char*>(&in);
-        auto* p_out = reinterpret_cast<char*>(&out);
-        p_out[0] = p_in[3];
-        p_out[1] = p_in[2];
-        p_out[2] = p_in[1];
-        p_out[3] = p_in[0];
-        return out;
-    }
+    static void storeFrameHeader(CAsterixFormatDescriptor &Descriptor, const unsigned char *pPacketBuffer,
+                                 const unsigned char *pIPHeader, const unsigned char *pUDPHeader);
+    static size_t appendFrameHeader(const CAsterixFormatDescriptor &Descriptor, std::vector<unsigned char> &buffer);
+    static bool writeRecord(CAsterixFormatDescriptor &Descriptor, CBaseDevice &device,
+                            const unsigned char *pData, size_t dataLen);
+    static void resolveRange(CAsterixFormatDescriptor &Descriptor, double firstTime);
+    static void seekToRange(CAsterixFormatDescriptor &Descriptor, CBaseDevice &device);
+    static bool seekToResume(CAsterixFormatDescriptor &Descriptor, CBaseDevice &device);
+    static int checkRange(CAsterixFormatDescriptor &Descriptor, double packetTime);
 };
 
 #endif
@@ -23,6 +23,7 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <memory>
 #ifdef _WIN32
   #include <winsock2.h>
   #include <time.h>
@@ -53,6 +54,72 @@
 #include "AsterixDefinition.h"
 #include "InputParser.h"
 
+extern bool gFiltering;
+extern bool gDecodeInput;
+extern int64_t gResumeOffset;
+
+namespace {
+    /*
+     * Split key of data block: category from block header, SAC/SIC from the first
+     * record if its first FSPEC bit (I010 in standard UAPs) is set
+     */
+    SSplitKey blockKey(const unsigned char *pBlock, size_t blockLen) {
+        SSplitKey key = {pBlock[0], -1, -1};
+        size_t pos = 3;
+        while (pos < blockLen && (pBlock[pos] & 0x01)) {
+            pos++;
+        }
+        if (blockLen > 3 && (pBlock[3] & 0x80) && pos + 2 < blockLen) {
+            key.sac = pBlock[pos + 1];
+            key.sic = pBlock[pos + 2];
+        }
+        return key;
+    }
+
+    bool operator==(const SSplitKey &a, const SSplitKey &b) {
+        return a.cat == b.cat && a.sac == b.sac && a.sic == b.sic;
+    }
+
+    /*
+     * Read data blocks from stream device (TCP, serial line) through framer,
+     * packet data points into framer buffer
+     */
+    bool readStream(CAsterixFormatDescriptor &Descriptor, CBaseDevice &device) {
+        if (!Descriptor.m_pFramer) {
+            // accept blocks of defined categories only (all if nothing is defined),
+            // registered categories are not loaded before they are received
+            Descriptor.m_pFramer = std::make_unique<CStreamFramer>(Descriptor.FramedCategories());
+        }
+        CStreamFramer &framer = *Descriptor.m_pFramer;
+
+        const uint64_t nResync = framer.GetNResync();
+        const uint64_t nSkipped = framer.GetNSkipped();
+        unsigned int len = 0;
+        const unsigned char *pBlocks;
+        while ((pBlocks = framer.NextBlocks(len)) == nullptr) {
+            size_t readSize = 0;
+            unsigned char *pBuffer = framer.GetWriteBuffer(readSize);
+            if (!device.Read(pBuffer, &readSize)) {
+                framer.Reset(); // data of next connection is not continuation
+                return false;
+            }
+            if (readSize == 0) {
+                return false;
+            }
+            framer.Commit(readSize);
+        }
+
+        if (framer.GetNResync() != nResync || framer.GetNSkipped() != nSkipped) {
+            LOGWARNING(1, "Lost synchronization on input stream, %llu bytes skipped.\n",
+                       static_cast<unsigned long long>(framer.GetNSkipped() - nSkipped));
+        }
+
+        Descriptor.m_pPacketData = pBlocks;
+        Descriptor.m_nPacketDataLen = len;
+        return true;
+    }
+}
+
 /*
  * Read packet and store it in Descriptor.m_pBuffer
  */
@@ -61,7 +128,9 @@ bool CAsterixRawSubformat::ReadPacket(CBaseFormatDescriptor &formatDescriptor, C
     auto &Descriptor = static_cast<CAsterixFormatDescriptor &>(formatDescriptor);
     size_t readSize = 0;
 
-    if (device.IsPacketDevice()) { // if using packet device read complete packet
+    if (device.IsStreamDevice() && !oradis) { // stream device, cut data blocks from received bytes
+        return readStream(Descriptor, device);
+    } else if (device.IsPacketDevice()) { // if using packet device read complete packet
         readSize = device.MaxPacketSize();
 
         unsigned char *pBuffer = Descriptor.GetNewBuffer(readSize);
@@ -78,6 +147,17 @@ bool CAsterixRawSubformat::ReadPacket(CBaseFormatDescriptor &formatDescriptor, C
             LOGERROR(1, "Packet too big! Size = %d, limit = %d.\n", Descriptor.GetBufferLen(), device.MaxPacketSize());
         }
     } else { // if this is not packet device (e.g. it is file), read one by one Asterix record
+        // Continue resumed conversion
+        if (gResumeOffset > 0 && device.IsOnStart()) {
+            const int64_t offset = gResumeOffset;
+            gResumeOffset = 0;
+            if (!device.IoCtrl(CBaseDevice::ESeek, &offset, sizeof(offset))) {
+                LOGERROR(1, "Cannot resume reading at offset %lld\n", static_cast<long long>(offset));
+                return false;
+            }
+            LOGNOTIFY(gVerbose, "Resuming input at offset %lld\n", static_cast<long long>(offset));
+        }
+
         int leftBytes = device.BytesLeftToRead();
 
         if (oradis) {
@@ -153,20 +233,105 @@ bool CAsterixRawSubformat::ReadPacket(CBaseFormatDescriptor &formatDescriptor, C
     return true;
 }
 
-bool CAsterixRawSubformat::WritePacket([[maybe_unused]] CBaseFormatDescriptor &formatDescriptor, [[maybe_unused]] CBaseDevice &device, [[maybe_unused]] bool &discard,
-                                       [[maybe_unused]] bool oradis) {
-    return false; //TODO
+bool CAsterixRawSubformat::AppendPacketData(CAsterixFormatDescriptor &Descriptor, std::vector<unsigned char> &buffer) {
+    if (!gFiltering && Descriptor.m_pPacketData != nullptr) {
+        buffer.insert(buffer.end(), Descriptor.m_pPacketData, Descriptor.m_pPacketData + Descriptor.m_nPacketDataLen);
+        return Descriptor.m_nPacketDataLen > 0;
+    }
+
+    return Descriptor.m_pAsterixData != nullptr && Descriptor.m_pAsterixData->getBinary(buffer);
+}
+
+/*
+ * Write ASTERIX data blocks of the last packet read (one write per packet)
+ */
+bool CAsterixRawSubformat::WritePacket(CBaseFormatDescriptor &formatDescriptor, CBaseDevice &device, [[maybe_unused]] bool &discard,
+                                       bool oradis) {
+    auto &Descriptor = static_cast<CAsterixFormatDescriptor &>(formatDescriptor);
+
+    if (oradis) {
+        LOGERROR(1, "Writing ORADIS format is not supported.\n");
+        return false;
+    }
+
+    std::vector<unsigned char> &buffer = Descriptor.m_WriteBuffer;
+    buffer.clear();
+    if (!AppendPacketData(Descriptor, buffer)) {
+        return true; // everything filtered out
+    }
+
+    return WriteSplit(device, buffer.data(), buffer.size(), [&device](const unsigned char *p, size_t n) {
+        return device.Write(p, n);
+    });
+}
+
+bool CAsterixRawSubformat::WriteSplit(CBaseDevice &device, const unsigned char *pData, size_t len,
+                                      const std::function<bool(const unsigned char *, size_t)> &write) {
+    if (len < 3) {
+        return write(pData, len);
+    }
+
+    // Blocks of the packet: key, offset and length
+    struct SBlock {
+        SSplitKey key;
+        size_t pos;
+        size_t len;
+    };
+    std::vector<SBlock> blocks;
+    bool single = true;
+    size_t pos = 0;
+    while (pos < len) {
+        size_t blockLen = len - pos;
+        if (blockLen >= 3) {
+            const size_t headerLen = (static_cast<size_t>(pData[pos + 1]) << 8) | pData[pos + 2];
+            if (headerLen >= 3 && headerLen < blockLen) {
+                blockLen = headerLen;
+            }
+        }
+        blocks.push_back({blockKey(pData + pos, blockLen), pos, blockLen});
+        single = single && blocks.back().key == blocks.front().key;
+        pos += blockLen;
+    }
+
+    if (!device.IoCtrl(CBaseDevice::ESelectOutput, &blocks.front().key, sizeof(SSplitKey))) {
+        return write(pData, len); // device does not split output
+    }
+    if (single) {
+        return write(pData, len);
+    }
+
+    // Write each group in order of first appearance
+    bool result = true;
+    std::vector<unsigned char> group;
+    std::vector<bool> done(blocks.size(), false);
+    for (size_t i = 0; i < blocks.size(); i++) {
+        if (done[i]) {
+            continue;
+        }
+        group.clear();
+        for (size_t j = i; j < blocks.size(); j++) {
+            if (!done[j] && blocks[j].key == blocks[i].key) {
+                group.insert(group.end(), pData + blocks[j].pos, pData + blocks[j].pos + blocks[j].len);
+                done[j] = true;
+            }
+        }
+        if (!device.IoCtrl(CBaseDevice::ESelectOutput, &blocks[i].key, sizeof(SSplitKey)) ||
+            !write(group.data(), group.size())) {
+            result = false;
+        }
+    }
+    return result;
 }
 
 /*
  * Parse packet read from UDP and stored to Descriptor.m_pBuffer
  */
-bool CAsterixRawSubformat::ProcessPacket(CBaseFormatDescriptor &formatDescriptor, [[maybe_unused]] CBaseDevice &device, [[maybe_unused]] bool &discard,
+bool CAsterixRawSubformat::ProcessPacket(CBaseFormatDescriptor &formatDescriptor, CBaseDevice &device, [[maybe_unused]] bool &discard,
                                          bool oradis) {
     auto &Descriptor = static_cast<CAsterixFormatDescriptor &>(formatDescriptor);
 
-    // check data size
-    if (Descriptor.GetBufferLen() < 3) {
+    // check data size (data blocks from stream device are already in framer buffer)
+    if ((Descriptor.m_pPacketData ? Descriptor.m_nPacketDataLen : Descriptor.GetBufferLen()) < 3) {
         LOGERROR(1, "Packet too small.\n");
         return false;
     }
@@ -177,10 +342,14 @@ bool CAsterixRawSubformat::ProcessPacket(CBaseFormatDescriptor &formatDescriptor
         Descriptor.m_pAsterixData = nullptr;
     }
 
-    // get current timstamp in ms since midnight
-    struct timeval tp;
-    gettimeofday(&tp, nullptr);
-    double dTimestamp = tp.tv_sec + (1.0/1000000.0) * tp.tv_usec;
+    // use receive time if known by device, otherwise current time
+    double dTimestamp = device.GetPacketTime();
+    if (dTimestamp <= 0) {
+        struct timeval tp;
+        gettimeofday(&tp, nullptr);
+        dTimestamp = tp.tv_sec + (1.0/1000000.0) * tp.tv_usec;
+    }
+    Descriptor.SetTimeStamp(dTimestamp);
 
     // parse packet
     if (oradis) {
@@ -223,8 +392,14 @@ bool CAsterixRawSubformat::ProcessPacket(CBaseFormatDescriptor &formatDescriptor
             m_nDataLength -= byteCount;
         }
     } else {
-        Descriptor.m_pAsterixData = Descriptor.m_InputParser.parsePacket(Descriptor.GetBuffer(),
-                                                                         Descriptor.GetBufferLen(), dTimestamp);
+        if (Descriptor.m_pPacketData == nullptr) {
+            Descriptor.m_pPacketData = Descriptor.GetBuffer();
+            Descriptor.m_nPacketDataLen = Descriptor.GetBufferLen();
+        }
+        if (gDecodeInput) {
+            Descriptor.m_pAsterixData = Descriptor.m_InputParser.parsePacket(Descriptor.m_pPacketData,
+                                                                             Descriptor.m_nPacketDataLen, dTimestamp);
+        }
     }
 
     return true;
@@ -23,8 +23,14 @@
 #ifndef ASTERIXRAWSUBFORMAT_HXX__
 #define ASTERIXRAWSUBFORMAT_HXX__
 
+#include <cstddef>
+#include <functional>
+#include <vector>
+
 class CBaseDevice;
 
+class CAsterixFormatDescriptor;
+
 /**
  * @class CAsterixInSubformat
  *
@@ -47,6 +53,22 @@ public:
 
     static bool Heartbeat(CBaseFormatDescriptor &formatDescriptor, CBaseDevice &device, bool oradis = false);
 
+    /**
+     * Append ASTERIX data of the last packet read to buffer: as read if nothing is filtered,
+     * otherwise only data blocks and records passing the filter.
+     * Returns false if there is nothing to write.
+     */
+    static bool AppendPacketData(CAsterixFormatDescriptor &Descriptor, std::vector<unsigned char> &buffer);
+
+    /**
+     * Write ASTERIX data blocks with given write function. If the device selects outputs
+     * (IoCtrl ESelectOutput, e.g. split device) blocks are grouped by category and SAC/SIC
+     * of their first record, taken from the data without decoding, and each group is
+     * written to its output. Otherwise all data is written at once.
+     */
+    static bool WriteSplit(CBaseDevice &device, const unsigned char *pData, size_t len,
+                           const std::function<bool(const unsigned char *, size_t)> &write);
+
 private:
 
 };
@@ -0,0 +1,302 @@
+/*
+ *  Copyright (c) 2013 Croatia Control Ltd. (www.crocontrol.hr)
+ *
+ *  This file is part of Asterix.
+ *
+ *  Asterix is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Asterix is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Asterix.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+
+#include "asterixvalidator.hxx"
+#include "AsterixDefinition.h"
+#include "Category.h"
+#include "DataItemDescription.h"
+#include "UAP.h"
+#include "UAPItem.h"
+#include "Utils.h"
+
+namespace {
+    int64_t now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+
+CAsterixValidator::CAsterixValidator(AsterixDefinition *pDefinition, const std::string &name)
+        : _pDefinition(pDefinition), _name(name), _categories(256), _definitions(256, nullptr),
+          _packetErrors(0), _nPackets(0), _nBytes(0), _nMalformed(0), _startTime(0), _lastTime(0) {
+}
+
+
+CAsterixValidator::~CAsterixValidator() = default;
+
+
+const CAsterixValidator::SUAPItems &CAsterixValidator::uapItems(int cat, const UAP *pUAP) {
+    auto it = _uapItems.find(pUAP);
+    if (it != _uapItems.end()) {
+        return it->second;
+    }
+
+    // map FRNs to item descriptions once
+    SUAPItems &uapItems = _uapItems[pUAP];
+    std::vector<SItem> &items = _categories[cat].items;
+    for (const UAPItem *pItem : pUAP->m_lUAPItems) {
+        if (pItem == nullptr || pItem->m_nFRN <= 0) {
+            continue;
+        }
+        const DataItemDescription *pDescription = _definitions[cat]->findDataItemDescription(pItem->m_strItemID);
+        if (pDescription == nullptr || pDescription->m_pFormat == nullptr) {
+            continue;
+        }
+
+        int index = 0;
+        while (index < static_cast<int>(items.size()) && items[index].pDescription != pDescription) {
+            index++;
+        }
+        if (index == static_cast<int>(items.size())) {
+            items.push_back({pDescription, 0});
+        }
+
+        if (uapItems.index.size() <= static_cast<size_t>(pItem->m_nFRN)) {
+            uapItems.index.resize(pItem->m_nFRN + 1, -1);
+        }
+        uapItems.index[pItem->m_nFRN] = index;
+    }
+    return uapItems;
+}
+
+
+void CAsterixValidator::addError(int cat, uint64_t packetNo, unsigned int offset, const std::string &description) {
+    _categories[cat].nMalformed++;
+    _nMalformed++;
+    if (_errors.size() < MAX_ERRORS) {
+        _errors.push_back({packetNo, offset, -1, cat, description});
+    }
+}
+
+
+bool CAsterixValidator::validateBlock(int cat, const unsigned char *data, unsigned int len, uint64_t packetNo,
+                                      unsigned int offset) {
+    Category *pCategory = _definitions[cat];
+    SCategory &stats = _categories[cat];
+    unsigned int pos = 0;
+    int nRecord = 0;
+
+    while (pos < len) {
+        const unsigned char *pRecord = data + pos;
+        const unsigned int left = len - pos;
+        nRecord++;
+
+        const UAP *pUAP = pCategory->getUAP(pRecord, left);
+        if (pUAP == nullptr) {
+            addError(cat, packetNo, offset + pos, format("record %d: UAP not found", nRecord));
+            return false;
+        }
+        const SUAPItems &items = uapItems(cat, pUAP);
+
+        // FSPEC
+        _present.clear();
+        unsigned int fspecLen = 0;
+        int frn = 1;
+        bool bLast = false;
+        while (!bLast) {
+            if (fspecLen >= left) {
+                addError(cat, packetNo, offset + pos, format("record %d: FSPEC exceeds data block", nRecord));
+                return false;
+            }
+            const unsigned char fspec = pRecord[fspecLen++];
+            bLast = (fspec & 0x01) == 0;
+            for (unsigned int bitmask = 0x80; bitmask > 1; bitmask >>= 1, frn++) {
+                if (fspec & bitmask) {
+                    const int index = static_cast<size_t>(frn) < items.index.size() ? items.index[frn] : -1;
+                    if (index < 0) {
+                        addError(cat, packetNo, offset + pos, format("record %d: item for FRN %d not defined",
+                                                                     nRecord, frn));
+                        return false;
+                    }
+                    _present.push_back(index);
+                }
+            }
+        }
+
+        // items
+        unsigned int recordLen = fspecLen;
+        for (const int index : _present) {
+            const DataItemDescription *pDescription = stats.items[index].pDescription;
+            const long itemLen = pDescription->m_pFormat->getLength(pRecord + recordLen);
+            if (itemLen <= 0 || itemLen > static_cast<long>(left - recordLen)) {
+                addError(cat, packetNo, offset + pos, format("record %d: wrong length of item I%s",
+                                                             nRecord, pDescription->m_strID.c_str()));
+                return false;
+            }
+            recordLen += static_cast<unsigned int>(itemLen);
+        }
+
+        // records without items (padding) are not counted
+        if (!_present.empty()) {
+            stats.nRecords++;
+            for (const int index : _present) {
+                stats.items[index].nPresent++;
+            }
+        }
+        pos += recordLen;
+    }
+    return true;
+}
+
+
+unsigned int CAsterixValidator::Validate(const unsigned char *data, unsigned int len, uint64_t packetNo) {
+    _lastTime = now();
+    if (_nPackets == 0) {
+        _startTime = _lastTime;
+    }
+    _nPackets++;
+    _nBytes += len;
+    _packetErrors = _errors.size();
+    if (packetNo == 0) {
+        packetNo = _nPackets;
+    }
+
+    const uint64_t nMalformed = _nMalformed;
+    unsigned int pos = 0;
+    while (pos < len) {
+        const int cat = data[pos];
+        if (!_resolved[cat]) {
+            // looked up on first use, so categories not in the data are not loaded
+            _resolved[cat] = true;
+            if (_pDefinition->CategoryDefined(cat)) {
+                _definitions[cat] = _pDefinition->getCategory(cat);
+            }
+        }
+        if (len - pos < 3) {
+            addError(cat, packetNo, pos, "data block header truncated");
+            break;
+        }
+        const unsigned int blockLen = (static_cast<unsigned int>(data[pos + 1]) << 8) | data[pos + 2];
+        if (blockLen <= 3 || blockLen > len - pos) {
+            addError(cat, packetNo, pos, format("wrong data block length %u", blockLen));
+            break;
+        }
+
+        SCategory &stats = _categories[cat];
+        stats.nBlocks++;
+        stats.nBytes += blockLen;
+        if (_definitions[cat] != nullptr) {
+            validateBlock(cat, data + pos + 3, blockLen - 3, packetNo, pos + 3);
+        }
+        pos += blockLen;
+    }
+    return static_cast<unsigned int>(_nMalformed - nMalformed);
+}
+
+
+void CAsterixValidator::SetInputOffset(int64_t offset) {
+    for (size_t i = _packetErrors; i < _errors.size(); i++) {
+        _errors[i].inputOffset = offset + _errors[i].packetOffset;
+    }
+}
+
+
+void CAsterixValidator::SetDefinition(AsterixDefinition *pDefinition) {
+    for (int cat = 0; cat < 256; cat++) {
+        std::vector<SItem> &items = _categories[cat].items;
+        if (items.empty()) {
+            continue;
+        }
+        Category *pCategory = pDefinition->CategoryDefined(cat) ? pDefinition->getCategory(cat) : nullptr;
+        for (SItem &item : items) {
+            const DataItemDescription *pDescription =
+                    pCategory ? pCategory->findDataItemDescription(item.pDescription->m_strID) : nullptr;
+            if (pDescription == nullptr) {
+                // keep ID and name for the report
+                auto pRemoved = std::make_unique<DataItemDescription>(item.pDescription->m_strID);
+                pRemoved->m_strName = item.pDescription->m_strName;
+                pDescription = pRemoved.get();
+                _removedItems.push_back(std::move(pRemoved));
+            }
+            item.pDescription = pDescription;
+        }
+    }
+
+    _pDefinition = pDefinition;
+    std::fill(_definitions.begin(), _definitions.end(), nullptr);
+    _resolved.reset();
+    _uapItems.clear();
+}
+
+
+void CAsterixValidator::Report(FILE *f) const {
+    const double seconds = (_lastTime - _startTime) / 1e9;
+    uint64_t nBlocks = 0;
+    uint64_t nRecords = 0;
+    for (const SCategory &stats : _categories) {
+        nBlocks += stats.nBlocks;
+        nRecords += stats.nRecords;
+    }
+
+    fprintf(f, "Validation of %s: %s\n", _name.c_str(), _nMalformed == 0 ? "OK" : "MALFORMED DATA");
+    fprintf(f, "  %llu packets, %llu bytes, %llu data blocks, %llu records, %llu malformed\n",
+            static_cast<unsigned long long>(_nPackets), static_cast<unsigned long long>(_nBytes),
+            static_cast<unsigned long long>(nBlocks), static_cast<unsigned long long>(nRecords),
+            static_cast<unsigned long long>(_nMalformed));
+    if (seconds > 0) {
+        fprintf(f, "  %.3f s, %.1f MB/s, %.0f records/s\n", seconds, _nBytes / seconds / 1e6, nRecords / seconds);
+    }
+
+    fprintf(f, "\n  CAT    Blocks     Records   Malformed       Bytes\n");
+    for (int cat = 0; cat < 256; cat++) {
+        const SCategory &stats = _categories[cat];
+        if (stats.nBlocks == 0 && stats.nMalformed == 0) {
+            continue;
+        }
+        fprintf(f, "  %03d %9llu %11llu %11llu %11llu%s\n", cat, static_cast<unsigned long long>(stats.nBlocks),
+                static_cast<unsigned long long>(stats.nRecords), static_cast<unsigned long long>(stats.nMalformed),
+                static_cast<unsigned long long>(stats.nBytes),
+                _definitions[cat] == nullptr ? "  (not defined, not validated)" : "");
+    }
+
+    for (int cat = 0; cat < 256; cat++) {
+        const SCategory &stats = _categories[cat];
+        if (stats.nRecords == 0) {
+            continue;
+        }
+        fprintf(f, "\n  CAT%03d item presence:\n", cat);
+        for (const SItem &item : stats.items) {
+            if (item.nPresent > 0) {
+                fprintf(f, "    I%-8s %11llu %6.1f%%  %s\n", item.pDescription->m_strID.c_str(),
+                        static_cast<unsigned long long>(item.nPresent), 100.0 * item.nPresent / stats.nRecords,
+                        item.pDescription->m_strName.c_str());
+            }
+        }
+    }
+
+    if (!_errors.empty()) {
+        fprintf(f, "\n  Malformed data%s:\n", _nMalformed > _errors.size() ? " (first errors)" : "");
+        for (const SError &error : _errors) {
+            if (error.inputOffset >= 0) {
+                fprintf(f, "    packet %llu, input offset %lld: CAT%03d %s\n",
+                        static_cast<unsigned long long>(error.packet), static_cast<long long>(error.inputOffset),
+                        error.category, error.description.c_str());
+            } else {
+                fprintf(f, "    packet %llu, packet offset %u: CAT%03d %s\n",
+                        static_cast<unsigned long long>(error.packet), error.packetOffset, error.category,
+                        error.description.c_str());
+            }
+        }
+    }
+}
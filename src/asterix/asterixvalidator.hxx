@@ -0,0 +1,146 @@
+/*
+ *  Copyright (c) 2013 Croatia Control Ltd. (www.crocontrol.hr)
+ *
+ *  This file is part of Asterix.
+ *
+ *  Asterix is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Asterix is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Asterix.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef ASTERIXVALIDATOR_HXX__
+#define ASTERIXVALIDATOR_HXX__
+
+#include <stdio.h>
+#include <bitset>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class AsterixDefinition;
+class Category;
+class DataItemDescription;
+class UAP;
+
+/**
+ * @class CAsterixValidator
+ *
+ * @brief Checks structure of ASTERIX data and collects statistics (--validate).
+ *
+ * Walks data blocks and records like the parser (UAP selection, FSPEC and
+ * item lengths from DataItemFormat::getLength()) but does not create
+ * DataBlock/DataRecord objects or decode item contents. Item descriptions
+ * are looked up once per UAP and FRN.
+ *
+ * Collects per category block, record and malformed record counts, item
+ * presence counts and the first MAX_ERRORS malformed records or blocks
+ * with their position. A malformed record ends validation of its block,
+ * a malformed block header ends validation of the packet.
+ */
+class CAsterixValidator {
+public:
+    static constexpr unsigned int MAX_ERRORS = 100; // malformed records listed in report
+
+    struct SItem {
+        const DataItemDescription *pDescription;
+        uint64_t nPresent;
+    };
+
+    struct SCategory {
+        uint64_t nBlocks;
+        uint64_t nRecords;
+        uint64_t nMalformed;     // malformed records and blocks
+        uint64_t nBytes;
+        std::vector<SItem> items; // in order of first UAP position
+    };
+
+    struct SError {
+        uint64_t packet;
+        unsigned int packetOffset; // offset in packet data
+        int64_t inputOffset;       // offset in input file (-1 if not known)
+        int category;
+        std::string description;
+    };
+
+    /**
+     * @param pDefinition Category definitions
+     * @param name Input name used in the report
+     */
+    CAsterixValidator(AsterixDefinition *pDefinition, const std::string &name = "input");
+
+    ~CAsterixValidator();
+
+    /**
+     * Validate packet data (one or more data blocks).
+     * @param packetNo Packet number used in report (0 = count packets)
+     * @return number of malformed records and blocks found in the packet
+     */
+    unsigned int Validate(const unsigned char *data, unsigned int len, uint64_t packetNo = 0);
+
+    /**
+     * Set input file offset of packet data validated last, for its errors.
+     */
+    void SetInputOffset(int64_t offset);
+
+    /**
+     * Validate following packets with another definition (e.g. reloaded).
+     * Statistics are kept, item descriptions are looked up in the new
+     * definition, so the previous one may be deleted afterwards.
+     */
+    void SetDefinition(AsterixDefinition *pDefinition);
+
+    uint64_t GetNPackets() const { return _nPackets; }
+
+    uint64_t GetNMalformed() const { return _nMalformed; }
+
+    const SCategory &GetCategory(int cat) const { return _categories[cat & 0xFF]; }
+
+    const std::vector<SError> &GetErrors() const { return _errors; }
+
+    /**
+     * Print validation report.
+     */
+    void Report(FILE *f) const;
+
+private:
+    struct SUAPItems {
+        std::vector<int> index; // FRN -> index into SCategory::items (-1 if not defined)
+    };
+
+    AsterixDefinition *_pDefinition;
+    std::string _name;
+    std::vector<SCategory> _categories;
+    std::vector<Category *> _definitions; // defined categories (nullptr if not defined)
+    std::bitset<256> _resolved;          // categories looked up in _definitions
+    std::unordered_map<const UAP *, SUAPItems> _uapItems;
+    std::vector<std::unique_ptr<DataItemDescription>> _removedItems; // counted items not in the new definition
+    std::vector<int> _present; // items of record being validated
+    std::vector<SError> _errors;
+    size_t _packetErrors;     // index of first error in the last packet
+    uint64_t _nPackets;
+    uint64_t _nBytes;
+    uint64_t _nMalformed;
+    int64_t _startTime;       // ns, first packet
+    int64_t _lastTime;        // ns, last packet
+
+    const SUAPItems &uapItems(int cat, const UAP *pUAP);
+
+    // validate block data (after header), returns false if it contains malformed record
+    bool validateBlock(int cat, const unsigned char *data, unsigned int len, uint64_t packetNo, unsigned int offset);
+
+    void addError(int cat, uint64_t packetNo, unsigned int offset, const std::string &description);
+};
+
+#endif
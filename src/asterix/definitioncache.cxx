@@ -0,0 +1,495 @@
+/*
+ *  Copyright (c) 2013 Croatia Control Ltd. (www.crocontrol.hr)
+ *
+ *  This file is part of Asterix.
+ *
+ *  Asterix is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Asterix is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Asterix.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#ifdef _WIN32
+  #include <process.h>
+  #define getpid _getpid
+#else
+  #include <unistd.h>
+#endif
+#include <memory>
+
+#include "asterix.h"
+#include "definitioncache.hxx"
+#include "AsterixDefinition.h"
+#include "DataItemBits.h"
+#include "DataItemFormatBDS.h"
+#include "DataItemFormatCompound.h"
+#include "DataItemFormatExplicit.h"
+#include "DataItemFormatFixed.h"
+#include "DataItemFormatRepetitive.h"
+#include "DataItemFormatVariable.h"
+#include "UAPItem.h"
+#include "Utils.h"
+
+namespace {
+    const char CACHE_MAGIC[4] = {'A', 'X', 'D', 'C'};
+    const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+    // Cache file header, followed by payloadSize bytes of serialized categories
+    struct SCacheHeader {
+        char magic[4];
+        uint32_t version;
+        uint32_t byteOrder;
+        uint32_t nCategories;
+        uint64_t key;
+        uint64_t payloadSize;
+        uint64_t payloadHash;
+    };
+
+    // format tags
+    enum : uint8_t {
+        FORMAT_FIXED = 1,
+        FORMAT_VARIABLE,
+        FORMAT_COMPOUND,
+        FORMAT_REPETITIVE,
+        FORMAT_EXPLICIT,
+        FORMAT_BDS,
+        FORMAT_BITS
+    };
+
+    const uint64_t FNV_OFFSET = 14695981039346656037ULL;
+    const uint64_t FNV_PRIME = 1099511628211ULL;
+
+    uint64_t fnv1a(uint64_t hash, const unsigned char *data, size_t len) {
+        for (size_t i = 0; i < len; i++) {
+            hash = (hash ^ data[i]) * FNV_PRIME;
+        }
+        return hash;
+    }
+
+    class CWriter {
+    public:
+        std::string buffer;
+
+        void put(const void *data, size_t len) { buffer.append(static_cast<const char *>(data), len); }
+
+        void putU8(uint8_t v) { put(&v, sizeof(v)); }
+
+        void putI32(int32_t v) { put(&v, sizeof(v)); }
+
+        void putU32(uint32_t v) { put(&v, sizeof(v)); }
+
+        void putDouble(double v) { put(&v, sizeof(v)); }
+
+        void putString(const std::string &s) {
+            putU32(static_cast<uint32_t>(s.size()));
+            put(s.data(), s.size());
+        }
+
+        void putFormat(const DataItemFormat *pFormat);
+    };
+
+    // Reads serialized data, any read past the end clears ok
+    class CReader {
+    public:
+        CReader(const unsigned char *data, size_t len) : ok(true), _p(data), _end(data + len) {}
+
+        bool ok;
+
+        void get(void *data, size_t len) {
+            if (!ok || static_cast<size_t>(_end - _p) < len) {
+                ok = false;
+                memset(data, 0, len);
+                return;
+            }
+            memcpy(data, _p, len);
+            _p += len;
+        }
+
+        uint8_t getU8() {
+            uint8_t v;
+            get(&v, sizeof(v));
+            return v;
+        }
+
+        int32_t getI32() {
+            int32_t v;
+            get(&v, sizeof(v));
+            return v;
+        }
+
+        uint32_t getU32() {
+            uint32_t v;
+            get(&v, sizeof(v));
+            return v;
+        }
+
+        double getDouble() {
+            double v;
+            get(&v, sizeof(v));
+            return v;
+        }
+
+        std::string getString() {
+            const uint32_t len = getU32();
+            if (!ok || static_cast<size_t>(_end - _p) < len) {
+                ok = false;
+                return std::string();
+            }
+            std::string s(reinterpret_cast<const char *>(_p), len);
+            _p += len;
+            return s;
+        }
+
+        // number of list entries, each of them takes at least one byte
+        uint32_t getCount() {
+            const uint32_t n = getU32();
+            if (n > static_cast<size_t>(_end - _p)) {
+                ok = false;
+                return 0;
+            }
+            return n;
+        }
+
+        bool atEnd() const { return _p == _end; }
+
+        DataItemFormat *getFormat(DataItemFormat *pParent, int depth);
+
+    private:
+        const unsigned char *_p;
+        const unsigned char *_end;
+    };
+
+    void CWriter::putFormat(const DataItemFormat *pFormat) {
+        if (pFormat->isBits()) {
+            const auto *pBits = static_cast<const DataItemBits *>(pFormat);
+            putU8(FORMAT_BITS);
+            putI32(pBits->m_nID);
+            putString(pBits->m_strShortName);
+            putString(pBits->m_strName);
+            putI32(pBits->m_nFrom);
+            putI32(pBits->m_nTo);
+            putI32(pBits->m_eEncoding);
+            putU8(pBits->m_bIsConst);
+            putI32(pBits->m_nConst);
+            putString(pBits->m_strUnit);
+            putDouble(pBits->m_dScale);
+            putU8(pBits->m_bMaxValueSet);
+            putDouble(pBits->m_dMaxValue);
+            putU8(pBits->m_bMinValueSet);
+            putDouble(pBits->m_dMinValue);
+            putU8(pBits->m_bExtension);
+            putI32(pBits->m_nPresenceOfField);
+            putU32(static_cast<uint32_t>(pBits->m_lValue.size()));
+            for (const BitsValue *pValue : pBits->m_lValue) {
+                putI32(pValue->m_nVal);
+                putString(pValue->m_strDescription);
+            }
+            return;
+        }
+
+        if (pFormat->isFixed()) {
+            putU8(FORMAT_FIXED);
+            putI32(pFormat->m_nID);
+            putI32(static_cast<const DataItemFormatFixed *>(pFormat)->m_nLength);
+        } else if (pFormat->isVariable()) {
+            putU8(FORMAT_VARIABLE);
+            putI32(pFormat->m_nID);
+        } else if (pFormat->isCompound()) {
+            putU8(FORMAT_COMPOUND);
+            putI32(pFormat->m_nID);
+        } else if (pFormat->isRepetitive()) {
+            putU8(FORMAT_REPETITIVE);
+            putI32(pFormat->m_nID);
+        } else if (pFormat->isExplicit()) {
+            putU8(FORMAT_EXPLICIT);
+            putI32(pFormat->m_nID);
+        } else {
+            putU8(FORMAT_BDS);
+            putI32(pFormat->m_nID);
+        }
+        putU32(static_cast<uint32_t>(pFormat->m_lSubItems.size()));
+        for (const DataItemFormat *pSubItem : pFormat->m_lSubItems) {
+            putFormat(pSubItem);
+        }
+    }
+
+    DataItemFormat *CReader::getFormat(DataItemFormat *pParent, int depth) {
+        const uint8_t tag = getU8();
+        const int id = getI32();
+        if (!ok || depth > 16) {
+            ok = false;
+            return nullptr;
+        }
+
+        if (tag == FORMAT_BITS) {
+            auto *pBits = new DataItemBits(id);
+            pBits->m_pParentFormat = pParent;
+            pBits->m_strShortName = getString();
+            pBits->m_strName = getString();
+            pBits->m_nFrom = getI32();
+            pBits->m_nTo = getI32();
+            pBits->m_eEncoding = static_cast<DataItemBits::_eEncoding>(getI32());
+            pBits->m_bIsConst = getU8() != 0;
+            pBits->m_nConst = getI32();
+            pBits->m_strUnit = getString();
+            pBits->m_dScale = getDouble();
+            pBits->m_bMaxValueSet = getU8() != 0;
+            pBits->m_dMaxValue = getDouble();
+            pBits->m_bMinValueSet = getU8() != 0;
+            pBits->m_dMinValue = getDouble();
+            pBits->m_bExtension = getU8() != 0;
+            pBits->m_nPresenceOfField = getI32();
+            const uint32_t nValues = getCount();
+            for (uint32_t i = 0; i < nValues && ok; i++) {
+                const int val = getI32();
+                pBits->m_lValue.push_back(new BitsValue(val, getString()));
+            }
+            return pBits;
+        }
+
+        DataItemFormat *pFormat = nullptr;
+        switch (tag) {
+            case FORMAT_FIXED: {
+                auto *pFixed = new DataItemFormatFixed(id);
+                pFixed->m_nLength = getI32();
+                pFormat = pFixed;
+                break;
+            }
+            case FORMAT_VARIABLE:
+                pFormat = new DataItemFormatVariable(id);
+                break;
+            case FORMAT_COMPOUND:
+                pFormat = new DataItemFormatCompound(id);
+                break;
+            case FORMAT_REPETITIVE:
+                pFormat = new DataItemFormatRepetitive(id);
+                break;
+            case FORMAT_EXPLICIT:
+                pFormat = new DataItemFormatExplicit(id);
+                break;
+            case FORMAT_BDS:
+                pFormat = new DataItemFormatBDS(id);
+                break;
+            default:
+                ok = false;
+                return nullptr;
+        }
+        pFormat->m_pParentFormat = pParent;
+
+        const uint32_t nSubItems = getCount();
+        for (uint32_t i = 0; i < nSubItems && ok; i++) {
+            DataItemFormat *pSubItem = getFormat(pFormat, depth + 1);
+            if (pSubItem != nullptr) {
+                pFormat->m_lSubItems.push_back(pSubItem);
+            }
+        }
+        return pFormat;
+    }
+
+    void putCategory(CWriter &writer, const Category *pCategory) {
+        writer.putU32(pCategory->m_id);
+        writer.putString(pCategory->m_strName);
+        writer.putString(pCategory->m_strVer);
+
+        writer.putU32(static_cast<uint32_t>(pCategory->m_lDataItems.size()));
+        for (const DataItemDescription *pItem : pCategory->m_lDataItems) {
+            writer.putString(pItem->m_strID);
+            writer.putString(pItem->m_strName);
+            writer.putString(pItem->m_strDefinition);
+            writer.putString(pItem->m_strFormat);
+            writer.putString(pItem->m_strNote);
+            writer.putI32(pItem->m_eRule);
+            writer.putU8(pItem->m_pFormat != nullptr);
+            if (pItem->m_pFormat != nullptr) {
+                writer.putFormat(pItem->m_pFormat);
+            }
+        }
+
+        writer.putU32(static_cast<uint32_t>(pCategory->m_lUAPs.size()));
+        for (const UAP *pUAP : pCategory->m_lUAPs) {
+            writer.putU32(static_cast<uint32_t>(pUAP->m_nUseIfBitSet));
+            writer.putU32(static_cast<uint32_t>(pUAP->m_nUseIfByteNr));
+            writer.putU8(pUAP->m_nIsSetTo);
+            writer.putU32(static_cast<uint32_t>(pUAP->m_lUAPItems.size()));
+            for (const UAPItem *pUAPItem : pUAP->m_lUAPItems) {
+                writer.putI32(pUAPItem->m_nBit);
+                writer.putI32(pUAPItem->m_nFRN);
+                writer.putU8(pUAPItem->m_bFX);
+                writer.putI32(pUAPItem->m_nLen);
+                writer.putString(pUAPItem->m_strItemID);
+            }
+        }
+    }
+
+    Category *getCategory(CReader &reader) {
+        const uint32_t id = reader.getU32();
+        if (!reader.ok || id >= MAX_CATEGORIES) {
+            reader.ok = false;
+            return nullptr;
+        }
+        auto pCategory = std::make_unique<Category>(id);
+        pCategory->m_strName = reader.getString();
+        pCategory->m_strVer = reader.getString();
+
+        const uint32_t nItems = reader.getCount();
+        for (uint32_t i = 0; i < nItems && reader.ok; i++) {
+            auto *pItem = new DataItemDescription(reader.getString());
+            pCategory->m_lDataItems.push_back(pItem);
+            pItem->m_strName = reader.getString();
+            pItem->m_strDefinition = reader.getString();
+            pItem->m_strFormat = reader.getString();
+            pItem->m_strNote = reader.getString();
+            pItem->m_eRule = static_cast<DataItemDescription::_eRule>(reader.getI32());
+            if (reader.getU8() != 0) {
+                pItem->m_pFormat = reader.getFormat(nullptr, 0);
+            }
+        }
+
+        const uint32_t nUAPs = reader.getCount();
+        for (uint32_t i = 0; i < nUAPs && reader.ok; i++) {
+            UAP *pUAP = pCategory->newUAP();
+            pUAP->m_nUseIfBitSet = reader.getU32();
+            pUAP->m_nUseIfByteNr = reader.getU32();
+            pUAP->m_nIsSetTo = reader.getU8();
+            const uint32_t nUAPItems = reader.getCount();
+            for (uint32_t j = 0; j < nUAPItems && reader.ok; j++) {
+                UAPItem *pUAPItem = pUAP->newUAPItem();
+                pUAPItem->m_nBit = reader.getI32();
+                pUAPItem->m_nFRN = reader.getI32();
+                pUAPItem->m_bFX = reader.getU8() != 0;
+                pUAPItem->m_nLen = reader.getI32();
+                pUAPItem->m_strItemID = reader.getString();
+            }
+        }
+
+        return reader.ok ? pCategory.release() : nullptr;
+    }
+}
+
+
+bool CDefinitionCache::ComputeKey(const std::vector<std::string> &files, uint64_t &key) {
+    uint64_t hash = fnv1a(FNV_OFFSET, reinterpret_cast<const unsigned char *>(&CACHE_VERSION), sizeof(CACHE_VERSION));
+    std::vector<unsigned char> buffer(64 * 1024);
+
+    for (const std::string &file : files) {
+        FILE *f = fopen(file.c_str(), "rb");
+        if (f == nullptr) {
+            return false;
+        }
+        uint64_t size = 0;
+        size_t len;
+        while ((len = fread(buffer.data(), 1, buffer.size(), f)) > 0) {
+            hash = fnv1a(hash, buffer.data(), len);
+            size += len;
+        }
+        const bool ok = ferror(f) == 0;
+        fclose(f);
+        if (!ok) {
+            return false;
+        }
+        // file boundaries
+        hash = fnv1a(hash, reinterpret_cast<const unsigned char *>(&size), sizeof(size));
+    }
+
+    key = hash;
+    return true;
+}
+
+
+bool CDefinitionCache::Save(const char *cacheFile, uint64_t key, AsterixDefinition *pDefinition) {
+    CWriter writer;
+    uint32_t nCategories = 0;
+    for (int i = 0; i < MAX_CATEGORIES; i++) {
+        if (pDefinition->CategoryDefined(i)) {
+            putCategory(writer, pDefinition->getCategory(i));
+            nCategories++;
+        }
+    }
+
+    SCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = CACHE_VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.nCategories = nCategories;
+    header.key = key;
+    header.payloadSize = writer.buffer.size();
+    header.payloadHash = fnv1a(FNV_OFFSET, reinterpret_cast<const unsigned char *>(writer.buffer.data()),
+                               writer.buffer.size());
+
+    // other processes may load the cache while it is written
+    const std::string tmpFile = std::string(cacheFile) + format(".%d", static_cast<int>(getpid()));
+    FILE *f = fopen(tmpFile.c_str(), "wb");
+    if (f == nullptr) {
+        LOGNOTIFY(gVerbose, "Cannot create definitions cache '%s'\n", cacheFile);
+        return false;
+    }
+
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1 &&
+              fwrite(writer.buffer.data(), 1, writer.buffer.size(), f) == writer.buffer.size();
+    ok = (fclose(f) == 0) && ok;
+#ifdef _WIN32
+    // rename does not replace existing file
+    remove(cacheFile);
+#endif
+    ok = ok && rename(tmpFile.c_str(), cacheFile) == 0;
+
+    if (!ok) {
+        remove(tmpFile.c_str());
+        LOGWARNING(1, "Error writing definitions cache '%s'\n", cacheFile);
+    }
+    return ok;
+}
+
+
+bool CDefinitionCache::Load(const char *cacheFile, uint64_t key, AsterixDefinition *pDefinition) {
+    FILE *f = fopen(cacheFile, "rb");
+    if (f == nullptr) {
+        return false;
+    }
+
+    SCacheHeader header;
+    std::vector<unsigned char> payload;
+    bool ok = fread(&header, sizeof(header), 1, f) == 1 &&
+              memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) == 0 &&
+              header.version == CACHE_VERSION && header.byteOrder == BYTE_ORDER_MARK && header.key == key &&
+              header.nCategories <= MAX_CATEGORIES && header.payloadSize < (1ULL << 31);
+    if (ok) {
+        payload.resize(header.payloadSize);
+        ok = fread(payload.data(), 1, payload.size(), f) == payload.size() &&
+             fnv1a(FNV_OFFSET, payload.data(), payload.size()) == header.payloadHash;
+    }
+    fclose(f);
+
+    if (!ok) {
+        LOGNOTIFY(gVerbose, "Definitions cache '%s' is out of date, rebuilding it\n", cacheFile);
+        return false;
+    }
+
+    // categories are registered only when the whole cache is read
+    std::vector<std::unique_ptr<Category>> categories;
+    CReader reader(payload.data(), payload.size());
+    for (uint32_t i = 0; i < header.nCategories && reader.ok; i++) {
+        categories.emplace_back(getCategory(reader));
+    }
+    if (!reader.ok || !reader.atEnd()) {
+        LOGWARNING(1, "Definitions cache '%s' is corrupted, rebuilding it\n", cacheFile);
+        return false;
+    }
+
+    for (auto &pCategory : categories) {
+        pDefinition->setCategory(pCategory.release());
+    }
+    return true;
+}
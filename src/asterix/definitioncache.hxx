@@ -0,0 +1,68 @@
+/*
+ *  Copyright (c) 2013 Croatia Control Ltd. (www.crocontrol.hr)
+ *
+ *  This file is part of Asterix.
+ *
+ *  Asterix is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Asterix is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Asterix.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef DEFINITIONCACHE_HXX__
+#define DEFINITIONCACHE_HXX__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class AsterixDefinition;
+
+/**
+ * @class CDefinitionCache
+ *
+ * @brief Binary cache of category definitions loaded from XML files.
+ *
+ * The cache holds the complete AsterixDefinition tree (categories, items,
+ * formats, bits, values and UAPs) as built by XMLParser, so that startup
+ * needs one file read instead of parsing all XML definition files.
+ *
+ * The cache is keyed by a hash of the contents of the XML files in load
+ * order. Load() fails if the key does not match, the cache is then rebuilt
+ * from XML and saved again. The cache is written in native byte order and
+ * is rejected by builds with different type sizes or byte order.
+ *
+ * Output filter flags are not stored, filters are applied after loading.
+ */
+class CDefinitionCache {
+public:
+    static constexpr uint32_t CACHE_VERSION = 1;
+
+    /**
+     * Compute cache key from contents of definition files.
+     * @return false if one of the files cannot be read
+     */
+    static bool ComputeKey(const std::vector<std::string> &files, uint64_t &key);
+
+    /**
+     * Write definitions to cache file (written to temporary file and renamed).
+     */
+    static bool Save(const char *cacheFile, uint64_t key, AsterixDefinition *pDefinition);
+
+    /**
+     * Load definitions from cache file into empty definition.
+     * @return false if cache file is missing, out of date or corrupted
+     */
+    static bool Load(const char *cacheFile, uint64_t key, AsterixDefinition *pDefinition);
+};
+
+#endif
@@ -0,0 +1,203 @@
+/*
+ *  Copyright (c) 2013 Croatia Control Ltd. (www.crocontrol.hr)
+ *
+ *  This file is part of Asterix.
+ *
+ *  Asterix is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Asterix is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Asterix.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <signal.h>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+
+#include "asterix.h"
+#include "definitionreloader.hxx"
+#include "AsterixDefinition.h"
+
+namespace {
+    // SIGHUP count, compared by each background thread with the count it has seen
+    std::atomic<unsigned int> gReloadSignals{0};
+
+    // how often the background thread checks for signals and definitions to delete
+    constexpr std::chrono::milliseconds POLL_INTERVAL(100);
+
+#ifdef SIGHUP
+    extern "C" void onReloadSignal(int) {
+        gReloadSignals.fetch_add(1, std::memory_order_relaxed);
+    }
+#endif
+}
+
+
+CDefinitionReloader::CDefinitionReloader(AsterixDefinition *pDefinition, Loader loader)
+        : _loader(std::move(loader)), _pCurrent(pDefinition), _generation(0), _bRequested(false), _bStop(false),
+          _nSignals(gReloadSignals.load(std::memory_order_relaxed)) {
+}
+
+
+CDefinitionReloader::~CDefinitionReloader() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _bStop = true;
+    }
+    _wakeup.notify_all();
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+
+    for (const SRetired &retired : _retired) {
+        delete retired.pDefinition;
+    }
+    delete _pCurrent.load();
+}
+
+
+CDefinitionReloader::CReader *CDefinitionReloader::AddReader(AsterixDefinition *&pDefinition) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _readers.emplace_back();
+    CReader &reader = _readers.back();
+    reader._generation.store(_generation.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    pDefinition = _pCurrent.load(std::memory_order_relaxed);
+    return &reader;
+}
+
+
+void CDefinitionReloader::RemoveReader(CReader *pReader) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _readers.remove_if([pReader](const CReader &reader) { return &reader == pReader; });
+}
+
+
+bool CDefinitionReloader::FilterOutItem(int cat, const std::string &item, const char *name) {
+    std::lock_guard<std::mutex> lock(_reloadMutex);
+    _filters.push_back({cat, item, name ? name : "", name != nullptr});
+    return _pCurrent.load(std::memory_order_relaxed)->filterOutItem(cat, item, name);
+}
+
+
+bool CDefinitionReloader::Reload() {
+    // the current definition is replaced only here, so it stays valid while the lock is held
+    std::lock_guard<std::mutex> reloadLock(_reloadMutex);
+    AsterixDefinition *pCurrent = _pCurrent.load(std::memory_order_relaxed);
+
+    std::unique_ptr<AsterixDefinition> pDefinition(_loader ? _loader() : nullptr);
+    if (!pDefinition) {
+        LOGERROR(1, "Failed to reload definitions, keeping the loaded ones.\n");
+        return false;
+    }
+
+    // load categories in use now, inputs switching to the new definition do not wait for them
+    for (int i = 0; i < MAX_CATEGORIES; i++) {
+        if (pCurrent->CategoryLoaded(i) && pDefinition->CategoryAvailable(i) && !pDefinition->loadCategory(i)) {
+            LOGERROR(1, "Failed to reload definitions of category %d, keeping the loaded ones.\n", i);
+            return false;
+        }
+    }
+
+    for (const SFilter &filter : _filters) {
+        pDefinition->filterOutItem(filter.cat, filter.item, filter.bName ? filter.name.c_str() : nullptr);
+    }
+
+    uint64_t generation;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        generation = _generation.load(std::memory_order_relaxed) + 1;
+        _retired.push_back({pCurrent, generation});
+        _pCurrent.store(pDefinition.release(), std::memory_order_release);
+        _generation.store(generation, std::memory_order_release);
+    }
+    LOGNOTIFY(gVerbose, "Definitions reloaded (generation %llu).\n", static_cast<unsigned long long>(generation));
+    return true;
+}
+
+
+void CDefinitionReloader::RequestReload() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _bRequested = true;
+    }
+    _wakeup.notify_all();
+}
+
+
+void CDefinitionReloader::Start() {
+    if (!_thread.joinable()) {
+        _thread = std::thread(&CDefinitionReloader::run, this);
+    }
+}
+
+
+void CDefinitionReloader::InstallSignalHandler() {
+#ifdef SIGHUP
+    struct sigaction action = {};
+    action.sa_handler = onReloadSignal;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    sigaction(SIGHUP, &action, nullptr);
+#endif
+}
+
+
+size_t CDefinitionReloader::Reclaim() {
+    std::vector<AsterixDefinition *> unused;
+    size_t nInUse;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        uint64_t oldest = _generation.load(std::memory_order_relaxed);
+        for (const CReader &reader : _readers) {
+            oldest = std::min(oldest, reader._generation.load(std::memory_order_acquire));
+        }
+
+        auto it = _retired.begin();
+        while (it != _retired.end()) {
+            if (it->generation <= oldest) {
+                unused.push_back(it->pDefinition);
+                it = _retired.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        nInUse = _retired.size();
+    }
+
+    for (AsterixDefinition *pDefinition : unused) {
+        delete pDefinition;
+    }
+    return nInUse;
+}
+
+
+void CDefinitionReloader::run() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (!_bStop) {
+        _wakeup.wait_for(lock, POLL_INTERVAL, [this]() { return _bStop || _bRequested; });
+        if (_bStop) {
+            break;
+        }
+
+        const unsigned int nSignals = gReloadSignals.load(std::memory_order_relaxed);
+        const bool bReload = _bRequested || nSignals != _nSignals;
+        _bRequested = false;
+        _nSignals = nSignals;
+
+        lock.unlock();
+        if (bReload) {
+            Reload();
+        }
+        Reclaim();
+        lock.lock();
+    }
+}
@@ -0,0 +1,184 @@
+/*
+ *  Copyright (c) 2013 Croatia Control Ltd. (www.crocontrol.hr)
+ *
+ *  This file is part of Asterix.
+ *
+ *  Asterix is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Asterix is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Asterix.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef DEFINITIONRELOADER_HXX__
+#define DEFINITIONRELOADER_HXX__
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class AsterixDefinition;
+
+/**
+ * @class CDefinitionReloader
+ *
+ * @brief Replaces category definitions of running inputs (hot reload).
+ *
+ * A reload builds a new AsterixDefinition with the loader function while
+ * packets are decoded with the current one, then publishes it. Each input
+ * (reader) checks between packets whether a newer definition was published
+ * and switches to it; the check is two atomic loads and never blocks.
+ *
+ * Replaced definitions are reclaimed RCU-style: a reader acknowledges the
+ * generation it switched to after it dropped everything decoded with the
+ * old definition, and a replaced definition is deleted by the reloader once
+ * all readers acknowledged a later generation. Deletion never happens on
+ * the receive path; a reader waiting for input keeps the definition it
+ * last used until it reads its next packet.
+ *
+ * Categories the current definition has loaded are loaded into the new one
+ * before it is published, so inputs do not parse XML after switching, and
+ * items filtered out with FilterOutItem() are filtered out again. If the
+ * loader fails or a category cannot be loaded, the current definition is
+ * kept.
+ *
+ * Reloads are requested with RequestReload() or by SIGHUP once
+ * InstallSignalHandler() was called, and run in a background thread
+ * started by Start(). Reload() runs one synchronously.
+ */
+class CDefinitionReloader {
+public:
+    typedef std::function<AsterixDefinition *()> Loader; // returns nullptr on error
+
+    /**
+     * Reader of definitions (one per input), see AddReader().
+     */
+    class CReader {
+        friend class CDefinitionReloader;
+        std::atomic<uint64_t> _generation{0}; // generation of the definition in use
+    };
+
+    /**
+     * @param pDefinition Initial definition (owned)
+     * @param loader Builds a new definition for reloads
+     */
+    CDefinitionReloader(AsterixDefinition *pDefinition, Loader loader);
+
+    /**
+     * Stops the background thread and deletes all definitions.
+     */
+    ~CDefinitionReloader();
+
+    CDefinitionReloader(const CDefinitionReloader &) = delete;
+
+    CDefinitionReloader &operator=(const CDefinitionReloader &) = delete;
+
+    /**
+     * Register a reader.
+     * @param pDefinition [out] Definition to use, kept until Update() replaces it
+     */
+    CReader *AddReader(AsterixDefinition *&pDefinition);
+
+    /**
+     * Unregister a reader, its definition may be deleted afterwards.
+     */
+    void RemoveReader(CReader *pReader);
+
+    /**
+     * Switch reader to the latest published definition, called between packets.
+     * switchTo gets the new definition and must drop all data referring to
+     * the old one before it returns.
+     * @return true if the definition was replaced
+     */
+    template<typename F>
+    bool Update(CReader &reader, F switchTo) {
+        const uint64_t generation = _generation.load(std::memory_order_acquire);
+        if (generation == reader._generation.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        switchTo(_pCurrent.load(std::memory_order_acquire));
+        reader._generation.store(generation, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Filter out item in the current definition and in all reloaded ones
+     * (AsterixDefinition::filterOutItem()).
+     */
+    bool FilterOutItem(int cat, const std::string &item, const char *name);
+
+    /**
+     * Build and publish a new definition in the calling thread.
+     * @return false if it could not be loaded, the current one is kept
+     */
+    bool Reload();
+
+    /**
+     * Request a reload by the background thread, returns immediately.
+     */
+    void RequestReload();
+
+    /**
+     * Start the background thread which runs requested reloads and deletes
+     * replaced definitions no longer in use.
+     */
+    void Start();
+
+    /**
+     * Request a reload of all started reloaders on SIGHUP (not on Windows).
+     */
+    static void InstallSignalHandler();
+
+    uint64_t GetGeneration() const { return _generation.load(std::memory_order_acquire); }
+
+    /**
+     * Delete replaced definitions all readers switched away from.
+     * @return number of replaced definitions still in use
+     */
+    size_t Reclaim();
+
+private:
+    struct SRetired {
+        AsterixDefinition *pDefinition;
+        uint64_t generation; // deleted when all readers are at this generation or later
+    };
+
+    struct SFilter {
+        int cat;
+        std::string item;
+        std::string name;
+        bool bName;
+    };
+
+    Loader _loader;
+    std::atomic<AsterixDefinition *> _pCurrent;
+    std::atomic<uint64_t> _generation;
+    std::mutex _reloadMutex;       // one reload at a time, guards _filters
+    std::vector<SFilter> _filters;
+    std::mutex _mutex;             // guards readers, retired definitions and requests
+    std::list<CReader> _readers;
+    std::vector<SRetired> _retired;
+    std::condition_variable _wakeup;
+    bool _bRequested;
+    bool _bStop;
+    unsigned int _nSignals;        // signals seen by the background thread
+    std::thread _thread;
+
+    void run();
+};
+
+#endif
@@ -0,0 +1,128 @@
+/*
+ *  Copyright (c) 2013 Croatia Control Ltd. (www.crocontrol.hr)
+ *
+ *  This file is part of Asterix.
+ *
+ *  Asterix is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Asterix is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Asterix.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <string.h>
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+#include "ipreassembly.hxx"
+
+// Largest IPv4 payload
+#define MAX_IP_PAYLOAD  (65535 - 20)
+
+
+CIpReassembly::CIpReassembly(unsigned int maxDatagrams, size_t maxMemory, double timeout)
+        : _maxDatagrams(maxDatagrams), _maxMemory(maxMemory), _timeout(timeout),
+          _memory(0), _nReassembled(0), _nDropped(0) {
+}
+
+
+void CIpReassembly::Erase(std::list<SDatagram>::iterator it, bool dropped) {
+    _memory -= it->data.size();
+    if (dropped) {
+        _nDropped++;
+    }
+    _datagrams.erase(it);
+}
+
+
+void CIpReassembly::Expire(double time) {
+    // Capture time may also jump back (e.g. file read in loop)
+    for (auto it = _datagrams.begin(); it != _datagrams.end();) {
+        auto next = std::next(it);
+        if (std::fabs(time - it->firstTime) > _timeout) {
+            Erase(it, true);
+        }
+        it = next;
+    }
+}
+
+
+const unsigned char *CIpReassembly::AddFragment(uint32_t src, uint32_t dst, uint8_t protocol, uint16_t id,
+                                                unsigned int offset, bool moreFragments,
+                                                const unsigned char *data, unsigned int len,
+                                                double time, unsigned int &totalLen) {
+    const unsigned int end = offset + len;
+    if (len == 0 || end > MAX_IP_PAYLOAD || end > _maxMemory) {
+        return nullptr;
+    }
+
+    Expire(time);
+
+    auto it = _datagrams.begin();
+    while (it != _datagrams.end() &&
+           !(it->id == id && it->src == src && it->dst == dst && it->protocol == protocol)) {
+        ++it;
+    }
+
+    if (it == _datagrams.end()) {
+        if (_datagrams.size() >= _maxDatagrams && !_datagrams.empty()) {
+            Erase(_datagrams.begin(), true);
+        }
+        _datagrams.push_back({src, dst, protocol, id, time, 0, {}, {}});
+        it = std::prev(_datagrams.end());
+    }
+
+    // Make room for the fragment by dropping the oldest other datagrams
+    if (end > it->data.size()) {
+        const size_t growth = end - it->data.size();
+        while (_memory + growth > _maxMemory && _datagrams.begin() != it) {
+            Erase(_datagrams.begin(), true);
+        }
+        if (_memory + growth > _maxMemory) {
+            Erase(it, true);
+            return nullptr;
+        }
+        it->data.resize(end);
+        _memory += growth;
+    }
+
+    memcpy(it->data.data() + offset, data, len);
+    if (!moreFragments) {
+        it->totalLen = end;
+    }
+
+    // Insert received range and merge with overlapping or adjacent ones
+    auto &ranges = it->ranges;
+    auto pos = ranges.begin();
+    while (pos != ranges.end() && pos->second < offset) {
+        ++pos;
+    }
+    pos = ranges.insert(pos, {offset, end});
+    while (std::next(pos) != ranges.end() && std::next(pos)->first <= pos->second) {
+        pos->first = std::min(pos->first, std::next(pos)->first);
+        pos->second = std::max(pos->second, std::next(pos)->second);
+        ranges.erase(std::next(pos));
+    }
+
+    if (it->totalLen == 0 || ranges.size() != 1 || ranges[0].first != 0 || ranges[0].second < it->totalLen) {
+        return nullptr;
+    }
+
+    // Complete
+    totalLen = it->totalLen;
+    _memory -= it->data.size();
+    _complete.swap(it->data);
+    _complete.resize(totalLen);
+    _datagrams.erase(it);
+    _nReassembled++;
+    return _complete.data();
+}
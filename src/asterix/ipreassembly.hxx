@@ -0,0 +1,98 @@
+/*
+ *  Copyright (c) 2013 Croatia Control Ltd. (www.crocontrol.hr)
+ *
+ *  This file is part of Asterix.
+ *
+ *  Asterix is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Asterix is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Asterix.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef IPREASSEMBLY_HXX__
+#define IPREASSEMBLY_HXX__
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <utility>
+#include <vector>
+
+/**
+ * @class CIpReassembly
+ *
+ * @brief Reassembly of fragmented IPv4 datagrams.
+ *
+ * Fragments are collected per (source, destination, protocol, id) until the
+ * whole payload is present. Memory is bounded: at most `maxDatagrams`
+ * datagrams and `maxMemory` payload bytes are kept, the oldest incomplete
+ * datagram is dropped to make room. Datagrams not completed within `timeout`
+ * seconds of capture time are expired.
+ *
+ * Only fragmented datagrams are passed here; unfragmented ones are parsed
+ * in place by the caller.
+ */
+class CIpReassembly {
+public:
+    static const unsigned int DEFAULT_MAX_DATAGRAMS = 64;
+    static const size_t DEFAULT_MAX_MEMORY = 4 * 1024 * 1024;
+    static constexpr double DEFAULT_TIMEOUT = 30.0;
+
+    explicit CIpReassembly(unsigned int maxDatagrams = DEFAULT_MAX_DATAGRAMS,
+                           size_t maxMemory = DEFAULT_MAX_MEMORY,
+                           double timeout = DEFAULT_TIMEOUT);
+
+    /**
+     * Add fragment payload (without IP header) at given byte offset.
+     * Returns the whole datagram payload when this fragment completes it,
+     * otherwise nullptr. Returned data is valid until the next call.
+     */
+    const unsigned char *AddFragment(uint32_t src, uint32_t dst, uint8_t protocol, uint16_t id,
+                                     unsigned int offset, bool moreFragments,
+                                     const unsigned char *data, unsigned int len,
+                                     double time, unsigned int &totalLen);
+
+    size_t GetNPending() const { return _datagrams.size(); }
+
+    size_t GetMemory() const { return _memory; }
+
+    uint64_t GetNReassembled() const { return _nReassembled; }
+
+    uint64_t GetNDropped() const { return _nDropped; } // incomplete datagrams evicted or expired
+
+private:
+    struct SDatagram {
+        uint32_t src;
+        uint32_t dst;
+        uint8_t protocol;
+        uint16_t id;
+        double firstTime;
+        unsigned int totalLen;  // known when the last fragment arrived, 0 before
+        std::vector<unsigned char> data;
+        std::vector<std::pair<unsigned int, unsigned int>> ranges; // received [begin, end), sorted and merged
+    };
+
+    unsigned int _maxDatagrams;
+    size_t _maxMemory;
+    double _timeout;
+    size_t _memory;
+    uint64_t _nReassembled;
+    uint64_t _nDropped;
+    std::list<SDatagram> _datagrams; // oldest first
+    std::vector<unsigned char> _complete;
+
+    void Expire(double time);
+
+    void Erase(std::list<SDatagram>::iterator it, bool dropped);
+};
+
+#endif
@@ -0,0 +1,346 @@
+/*
+ *  Copyright (c) 2013 Croatia Control Ltd. (www.crocontrol.hr)
+ *
+ *  This file is part of Asterix.
+ *
+ *  Asterix is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Asterix is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Asterix.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#ifdef _WIN32
+  #define ftello _ftelli64
+#endif
+
+#include "asterix.h"
+#include "pcapindex.hxx"
+
+namespace {
+    const char INDEX_MAGIC[4] = {'A', 'X', 'P', 'I'};
+    const uint32_t INDEX_VERSION = 1;
+
+    // Index file header, followed by nCheckpoints SCheckpoint entries
+    struct SIndexHeader {
+        char magic[4];
+        uint32_t version;
+        uint64_t pcapSize;
+        int64_t pcapMtime;
+        uint32_t interval;
+        uint32_t reserved;
+        uint64_t nPackets;
+        double firstTime;
+        double lastTime;
+        uint64_t nCheckpoints;
+        uint64_t categoryCount[256];
+    };
+
+    uint32_t swap32(uint32_t v) {
+        return ((v & 0xFF) << 24) | ((v & 0xFF00) << 8) | ((v >> 8) & 0xFF00) | (v >> 24);
+    }
+
+    unsigned int get16(const unsigned char *p) {
+        return (static_cast<unsigned int>(p[0]) << 8) | p[1];
+    }
+}
+
+
+CPcapIndex::CPcapIndex()
+        : _pcapSize(0), _pcapMtime(0), _interval(DEFAULT_INTERVAL), _nPackets(0), _firstTime(0), _lastTime(0) {
+    memset(_categoryCount, 0, sizeof(_categoryCount));
+}
+
+
+bool CPcapIndex::FileStat(const char *file, uint64_t &size, int64_t &mtime) {
+    struct stat fs;
+    if (stat(file, &fs) != 0) {
+        return false;
+    }
+    size = static_cast<uint64_t>(fs.st_size);
+    mtime = static_cast<int64_t>(fs.st_mtime);
+    return true;
+}
+
+
+void CPcapIndex::CountCategories(const unsigned char *frame, size_t len, unsigned int linkType) {
+    size_t protoPos;
+    size_t pos;
+    if (linkType == 1) { // Ethernet
+        protoPos = 12;
+        while (protoPos + 2 <= len &&
+               (get16(frame + protoPos) == 0x8100 || get16(frame + protoPos) == 0x88A8 ||
+                get16(frame + protoPos) == 0x9100)) {
+            protoPos += 4; // VLAN tag
+        }
+        pos = protoPos + 2;
+    } else if (linkType == 113) { // Linux cooked
+        protoPos = 14;
+        pos = 16;
+    } else if (linkType == 276) { // Linux cooked v2, protocol is the first field
+        protoPos = 0;
+        pos = 20;
+    } else {
+        return;
+    }
+
+    if (pos > len || get16(frame + protoPos) != 0x0800) {
+        return;
+    }
+
+    // IPv4, first fragment of UDP datagrams only
+    if (pos + 20 > len || frame[pos + 9] != 17 || (get16(frame + pos + 6) & 0x1FFF) != 0) {
+        return;
+    }
+    // Ethernet frames may be padded, payload ends with the IP datagram
+    const size_t end = pos + get16(frame + pos + 2);
+    if (end < len) {
+        len = end;
+    }
+    pos += (frame[pos] & 0x0F) * 4 + 8;
+
+    // ASTERIX data blocks: CAT (1) + LEN (2)
+    while (pos + 3 <= len) {
+        unsigned int blockLen = get16(frame + pos + 1);
+        if (blockLen < 3) {
+            break;
+        }
+        _categoryCount[frame[pos]]++;
+        pos += blockLen;
+    }
+}
+
+
+bool CPcapIndex::Build(const char *pcapFile, unsigned int interval) {
+    _pcapFile = pcapFile;
+    _interval = interval > 0 ? interval : DEFAULT_INTERVAL;
+    _nPackets = 0;
+    _firstTime = _lastTime = 0;
+    _checkpoints.clear();
+    memset(_categoryCount, 0, sizeof(_categoryCount));
+
+    if (!FileStat(pcapFile, _pcapSize, _pcapMtime)) {
+        LOGERROR(1, "Cannot open PCAP file '%s'\n", pcapFile);
+        return false;
+    }
+
+    FILE *f = fopen(pcapFile, "rb");
+    if (f == nullptr) {
+        LOGERROR(1, "Cannot open PCAP file '%s'\n", pcapFile);
+        return false;
+    }
+
+    uint32_t fileHeader[6];
+    if (fread(fileHeader, sizeof(fileHeader), 1, f) != 1) {
+        LOGERROR(1, "Couldn't read PCAP file header.\n");
+        fclose(f);
+        return false;
+    }
+
+    bool swap;
+    double fraction; // ts_usec unit
+    switch (fileHeader[0]) {
+        case 0xA1B2C3D4: swap = false; fraction = 1e-6; break;
+        case 0xD4C3B2A1: swap = true;  fraction = 1e-6; break;
+        case 0xA1B23C4D: swap = false; fraction = 1e-9; break;
+        case 0x4D3CB2A1: swap = true;  fraction = 1e-9; break;
+        case 0x0A0D0D0A:
+            // seeking into pcapng would also need interface blocks read before the checkpoint
+            LOGERROR(1, "Index of pcapng file '%s' is not supported\n", pcapFile);
+            fclose(f);
+            return false;
+        default:
+            LOGERROR(1, "'%s' is not a PCAP file\n", pcapFile);
+            fclose(f);
+            return false;
+    }
+    const unsigned int linkType = swap ? swap32(fileHeader[5]) : fileHeader[5];
+
+    std::vector<unsigned char> frame;
+    for (;;) {
+        const int64_t offset = ftello(f);
+        uint32_t recHeader[4];
+        if (fread(recHeader, sizeof(recHeader), 1, f) != 1) {
+            break;
+        }
+        if (swap) {
+            for (uint32_t &v : recHeader) {
+                v = swap32(v);
+            }
+        }
+
+        const double packetTime = recHeader[0] + recHeader[1] * fraction;
+        frame.resize(recHeader[2]);
+        if (recHeader[2] > 0 && fread(frame.data(), recHeader[2], 1, f) != 1) {
+            LOGWARNING(1, "Truncated packet %llu in '%s'\n", static_cast<unsigned long long>(_nPackets), pcapFile);
+            break;
+        }
+
+        if (_nPackets % _interval == 0) {
+            _checkpoints.push_back({_nPackets, static_cast<uint64_t>(offset), packetTime});
+        }
+        if (_nPackets == 0) {
+            _firstTime = packetTime;
+        }
+        _lastTime = packetTime;
+        _nPackets++;
+
+        CountCategories(frame.data(), frame.size(), linkType);
+    }
+
+    fclose(f);
+    return true;
+}
+
+
+bool CPcapIndex::Save() const {
+    const std::string indexFile = IndexFileName(_pcapFile.c_str());
+    FILE *f = fopen(indexFile.c_str(), "wb");
+    if (f == nullptr) {
+        LOGERROR(1, "Cannot create index file '%s'\n", indexFile.c_str());
+        return false;
+    }
+
+    SIndexHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    header.version = INDEX_VERSION;
+    header.pcapSize = _pcapSize;
+    header.pcapMtime = _pcapMtime;
+    header.interval = _interval;
+    header.nPackets = _nPackets;
+    header.firstTime = _firstTime;
+    header.lastTime = _lastTime;
+    header.nCheckpoints = _checkpoints.size();
+    memcpy(header.categoryCount, _categoryCount, sizeof(_categoryCount));
+
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1;
+    if (ok && !_checkpoints.empty()) {
+        ok = fwrite(_checkpoints.data(), sizeof(SCheckpoint), _checkpoints.size(), f) == _checkpoints.size();
+    }
+    ok = (fclose(f) == 0) && ok;
+
+    if (!ok) {
+        LOGERROR(1, "Error writing index file '%s'\n", indexFile.c_str());
+    }
+    return ok;
+}
+
+
+bool CPcapIndex::Load(const char *pcapFile) {
+    const std::string indexFile = IndexFileName(pcapFile);
+    FILE *f = fopen(indexFile.c_str(), "rb");
+    if (f == nullptr) {
+        return false;
+    }
+
+    SIndexHeader header;
+    uint64_t pcapSize;
+    int64_t pcapMtime;
+    bool ok = fread(&header, sizeof(header), 1, f) == 1 &&
+              memcmp(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) == 0 &&
+              header.version == INDEX_VERSION &&
+              FileStat(pcapFile, pcapSize, pcapMtime) &&
+              pcapSize == header.pcapSize && pcapMtime == header.pcapMtime;
+
+    if (!ok) {
+        LOGWARNING(1, "Index file '%s' is invalid or out of date, rebuild it\n", indexFile.c_str());
+        fclose(f);
+        return false;
+    }
+
+    // A damaged index may still have a valid header: the checkpoint table must fill the rest of the file
+    uint64_t indexSize;
+    int64_t indexMtime;
+    if (header.interval == 0 || !FileStat(indexFile.c_str(), indexSize, indexMtime) ||
+        (indexSize - sizeof(header)) % sizeof(SCheckpoint) != 0 ||
+        header.nCheckpoints != (indexSize - sizeof(header)) / sizeof(SCheckpoint)) {
+        LOGERROR(1, "Damaged index file '%s', rebuild it\n", indexFile.c_str());
+        fclose(f);
+        return false;
+    }
+
+    _checkpoints.resize(header.nCheckpoints);
+    if (header.nCheckpoints > 0 &&
+        fread(_checkpoints.data(), sizeof(SCheckpoint), header.nCheckpoints, f) != header.nCheckpoints) {
+        LOGERROR(1, "Truncated index file '%s'\n", indexFile.c_str());
+        _checkpoints.clear();
+        fclose(f);
+        return false;
+    }
+    fclose(f);
+
+    _pcapFile = pcapFile;
+    _pcapSize = header.pcapSize;
+    _pcapMtime = header.pcapMtime;
+    _interval = header.interval;
+    _nPackets = header.nPackets;
+    _firstTime = header.firstTime;
+    _lastTime = header.lastTime;
+    memcpy(_categoryCount, header.categoryCount, sizeof(_categoryCount));
+    return true;
+}
+
+
+const CPcapIndex::SCheckpoint *CPcapIndex::LookupTime(double time) const {
+    // Capture times are not strictly ordered, so step one checkpoint back
+    // from the last checkpoint not later than requested time
+    size_t lo = 0;
+    size_t hi = _checkpoints.size();
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (_checkpoints[mid].time <= time) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo == 0) {
+        return _checkpoints.empty() ? nullptr : &_checkpoints[0];
+    }
+    return &_checkpoints[lo > 1 ? lo - 2 : 0];
+}
+
+
+const CPcapIndex::SCheckpoint *CPcapIndex::LookupPacket(uint64_t packetNo) const {
+    if (_checkpoints.empty()) {
+        return nullptr;
+    }
+    size_t i = static_cast<size_t>(packetNo / _interval);
+    return &_checkpoints[i < _checkpoints.size() ? i : _checkpoints.size() - 1];
+}
+
+
+void CPcapIndex::Print(FILE *out) const {
+    char sFirst[32];
+    char sLast[32];
+    struct tm tmBuf;
+    time_t t = static_cast<time_t>(_firstTime);
+    strftime(sFirst, sizeof(sFirst), "%Y-%m-%d %H:%M:%S", ASTERIX_GMTIME_R(&t, &tmBuf));
+    t = static_cast<time_t>(_lastTime);
+    strftime(sLast, sizeof(sLast), "%Y-%m-%d %H:%M:%S", ASTERIX_GMTIME_R(&t, &tmBuf));
+
+    fprintf(out, "File:        %s\n", _pcapFile.c_str());
+    fprintf(out, "Packets:     %llu\n", static_cast<unsigned long long>(_nPackets));
+    fprintf(out, "First:       %s UTC (%.6f)\n", sFirst, _firstTime);
+    fprintf(out, "Last:        %s UTC (%.6f)\n", sLast, _lastTime);
+    fprintf(out, "Checkpoints: %zu (every %u packets)\n", _checkpoints.size(), _interval);
+    fprintf(out, "Data blocks per category:\n");
+    for (unsigned int cat = 0; cat < 256; cat++) {
+        if (_categoryCount[cat] > 0) {
+            fprintf(out, "  CAT%03u     %llu\n", cat, static_cast<unsigned long long>(_categoryCount[cat]));
+        }
+    }
+}
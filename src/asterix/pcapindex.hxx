@@ -0,0 +1,115 @@
+/*
+ *  Copyright (c) 2013 Croatia Control Ltd. (www.crocontrol.hr)
+ *
+ *  This file is part of Asterix.
+ *
+ *  Asterix is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Asterix is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Asterix.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PCAPINDEX_HXX__
+#define PCAPINDEX_HXX__
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * @class CPcapIndex
+ *
+ * @brief Sidecar index of a PCAP file for seeking by time or packet number.
+ *
+ * The index is stored next to the capture as <file>.idx and holds a
+ * checkpoint (packet number, capture time, file offset) for every
+ * `interval`-th packet, plus the number of ASTERIX data blocks per category.
+ * It is valid only while the size and modification time of the capture
+ * match the values stored in the index.
+ *
+ * Lookup returns the offset of the last checkpoint not later than the
+ * requested time or packet, so the reader skips at most `interval` packets
+ * before reaching it.
+ */
+class CPcapIndex {
+public:
+    static const unsigned int DEFAULT_INTERVAL = 1000;
+
+    struct SCheckpoint {
+        uint64_t packetNo;  // zero based packet number
+        uint64_t offset;    // file offset of the packet record header
+        double time;        // capture time of the packet (seconds since epoch)
+    };
+
+    CPcapIndex();
+
+    /**
+     * Scan the capture and build the index in memory.
+     * Only record headers and the UDP payload of each packet are inspected.
+     */
+    bool Build(const char *pcapFile, unsigned int interval = DEFAULT_INTERVAL);
+
+    /**
+     * Write the index to <pcapFile>.idx
+     */
+    bool Save() const;
+
+    /**
+     * Load <pcapFile>.idx, fails if it is missing or out of date.
+     */
+    bool Load(const char *pcapFile);
+
+    /**
+     * Find the checkpoint to start reading from for the given capture time.
+     */
+    const SCheckpoint *LookupTime(double time) const;
+
+    /**
+     * Find the checkpoint to start reading from for the given packet number.
+     */
+    const SCheckpoint *LookupPacket(uint64_t packetNo) const;
+
+    /**
+     * Print summary (time span, packets, data blocks per category).
+     */
+    void Print(FILE *out) const;
+
+    static std::string IndexFileName(const char *pcapFile) { return std::string(pcapFile) + ".idx"; }
+
+    uint64_t GetNPackets() const { return _nPackets; }
+
+    double GetFirstTime() const { return _firstTime; }
+
+    double GetLastTime() const { return _lastTime; }
+
+    uint64_t GetCategoryCount(unsigned int category) const { return category < 256 ? _categoryCount[category] : 0; }
+
+    const std::vector<SCheckpoint> &GetCheckpoints() const { return _checkpoints; }
+
+private:
+    std::string _pcapFile;
+    uint64_t _pcapSize;
+    int64_t _pcapMtime;
+    unsigned int _interval;
+    uint64_t _nPackets;
+    double _firstTime;
+    double _lastTime;
+    uint64_t _categoryCount[256];
+    std::vector<SCheckpoint> _checkpoints;
+
+    static bool FileStat(const char *file, uint64_t &size, int64_t &mtime);
+
+    void CountCategories(const unsigned char *frame, size_t len, unsigned int linkType);
+};
+
+#endif
@@ -0,0 +1,191 @@
+/*
+ *  Copyright (c) 2013 Croatia Control Ltd. (www.crocontrol.hr)
+ *
+ *  This file is part of Asterix.
+ *
+ *  Asterix is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Asterix is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Asterix.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "recorddecoder.hxx"
+#include "Category.h"
+#include "DataItemBits.h"
+#include "DataItemDescription.h"
+#include "DataItemFormatFixed.h"
+#include "UAP.h"
+#include "UAPItem.h"
+#include "Utils.h"
+
+#ifdef ASTERIX_GENERATED_DECODERS
+// generated_decoders.cxx
+extern const SGeneratedDecoder gGeneratedDecoders[];
+extern const unsigned int gNGeneratedDecoders;
+#else
+// built without generator (language bindings), all categories use the interpreter
+static const SGeneratedDecoder *gGeneratedDecoders = nullptr;
+static const unsigned int gNGeneratedDecoders = 0;
+#endif
+
+
+CRecordDecoder::CRecordDecoder(const SGeneratedDecoder *pGenerated, Category *pCategory)
+        : _pGenerated(pGenerated), _pCategory(pCategory) {
+    for (const UAP *pUAP : pCategory->m_lUAPs) {
+        _uaps.push_back(pUAP);
+
+        // resolve item of each FRN as UAP::getDataItemIDByUAPfrn() does (first UAPItem with FRN)
+        int maxFRN = 0;
+        for (const UAPItem *pItem : pUAP->m_lUAPItems) {
+            if (pItem != nullptr && pItem->m_nFRN > maxFRN) {
+                maxFRN = pItem->m_nFRN;
+            }
+        }
+        std::vector<DataItemDescription *> items(maxFRN + 1, nullptr);
+        for (int frn = 1; frn <= maxFRN; frn++) {
+            items[frn] = pCategory->findDataItemDescription(pUAP->getDataItemIDByUAPfrn(frn));
+        }
+        _descriptions.push_back(items);
+    }
+}
+
+
+void CRecordDecoder::formatSignature(const DataItemFormat *pFormat, std::string &signature) {
+    if (pFormat->isFixed()) {
+        signature += format("F%d", static_cast<const DataItemFormatFixed *>(pFormat)->m_nLength);
+        for (const DataItemFormat *pSubItem : pFormat->m_lSubItems) {
+            const auto *pBits = static_cast<const DataItemBits *>(pSubItem);
+            if (pBits->m_bExtension) {
+                signature += format("x%d", pBits->m_nFrom);
+            }
+            if (pBits->m_nPresenceOfField != 0) {
+                signature += format("p%d@%d", pBits->m_nPresenceOfField, pBits->m_nFrom);
+            }
+        }
+        return;
+    }
+    if (pFormat->isBDS()) {
+        signature += 'B';
+        return;
+    }
+
+    if (pFormat->isVariable()) {
+        signature += "V(";
+    } else if (pFormat->isCompound()) {
+        signature += "C(";
+    } else if (pFormat->isRepetitive()) {
+        signature += "R(";
+    } else if (pFormat->isExplicit()) {
+        signature += "E(";
+    } else {
+        signature += "?(";
+    }
+    bool first = true;
+    for (const DataItemFormat *pSubItem : pFormat->m_lSubItems) {
+        if (!first) {
+            signature += ',';
+        }
+        formatSignature(pSubItem, signature);
+        first = false;
+    }
+    signature += ')';
+}
+
+
+std::string CRecordDecoder::Signature(const Category *pCategory) {
+    std::string signature;
+    std::vector<std::string> referenced;
+
+    for (const UAP *pUAP : pCategory->m_lUAPs) {
+        signature += format("U%lu,%lu,%u[", pUAP->m_nUseIfBitSet, pUAP->m_nUseIfByteNr,
+                            static_cast<unsigned int>(pUAP->m_nIsSetTo));
+
+        // FRNs in ascending order, first UAPItem wins
+        std::vector<const UAPItem *> items;
+        for (const UAPItem *pItem : pUAP->m_lUAPItems) {
+            if (pItem == nullptr || pItem->m_bFX || pItem->m_nFRN <= 0) {
+                continue;
+            }
+            if (static_cast<size_t>(pItem->m_nFRN) >= items.size()) {
+                items.resize(pItem->m_nFRN + 1, nullptr);
+            }
+            if (items[pItem->m_nFRN] == nullptr) {
+                items[pItem->m_nFRN] = pItem;
+            }
+        }
+        for (const UAPItem *pItem : items) {
+            if (pItem == nullptr) {
+                continue;
+            }
+            signature += format("%d=%s;", pItem->m_nFRN, pItem->m_strItemID.c_str());
+            bool found = false;
+            for (const std::string &id : referenced) {
+                found = found || id == pItem->m_strItemID;
+            }
+            if (!found) {
+                referenced.push_back(pItem->m_strItemID);
+            }
+        }
+        signature += ']';
+    }
+
+    for (const std::string &id : referenced) {
+        signature += 'I' + id + '=';
+        const DataItemDescription *pDescription = pCategory->findDataItemDescription(id);
+        if (pDescription == nullptr) {
+            signature += '?';
+        } else if (pDescription->m_pFormat == nullptr) {
+            signature += '-';
+        } else {
+            formatSignature(pDescription->m_pFormat, signature);
+        }
+        signature += ';';
+    }
+    return signature;
+}
+
+
+CRecordDecoder *CRecordDecoder::Create(Category *pCategory) {
+    if (pCategory == nullptr || gNGeneratedDecoders == 0) {
+        return nullptr;
+    }
+
+    std::string signature;
+    for (unsigned int i = 0; i < gNGeneratedDecoders; i++) {
+        const SGeneratedDecoder &generated = gGeneratedDecoders[i];
+        if (generated.category != pCategory->m_id) {
+            continue;
+        }
+        if (signature.empty()) {
+            signature = Signature(pCategory);
+        }
+        if (signature == generated.signature) {
+            return new CRecordDecoder(&generated, pCategory);
+        }
+    }
+    return nullptr;
+}
+
+
+unsigned int CRecordDecoder::GetNGenerated() {
+    return gNGeneratedDecoders;
+}
+
+
+int CRecordDecoder::GetUAPIndex(const UAP *pUAP) const {
+    for (size_t i = 0; i < _uaps.size(); i++) {
+        if (_uaps[i] == pUAP) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,114 @@
+/*
+ *  Copyright (c) 2013 Croatia Control Ltd. (www.crocontrol.hr)
+ *
+ *  This file is part of Asterix.
+ *
+ *  Asterix is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Asterix is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Asterix.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RECORDDECODER_HXX__
+#define RECORDDECODER_HXX__
+
+#include <string>
+#include <vector>
+
+class Category;
+class DataItemDescription;
+class DataItemFormat;
+class UAP;
+
+/**
+ * Record decoder generated at build time from category XML definition
+ * (asterix-specs-converter/asterixxml2cpp.py).
+ */
+struct SGeneratedDecoder {
+    unsigned int category;
+    const char *version;
+    // structural signature of definition the decoder was generated from
+    const char *signature;
+    // length of item at FRN of UAP, greater than len if item exceeds data
+    long (*itemLength)(int uap, int frn, const unsigned char *pData, long len);
+};
+
+/**
+ * @class CRecordDecoder
+ *
+ * @brief Generated record decoder bound to a loaded category definition.
+ *
+ * Generated decoders resolve the data items present in a record with a
+ * switch per UAP and compute item lengths with compile-time offsets and
+ * masks, instead of walking the UAP and item lists and the DataItemFormat
+ * tree for every item. Values are still decoded by the DataItemFormat
+ * classes of the loaded definition.
+ *
+ * A generated decoder is used only if its signature equals the signature of
+ * the loaded definition, otherwise DataRecord falls back to the interpreter.
+ */
+class CRecordDecoder {
+public:
+    /**
+     * Bind generated decoder to category.
+     * @return nullptr if no generated decoder matches the category definition
+     */
+    static CRecordDecoder *Create(Category *pCategory);
+
+    /**
+     * Structural signature of category definition (UAPs, item formats, lengths,
+     * FX and presence bits), same as computed by the generator.
+     */
+    static std::string Signature(const Category *pCategory);
+
+    /**
+     * Number of decoders generated into this build.
+     */
+    static unsigned int GetNGenerated();
+
+    /**
+     * Index of UAP in category, -1 if UAP is not from this category.
+     */
+    int GetUAPIndex(const UAP *pUAP) const;
+
+    /**
+     * Item description of FRN in UAP, nullptr if not defined.
+     */
+    DataItemDescription *GetDescription(int uap, int frn) const {
+        const std::vector<DataItemDescription *> &items = _descriptions[uap];
+        return frn >= 0 && static_cast<size_t>(frn) < items.size() ? items[frn] : nullptr;
+    }
+
+    /**
+     * Length of item at FRN of UAP (greater than len if item exceeds data).
+     */
+    long ItemLength(int uap, int frn, const unsigned char *pData, long len) const {
+        return _pGenerated->itemLength(uap, frn, pData, len);
+    }
+
+    Category *GetCategory() const { return _pCategory; }
+
+    const char *GetVersion() const { return _pGenerated->version; }
+
+private:
+    CRecordDecoder(const SGeneratedDecoder *pGenerated, Category *pCategory);
+
+    static void formatSignature(const DataItemFormat *pFormat, std::string &signature);
+
+    const SGeneratedDecoder *_pGenerated;
+    Category *_pCategory;
+    std::vector<const UAP *> _uaps;
+    // item descriptions per UAP indexed by FRN
+    std::vector<std::vector<DataItemDescription *>> _descriptions;
+};
+
+#endif
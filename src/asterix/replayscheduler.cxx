@@ -0,0 +1,126 @@
+/*
+ *  Copyright (c) 2013 Croatia Control Ltd. (www.crocontrol.hr)
+ *
+ *  This file is part of Asterix.
+ *
+ *  Asterix is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Asterix is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Asterix.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+#include <chrono>
+#include <thread>
+
+#include "asterix.h"
+#include "replayscheduler.hxx"
+
+extern bool gVerbose;
+
+// clock_nanosleep with TIMER_ABSTIME is not available everywhere (e.g. macOS, Windows)
+#if defined(TIMER_ABSTIME) && defined(CLOCK_MONOTONIC) && !defined(__APPLE__)
+  #define REPLAY_CLOCK_NANOSLEEP 1
+#endif
+
+
+CReplayScheduler::CReplayScheduler(double speed, const std::string &name)
+        : _name(name), _speed(speed < MIN_SPEED ? MIN_SPEED : (speed > MAX_SPEED ? MAX_SPEED : speed)),
+          _anchored(false), _wallStart(0), _captureStart(0), _lastCapture(0) {
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+
+int64_t CReplayScheduler::Now() {
+#ifdef REPLAY_CLOCK_NANOSLEEP
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+
+void CReplayScheduler::Reset() {
+    _anchored = false;
+}
+
+
+void CReplayScheduler::Anchor(double captureTime, int64_t now) {
+    _anchored = true;
+    _wallStart = now;
+    _captureStart = captureTime;
+    _lastCapture = captureTime;
+    _stats.captureSpan = 0;
+    _stats.wallSpan = 0;
+}
+
+
+void CReplayScheduler::WaitFor(double captureTime) {
+    int64_t now = Now();
+    if (!_anchored || captureTime < _lastCapture - REANCHOR_GAP) {
+        Anchor(captureTime, now);
+    }
+    if (captureTime > _lastCapture) {
+        _lastCapture = captureTime;
+    }
+
+    // Packets slightly out of order are released at once
+    const double offset = captureTime > _captureStart ? (captureTime - _captureStart) / _speed : 0;
+    const int64_t due = _wallStart + static_cast<int64_t>(offset * 1e9);
+
+    if (due > now) {
+#ifdef REPLAY_CLOCK_NANOSLEEP
+        struct timespec ts;
+        ts.tv_sec = static_cast<time_t>(due / 1000000000);
+        ts.tv_nsec = static_cast<long>(due % 1000000000);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {
+        }
+#else
+        std::this_thread::sleep_until(std::chrono::steady_clock::time_point(std::chrono::nanoseconds(due)));
+#endif
+        now = Now();
+    }
+
+    const double lag = now > due ? (now - due) / 1e9 : 0;
+    _stats.nPackets++;
+    _stats.sumLag += lag;
+    if (lag > _stats.maxLag) {
+        _stats.maxLag = lag;
+    }
+    if (lag > LATE_THRESHOLD) {
+        _stats.nLate++;
+    }
+    _stats.captureSpan = _lastCapture - _captureStart;
+    _stats.wallSpan = (now - _wallStart) / 1e9;
+}
+
+
+double CReplayScheduler::GetAchievedSpeed() const {
+    return _stats.wallSpan > 0 ? _stats.captureSpan / _stats.wallSpan : 0;
+}
+
+
+void CReplayScheduler::Report() const {
+    if (_stats.nPackets == 0) {
+        return;
+    }
+    LOGNOTIFY(gVerbose, "Replay of %s: %llu packets, speed %.2fx (target %.2fx), lag mean %.3f ms max %.3f ms, "
+                        "%llu packets late by more than %.0f ms\n",
+              _name.c_str(), static_cast<unsigned long long>(_stats.nPackets), GetAchievedSpeed(), _speed,
+              _stats.sumLag * 1000 / _stats.nPackets, _stats.maxLag * 1000,
+              static_cast<unsigned long long>(_stats.nLate), LATE_THRESHOLD * 1000);
+}
@@ -0,0 +1,103 @@
+/*
+ *  Copyright (c) 2013 Croatia Control Ltd. (www.crocontrol.hr)
+ *
+ *  This file is part of Asterix.
+ *
+ *  Asterix is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Asterix is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Asterix.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef REPLAYSCHEDULER_HXX__
+#define REPLAYSCHEDULER_HXX__
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @class CReplayScheduler
+ *
+ * @brief Paces replay of recorded packets (synchronous mode).
+ *
+ * The first packet anchors capture time to the monotonic clock; every
+ * following packet is released at
+ *
+ *     anchor + (captureTime - firstCaptureTime) / speed
+ *
+ * using an absolute sleep, so sleep overshoot and processing time do not
+ * accumulate. Packets already late are released at once, which keeps
+ * bursts (packets with equal capture time) together. If capture time jumps
+ * back by more than REANCHOR_GAP seconds (e.g. file read in loop or final
+ * format timestamp wrapping at midnight) the schedule is anchored again.
+ */
+class CReplayScheduler {
+public:
+    static constexpr double MIN_SPEED = 0.1;
+    static constexpr double MAX_SPEED = 100.0;
+    static constexpr double REANCHOR_GAP = 1.0;  // seconds
+    static constexpr double LATE_THRESHOLD = 0.001; // seconds
+
+    struct SStats {
+        uint64_t nPackets;
+        uint64_t nLate;         // released more than LATE_THRESHOLD after scheduled time
+        double sumLag;          // seconds
+        double maxLag;          // seconds
+        double captureSpan;     // capture time covered since anchor (seconds)
+        double wallSpan;        // wall time since anchor (seconds)
+    };
+
+    /**
+     * @param speed Replay speed factor, limited to MIN_SPEED..MAX_SPEED
+     * @param name Input name used in the report
+     */
+    explicit CReplayScheduler(double speed = 1.0, const std::string &name = "input");
+
+    /**
+     * Wait until the packet with given capture time (seconds) is due.
+     */
+    void WaitFor(double captureTime);
+
+    /**
+     * Start new schedule with the next packet (e.g. at start of file).
+     */
+    void Reset();
+
+    double GetSpeed() const { return _speed; }
+
+    const SStats &GetStats() const { return _stats; }
+
+    /**
+     * Achieved replay speed since the last anchor (0 if not known yet).
+     */
+    double GetAchievedSpeed() const;
+
+    /**
+     * Log achieved versus target timing.
+     */
+    void Report() const;
+
+    static int64_t Now(); // monotonic clock in nanoseconds
+
+private:
+    std::string _name;
+    double _speed;
+    bool _anchored;
+    int64_t _wallStart;
+    double _captureStart;
+    double _lastCapture;
+    SStats _stats;
+
+    void Anchor(double captureTime, int64_t now);
+};
+
+#endif
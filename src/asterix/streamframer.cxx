@@ -0,0 +1,135 @@
+/*
+ *  Copyright (c) 2013 Croatia Control Ltd. (www.crocontrol.hr)
+ *
+ *  This file is part of Asterix.
+ *
+ *  Asterix is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Asterix is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Asterix.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <string.h>
+#include <algorithm>
+
+#include "streamframer.hxx"
+
+
+CStreamFramer::CStreamFramer(const std::bitset<256> &categories, size_t capacity)
+        : _categories(categories),
+          _buffer(std::max(capacity, static_cast<size_t>(2 * (MAX_BLOCK_SIZE + HEADER_SIZE)))),
+          _read(0), _write(0), _synced(true), _nBlocks(0), _nResync(0), _nSkipped(0) {
+}
+
+
+unsigned int CStreamFramer::blockLength(const unsigned char *p) const {
+    const unsigned int len = (static_cast<unsigned int>(p[1]) << 8) | p[2];
+    if (!_categories.test(p[0]) || len < HEADER_SIZE + 1) {
+        return 0;
+    }
+    return len;
+}
+
+
+unsigned char *CStreamFramer::GetWriteBuffer(size_t &space) {
+    size_t buffered = _write - _read;
+
+    // request enough to complete the span, or the first block (and header after it)
+    size_t limit = MAX_SPAN;
+    if (buffered >= HEADER_SIZE) {
+        limit = std::max(limit, static_cast<size_t>(blockLength(&_buffer[_read]) + HEADER_SIZE));
+    }
+    if (limit <= buffered) {
+        limit = buffered + 1;
+    }
+
+    // keep blocks contiguous
+    if (_buffer.size() - _read < limit) {
+        if (buffered > 0) {
+            memmove(&_buffer[0], &_buffer[_read], buffered);
+        }
+        _read = 0;
+        _write = buffered;
+    }
+
+    space = limit - buffered;
+    return &_buffer[_write];
+}
+
+
+void CStreamFramer::Commit(size_t len) {
+    _write = std::min(_write + len, _buffer.size());
+}
+
+
+const unsigned char *CStreamFramer::NextBlocks(unsigned int &len) {
+    if (_synced && _write - _read >= HEADER_SIZE && blockLength(&_buffer[_read]) == 0) {
+        _synced = false;
+        _nResync++;
+    }
+
+    if (!_synced) {
+        // first plausible header followed by another one; skip bytes before it, but
+        // not beyond a block that cannot be checked yet
+        size_t pos = _read;
+        size_t firstOpen = _write;
+        bool bFound = false;
+        for (; pos + HEADER_SIZE <= _write; pos++) {
+            const unsigned int blockLen = blockLength(&_buffer[pos]);
+            if (blockLen == 0) {
+                continue;
+            }
+            if (pos + blockLen + HEADER_SIZE > _write) {
+                firstOpen = std::min(firstOpen, pos);
+            } else if (blockLength(&_buffer[pos + blockLen]) > 0) {
+                bFound = true;
+                break;
+            }
+        }
+        if (!bFound) {
+            pos = std::min(pos, firstOpen);
+        }
+        _nSkipped += pos - _read;
+        _read = pos;
+        if (!bFound) {
+            return nullptr;
+        }
+        _synced = true;
+    }
+
+    // consecutive complete blocks
+    size_t spanLen = 0;
+    while (_write - _read - spanLen >= HEADER_SIZE) {
+        const unsigned int blockLen = blockLength(&_buffer[_read + spanLen]);
+        if (blockLen == 0 || _write - _read - spanLen < blockLen ||
+            (spanLen > 0 && spanLen + blockLen > MAX_SPAN)) {
+            break;
+        }
+        spanLen += blockLen;
+        _nBlocks++;
+    }
+    if (spanLen == 0) {
+        return nullptr;
+    }
+
+    const unsigned char *pBlocks = &_buffer[_read];
+    _read += spanLen;
+    len = static_cast<unsigned int>(spanLen);
+    return pBlocks;
+}
+
+
+void CStreamFramer::Reset() {
+    _read = 0;
+    _write = 0;
+    _synced = true;
+}
@@ -0,0 +1,112 @@
+/*
+ *  Copyright (c) 2013 Croatia Control Ltd. (www.crocontrol.hr)
+ *
+ *  This file is part of Asterix.
+ *
+ *  Asterix is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Asterix is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Asterix.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef STREAMFRAMER_HXX__
+#define STREAMFRAMER_HXX__
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class CStreamFramer
+ *
+ * @brief Cuts ASTERIX data blocks from a byte stream (e.g. TCP or serial line).
+ *
+ * Bytes are received directly into the framer buffer (GetWriteBuffer() and
+ * Commit()) and complete data blocks are returned in place, so they are
+ * parsed without copying. The buffer has read and write positions; unread
+ * bytes are moved to its start only when the free space at the end gets
+ * too small for a data block, so blocks are always contiguous.
+ *
+ * Block boundaries are taken from the 3 byte header (category, length).
+ * A header is plausible if its category is accepted and the length holds
+ * at least one FSPEC byte. On an implausible header the framer skips bytes
+ * until it finds a plausible one that is followed by another plausible
+ * header, and continues from there.
+ */
+class CStreamFramer {
+public:
+    static constexpr unsigned int HEADER_SIZE = 3;
+    static constexpr unsigned int MAX_BLOCK_SIZE = 65535;
+    // Largest span of blocks returned at once (maximum UDP payload, so it can be written as one packet)
+    static constexpr unsigned int MAX_SPAN = 65507;
+    static constexpr size_t DEFAULT_CAPACITY = 256 * 1024;
+
+    /**
+     * @param categories Categories accepted in block headers (default all)
+     * @param capacity Buffer size, at least 2 * (MAX_BLOCK_SIZE + HEADER_SIZE)
+     */
+    explicit CStreamFramer(const std::bitset<256> &categories = std::bitset<256>().set(),
+                           size_t capacity = DEFAULT_CAPACITY);
+
+    /**
+     * Buffer to receive stream data into and its size. At most as many bytes
+     * are requested as needed to complete the current span, so no complete
+     * block is left buffered after NextBlocks() returned nullptr.
+     */
+    unsigned char *GetWriteBuffer(size_t &space);
+
+    /**
+     * Add len bytes received into the write buffer.
+     */
+    void Commit(size_t len);
+
+    /**
+     * Returns consecutive complete data blocks (up to MAX_SPAN bytes, but
+     * at least one block) and their length, or nullptr if more data is
+     * needed. Returned data is valid until the next GetWriteBuffer().
+     */
+    const unsigned char *NextBlocks(unsigned int &len);
+
+    /**
+     * Drop buffered data, e.g. when the connection is lost.
+     */
+    void Reset();
+
+    /**
+     * Categories accepted in headers of blocks not framed yet.
+     */
+    void SetCategories(const std::bitset<256> &categories) { _categories = categories; }
+
+    size_t GetNBuffered() const { return _write - _read; }
+
+    uint64_t GetNBlocks() const { return _nBlocks; }
+
+    uint64_t GetNResync() const { return _nResync; } // number of times synchronization was lost
+
+    uint64_t GetNSkipped() const { return _nSkipped; } // bytes skipped while resynchronizing
+
+private:
+    std::bitset<256> _categories;
+    std::vector<unsigned char> _buffer;
+    size_t _read;
+    size_t _write;
+    bool _synced;
+    uint64_t _nBlocks;
+    uint64_t _nResync;
+    uint64_t _nSkipped;
+
+    // length of block at p if its header is plausible, otherwise 0
+    unsigned int blockLength(const unsigned char *p) const;
+};
+
+#endif
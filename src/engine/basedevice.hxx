@@ -23,6 +23,16 @@
 #ifndef BASEDEVICE_HXX__
 #define BASEDEVICE_HXX__
 
+/**
+ * Output key given with IoCtrl(ESelectOutput) before writing to a split device.
+ * Negative value means the field is not known (e.g. record without SAC/SIC).
+ */
+struct SSplitKey {
+    int cat;
+    int sac;
+    int sic;
+};
+
 /**
  * @class CBaseDevice
  *
@@ -47,7 +57,11 @@ public:
         EReset,
         EPacketDone,
         EAllDone,
-        EIsLastPacket
+        EIsLastPacket,
+        ESeek,          // data points to file offset (int64_t) to continue reading from
+        EEndOfInput,    // stop reading current input as if its end was reached
+        ESelectOutput,  // data points to SSplitKey selecting output file of split device
+        EGetPosition    // data points to int64_t receiving read offset of input or size of (flushed) output
     };
 
 
@@ -76,10 +90,13 @@ public:
     virtual bool IsPacketDevice() = 0;
 
     virtual unsigned int MaxPacketSize() { return 0; } // return maximal packet size (only for packet devices)
+    virtual bool IsStreamDevice() { return false; } // if true Read(data, &len) returns available bytes without preserving message boundaries
     virtual bool IsOpened() { return _opened; }
 
     virtual bool IsOnStart() { return _onstart; } // if true device is on start (e.g. beginning of file)
     virtual unsigned int BytesLeftToRead() { return 0; } // return number of bytes left to read or 0 if unknown
+    virtual double GetPacketTime() { return 0; } // return receive time of last read packet (seconds since epoch) or 0 if unknown
+    virtual const char *GetFileName() { return nullptr; } // return name of the file being read or nullptr if not a file
     virtual unsigned int GetNReadErrors(bool bSeq = false) { return bSeq ? _nSeqReadErrors : _nReadErrors; }
 
     virtual unsigned int GetNWriteErrors(bool bSeq = false) { return bSeq ? _nSeqWriteErrors : _nWriteErrors; }
@@ -63,6 +63,14 @@ public:
     virtual CBaseFormatDescriptor *CreateFormatDescriptor
             (const unsigned int formatNo, const char *sFormatDescriptor) = 0;
 
+    /**
+     * Creates a descriptor with its own packet buffers and parser state.
+     * Used when several input channels are read in parallel, so that each
+     * input thread works on its own descriptor.
+     */
+    virtual CBaseFormatDescriptor *CreatePrivateFormatDescriptor
+            (const unsigned int formatNo, const char *sFormatDescriptor) = 0;
+
     virtual bool GetFormatNo(const char *formatName, unsigned int &formatNo) = 0;
 
     virtual int GetStatus(CBaseDevice &device,
@@ -57,6 +57,11 @@ public:
 
     virtual bool filterOutItem(int /*cat*/, std::string /*item*/, const char * /*name*/) { return false; }
 
+    /**
+     * Time of the last packet read (seconds since epoch), 0 if unknown
+     */
+    virtual double GetTimeStamp() { return 0; }
+
 };
 
 #endif
@@ -58,7 +58,11 @@ CChannelFactory::CChannelFactory() {
     }
 
     // Make sure that all channels are put to uninitialized state.
-    _inputChannel = nullptr;
+    for (unsigned int i = 0; i < MAX_INPUT_CHANNELS; i++) {
+        _inputChannel[i] = nullptr;
+    }
+    _nInputChannels = 0;
+
     for (unsigned int i = 0; i < MAX_OUTPUT_CHANNELS; i++) {
         _outputChannel[i] = nullptr;
     }
@@ -70,8 +74,10 @@ CChannelFactory::CChannelFactory() {
 
 
 CChannelFactory::~CChannelFactory() {
-    if (_inputChannel) {
-        delete _inputChannel;
+    for (unsigned int i = 0; i < MAX_INPUT_CHANNELS; i++) {
+        if (_inputChannel[i]) {
+            delete _inputChannel[i];
+        }
     }
 
     for (unsigned int i = 0; i < MAX_OUTPUT_CHANNELS; i++) {
@@ -91,10 +97,10 @@ bool CChannelFactory::CreateInputChannel(const char *sDeviceName, const char *sD
                                          const char *sFormatName, const char *sFormatDescriptor) {
     ASSERT(_formatEngine);
 
-    // Check if input channel has been already initialized
-    if (_inputChannel) {
-        // Already installed
-        LOGERROR(1, "Input channel has been already installed.\n");
+    // Check for free input channel slots
+    if (_nInputChannels >= MAX_INPUT_CHANNELS) {
+        // No free slots
+        LOGERROR(1, "Couldn't create device '%s'. Maximum number of input channels reached.\n", sDeviceName);
         return false;
     }
 
@@ -105,18 +111,34 @@ bool CChannelFactory::CreateInputChannel(const char *sDeviceName, const char *sD
         return false;
     }
 
+    // Optionally receive packets on a separate thread
+    if (gReceiveRing > 0 && CDeviceFactory::Instance()->GetDevice(deviceNo)->IsPacketDevice()) {
+        if (!CDeviceFactory::Instance()->AttachReceiveRing(deviceNo, gReceiveRing)) {
+            LOGERROR(1, "Couldn't attach receive ring to device '%s'.\n", sDeviceName);
+            return false;
+        }
+    }
+
     // Attach formatter to the input channel
+    // Additional inputs are read on their own threads and need their own descriptor
     unsigned int formatNo;
     CBaseFormatDescriptor *formatDesc;
-    if (!CChannelFactory::Instance()->AttachFormatter(sFormatName, sFormatDescriptor, formatNo, &formatDesc)) {
+    if (!CChannelFactory::Instance()->AttachFormatter(sFormatName, sFormatDescriptor, formatNo, &formatDesc,
+                                                      _nInputChannels > 0)) {
         LOGERROR(1, "Couldn't attach formatter '%s'.\n", sFormatDescriptor);
         return false;
     }
 
     // Activate input channel
-    _inputChannel = new CChannel(deviceNo, formatNo, formatDesc, false, false, 0, 0);
+    _inputChannel[_nInputChannels] = new CChannel(deviceNo, formatNo, formatDesc, false, false, 0, 0);
+
+    if (_inputChannel[_nInputChannels] == nullptr) {
+        return false;
+    }
 
-    return (_inputChannel != nullptr);
+    _nInputChannels++;
+
+    return true;
 }
 
 
@@ -192,7 +214,7 @@ bool CChannelFactory::CreateOutputChannel(const char *sDeviceName, const char *s
 
 
 bool CChannelFactory::AttachFormatter(const char *sFormatName, const char *sFormatDescriptor, unsigned int &formatNo,
-                                      CBaseFormatDescriptor **formatDesc) {
+                                      CBaseFormatDescriptor **formatDesc, bool bPrivate) {
     LOGDEBUG(1, "AttachFormatter %s\n", sFormatName);
 
     if (!_formatEngine->GetFormatNo(sFormatName, formatNo)) {
@@ -201,7 +223,13 @@ bool CChannelFactory::AttachFormatter(const char *sFormatName, const char *sForm
     }
 
     // Create format descriptor
-    if ((*formatDesc = _formatEngine->CreateFormatDescriptor(formatNo, sFormatDescriptor)) == nullptr) {
+    if (bPrivate) {
+        *formatDesc = _formatEngine->CreatePrivateFormatDescriptor(formatNo, sFormatDescriptor);
+    } else {
+        *formatDesc = _formatEngine->CreateFormatDescriptor(formatNo, sFormatDescriptor);
+    }
+
+    if (*formatDesc == nullptr) {
         LOGERROR(1, "Couldn't create format descriptor'%s' for '%s'.\n", sFormatDescriptor, sFormatName);
         return false;
     }
@@ -210,16 +238,17 @@ bool CChannelFactory::AttachFormatter(const char *sFormatName, const char *sForm
 }
 
 
-bool CChannelFactory::WaitForPacket(const unsigned int secondsToWait) {
+bool CChannelFactory::WaitForPacket(const unsigned int secondsToWait, const unsigned int inputChannel) {
     ASSERT(_formatEngine);
 
-    if (_inputChannel == nullptr) {
+    CChannel *pInput = GetInputChannel(inputChannel);
+    if (pInput == nullptr) {
         LOGERROR(1, "Select() - Input device not installed.\n");
         return false;
     }
 
     // Get the reference to the input device
-    CBaseDevice *inputDevice = CDeviceFactory::Instance()->GetDevice(_inputChannel->GetDeviceNo());
+    CBaseDevice *inputDevice = CDeviceFactory::Instance()->GetDevice(pInput->GetDeviceNo());
 
     if (inputDevice == nullptr) {
         LOGERROR(1, "Select() - Cannot get the input device.\n");
@@ -230,16 +259,17 @@ bool CChannelFactory::WaitForPacket(const unsigned int secondsToWait) {
 }
 
 
-bool CChannelFactory::ReadPacket() {
+bool CChannelFactory::ReadPacket(const unsigned int inputChannel) {
     ASSERT(_formatEngine);
 
-    if (_inputChannel == nullptr) {
+    CChannel *pInput = GetInputChannel(inputChannel);
+    if (pInput == nullptr) {
         LOGERROR(1, "ReadPacket() - Input device not installed.\n");
         return false;
     }
 
     // Get the reference to the input device
-    CBaseDevice *inputDevice = CDeviceFactory::Instance()->GetDevice(_inputChannel->GetDeviceNo());
+    CBaseDevice *inputDevice = CDeviceFactory::Instance()->GetDevice(pInput->GetDeviceNo());
 
     if (inputDevice == nullptr) {
         LOGERROR(1, "ReadPacket() - Cannot get the input device.\n");
@@ -247,13 +277,13 @@ bool CChannelFactory::ReadPacket() {
     }
 
     // Get thr format descriptor and number
-    CBaseFormatDescriptor *formatDescriptor = _inputChannel->GetFormatDescriptor();
+    CBaseFormatDescriptor *formatDescriptor = pInput->GetFormatDescriptor();
     if (formatDescriptor == nullptr) {
         LOGERROR(1, "ReadPacket() - Cannot get the format descriptor.\n");
         return false;
     }
 
-    unsigned int formatNo = _inputChannel->GetFormatNo();
+    unsigned int formatNo = pInput->GetFormatNo();
     bool discard = false;
 
     // FormatEngine - read packet from the input device using predefined format
@@ -261,7 +291,7 @@ bool CChannelFactory::ReadPacket() {
 }
 
 
-bool CChannelFactory::WritePacket(const unsigned int outputChannel) {
+bool CChannelFactory::WritePacket(const unsigned int outputChannel, const unsigned int inputChannel) {
     ASSERT(_formatEngine);
 
     if (_outputChannel[outputChannel] == nullptr) {
@@ -269,6 +299,12 @@ bool CChannelFactory::WritePacket(const unsigned int outputChannel) {
         return false;
     }
 
+    CChannel *pInput = GetInputChannel(inputChannel);
+    if (pInput == nullptr) {
+        LOGERROR(1, "WritePacket() - Input device not installed.\n");
+        return false;
+    }
+
     // Get the reference to the output device
     CBaseDevice *outputDevice =
             CDeviceFactory::Instance()->GetDevice(_outputChannel[outputChannel]->GetDeviceNo());
@@ -278,8 +314,9 @@ bool CChannelFactory::WritePacket(const unsigned int outputChannel) {
         return false;
     }
 
-    // Get the format descriptor and number
-    CBaseFormatDescriptor *formatDescriptor = _outputChannel[outputChannel]->GetFormatDescriptor();
+    // Get the format descriptor holding the packet read from the input channel
+    // (with a single input this is the same descriptor as the output channel one)
+    CBaseFormatDescriptor *formatDescriptor = pInput->GetFormatDescriptor();
     if (formatDescriptor == nullptr) {
         LOGERROR(1, "WritePacket() - Cannot get the format descriptor.\n");
         return false;
@@ -300,16 +337,17 @@ bool CChannelFactory::WritePacket(const unsigned int outputChannel) {
 }
 
 
-bool CChannelFactory::ProcessPacket(bool &discard) {
+bool CChannelFactory::ProcessPacket(bool &discard, const unsigned int inputChannel) {
     ASSERT(_formatEngine);
 
-    if (_inputChannel == nullptr) {
+    CChannel *pInput = GetInputChannel(inputChannel);
+    if (pInput == nullptr) {
         LOGERROR(1, "ProcessPacket() - Input device not installed.\n");
         return false;
     }
 
     // Get the reference to the input device
-    CBaseDevice *inputDevice = CDeviceFactory::Instance()->GetDevice(_inputChannel->GetDeviceNo());
+    CBaseDevice *inputDevice = CDeviceFactory::Instance()->GetDevice(pInput->GetDeviceNo());
 
     if (inputDevice == nullptr) {
         LOGERROR(1, "ProcessPacket() - Cannot get the input device.\n");
@@ -317,12 +355,12 @@ bool CChannelFactory::ProcessPacket(bool &discard) {
     }
 
     // Get the format descriptor and number
-    CBaseFormatDescriptor *formatDescriptor = _inputChannel->GetFormatDescriptor();
+    CBaseFormatDescriptor *formatDescriptor = pInput->GetFormatDescriptor();
     if (formatDescriptor == nullptr) {
         LOGERROR(1, "ProcessPacket() - Cannot get the format descriptor.\n");
         return false;
     }
-    unsigned int formatNo = _inputChannel->GetFormatNo();
+    unsigned int formatNo = pInput->GetFormatNo();
 
     // FormatEngine - process packet from the input device using predefined format
     return _formatEngine->ProcessPacket(*formatDescriptor, *inputDevice, formatNo, discard);
@@ -389,11 +427,17 @@ bool CChannelFactory::HeartbeatProcessing(const unsigned int outputChannel) {
 }
 
 
-int CChannelFactory::GetStatus(int query) {
+int CChannelFactory::GetStatus(int query, const unsigned int inputChannel) {
     ASSERT(_formatEngine);
 
+    CChannel *pInput = GetInputChannel(inputChannel);
+    if (pInput == nullptr) {
+        LOGERROR(1, "GetStatus() - Input device not installed.\n");
+        return STS_NO_DATA;
+    }
+
     // Get the reference to the input device
-    CBaseDevice *inputDevice = CDeviceFactory::Instance()->GetDevice(_inputChannel->GetDeviceNo());
+    CBaseDevice *inputDevice = CDeviceFactory::Instance()->GetDevice(pInput->GetDeviceNo());
 
     if (inputDevice == nullptr) {
         LOGERROR(1, "GetStatus() - Cannot get the input device.\n");
@@ -401,7 +445,7 @@ int CChannelFactory::GetStatus(int query) {
     }
 
     CBaseDevice &devRef = *inputDevice;
-    unsigned int formatNo = _inputChannel->GetFormatNo();
+    unsigned int formatNo = pInput->GetFormatNo();
 
     // FormatEngine - get status for the input device and format
     return _formatEngine->GetStatus(devRef, formatNo, query);
@@ -458,21 +502,22 @@ bool CChannelFactory::IsFailoverOutputChannel(const unsigned int ch) {
 }
 
 
-bool CChannelFactory::ResetInputChannel() {
+bool CChannelFactory::ResetInputChannel(const unsigned int inputChannel) {
     ASSERT(_formatEngine);
 
-    if (_inputChannel == nullptr) {
+    CChannel *pInput = GetInputChannel(inputChannel);
+    if (pInput == nullptr) {
         LOGERROR(1, "ResetInputChannel() - Input device not installed.\n");
         return false;
     }
 
-    CBaseFormatDescriptor *formatDescriptor = _inputChannel->GetFormatDescriptor();
+    CBaseFormatDescriptor *formatDescriptor = pInput->GetFormatDescriptor();
     if (formatDescriptor == nullptr) {
         LOGERROR(1, "ResetInputChannel() - Cannot get the format descriptor.\n");
         return false;
     }
 
-    bool rc = _inputChannel->Reset();
+    bool rc = pInput->Reset();
     rc = _formatEngine->OnResetInputChannel(*formatDescriptor) && rc;
 
     return rc;
@@ -505,12 +550,12 @@ bool CChannelFactory::IoCtrl(const int channel, const unsigned int command, cons
 
     if (channel == -1) {
         // input channel
-        if (_inputChannel == nullptr) {
+        if (_inputChannel[0] == nullptr) {
             LOGERROR(1, "IoCtrl() - Input device not installed.\n");
             return false;
         }
 
-        pDev = CDeviceFactory::Instance()->GetDevice(_inputChannel->GetDeviceNo());
+        pDev = CDeviceFactory::Instance()->GetDevice(_inputChannel[0]->GetDeviceNo());
     } else {
         // output channel
         if (_outputChannel[channel] == nullptr) {
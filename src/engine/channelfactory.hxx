@@ -41,6 +41,7 @@ class CBaseFormatDescriptor;
 class CChannelFactory {
 public:
 
+    static const unsigned int MAX_INPUT_CHANNELS = 32;
     static const unsigned int MAX_OUTPUT_CHANNELS = 10;
 
 private:
@@ -51,7 +52,8 @@ private:
     // To access private Ctor...
     friend class CSingleton<CChannelFactory>;
 
-    CChannel *_inputChannel;
+    CChannel *_inputChannel[MAX_INPUT_CHANNELS];
+    unsigned int _nInputChannels;
     CChannel *_outputChannel[MAX_OUTPUT_CHANNELS];
     unsigned int _nOutputChannels;
     CBaseFormat *_formatEngine;
@@ -97,8 +99,11 @@ public:
                              const char *sFormatName, const char *sFormatDescriptor,
                              const bool bFailover, const char *sHeartbeat);
 
-    CChannel *GetInputChannel() { return _inputChannel; };
+    CChannel *GetInputChannel(const unsigned int inputChannel = 0) {
+        return (inputChannel < _nInputChannels) ? _inputChannel[inputChannel] : nullptr;
+    };
 
+    unsigned int GetNInputChannels() { return _nInputChannels; }
 
     unsigned int GetNOutputChannels() { return _nOutputChannels; }
 
@@ -108,19 +113,19 @@ public:
 
     bool IsFailoverOutputChannel(const unsigned int ch);
 
-    bool WaitForPacket(const unsigned int secondsToWait);
+    bool WaitForPacket(const unsigned int secondsToWait, const unsigned int inputChannel = 0);
 
-    bool ReadPacket();
+    bool ReadPacket(const unsigned int inputChannel = 0);
 
-    bool WritePacket(const unsigned int outputChannel);
+    bool WritePacket(const unsigned int outputChannel, const unsigned int inputChannel = 0);
 
-    bool ProcessPacket(bool &discard);
+    bool ProcessPacket(bool &discard, const unsigned int inputChannel = 0);
 
     bool HeartbeatProcessing(const unsigned int outputChannel);
 
-    int GetStatus(int query = 0);
+    int GetStatus(int query = 0, const unsigned int inputChannel = 0);
 
-    bool ResetInputChannel();
+    bool ResetInputChannel(const unsigned int inputChannel = 0);
 
     bool ResetOutputChannel(const unsigned int outputChannel);
 
@@ -129,7 +134,8 @@ public:
 private:
 
     bool AttachFormatter(const char *sFormatName, const char *sFormatDescriptor,
-                         unsigned int &formatNo, CBaseFormatDescriptor **formatDesc);
+                         unsigned int &formatNo, CBaseFormatDescriptor **formatDesc,
+                         bool bPrivate = false);
 };
 
 #endif
@@ -0,0 +1,124 @@
+/*
+ *  Copyright (c) 2013 Croatia Control Ltd. (www.crocontrol.hr)
+ *
+ *  This file is part of Asterix.
+ *
+ *  Asterix is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Asterix is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Asterix.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "asterix.h"
+#include "checkpoint.hxx"
+
+
+CCheckpoint::CCheckpoint(const std::string &path)
+        : inputSize(0), inputOffset(0), packets(0), outputOffset(0), complete(false), _path(path) {
+}
+
+
+bool CCheckpoint::Load() {
+    FILE *f = fopen(_path.c_str(), "r");
+    if (f == nullptr) {
+        LOGERROR(1, "Cannot open checkpoint file '%s'\n", _path.c_str());
+        return false;
+    }
+
+    // every key is required, and a last line without end of line means the file was cut
+    enum {
+        KEY_INPUT = 0x01, KEY_INPUT_SIZE = 0x02, KEY_INPUT_OFFSET = 0x04, KEY_PACKETS = 0x08,
+        KEY_OUTPUT = 0x10, KEY_OUTPUT_OFFSET = 0x20, KEY_COMPLETE = 0x40, KEY_ALL = 0x7F
+    };
+    unsigned int keys = 0;
+    bool bTruncated = false;
+    char line[4096];
+    while (fgets(line, sizeof(line), f) != nullptr) {
+        const size_t len = strcspn(line, "\r\n");
+        bTruncated = line[len] == '\0';
+        line[len] = '\0';
+        char *value = strchr(line, '=');
+        if (line[0] == '#' || value == nullptr) {
+            continue;
+        }
+        *value++ = '\0';
+
+        if (strcmp(line, "input") == 0) {
+            input = value;
+            keys |= KEY_INPUT;
+        } else if (strcmp(line, "input_size") == 0) {
+            inputSize = strtoull(value, nullptr, 10);
+            keys |= KEY_INPUT_SIZE;
+        } else if (strcmp(line, "input_offset") == 0) {
+            inputOffset = strtoll(value, nullptr, 10);
+            keys |= KEY_INPUT_OFFSET;
+        } else if (strcmp(line, "packets") == 0) {
+            packets = strtoull(value, nullptr, 10);
+            keys |= KEY_PACKETS;
+        } else if (strcmp(line, "output") == 0) {
+            output = value;
+            keys |= KEY_OUTPUT;
+        } else if (strcmp(line, "output_offset") == 0) {
+            outputOffset = strtoll(value, nullptr, 10);
+            keys |= KEY_OUTPUT_OFFSET;
+        } else if (strcmp(line, "complete") == 0) {
+            complete = atoi(value) != 0;
+            keys |= KEY_COMPLETE;
+        }
+    }
+    fclose(f);
+
+    if (bTruncated || keys != KEY_ALL || input.empty() || output.empty() || inputOffset < 0 || outputOffset < 0) {
+        LOGERROR(1, "Invalid checkpoint file '%s'\n", _path.c_str());
+        return false;
+    }
+    return true;
+}
+
+
+bool CCheckpoint::Save() const {
+    const std::string tmpPath = _path + ".tmp";
+
+    FILE *f = fopen(tmpPath.c_str(), "w");
+    if (f == nullptr) {
+        LOGERROR(1, "Cannot create checkpoint file '%s'\n", tmpPath.c_str());
+        return false;
+    }
+
+    fprintf(f, "# asterix conversion checkpoint\n");
+    fprintf(f, "input=%s\n", input.c_str());
+    fprintf(f, "input_size=%llu\n", static_cast<unsigned long long>(inputSize));
+    fprintf(f, "input_offset=%lld\n", static_cast<long long>(inputOffset));
+    fprintf(f, "packets=%llu\n", static_cast<unsigned long long>(packets));
+    fprintf(f, "output=%s\n", output.c_str());
+    fprintf(f, "output_offset=%lld\n", static_cast<long long>(outputOffset));
+    fprintf(f, "complete=%d\n", complete ? 1 : 0);
+
+    const bool ok = (fflush(f) == 0) && !ferror(f);
+    if (fclose(f) != 0 || !ok) {
+        LOGERROR(1, "Cannot write checkpoint file '%s'\n", tmpPath.c_str());
+        remove(tmpPath.c_str());
+        return false;
+    }
+
+#ifdef _WIN32
+    remove(_path.c_str()); // rename does not replace existing file
+#endif
+    if (rename(tmpPath.c_str(), _path.c_str()) != 0) {
+        LOGERROR(1, "Cannot rename checkpoint file '%s'\n", tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
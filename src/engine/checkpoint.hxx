@@ -0,0 +1,71 @@
+/*
+ *  Copyright (c) 2013 Croatia Control Ltd. (www.crocontrol.hr)
+ *
+ *  This file is part of Asterix.
+ *
+ *  Asterix is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Asterix is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Asterix.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef CHECKPOINT_HXX__
+#define CHECKPOINT_HXX__
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @class CCheckpoint
+ *
+ * @brief Progress of a file conversion, used to resume it after interruption.
+ *
+ * Holds the input file offset after the last packet written to output, the
+ * number of packets and the output file size at that point. The converter
+ * engine updates and saves it periodically (output is flushed first). The
+ * file is written under a temporary name and renamed, so a checkpoint on
+ * disk is always complete. To resume, the output is truncated to the saved
+ * size and the input is read from the saved offset.
+ *
+ * File format is text, one "key=value" per line.
+ */
+class CCheckpoint {
+public:
+    static const unsigned int DEFAULT_INTERVAL = 10; // seconds
+
+    std::string input;      // input file name
+    uint64_t inputSize;     // input file size when the conversion started
+    int64_t inputOffset;    // offset of the next packet to read
+    uint64_t packets;       // number of packets read before inputOffset
+    std::string output;     // output file name
+    int64_t outputOffset;   // output file size after the packets
+    bool complete;          // whole input converted
+
+    explicit CCheckpoint(const std::string &path);
+
+    const std::string &GetPath() const { return _path; }
+
+    /**
+     * Read checkpoint file. Returns false if it does not exist, is not valid
+     * or not completely written.
+     */
+    bool Load();
+
+    /**
+     * Write checkpoint file atomically.
+     */
+    bool Save() const;
+
+private:
+    std::string _path;
+};
+
+#endif
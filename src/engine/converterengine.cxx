@@ -22,46 +22,62 @@
  */
 #include <stdio.h>
 #include <string.h>
+#include <thread>
+#include <vector>
 
 #include "asterix.h"
 #include "converterengine.hxx"
 #include "channelfactory.hxx"
+#include "checkpoint.hxx"
 #include "descriptor.hxx"
+#include "inputmerger.hxx"
 
 CSingleton<CConverterEngine> CConverterEngine::_Instance;
 
 
 bool CConverterEngine::Initialize(const char *inputChannel, const char *outputChannel[], const unsigned int nOutput,
                                   const unsigned int chFailover) {
+    return Initialize(&inputChannel, 1, outputChannel, nOutput, chFailover);
+}
 
-    ASSERT(inputChannel);
 
-    CDescriptor inputDescriptor(inputChannel, ";");
-    const char *inputDevice = inputDescriptor.GetFirst();
-    const char *inputDeviceDescriptor = inputDescriptor.GetNext();
-    const char *inputFormat = inputDescriptor.GetNext();
-    const char *inputFormatDescriptor = inputDescriptor.GetNext();
+bool CConverterEngine::Initialize(const char *inputChannel[], const unsigned int nInput,
+                                  const char *outputChannel[], const unsigned int nOutput,
+                                  const unsigned int chFailover, const unsigned int mergeWindow) {
 
-    LOGDEBUG(1, "inputDevice(%s)", inputDevice);
-    LOGDEBUG(1, "inputDeviceDescriptor(%s)", inputDeviceDescriptor);
-    LOGDEBUG(1, "inputFormatDescriptor(%s)", inputFormatDescriptor);
+    // Process input channels
+    for (unsigned int i = 0; i < nInput; i++) {
+        ASSERT(inputChannel[i]);
 
-    // Check input channel parameters consistency
-    if ((inputDevice == nullptr) || (inputDeviceDescriptor == nullptr) || (inputFormat == nullptr)) {
-        LOGERROR(1, "Input channel descriptor must be in the following format: \n\""
-                    "<device> <device_descriptor> <format> [format_descriptor]\"\n");
-        return false;
-    }
+        CDescriptor inputDescriptor(inputChannel[i], ";");
+        const char *inputDevice = inputDescriptor.GetFirst();
+        const char *inputDeviceDescriptor = inputDescriptor.GetNext();
+        const char *inputFormat = inputDescriptor.GetNext();
+        const char *inputFormatDescriptor = inputDescriptor.GetNext();
 
-    LOGDEBUG(1, "Input format: %s\n", inputFormat);
+        LOGDEBUG(1, "inputDevice(%s)", inputDevice);
+        LOGDEBUG(1, "inputDeviceDescriptor(%s)", inputDeviceDescriptor);
+        LOGDEBUG(1, "inputFormatDescriptor(%s)", inputFormatDescriptor);
 
-    // Create input channel
-    if (!CChannelFactory::Instance()->CreateInputChannel(inputDevice, inputDeviceDescriptor, inputFormat,
-                                                         inputFormatDescriptor)) {
-        LOGERROR(1, "Input channel initialization failed.\n");
-        return false;
+        // Check input channel parameters consistency
+        if ((inputDevice == nullptr) || (inputDeviceDescriptor == nullptr) || (inputFormat == nullptr)) {
+            LOGERROR(1, "Input channel descriptor must be in the following format: \n\""
+                        "<device> <device_descriptor> <format> [format_descriptor]\"\n");
+            return false;
+        }
+
+        LOGDEBUG(1, "Input format: %s\n", inputFormat);
+
+        // Create input channel
+        if (!CChannelFactory::Instance()->CreateInputChannel(inputDevice, inputDeviceDescriptor, inputFormat,
+                                                             inputFormatDescriptor)) {
+            LOGERROR(1, "Input channel initialization failed.\n");
+            return false;
+        }
     }
 
+    _mergeWindow = mergeWindow;
+
     // Process output channels
     for (unsigned int i = 0; i < nOutput; i++) {
         // TODO: special initialization of Failover channels
@@ -112,12 +128,12 @@ void CConverterEngine::waitForPacketWithHeartbeat(unsigned int nChannels) {
 }
 
 // Helper: Handle packet reading, returns true if packet read OK
-bool CConverterEngine::handlePacketRead(bool &noMoreData) {
-    if (CChannelFactory::Instance()->ReadPacket()) {
+bool CConverterEngine::handlePacketRead(bool &noMoreData, unsigned int inputChannel) {
+    if (CChannelFactory::Instance()->ReadPacket(inputChannel)) {
         return true;
     }
 
-    int sts = ProcessStatus();
+    int sts = ProcessStatus(inputChannel);
     noMoreData = (sts & STS_NO_DATA) != 0;
 
     if (noMoreData) {
@@ -127,20 +143,21 @@ bool CConverterEngine::handlePacketRead(bool &noMoreData) {
 }
 
 // Helper: Handle packet processing, returns true to continue main loop
-bool CConverterEngine::handlePacketProcess(bool packetOk, bool noMoreData, bool &discard) {
+bool CConverterEngine::handlePacketProcess(bool packetOk, bool noMoreData, bool &discard, unsigned int inputChannel) {
     if (!packetOk || noMoreData) {
         return true;
     }
 
-    if (!CChannelFactory::Instance()->ProcessPacket(discard)) {
+    if (!CChannelFactory::Instance()->ProcessPacket(discard, inputChannel)) {
         LOGERROR(1, "ProcessPacket() failed.\n");
-        return (ProcessStatus() & (STS_FAIL_INPUT | STS_FAIL_DATA)) != 0;
+        return (ProcessStatus(inputChannel) & (STS_FAIL_INPUT | STS_FAIL_DATA)) != 0;
     }
     return true;
 }
 
 // Helper: Dispatch to normal (non-failover) output channels
-void CConverterEngine::dispatchToNormalChannels(unsigned int nChannels, bool noMoreData, bool packetOk) {
+void CConverterEngine::dispatchToNormalChannels(unsigned int nChannels, bool noMoreData, bool packetOk,
+                                                unsigned int inputChannel) {
     for (unsigned int i = 0; i < nChannels; ++i) {
         if (CChannelFactory::Instance()->IsFailoverOutputChannel(i)) {
             break; // Stop at first failover channel
@@ -151,7 +168,7 @@ void CConverterEngine::dispatchToNormalChannels(unsigned int nChannels, bool noM
                 LOGERROR(1, "IoCtrl() failed.\n");
             }
         } else if (packetOk) {
-            if (!CChannelFactory::Instance()->WritePacket(i)) {
+            if (!CChannelFactory::Instance()->WritePacket(i, inputChannel)) {
                 LOGERROR(1, "WritePacket() failed.\n");
             }
         }
@@ -159,18 +176,18 @@ void CConverterEngine::dispatchToNormalChannels(unsigned int nChannels, bool noM
 }
 
 // Helper: Handle failover output channels with automatic switching
-void CConverterEngine::dispatchToFailoverChannels(unsigned int nChannels) {
+void CConverterEngine::dispatchToFailoverChannels(unsigned int nChannels, unsigned int inputChannel) {
     unsigned int ch = CChannelFactory::Instance()->GetActiveFailoverOutputChannel();
     unsigned int startCh = ch;
 
     while (ch < nChannels) {
-        if (CChannelFactory::Instance()->WritePacket(ch)) {
+        if (CChannelFactory::Instance()->WritePacket(ch, inputChannel)) {
             break; // Success
         }
 
         LOGERROR(1, "The current packet has been lost for failover output channel %d\n", static_cast<int>(ch));
 
-        int sts = ProcessStatus();
+        int sts = ProcessStatus(inputChannel);
 
         if (sts & STS_FAIL_OUTPUT) {
             ch = CChannelFactory::Instance()->GetNextFailoverOutputChannel();
@@ -195,6 +212,11 @@ void CConverterEngine::Start() {
     unsigned int nChannels = CChannelFactory::Instance()->GetNOutputChannels();
     bool discard = false;
 
+    if (CChannelFactory::Instance()->GetNInputChannels() > 1) {
+        StartMerged(nChannels);
+        return;
+    }
+
     LOGNOTIFY(gVerbose, "Converter Engine Started.\n");
 
     while (true) {
@@ -228,16 +250,142 @@ void CConverterEngine::Start() {
             dispatchToNormalChannels(nChannels, noMoreData, packetOk);
             dispatchToFailoverChannels(nChannels);
         }
+
+        // 5. Save progress periodically
+        if (packetOk && _pCheckpoint != nullptr) {
+            _pCheckpoint->packets++;
+            if ((_pCheckpoint->packets & 0xFF) == 0 && time(nullptr) >= _nextCheckpoint) {
+                saveCheckpoint(false);
+            }
+        }
+    }
+
+    if (_pCheckpoint != nullptr) {
+        saveCheckpoint(true);
+    }
+}
+
+
+void CConverterEngine::SetCheckpoint(CCheckpoint *checkpoint, unsigned int interval) {
+    _pCheckpoint = checkpoint;
+    _checkpointInterval = interval;
+    _nextCheckpoint = time(nullptr) + interval;
+}
+
+
+// Helper: Save input position after the last packet written and output size (output is flushed first)
+bool CConverterEngine::saveCheckpoint(bool complete) {
+    int64_t inputOffset = static_cast<int64_t>(_pCheckpoint->inputSize);
+    if (!complete && !CChannelFactory::Instance()->IoCtrl(-1, CBaseDevice::EGetPosition, &inputOffset,
+                                                          sizeof(inputOffset))) {
+        return false; // input already closed (e.g. at the end of file)
+    }
+
+    int64_t outputOffset = 0;
+    if (!CChannelFactory::Instance()->IoCtrl(0, CBaseDevice::EGetPosition, &outputOffset, sizeof(outputOffset))) {
+        LOGERROR(1, "Cannot get output position for checkpoint.\n");
+        return false;
+    }
+
+    _pCheckpoint->inputOffset = inputOffset;
+    _pCheckpoint->outputOffset = outputOffset;
+    _pCheckpoint->complete = complete;
+    _nextCheckpoint = time(nullptr) + _checkpointInterval;
+
+    if (!_pCheckpoint->Save()) {
+        return false;
+    }
+    LOGDEBUG(1, "Checkpoint: input offset %lld, %llu packets, output offset %lld\n",
+             static_cast<long long>(inputOffset), static_cast<unsigned long long>(_pCheckpoint->packets),
+             static_cast<long long>(outputOffset));
+    return true;
+}
+
+
+// Input thread: reads and parses packets of one input channel and writes
+// them to the output channels once the merger allows it
+void CConverterEngine::inputWorker(unsigned int inputChannel, unsigned int nChannels, CInputMerger &merger) {
+    CChannelFactory *factory = CChannelFactory::Instance();
+    bool discard = false;
+
+    while (true) {
+        // 1. Wait for incoming packet (heartbeat is handled by the main thread)
+        while (!factory->WaitForPacket(gHeartbeat, inputChannel)) {
+            if (factory->GetStatus(0, inputChannel) & STS_NO_DATA) {
+                break;
+            }
+        }
+
+        // 1a. Check if there is more data
+        if (factory->GetStatus(0, inputChannel) & STS_NO_DATA) {
+            break;
+        }
+
+        // 2. Read the incoming packet
+        bool noMoreData = false;
+        if (!handlePacketRead(noMoreData, inputChannel)) {
+            if (noMoreData) {
+                break;
+            }
+            continue;
+        }
+
+        // 3. Process the packet
+        if (!handlePacketProcess(true, false, discard, inputChannel)) {
+            continue;
+        }
+
+        // 4. Dispatch to output channels if not discarded
+        if (gForceRouting || !discard) {
+            CBaseFormatDescriptor *desc = factory->GetInputChannel(inputChannel)->GetFormatDescriptor();
+
+            merger.Acquire(inputChannel, desc->GetTimeStamp());
+            dispatchToNormalChannels(nChannels, false, true, inputChannel);
+            dispatchToFailoverChannels(nChannels, inputChannel);
+            merger.Release();
+        }
+    }
+
+    LOGINFO(gVerbose, "No more data available on input channel %d.\n", static_cast<int>(inputChannel));
+    merger.Finish(inputChannel);
+}
+
+
+void CConverterEngine::StartMerged(unsigned int nChannels) {
+    unsigned int nInputs = CChannelFactory::Instance()->GetNInputChannels();
+    CInputMerger merger(nInputs, _mergeWindow);
+    std::vector<std::thread> workers;
+
+    LOGNOTIFY(gVerbose, "Converter Engine Started with %d input channels (merge window %d ms).\n",
+              static_cast<int>(nInputs), static_cast<int>(_mergeWindow));
+
+    for (unsigned int i = 0; i < nInputs; i++) {
+        workers.emplace_back(&CConverterEngine::inputWorker, this, i, nChannels, std::ref(merger));
+    }
+
+    // HeartbeatProcessing for all output channels is called at least every second
+    while (!merger.WaitAllFinished(1000)) {
+        merger.AcquireOutputs();
+        for (unsigned int i = 0; i < nChannels; ++i) {
+            if (!CChannelFactory::Instance()->HeartbeatProcessing(i)) {
+                LOGERROR(1, "Heartbeat() failed.\n");
+            }
+        }
+        merger.Release();
+    }
+
+    for (auto &worker : workers) {
+        worker.join();
     }
 }
 
 
-int CConverterEngine::ProcessStatus() {
-    int sts = CChannelFactory::Instance()->GetStatus();
+int CConverterEngine::ProcessStatus(unsigned int inputChannel) {
+    int sts = CChannelFactory::Instance()->GetStatus(0, inputChannel);
 
     if ((sts & STS_FAIL_INPUT) || (sts & STS_FAIL_DATA)) {
         LOGWARNING(1, "Resetting input channel due to excessive errors or data errors\n");
-        if (!CChannelFactory::Instance()->ResetInputChannel()) {
+        if (!CChannelFactory::Instance()->ResetInputChannel(inputChannel)) {
             LOGERROR(1, "Failed to reset input channel.\n");
         }
     }
@@ -23,8 +23,14 @@
 #ifndef CONVERTERENGINE_HXX__
 #define CONVERTERENGINE_HXX__
 
+#include <time.h>
+
 #include "singleton.hxx"
 
+class CInputMerger;
+
+class CCheckpoint;
+
 /**
  * @class CConverterEngine
  * 
@@ -42,6 +48,16 @@ private:
     // To access private Ctor...
     friend class CSingleton<CConverterEngine>;
 
+    CConverterEngine() : _mergeWindow(0), _pCheckpoint(nullptr), _checkpointInterval(0), _nextCheckpoint(0) {}
+
+    // Ordering window (ms) used when merging several input channels
+    unsigned int _mergeWindow;
+
+    // Progress of single input conversion, saved every _checkpointInterval seconds
+    CCheckpoint *_pCheckpoint;
+    unsigned int _checkpointInterval;
+    time_t _nextCheckpoint;
+
 public:
 
     /**
@@ -81,22 +97,57 @@ public:
                     const unsigned int chFailover);
 
     /**
-     * Starts the engine. Never returns. Must not be called if initialization
-     * is not properly finished.
+    * Initializes the engine with several input channels. Each input channel
+    * is read and parsed on its own thread and all packets are merged into
+    * the same output channels.
+    *
+    * @param inputChannel
+    * Array of string descriptions of input channels.
+    *
+    * @param nInput
+    * Number of input channels.
+    *
+    * @param mergeWindow
+    * Ordering window in milliseconds. If not 0, packets from different
+    * inputs arriving within the window are written in timestamp order.
+    *
+    * @see <CConverterEngine>::<Initialize>
+    */
+    bool Initialize(const char *inputChannel[], const unsigned int nInput,
+                    const char *outputChannel[], const unsigned int nOutput,
+                    const unsigned int chFailover, const unsigned int mergeWindow = 0);
+
+    /**
+     * Starts the engine. Returns when there is no more input data. Must not
+     * be called if initialization is not properly finished.
      *
      * @see <CConverterEngine>::<Initialize>
      */
     void Start();
 
-    int ProcessStatus();
+    /**
+     * Saves progress of the conversion to checkpoint every interval seconds
+     * and when all input is converted. Supported for a single input channel
+     * and a single output channel with devices reporting their position
+     * (EGetPosition). The checkpoint is not owned by the engine.
+     */
+    void SetCheckpoint(CCheckpoint *checkpoint, unsigned int interval);
+
+    int ProcessStatus(unsigned int inputChannel = 0);
 
 private:
     // Helper methods to reduce cognitive complexity of Start()
     void waitForPacketWithHeartbeat(unsigned int nChannels);
-    bool handlePacketRead(bool &noMoreData);
-    bool handlePacketProcess(bool packetOk, bool noMoreData, bool &discard);
-    void dispatchToNormalChannels(unsigned int nChannels, bool noMoreData, bool packetOk);
-    void dispatchToFailoverChannels(unsigned int nChannels);
+    bool handlePacketRead(bool &noMoreData, unsigned int inputChannel = 0);
+    bool handlePacketProcess(bool packetOk, bool noMoreData, bool &discard, unsigned int inputChannel = 0);
+    void dispatchToNormalChannels(unsigned int nChannels, bool noMoreData, bool packetOk,
+                                  unsigned int inputChannel = 0);
+    void dispatchToFailoverChannels(unsigned int nChannels, unsigned int inputChannel = 0);
+    bool saveCheckpoint(bool complete);
+
+    // Multiple input channels
+    void StartMerged(unsigned int nChannels);
+    void inputWorker(unsigned int inputChannel, unsigned int nChannels, CInputMerger &merger);
 };
 
 #endif
@@ -34,8 +34,13 @@
 #include "udpdevice.hxx"
 #include "diskdevice.hxx"
 #include "stddevice.hxx"
+#include "rxringdevice.hxx"
+#include "splitdevice.hxx"
 #ifndef _WIN32
 #include "serialdevice.hxx"
+#include "shmdevice.hxx"
+#include "unixdevice.hxx"
+#include "tcpfanoutdevice.hxx"
 #endif
 #ifdef HAVE_ZEROMQ
 #include "zeromqdevice.hxx"
@@ -93,10 +98,22 @@ bool CDeviceFactory::CreateDevice(const char *deviceName, const char *deviceDesc
     } else if (strcasecmp(deviceName, "disk") == 0) {
         CDescriptor descriptor(deviceDescriptor, "|");
         _Device[_nDevices] = std::make_unique<CDiskDevice>(descriptor);
+    } else if (strcasecmp(deviceName, "split") == 0) {
+        CDescriptor descriptor(deviceDescriptor, "|");
+        _Device[_nDevices] = std::make_unique<CSplitDevice>(descriptor);
 #ifndef _WIN32
     } else if (strcasecmp(deviceName, "serial") == 0) {
         CDescriptor descriptor(deviceDescriptor, ":");
         _Device[_nDevices] = std::make_unique<CSerialDevice>(descriptor);
+    } else if (strcasecmp(deviceName, "shm") == 0) {
+        CDescriptor descriptor(deviceDescriptor, ":");
+        _Device[_nDevices] = std::make_unique<CShmDevice>(descriptor);
+    } else if (strcasecmp(deviceName, "unix") == 0) {
+        CDescriptor descriptor(deviceDescriptor, ":");
+        _Device[_nDevices] = std::make_unique<CUnixDevice>(descriptor);
+    } else if (strcasecmp(deviceName, "tcpfan") == 0) {
+        CDescriptor descriptor(deviceDescriptor, ":");
+        _Device[_nDevices] = std::make_unique<CTcpFanoutDevice>(descriptor);
 #endif
 #ifdef HAVE_ZEROMQ
     } else if (strcasecmp(deviceName, "zmq") == 0 || strcasecmp(deviceName, "zeromq") == 0) {
@@ -143,3 +160,21 @@ bool CDeviceFactory::CreateDevice(const char *deviceName, const char *deviceDesc
     deviceNo = _nDevices++;
     return true;
 }
+
+
+bool CDeviceFactory::AttachReceiveRing(unsigned int deviceNo, unsigned int nSlots) {
+    if (deviceNo >= _nDevices || !_Device[deviceNo]) {
+        LOGERROR(1, "Cannot attach receive ring to device %u.\n", deviceNo);
+        return false;
+    }
+
+    if (!_Device[deviceNo]->IsPacketDevice()) {
+        LOGERROR(1, "Receive ring can be attached only to packet devices.\n");
+        return false;
+    }
+
+    auto ring = std::make_unique<CRxRingDevice>(std::move(_Device[deviceNo]), nSlots);
+    _Device[deviceNo] = std::move(ring);
+
+    return _Device[deviceNo]->IsOpened();
+}
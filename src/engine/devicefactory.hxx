@@ -84,6 +84,12 @@ public:
 
     CBaseDevice *GetDevice(unsigned int DeviceNo) { return _Device[DeviceNo].get(); }
 
+    /**
+     * Moves the reception of a packet device to its own thread by wrapping
+     * it into <CRxRingDevice> with the given number of ring slots.
+     */
+    bool AttachReceiveRing(unsigned int deviceNo, unsigned int nSlots);
+
 };
 
 #endif
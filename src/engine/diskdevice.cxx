@@ -37,6 +37,8 @@
   #define access _access
   #define unlink _unlink
   #define fileno _fileno
+  #define fseeko _fseeki64
+  #define ftello _ftelli64
 #else
   #include <unistd.h>
   #include <sys/stat.h>
@@ -294,6 +296,10 @@ bool CDiskDevice::Init(const char *path) {
 //         ASSERT( !(_mode & DD_MODE_TEMPNAME) ); // not supported for input
 
         _fileStream = fopen(fname, "rb");
+        if (_fileStream != nullptr) {
+            _readahead.resize(DD_READAHEAD_SIZE);
+            setvbuf(_fileStream, _readahead.data(), _IOFBF, _readahead.size());
+        }
         _onstart = true;
     } else {
 /*
@@ -372,17 +378,21 @@ bool CDiskDevice::OpenOutputFile(const char *path, bool openNow) {
 
     if (openNow || (!_delayOpen)) {
         // open the file
-        _fileStream = fopen(fname, (_mode & DD_MODE_WRITENEW) ? "w" : "a");
+        _fileStream = fopen(fname, (_mode & DD_MODE_WRITENEW) ? "wb" : "ab");
         if (_fileStream == nullptr) {
             LOGERROR(1, "Cannot open file '%s'\n", fname);
             return false;
         } else {
+            _readahead.resize(DD_READAHEAD_SIZE);
+            setvbuf(_fileStream, _readahead.data(), _IOFBF, _readahead.size());
             if (fname != _fileName) {
                 snprintf(_fileName, sizeof(_fileName), "%s", fname);
             }
             LOGDEBUG(ZONE_DISKDEVICE, "Opened output file '%s'\n", _fileName);
             _opened = true;
-            _onstart = true;
+            // appending to existing data (e.g. resumed conversion) is not on start, file headers are already written
+            struct stat fs;
+            _onstart = (fstat(fileno(_fileStream), &fs) != 0) || (fs.st_size == 0);
             return true;
         }
     } else {
@@ -399,6 +409,10 @@ bool CDiskDevice::OpenOutputFile(const char *path, bool openNow) {
             snprintf(_fileName, sizeof(_fileName), "%s", fname);
         }
 
+        // data will be appended to existing file
+        struct stat fs;
+        _onstart = (_mode & DD_MODE_WRITENEW) || (stat(_fileName, &fs) != 0) || (fs.st_size == 0);
+
         LOGDEBUG(ZONE_DISKDEVICE, "Output file '%s' will be opened on first write\n", _fileName);
         return true;
     }
@@ -643,6 +657,45 @@ bool CDiskDevice::IoCtrl(const unsigned int command, const void *data, size_t le
                     ASSERT(0);
             }
             break;
+        case ESeek:
+            if (_opened && _fileStream && _input && (data != nullptr) && (len == sizeof(int64_t))) {
+                result = (fseeko(_fileStream, *static_cast<const int64_t *>(data), SEEK_SET) == 0);
+                if (!result) {
+                    LOGERROR(1, "Cannot seek in file '%s'\n", _fileName);
+                }
+            }
+            break;
+        case EGetPosition:
+            if ((data != nullptr) && (len == sizeof(int64_t))) {
+                int64_t *position = static_cast<int64_t *>(const_cast<void *>(data));
+                if (_input) {
+                    result = _opened && _fileStream && ((*position = ftello(_fileStream)) >= 0);
+                } else if (_fileStream != nullptr) {
+                    // output is only appended, its size is the position
+                    struct stat fs;
+                    result = (fflush(_fileStream) == 0) && (fstat(fileno(_fileStream), &fs) == 0);
+                    *position = result ? static_cast<int64_t>(fs.st_size) : 0;
+                } else {
+                    // not opened yet (delayed open)
+                    struct stat fs;
+                    *position = (stat(_fileName, &fs) == 0 && !(_mode & DD_MODE_WRITENEW)) ?
+                                static_cast<int64_t>(fs.st_size) : 0;
+                    result = true;
+                }
+            }
+            break;
+        case EEndOfInput:
+            if (_opened && _fileStream && _input) {
+                // same as reaching the end of file in Read()
+                if (_mode & DD_MODE_READLOOP) {
+                    result = (fseek(_fileStream, 0, SEEK_SET) == 0);
+                    _onstart = result;
+                } else {
+                    DoneWithFile();
+                    result = true;
+                }
+            }
+            break;
         default:
             result = false;
             break;
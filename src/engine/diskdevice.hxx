@@ -31,9 +31,16 @@
   #include <unistd.h>
 #endif
 
+#include <vector>
+
 #include "basedevice.hxx"
 #include "descriptor.hxx"
 
+// stdio buffer of each file, so several files read in turn (e.g. merged by
+// timestamp) are read in large blocks instead of seeking between them and
+// output (e.g. PCAP extraction) is written in large blocks
+#define DD_READAHEAD_SIZE   (256 * 1024)
+
 // mode descriptor values (binary OR-ed)
 
 // If set, read the input file from beginning to the end, close it when reaching EOF.
@@ -102,6 +109,7 @@ private:
     char _tempName[MAXPATHLEN+1];
     unsigned int _seqNo;
     bool _delayOpen;
+    std::vector<char> _readahead; // stream buffer, must outlive _fileStream
 
 public:
 
@@ -130,6 +138,8 @@ public:
 
     unsigned int BytesLeftToRead() override; // return number of bytes left to read or 0 if unknown
 
+    const char *GetFileName() override { return (_input && _opened) ? _fileName : nullptr; }
+
 private:
     bool Init(const char *path);
 
@@ -29,6 +29,8 @@
  * These globals are externally declared in src/main/asterix.h
  */
 
+#include <cstdint>
+
 // Global verbose flag - controls debug output
 bool gVerbose = false;
 
@@ -44,8 +46,40 @@ int gHeartbeat = 0;
 // Path to ASTERIX definitions file
 const char* gAsterixDefinitionsFile = nullptr;
 
+// Binary cache of the definitions listed in gAsterixDefinitionsFile (nullptr = not used)
+const char* gDefinitionsCacheFile = nullptr;
+
+// Parse all definition files at startup instead of when their category is first received
+bool gEagerDefinitions = false;
+
 // Global filtering flag - controls data filtering behavior
 bool gFiltering = false;
 
+// Decode packets read in raw and PCAP formats (not needed if they are only copied to output)
+bool gDecodeInput = true;
+
+// Validate structure of raw and PCAP input instead of converting it (--validate)
+bool gValidate = false;
+
+// Malformed records and data blocks found in validation
+uint64_t gValidationErrors = 0;
+
 // Global synchronous flag - controls synchronous packet processing
 bool gSynchronous = false;
+
+// Replay speed factor in synchronous mode (1 = real time)
+double gReplaySpeed = 1.0;
+
+// Number of receive ring slots for packet inputs (0 = receive and parse on the same thread)
+unsigned int gReceiveRing = 0;
+
+// Capture time range read from PCAP files, seconds since epoch or UTC time of day if below 86400 (0 = not limited)
+double gStartTime = 0;
+double gEndTime = 0;
+
+// Input file offset to continue a resumed conversion from (0 = read from the start)
+int64_t gResumeOffset = 0;
+
+// Packet range read from PCAP files, 1 based (0 = not limited)
+unsigned long gFirstPacket = 0;
+unsigned long gLastPacket = 0;
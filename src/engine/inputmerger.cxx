@@ -0,0 +1,110 @@
+/*
+ *  Copyright (c) 2013 Croatia Control Ltd. (www.crocontrol.hr)
+ *
+ *  This file is part of Asterix.
+ *
+ *  Asterix is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Asterix is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Asterix.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "inputmerger.hxx"
+
+
+CInputMerger::CInputMerger(unsigned int nInputs, unsigned int windowMs)
+        : _inputs(nInputs), _window(windowMs == WINDOW_UNBOUNDED ? 0 : windowMs),
+          _unbounded(windowMs == WINDOW_UNBOUNDED), _nFinished(0), _busy(false) {
+    for (auto &in : _inputs) {
+        in.finished = false;
+    }
+}
+
+
+bool CInputMerger::IsNext(unsigned int input, Clock::time_point now) {
+    if (_window.count() == 0 && !_unbounded) {
+        return true; // no ordering, first come first served
+    }
+
+    // oldest pending packet goes first (ties resolved by input number)
+    if (_pending.empty() || _pending.top().second != input) {
+        return false;
+    }
+
+    const bool allPending = _pending.size() + _nFinished >= _inputs.size();
+    return allPending || (!_unbounded && now - _inputs[input].arrival >= _window);
+}
+
+
+void CInputMerger::Acquire(unsigned int input, double timestamp) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    const bool ordered = _window.count() > 0 || _unbounded;
+
+    SInput &me = _inputs[input];
+    me.arrival = Clock::now();
+    if (timestamp <= 0) {
+        timestamp = std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+    if (ordered) {
+        _pending.emplace(timestamp, input);
+        _cond.notify_all();
+    }
+
+    while (_busy || !IsNext(input, Clock::now())) {
+        Clock::time_point deadline = me.arrival + _window;
+        if (!_busy && !_unbounded && Clock::now() < deadline) {
+            // wake up when the window expires, even if nothing else happens
+            _cond.wait_until(lock, deadline);
+        } else {
+            _cond.wait(lock);
+        }
+    }
+
+    if (ordered) {
+        _pending.pop();
+    }
+    _busy = true;
+}
+
+
+void CInputMerger::AcquireOutputs() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _cond.wait(lock, [this] { return !_busy; });
+    _busy = true;
+}
+
+
+void CInputMerger::Release() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _busy = false;
+    }
+    _cond.notify_all();
+}
+
+
+void CInputMerger::Finish(unsigned int input) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_inputs[input].finished) {
+            _inputs[input].finished = true;
+            _nFinished++;
+        }
+    }
+    _cond.notify_all();
+}
+
+
+bool CInputMerger::WaitAllFinished(unsigned int timeoutMs) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    return _cond.wait_for(lock, std::chrono::milliseconds(timeoutMs),
+                          [this] { return _nFinished >= _inputs.size(); });
+}
@@ -0,0 +1,118 @@
+/*
+ *  Copyright (c) 2013 Croatia Control Ltd. (www.crocontrol.hr)
+ *
+ *  This file is part of Asterix.
+ *
+ *  Asterix is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Asterix is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Asterix.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef INPUTMERGER_HXX__
+#define INPUTMERGER_HXX__
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <utility>
+#include <vector>
+
+/**
+ * @class CInputMerger
+ *
+ * @brief Serializes access to the output channels for several input
+ *        threads and optionally orders their packets by timestamp.
+ *
+ * Every input thread holds at most one parsed packet. Before writing it
+ * to the outputs the thread calls Acquire() which blocks until:
+ *  - no other thread is writing, and
+ *  - with ordering window == 0: immediately (arrival order), or
+ *  - with ordering window > 0: the packet has the lowest timestamp of all
+ *    pending packets, and either every active input has a packet pending
+ *    or the packet has already waited for the whole window.
+ *
+ * The window therefore bounds the added latency, while packets arriving
+ * within the window are written in timestamp order (k-way merge).
+ * With WINDOW_UNBOUNDED a packet always waits for all active inputs, which
+ * gives exact timestamp order (used to merge recorded files).
+ *
+ * Pending packets are kept in a min-heap ordered by timestamp and input
+ * number, so only the input at the top of the heap may write.
+ */
+class CInputMerger {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    static const unsigned int WINDOW_UNBOUNDED = 0xFFFFFFFF;
+
+    /**
+     * @param nInputs Number of input channels
+     * @param windowMs Ordering window in milliseconds (0 = no ordering,
+     *                 WINDOW_UNBOUNDED = wait for all inputs)
+     */
+    CInputMerger(unsigned int nInputs, unsigned int windowMs);
+
+    /**
+     * Blocks until the packet of the given input may be written to the
+     * outputs. Must be followed by Release().
+     *
+     * @param input Input channel number
+     * @param timestamp Packet time in seconds since epoch (0 = use arrival time)
+     */
+    void Acquire(unsigned int input, double timestamp);
+
+    /**
+     * Blocks until the outputs are free, regardless of pending packets
+     * (used for heartbeat processing). Must be followed by Release().
+     */
+    void AcquireOutputs();
+
+    /**
+     * Releases the outputs acquired with Acquire() or AcquireOutputs().
+     */
+    void Release();
+
+    /**
+     * Marks the input as finished, so other inputs do not wait for it.
+     */
+    void Finish(unsigned int input);
+
+    /**
+     * Waits until all inputs are finished or the timeout expires.
+     *
+     * @return <true> if all inputs are finished
+     */
+    bool WaitAllFinished(unsigned int timeoutMs);
+
+private:
+    struct SInput {
+        bool finished;
+        Clock::time_point arrival;
+    };
+
+    typedef std::pair<double, unsigned int> TPending; // timestamp, input
+
+    bool IsNext(unsigned int input, Clock::time_point now);
+
+    std::vector<SInput> _inputs;
+    std::priority_queue<TPending, std::vector<TPending>, std::greater<TPending>> _pending;
+    std::chrono::milliseconds _window;
+    bool _unbounded;
+    unsigned int _nFinished;
+    bool _busy;
+    std::mutex _mutex;
+    std::condition_variable _cond;
+};
+
+#endif
@@ -0,0 +1,190 @@
+/*
+ *  Copyright (c) 2013 Croatia Control Ltd. (www.crocontrol.hr)
+ *
+ *  This file is part of Asterix.
+ *
+ *  Asterix is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Asterix is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Asterix.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <string.h>
+#include <chrono>
+
+#include "asterix.h"
+#include "rxringdevice.hxx"
+
+
+CRxRingDevice::CRxRingDevice(std::unique_ptr<CBaseDevice> device, unsigned int nSlots)
+        : _device(std::move(device)), _nSlots(2), _slotSize(0), _packetTime(0),
+          _head(0), _tail(0), _stop(false), _waiting(false), _highWatermark(0),
+          _nReceived(0), _nDropped(0) {
+    while (_nSlots < nSlots) {
+        _nSlots <<= 1;
+    }
+
+    _slotSize = _device->MaxPacketSize();
+    if (_slotSize == 0) {
+        LOGERROR(1, "Receive ring can be attached only to packet devices.\n");
+        return;
+    }
+
+    // Preallocate the whole ring, nothing is allocated while receiving
+    _data = std::make_unique<unsigned char[]>(static_cast<size_t>(_nSlots) * _slotSize);
+    _slot = std::make_unique<SSlot[]>(_nSlots);
+
+    _opened = _device->IsOpened();
+    if (_opened) {
+        _thread = std::thread(&CRxRingDevice::ReceiveThread, this);
+    }
+
+    LOGNOTIFY(gVerbose, "Receive ring with %u slots of %u bytes attached.\n", _nSlots, _slotSize);
+}
+
+
+CRxRingDevice::~CRxRingDevice() {
+    _stop.store(true);
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+
+    LOGNOTIFY(gVerbose, "Receive ring: %llu packets received, %llu dropped, high watermark %u of %u slots.\n",
+              static_cast<unsigned long long>(GetNReceived()), static_cast<unsigned long long>(GetNDropped()),
+              GetHighWatermark(), _nSlots);
+}
+
+
+void CRxRingDevice::ReceiveThread() {
+    // Packets which do not fit in the ring still have to be drained from the device
+    std::unique_ptr<unsigned char[]> scratch = std::make_unique<unsigned char[]>(_slotSize);
+
+    while (!_stop.load(std::memory_order_relaxed)) {
+        // Short timeout so that the thread notices the stop request
+        if (!_device->Select(1)) {
+            continue;
+        }
+
+        const uint64_t head = _head.load(std::memory_order_relaxed);
+        const uint64_t tail = _tail.load(std::memory_order_acquire);
+        const bool full = (head - tail) >= _nSlots;
+
+        unsigned char *buffer = full ? scratch.get() : &_data[(head & (_nSlots - 1)) * _slotSize];
+        size_t len = _slotSize;
+
+        if (!_device->Read(buffer, &len)) {
+            // errors are counted by the wrapped device, avoid spinning on a broken device
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            continue;
+        }
+        if (len == 0) {
+            continue;
+        }
+
+        _nReceived.fetch_add(1, std::memory_order_relaxed);
+        if (full) {
+            _nDropped.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        // Prefer the time the kernel received the packet
+        double timestamp = _device->GetPacketTime();
+        if (timestamp <= 0) {
+            timestamp = std::chrono::duration<double>(
+                    std::chrono::system_clock::now().time_since_epoch()).count();
+        }
+
+        SSlot &slot = _slot[head & (_nSlots - 1)];
+        slot.len = len;
+        slot.timestamp = timestamp;
+
+        // Publish the slot
+        _head.store(head + 1, std::memory_order_seq_cst);
+
+        const unsigned int occupancy = static_cast<unsigned int>(head + 1 - tail);
+        if (occupancy > _highWatermark.load(std::memory_order_relaxed)) {
+            _highWatermark.store(occupancy, std::memory_order_relaxed);
+        }
+
+        // Wake up the parsing thread only if it is sleeping
+        if (_waiting.load(std::memory_order_seq_cst)) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _cond.notify_one();
+        }
+    }
+}
+
+
+bool CRxRingDevice::WaitNotEmpty(const unsigned int secondsToWait) {
+    auto notEmpty = [this] {
+        return _head.load(std::memory_order_seq_cst) != _tail.load(std::memory_order_relaxed);
+    };
+
+    if (notEmpty()) {
+        return true;
+    }
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _waiting.store(true, std::memory_order_seq_cst);
+    bool result;
+    if (secondsToWait) {
+        result = _cond.wait_for(lock, std::chrono::seconds(secondsToWait), notEmpty);
+    } else {
+        _cond.wait(lock, notEmpty);
+        result = true;
+    }
+    _waiting.store(false, std::memory_order_relaxed);
+    return result;
+}
+
+
+bool CRxRingDevice::Select(const unsigned int secondsToWait) {
+    if (!_opened) {
+        LOGERROR(1, "Cannot select() due to not properly initialized interface.\n");
+        return false;
+    }
+    return WaitNotEmpty(secondsToWait);
+}
+
+
+bool CRxRingDevice::Read(void *data, size_t len) {
+    return Read(data, &len);
+}
+
+
+bool CRxRingDevice::Read(void *data, size_t *len) {
+    if (!_opened) {
+        LOGERROR(1, "Cannot read due to not properly initialized interface.\n");
+        CountReadError();
+        return false;
+    }
+
+    WaitNotEmpty(0);
+
+    const uint64_t tail = _tail.load(std::memory_order_relaxed);
+    const SSlot &slot = _slot[tail & (_nSlots - 1)];
+    const bool fits = slot.len <= *len;
+
+    if (!fits) {
+        LOGERROR(1, "Buffer too small for received packet (%zu < %zu).\n", *len, slot.len);
+        CountReadError();
+    } else {
+        memcpy(data, &_data[(tail & (_nSlots - 1)) * _slotSize], slot.len);
+        *len = slot.len;
+        _packetTime = slot.timestamp;
+        ResetReadErrors(true);
+    }
+
+    // Release the slot to the receive thread
+    _tail.store(tail + 1, std::memory_order_release);
+
+    return fits;
+}
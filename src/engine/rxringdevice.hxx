@@ -0,0 +1,124 @@
+/*
+ *  Copyright (c) 2013 Croatia Control Ltd. (www.crocontrol.hr)
+ *
+ *  This file is part of Asterix.
+ *
+ *  Asterix is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Asterix is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Asterix.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef RXRINGDEVICE_HXX__
+#define RXRINGDEVICE_HXX__
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "basedevice.hxx"
+
+/**
+ * @class CRxRingDevice
+ *
+ * @brief Packet device wrapper which decouples receiving from parsing.
+ *
+ * A dedicated receive thread reads packets from the wrapped device and
+ * copies them, together with their receive time, into a preallocated
+ * single-producer/single-consumer ring. The parsing thread drains the ring
+ * through the usual Select()/Read() interface, so a burst of packets (or a
+ * slow output) no longer overflows the kernel socket buffer.
+ *
+ * The ring itself is lock-free: the receive thread only advances the head,
+ * the parsing thread only advances the tail. The mutex/condition pair is
+ * touched only when the parsing thread has to sleep on an empty ring.
+ * When the ring is full the newest packet is dropped and counted.
+ *
+ * @see   <CDeviceFactory>::<AttachReceiveRing>
+ */
+class CRxRingDevice : public CBaseDevice {
+public:
+    /**
+     * Takes ownership of a packet device and starts the receive thread.
+     *
+     * @param device Opened packet device (e.g. UDP or TCP input)
+     * @param nSlots Number of ring slots, rounded up to a power of two
+     */
+    CRxRingDevice(std::unique_ptr<CBaseDevice> device, unsigned int nSlots);
+
+    ~CRxRingDevice() override;
+
+    bool Read(void *data, size_t len) override;
+
+    bool Read(void *data, size_t *len) override;
+
+    bool Write(const void *data, size_t len) override { return _device->Write(data, len); }
+
+    bool Select(const unsigned int secondsToWait) override;
+
+    bool IoCtrl(const unsigned int command, const void *data = 0, size_t len = 0) override {
+        return _device->IoCtrl(command, data, len);
+    }
+
+    bool IsPacketDevice() override { return true; }
+
+    unsigned int MaxPacketSize() override { return _slotSize; }
+
+    double GetPacketTime() override { return _packetTime; }
+
+    // Ring statistics
+    unsigned int GetNSlots() const { return _nSlots; }
+
+    unsigned int GetOccupancy() const {
+        return static_cast<unsigned int>(_head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire));
+    }
+
+    unsigned int GetHighWatermark() const { return _highWatermark.load(std::memory_order_relaxed); }
+
+    uint64_t GetNReceived() const { return _nReceived.load(std::memory_order_relaxed); }
+
+    uint64_t GetNDropped() const { return _nDropped.load(std::memory_order_relaxed); }
+
+private:
+    struct SSlot {
+        size_t len;
+        double timestamp;
+    };
+
+    void ReceiveThread();
+
+    bool WaitNotEmpty(const unsigned int secondsToWait);
+
+    std::unique_ptr<CBaseDevice> _device;
+    unsigned int _nSlots;
+    unsigned int _slotSize;
+    std::unique_ptr<unsigned char[]> _data;
+    std::unique_ptr<SSlot[]> _slot;
+    double _packetTime;
+
+    // producer and consumer indexes on separate cache lines
+    alignas(64) std::atomic<uint64_t> _head;
+    alignas(64) std::atomic<uint64_t> _tail;
+
+    alignas(64) std::atomic<bool> _stop;
+    std::atomic<bool> _waiting;
+    std::atomic<unsigned int> _highWatermark;
+    std::atomic<uint64_t> _nReceived;
+    std::atomic<uint64_t> _nDropped;
+    std::mutex _mutex;
+    std::condition_variable _cond;
+    std::thread _thread;
+};
+
+#endif
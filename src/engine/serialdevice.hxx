@@ -73,6 +73,8 @@ public:
 
     bool IsPacketDevice() override { return false; }
 
+    bool IsStreamDevice() override { return true; }
+
     unsigned int BytesLeftToRead() override { return 0; } // return number of bytes left to read or 0 if unknown
 
 private:
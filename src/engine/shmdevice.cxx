@@ -0,0 +1,339 @@
+/*
+ *  Copyright (c) 2013 Croatia Control Ltd. (www.crocontrol.hr)
+ *
+ *  This file is part of Asterix.
+ *
+ *  Asterix is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Asterix is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Asterix.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+// Shared memory device uses POSIX shm_open/mmap - not supported on Windows
+#ifndef _WIN32
+
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>
+#include <stdlib.h> //atoi
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <chrono>
+#include <thread>
+
+#include "asterix.h"
+#include "shmdevice.hxx"
+
+namespace {
+    constexpr uint32_t SHM_MAGIC = 0x41535452; // "ASTR"
+    constexpr uint32_t SHM_VERSION = 1;
+
+    double Now() {
+        return std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+}
+
+
+CShmDevice::CShmDevice(CDescriptor &descriptor)
+        : _writer(false), _nSlots(0), _slotSize(0), _slotStride(0), _mapSize(0), _map(nullptr), _header(nullptr),
+          _cursor(0), _nLost(0), _packetTime(0) {
+    const char *name = descriptor.GetFirst();
+    const char *mode = descriptor.GetNext();
+    const char *slots = descriptor.GetNext();
+    const char *slotSize = descriptor.GetNext();
+
+    if (name == nullptr || *name == '\0') {
+        LOGERROR(1, "Shared memory name not specified.\n");
+        return;
+    }
+    _name = (name[0] == '/') ? name : std::string("/") + name;
+
+    if (mode == nullptr || (toupper(mode[0]) != 'W' && toupper(mode[0]) != 'R')) {
+        LOGERROR(1, "Shared memory mode not specified (W or R).\n");
+        return;
+    }
+    _writer = (toupper(mode[0]) == 'W');
+
+    if (_writer) {
+        unsigned int nSlots = (slots != nullptr && atoi(slots) > 0) ? atoi(slots) : SHM_DEFAULT_SLOTS;
+        _slotSize = (slotSize != nullptr && atoi(slotSize) > 0) ? atoi(slotSize) : SHM_DEFAULT_SLOT_SIZE;
+        for (_nSlots = 2; _nSlots < nSlots; _nSlots <<= 1);
+
+        LOGINFO(gVerbose, "Shared memory writer %s with %u slots of %u bytes\n", _name.c_str(), _nSlots, _slotSize);
+        _opened = InitWriter();
+    } else {
+        // Reader attaches when the writer has created the segment (see Select())
+        LOGINFO(gVerbose, "Shared memory reader %s\n", _name.c_str());
+        Attach();
+        _opened = true;
+    }
+}
+
+
+CShmDevice::~CShmDevice() {
+    if (_map != nullptr) {
+        munmap(_map, _mapSize);
+    }
+    if (_nLost > 0) {
+        LOGWARNING(gVerbose, "Shared memory reader %s lost %llu packets.\n", _name.c_str(),
+                   static_cast<unsigned long long>(_nLost));
+    }
+}
+
+
+bool CShmDevice::Map(int fd, size_t size, int prot) {
+    _map = mmap(nullptr, size, prot, MAP_SHARED, fd, 0);
+    if (_map == MAP_FAILED) {
+        _map = nullptr;
+        LOGERROR(1, "Cannot map shared memory %s: %s\n", _name.c_str(), strerror(errno));
+        return false;
+    }
+    _mapSize = size;
+    _header = static_cast<SHeader *>(_map);
+    return true;
+}
+
+
+bool CShmDevice::InitWriter() {
+    _slotStride = (sizeof(SSlot) + _slotSize + 63) & ~static_cast<size_t>(63);
+    const size_t size = sizeof(SHeader) + _nSlots * _slotStride;
+
+    int fd = shm_open(_name.c_str(), O_RDWR | O_CREAT, 0666);
+    if (fd < 0) {
+        LOGERROR(1, "Cannot open shared memory %s: %s\n", _name.c_str(), strerror(errno));
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) < 0) {
+        LOGERROR(1, "Cannot stat shared memory %s: %s\n", _name.c_str(), strerror(errno));
+        close(fd);
+        return false;
+    }
+
+    const bool existing = static_cast<size_t>(st.st_size) == size;
+    if (!existing) {
+        if (st.st_size != 0) {
+            // Shrinking the segment would crash readers which still map it
+            LOGERROR(1, "Shared memory %s exists with a different size. Remove it first.\n", _name.c_str());
+            close(fd);
+            return false;
+        }
+        if (ftruncate(fd, size) < 0) {
+            LOGERROR(1, "Cannot resize shared memory %s: %s\n", _name.c_str(), strerror(errno));
+            close(fd);
+            return false;
+        }
+    }
+
+    bool ok = Map(fd, size, PROT_READ | PROT_WRITE);
+    close(fd);
+    if (!ok) {
+        return false;
+    }
+
+    if (existing && _header->magic == SHM_MAGIC) {
+        if (_header->version != SHM_VERSION || _header->nSlots != _nSlots || _header->slotSize != _slotSize) {
+            LOGERROR(1, "Shared memory %s exists with a different layout. Remove it first.\n", _name.c_str());
+            return false;
+        }
+        // Previous writer restarted, continue its sequence
+        LOGINFO(gVerbose, "Continuing shared memory %s at sequence %llu\n", _name.c_str(),
+                static_cast<unsigned long long>(_header->writeSeq.load()));
+        return true;
+    }
+
+    // Fresh segment (zero filled by ftruncate); magic is set last so that readers see a complete header
+    _header->version = SHM_VERSION;
+    _header->nSlots = _nSlots;
+    _header->slotSize = _slotSize;
+    _header->writeSeq.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    _header->magic = SHM_MAGIC;
+
+    return true;
+}
+
+
+bool CShmDevice::Attach() {
+    if (_header != nullptr) {
+        return true;
+    }
+
+    int fd = shm_open(_name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        return false; // writer not started yet
+    }
+
+    struct stat st;
+    bool ok = false;
+    if (fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= sizeof(SHeader)) {
+        ok = Map(fd, st.st_size, PROT_READ);
+    }
+    close(fd);
+    if (!ok) {
+        return false;
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (_header->magic != SHM_MAGIC || _header->version != SHM_VERSION || _header->nSlots == 0 ||
+        sizeof(SHeader) + _header->nSlots * ((sizeof(SSlot) + _header->slotSize + 63) & ~static_cast<size_t>(63)) > _mapSize) {
+        // not initialized yet, try again later
+        munmap(_map, _mapSize);
+        _map = nullptr;
+        _header = nullptr;
+        return false;
+    }
+
+    _nSlots = _header->nSlots;
+    _slotSize = _header->slotSize;
+    _slotStride = (sizeof(SSlot) + _slotSize + 63) & ~static_cast<size_t>(63);
+
+    // Start with the packets written from now on
+    _cursor = _header->writeSeq.load(std::memory_order_acquire);
+
+    LOGINFO(gVerbose, "Attached to shared memory %s (%u slots of %u bytes) at sequence %llu\n", _name.c_str(),
+            _nSlots, _slotSize, static_cast<unsigned long long>(_cursor));
+    return true;
+}
+
+
+bool CShmDevice::Read(void *data, size_t len) {
+    return Read(data, &len);
+}
+
+
+bool CShmDevice::Read(void *data, size_t *len) {
+    if (!_opened || _writer) {
+        LOGERROR(1, "Cannot read due to not properly initialized interface.\n");
+        CountReadError();
+        return false;
+    }
+
+    for (;;) {
+        // Wait for data
+        if (!IsReadable()) {
+            Select(0);
+            continue;
+        }
+
+        const uint64_t writeSeq = _header->writeSeq.load(std::memory_order_acquire);
+
+        // Overtaken by the writer: skip to the oldest packet still in the ring
+        if (writeSeq - _cursor > _nSlots) {
+            _nLost += writeSeq - _nSlots - _cursor;
+            _cursor = writeSeq - _nSlots;
+        }
+
+        SSlot *slot = GetSlot(_cursor);
+        const uint64_t seq = slot->seq.load(std::memory_order_acquire);
+        if (seq != 2 * _cursor + 2) {
+            // slot already reused for a newer packet
+            _nLost++;
+            _cursor++;
+            continue;
+        }
+
+        const size_t packetLen = slot->len;
+        if (packetLen > *len || packetLen > _slotSize) {
+            LOGERROR(1, "Buffer too small for shared memory packet (%zu < %zu).\n", *len, packetLen);
+            CountReadError();
+            _cursor++;
+            return false;
+        }
+
+        memcpy(data, reinterpret_cast<unsigned char *>(slot) + sizeof(SSlot), packetLen);
+        const double timestamp = slot->timestamp;
+
+        // Check the writer did not touch the slot while copying
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot->seq.load(std::memory_order_relaxed) != seq) {
+            _nLost++;
+            _cursor++;
+            continue;
+        }
+
+        _cursor++;
+        *len = packetLen;
+        _packetTime = timestamp;
+        ResetReadErrors(true);
+        return true;
+    }
+}
+
+
+bool CShmDevice::Write(const void *data, size_t len) {
+    if (!_opened || !_writer) {
+        LOGERROR(1, "Cannot write due to not properly initialized interface.\n");
+        CountWriteError();
+        return false;
+    }
+
+    if (len > _slotSize) {
+        LOGERROR(1, "Packet too big for shared memory slot (%zu > %u).\n", len, _slotSize);
+        CountWriteError();
+        return false;
+    }
+
+    const uint64_t n = _header->writeSeq.load(std::memory_order_relaxed);
+    SSlot *slot = GetSlot(n);
+
+    // Mark slot as being written
+    slot->seq.store(2 * n + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    memcpy(reinterpret_cast<unsigned char *>(slot) + sizeof(SSlot), data, len);
+    slot->len = static_cast<uint32_t>(len);
+    slot->timestamp = Now();
+
+    // Publish the packet
+    slot->seq.store(2 * n + 2, std::memory_order_release);
+    _header->writeSeq.store(n + 1, std::memory_order_release);
+
+    ResetWriteErrors(true);
+    return true;
+}
+
+
+bool CShmDevice::Select(const unsigned int secondsToWait) {
+    if (!_opened) {
+        LOGERROR(1, "Cannot select() due to not properly initialized interface.\n");
+        return false;
+    }
+
+    if (_writer) {
+        return true;
+    }
+
+    // Readers poll the ring, there is no kernel object to wait on.
+    // Spin briefly to keep latency low, then back off.
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(secondsToWait);
+    for (unsigned int i = 0;; i++) {
+        if (!Attach()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        } else if (IsReadable()) {
+            return true;
+        } else if (i < 1000) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+
+        if (secondsToWait && std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+    }
+}
+
+#endif
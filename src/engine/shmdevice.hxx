@@ -0,0 +1,141 @@
+/*
+ *  Copyright (c) 2013 Croatia Control Ltd. (www.crocontrol.hr)
+ *
+ *  This file is part of Asterix.
+ *
+ *  Asterix is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Asterix is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Asterix.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef SHMDEVICE_HXX__
+#define SHMDEVICE_HXX__
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "basedevice.hxx"
+#include "descriptor.hxx"
+
+#define SHM_DEFAULT_SLOTS       256
+#define SHM_DEFAULT_SLOT_SIZE   65536
+
+/**
+ * @class CShmDevice
+ *
+ * @brief POSIX shared memory ring device for consumers on the same host.
+ *
+ * One writer process publishes packets into a ring of fixed size slots
+ * in a shared memory segment (shm_open + mmap). Every packet gets a
+ * sequence number; any number of reader processes follow the ring, each
+ * with its own private cursor, so the writer never waits for readers and
+ * no data passes through the kernel.
+ *
+ * Every slot is protected with a sequence lock: the slot sequence is odd
+ * while the writer copies the packet and even when it is complete. A slow
+ * reader which is overtaken by the writer detects it, skips the lost
+ * packets and counts them.
+ *
+ * Descriptor format: name:mode[:slots[:slotsize]]
+ *  - name     shared memory object name (e.g. asterix or /asterix)
+ *  - mode     W (writer, output) or R (reader, input)
+ *  - slots    number of slots, rounded up to power of two (writer only)
+ *  - slotsize maximal packet size in bytes (writer only)
+ *
+ * The segment is not removed when the writer exits, so readers survive a
+ * writer restart. A restarted writer continues the sequence numbering.
+ *
+ * @see   <CDeviceFactory>
+ *        <CBaseDevice>
+ *        <CDescriptor>
+ */
+class CShmDevice : public CBaseDevice {
+private:
+    struct SHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t nSlots;
+        uint32_t slotSize;
+        alignas(64) std::atomic<uint64_t> writeSeq; // sequence of next packet to be written
+    };
+
+    struct SSlot {
+        std::atomic<uint64_t> seq; // 2*n+1 while packet n is written, 2*n+2 when complete
+        uint32_t len;
+        uint32_t reserved;
+        double timestamp;
+    };
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared memory ring requires lock-free 64-bit atomics");
+
+    std::string _name;
+    bool _writer;
+    unsigned int _nSlots;
+    unsigned int _slotSize;
+    size_t _slotStride;
+    size_t _mapSize;
+    void *_map;
+    SHeader *_header;
+    uint64_t _cursor; // reader position
+    uint64_t _nLost;
+    double _packetTime;
+
+public:
+
+    /**
+     * Class constructor which uses descriptor
+     */
+    explicit CShmDevice(CDescriptor &descriptor);
+
+    /**
+     * Class destructor.
+     */
+    ~CShmDevice() override;
+
+    bool Read(void *data, size_t len) override;
+
+    bool Read(void *data, size_t *len) override;
+
+    bool Write(const void *data, size_t len) override;
+
+    bool Select(const unsigned int secondsToWait) override;
+
+    bool IoCtrl([[maybe_unused]] const unsigned int command, [[maybe_unused]] const void *data = 0, [[maybe_unused]] size_t len = 0) override { return false; }
+
+    bool IsPacketDevice() override { return true; }
+
+    unsigned int MaxPacketSize() override { return _slotSize; }
+
+    double GetPacketTime() override { return _packetTime; }
+
+    // Number of packets the reader missed because it was overtaken by the writer
+    uint64_t GetNLost() const { return _nLost; }
+
+private:
+    bool InitWriter();
+
+    bool Attach();
+
+    bool Map(int fd, size_t size, int prot);
+
+    SSlot *GetSlot(uint64_t seq) {
+        return reinterpret_cast<SSlot *>(static_cast<unsigned char *>(_map) + sizeof(SHeader) +
+                                         (seq & (_nSlots - 1)) * _slotStride);
+    }
+
+    bool IsReadable() {
+        return _header != nullptr && _header->writeSeq.load(std::memory_order_acquire) > _cursor;
+    }
+};
+
+#endif
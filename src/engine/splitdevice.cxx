@@ -0,0 +1,180 @@
+/*
+ *  Copyright (c) 2013 Croatia Control Ltd. (www.crocontrol.hr)
+ *
+ *  This file is part of Asterix.
+ *
+ *  Asterix is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Asterix is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Asterix.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "asterix.h"
+#include "splitdevice.hxx"
+
+
+CSplitDevice::CSplitDevice(CDescriptor &descriptor)
+        : _maxOpen(DEFAULT_MAX_OPEN), _selected(nullptr), _nOpen(0), _nReopened(0), _useCounter(0) {
+    const char *nameTemplate = descriptor.GetFirst();
+    const char *maxOpen = descriptor.GetNext();
+
+    if (nameTemplate == nullptr || strlen(nameTemplate) == 0) {
+        LOGERROR(1, "File name template not specified\n");
+        return;
+    }
+    _template = nameTemplate;
+
+    if (_template.find("{cat}") == std::string::npos && _template.find("{sac}") == std::string::npos &&
+        _template.find("{sic}") == std::string::npos) {
+        LOGERROR(1, "File name template '%s' shall contain {cat}, {sac} or {sic}\n", nameTemplate);
+        return;
+    }
+
+    if (maxOpen != nullptr && atoi(maxOpen) > 0) {
+        _maxOpen = static_cast<unsigned int>(atoi(maxOpen));
+    }
+
+    _opened = true;
+}
+
+
+CSplitDevice::~CSplitDevice() {
+    CloseAll();
+    if (!_files.empty()) {
+        LOGNOTIFY(gVerbose, "Split output: %u files written, %u reopened\n", GetNFiles(), _nReopened);
+    }
+}
+
+
+std::string CSplitDevice::GetFileName(const SSplitKey &key) const {
+    std::string name;
+    name.reserve(_template.size() + 8);
+
+    size_t pos = 0;
+    while (pos < _template.size()) {
+        char value[16];
+        if (_template.compare(pos, 5, "{cat}") == 0) {
+            snprintf(value, sizeof(value), key.cat >= 0 ? "%03d" : "x", key.cat);
+        } else if (_template.compare(pos, 5, "{sac}") == 0) {
+            snprintf(value, sizeof(value), key.sac >= 0 ? "%d" : "x", key.sac);
+        } else if (_template.compare(pos, 5, "{sic}") == 0) {
+            snprintf(value, sizeof(value), key.sic >= 0 ? "%d" : "x", key.sic);
+        } else {
+            name += _template[pos++];
+            continue;
+        }
+        name += value;
+        pos += 5;
+    }
+    return name;
+}
+
+
+bool CSplitDevice::Open(const std::string &name, SFile &file) {
+    // Keep number of open files limited, close the least recently written one
+    if (_nOpen >= _maxOpen) {
+        SFile *oldest = nullptr;
+        for (auto &it : _files) {
+            if (it.second.stream != nullptr && (oldest == nullptr || it.second.lastUse < oldest->lastUse)) {
+                oldest = &it.second;
+            }
+        }
+        if (oldest != nullptr) {
+            Close(*oldest);
+        }
+    }
+
+    file.stream = fopen(name.c_str(), file.written ? "ab" : "wb");
+    if (file.stream == nullptr) {
+        LOGERROR(1, "Cannot open file '%s'\n", name.c_str());
+        return false;
+    }
+    file.buffer.resize(FILE_BUFFER_SIZE);
+    setvbuf(file.stream, file.buffer.data(), _IOFBF, file.buffer.size());
+
+    if (file.written) {
+        _nReopened++;
+    }
+    _nOpen++;
+    LOGDEBUG(1, "Opened split output file '%s'\n", name.c_str());
+    return true;
+}
+
+
+void CSplitDevice::Close(SFile &file) {
+    if (file.stream != nullptr) {
+        fclose(file.stream);
+        file.stream = nullptr;
+        std::vector<char>().swap(file.buffer);
+        _nOpen--;
+    }
+}
+
+
+void CSplitDevice::CloseAll() {
+    for (auto &it : _files) {
+        Close(it.second);
+    }
+}
+
+
+bool CSplitDevice::Write(const void *data, size_t len) {
+    if (!_opened || _selected == nullptr) {
+        LOGERROR(1, "Cannot write, no split output selected.\n");
+        CountWriteError();
+        return false;
+    }
+
+    if (_selected->stream == nullptr) {
+        auto it = _files.begin();
+        while (&it->second != _selected) {
+            ++it;
+        }
+        if (!Open(it->first, *_selected)) {
+            CountWriteError();
+            return false;
+        }
+    }
+
+    if (fwrite(data, 1, len, _selected->stream) != len) {
+        LOGERROR(1, "Error writing to split output file.\n");
+        CountWriteError();
+        return false;
+    }
+
+    _selected->written = true;
+    _selected->lastUse = ++_useCounter;
+    _selected->bytes += len;
+    ResetWriteErrors(true);
+    return true;
+}
+
+
+bool CSplitDevice::IoCtrl(const unsigned int command, const void *data, size_t len) {
+    switch (command) {
+        case ESelectOutput:
+            if (!_opened || data == nullptr || len != sizeof(SSplitKey)) {
+                return false;
+            }
+            _selected = &_files.try_emplace(GetFileName(*static_cast<const SSplitKey *>(data)),
+                                            SFile{nullptr, {}, false, 0, 0}).first->second;
+            return true;
+        case EAllDone:
+            CloseAll();
+            return true;
+        default:
+            break;
+    }
+    return false;
+}
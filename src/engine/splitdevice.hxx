@@ -0,0 +1,120 @@
+/*
+ *  Copyright (c) 2013 Croatia Control Ltd. (www.crocontrol.hr)
+ *
+ *  This file is part of Asterix.
+ *
+ *  Asterix is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Asterix is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Asterix.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef SPLITDEVICE_HXX__
+#define SPLITDEVICE_HXX__
+
+#include <stdio.h>
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "basedevice.hxx"
+#include "descriptor.hxx"
+
+/**
+ * @class CSplitDevice
+ *
+ * @brief Output device writing each category and/or sensor to its own file.
+ *
+ * Before each Write() the format selects the output with IoCtrl(ESelectOutput)
+ * and an SSplitKey. The file name is made from a template in which {cat} is
+ * replaced with the category (3 digits) and {sac}, {sic} with the sensor
+ * identification ('x' if not known), e.g. out_cat{cat}_{sac}_{sic}.pcap.
+ * Keys giving the same name (e.g. all sensors of a category if the template
+ * has only {cat}) are written to the same file.
+ *
+ * Files are written through large stdio buffers. At most maxOpen files are
+ * kept open; when more are needed the least recently written one is closed
+ * and later reopened in append mode. Files are created (overwritten) on the
+ * first write of the run. IsOnStart() is true while nothing was written to
+ * the selected file, so file headers are written once per file.
+ *
+ * Descriptor format: template[|maxOpen]
+ *
+ * @see   <CDeviceFactory>
+ *        <CBaseDevice>
+ *        <CDescriptor>
+ */
+class CSplitDevice : public CBaseDevice {
+public:
+    static const unsigned int DEFAULT_MAX_OPEN = 64;
+    static const size_t FILE_BUFFER_SIZE = 64 * 1024;
+
+private:
+    struct SFile {
+        FILE *stream;
+        std::vector<char> buffer; // stdio buffer, must outlive stream
+        bool written;             // created in this run
+        uint64_t lastUse;
+        uint64_t bytes;
+    };
+
+    std::string _template;
+    unsigned int _maxOpen;
+    std::map<std::string, SFile> _files;
+    SFile *_selected;
+    unsigned int _nOpen;
+    unsigned int _nReopened;
+    uint64_t _useCounter;
+
+    bool Open(const std::string &name, SFile &file);
+
+    void Close(SFile &file);
+
+    void CloseAll();
+
+public:
+    /**
+     * Class constructor which uses the output device descriptor.
+     */
+    explicit CSplitDevice(CDescriptor &descriptor);
+
+    /**
+     * Class destructor, flushes and closes all files.
+     */
+    ~CSplitDevice() override;
+
+    bool Read([[maybe_unused]] void *data, [[maybe_unused]] size_t len) override { return false; }
+
+    bool Write(const void *data, size_t len) override;
+
+    bool Select([[maybe_unused]] const unsigned int secondsToWait) override { return false; }
+
+    bool IoCtrl(const unsigned int command, const void *data = 0, size_t len = 0) override;
+
+    bool IsPacketDevice() override { return false; }
+
+    bool IsOnStart() override { return _selected == nullptr || !_selected->written; }
+
+    /**
+     * File name of given key made from the template.
+     */
+    std::string GetFileName(const SSplitKey &key) const;
+
+    unsigned int GetNFiles() const { return static_cast<unsigned int>(_files.size()); }
+
+    unsigned int GetNOpen() const { return _nOpen; }
+
+    unsigned int GetNReopened() const { return _nReopened; }
+};
+
+#endif
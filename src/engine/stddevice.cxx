@@ -97,6 +97,7 @@ bool CStdDevice::Write(const void *data, size_t len) {
         bytesLeft -= bytesWrote;
         pData += bytesWrote;
     }
+    _onstart = false;
 
     ResetWriteErrors(true);
     return true;
@@ -275,6 +275,58 @@ bool CTcpDevice::Read(void *data, size_t len) {
 }
 
 
+/* Read available data but not more than value in *len (blocks until some data arrives).
+ * Return number of bytes read in *len
+ */
+bool CTcpDevice::Read(void *data, size_t *len) {
+    const size_t maxLen = *len;
+    *len = 0;
+
+    // Check if interface was set-up correctly (server)
+    if (!_opened) {
+        LOGERROR(1, "Cannot read due to not properly initialized interface.\n");
+        CountReadError();
+        return false;
+    }
+
+    // Connect or accept connection if necessary
+    if (!Connect()) {
+        LOGERROR(1, "Cannot read, could not establish connection.\n");
+        CountReadError();
+        return false;
+    }
+
+    // Chose appropriate socket for reading
+    int socketToRecv = _server ? _socketDescSession : _socketDesc;
+    ASSERT(socketToRecv >= 0);
+
+    int bytesReceived = recv(socketToRecv, static_cast<char *>(data), maxLen, MSG_NOSIGNAL);
+
+    if (bytesReceived < 0) {
+        LOGERROR(1, "Error %d reading from socket %d. %s\n",
+                 errno,
+                 socketToRecv,
+                 strerror(errno));
+
+        Disconnect(false); // error, do not linger
+        CountReadError();
+        return false;
+    } else if (bytesReceived == 0) {
+        LOGNOTIFY(gVerbose, "Connection closed by remote host\n");
+        Disconnect(false); // error, do not linger
+        return false;
+    }
+
+    LOGDEBUG(ZONE_TCPDEVICE, "Read %d bytes from socket %d.\n",
+             bytesReceived,
+             socketToRecv);
+
+    *len = bytesReceived;
+    ResetReadErrors(true);
+    return true;
+}
+
+
 bool CTcpDevice::Write(const void *data, size_t len) {
     // Check if interface was set-up correctly (client)
     if (!_opened) {
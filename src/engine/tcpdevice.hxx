@@ -101,6 +101,8 @@ public:
 
     bool Read(void *data, size_t len) override;
 
+    bool Read(void *data, size_t *len) override;
+
     bool Write(const void *data, size_t len) override;
 
     bool Select(const unsigned int secondsToWait) override;
@@ -109,6 +111,8 @@ public:
 
     bool IsPacketDevice() override { return true; }
 
+    bool IsStreamDevice() override { return true; }
+
     unsigned int
     MaxPacketSize() override { return MAX_TCP_PACKET_SIZE; } // return maximal packet size (only for packet devices
     unsigned int BytesLeftToRead() override { return 0; } // return number of bytes left to read or 0 if unknown
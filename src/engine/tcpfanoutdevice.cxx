@@ -0,0 +1,421 @@
+/*
+ *  Copyright (c) 2013 Croatia Control Ltd. (www.crocontrol.hr)
+ *
+ *  This file is part of Asterix.
+ *
+ *  Asterix is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Asterix is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Asterix.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+// Fan-out server uses poll() and sendmsg() - POSIX only
+#ifndef _WIN32
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+
+// Standard includes
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <errno.h>
+
+// Local includes
+#include "asterix.h"
+#include "tcpfanoutdevice.hxx"
+
+/*
+ * Older macOS has no MSG_NOSIGNAL, client sockets are set SO_NOSIGPIPE there
+ */
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+namespace {
+    // Maximal number of packets sent with one sendmsg()
+    constexpr int MAX_IOV = 64;
+
+    bool SetNonBlocking(int fd) {
+        int flags = fcntl(fd, F_GETFL, 0);
+        return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+    }
+}
+
+
+CTcpFanoutDevice::CTcpFanoutDevice(CDescriptor &descriptor)
+        : _socketDesc(-1), _port(0), _maxQueue(DEFAULT_QUEUE_KB * 1024), _downSample(false), _stop(false) {
+    const char *serverAddress = descriptor.GetFirst();
+    const char *serverPort = descriptor.GetNext();
+    const char *queueKB = descriptor.GetNext();
+    const char *policy = descriptor.GetNext();
+
+    _wakeup[0] = _wakeup[1] = -1;
+
+    if ((serverPort == nullptr) || (serverPort[0] == '\0')) {
+        LOGERROR(1, "Server port not specified\n");
+        return;
+    }
+
+    if ((queueKB != nullptr) && (atoi(queueKB) > 0)) {
+        _maxQueue = static_cast<size_t>(atoi(queueKB)) * 1024;
+    }
+    _downSample = (policy != nullptr) && (toupper(policy[0]) == 'S');
+
+    LOGINFO(gVerbose, "Fan-out server on %s:%s, client queue %zu KB, slow clients are %s\n",
+            (serverAddress && serverAddress[0]) ? serverAddress : "INADDR_ANY", serverPort, _maxQueue / 1024,
+            _downSample ? "down-sampled" : "disconnected");
+
+    if (!InitServer(serverAddress, atoi(serverPort))) {
+        return;
+    }
+
+    if (pipe(_wakeup) < 0) {
+        LOGERROR(1, "Cannot create wake-up pipe. %s\n", strerror(errno));
+        return;
+    }
+    SetNonBlocking(_wakeup[0]);
+    SetNonBlocking(_wakeup[1]);
+
+    _opened = true;
+    _thread = std::thread(&CTcpFanoutDevice::IoThread, this);
+}
+
+
+CTcpFanoutDevice::~CTcpFanoutDevice() {
+    _stop.store(true);
+    Wakeup();
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+
+    for (auto &client : _clients) {
+        CloseClient(client, "server closed");
+    }
+
+    if (_socketDesc >= 0) {
+        close(_socketDesc);
+    }
+    for (int fd : _wakeup) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+}
+
+
+bool CTcpFanoutDevice::InitServer(const char *serverAddress, const int serverPort) {
+    struct sockaddr_in serverAddr;
+    memset(&serverAddr, 0, sizeof(serverAddr));
+    serverAddr.sin_family = AF_INET;
+    serverAddr.sin_port = htons(serverPort);
+
+    if ((serverAddress == nullptr) || (serverAddress[0] == '\0')) {
+        serverAddr.sin_addr.s_addr = htonl(INADDR_ANY);
+    } else {
+        struct addrinfo hints = {};
+        struct addrinfo *result = nullptr;
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_STREAM;
+        if (getaddrinfo(serverAddress, nullptr, &hints, &result) != 0 || result == nullptr) {
+            LOGERROR(1, "Unknown server address '%s'\n", serverAddress);
+            return false;
+        }
+        serverAddr.sin_addr = reinterpret_cast<const struct sockaddr_in *>(result->ai_addr)->sin_addr;
+        freeaddrinfo(result);
+    }
+
+    _socketDesc = socket(AF_INET, SOCK_STREAM, 0);
+    if (_socketDesc < 0) {
+        LOGERROR(1, "Cannot open socket\n");
+        return false;
+    }
+
+    int opt = 1;
+    if (setsockopt(_socketDesc, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt)) != 0) {
+        LOGWARNING(1, "Error %d on setsockopt(). %s\n", errno, strerror(errno));
+    }
+
+    if (bind(_socketDesc, reinterpret_cast<struct sockaddr *>(&serverAddr), sizeof(serverAddr)) < 0) {
+        LOGERROR(1, "Cannot bind port number %d\n", serverPort);
+        return false;
+    }
+
+    if (listen(_socketDesc, MAX_BACKLOG) < 0 || !SetNonBlocking(_socketDesc)) {
+        LOGERROR(1, "Cannot listen on port number %d. %s\n", serverPort, strerror(errno));
+        return false;
+    }
+
+    socklen_t addrLen = sizeof(serverAddr);
+    if (getsockname(_socketDesc, reinterpret_cast<struct sockaddr *>(&serverAddr), &addrLen) == 0) {
+        _port = ntohs(serverAddr.sin_port);
+    }
+
+    return true;
+}
+
+
+void CTcpFanoutDevice::Wakeup() {
+    if (_wakeup[1] >= 0) {
+        const char c = 0;
+        // pipe full means the thread is already going to wake up
+        [[maybe_unused]] ssize_t n = write(_wakeup[1], &c, 1);
+    }
+}
+
+
+bool CTcpFanoutDevice::Write(const void *data, size_t len) {
+    if (!_opened) {
+        LOGERROR(1, "Cannot write due to not properly initialized interface.\n");
+        CountWriteError();
+        return false;
+    }
+
+    // One copy of the packet shared by all client queues
+    TPacket packet;
+    bool wakeup = false;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        for (auto &client : _clients) {
+            if (client.closing) {
+                continue;
+            }
+
+            if (client.skipping && client.queued <= _maxQueue / 2) {
+                LOGINFO(gVerbose, "Client %s caught up, %llu packets skipped\n", client.peer.c_str(),
+                        static_cast<unsigned long long>(client.nSkipped));
+                client.skipping = false;
+            }
+
+            if (client.skipping || client.queued + len > _maxQueue) {
+                if (_downSample) {
+                    client.skipping = true;
+                    client.nSkipped++;
+                } else {
+                    client.closing = true; // closed by the I/O thread
+                    client.slow = true;
+                    wakeup = true;
+                }
+                continue;
+            }
+
+            if (!packet) {
+                packet = std::make_shared<const std::vector<unsigned char>>(
+                        static_cast<const unsigned char *>(data), static_cast<const unsigned char *>(data) + len);
+            }
+            client.queue.push_back(packet);
+            client.queued += len;
+            wakeup = true;
+        }
+    }
+
+    if (wakeup) {
+        Wakeup();
+    }
+
+    // Nobody listening is not an error for a fan-out server
+    ResetWriteErrors(true);
+    return true;
+}
+
+
+void CTcpFanoutDevice::AcceptPending() {
+    for (;;) {
+        struct sockaddr_in clientAddr;
+        socklen_t clientAddrLen = sizeof(clientAddr);
+        int fd = accept(_socketDesc, reinterpret_cast<struct sockaddr *>(&clientAddr), &clientAddrLen);
+        if (fd < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                LOGERROR(1, "Error %d accepting connection. %s\n", errno, strerror(errno));
+            }
+            return;
+        }
+
+        char peer[INET_ADDRSTRLEN + 8];
+        char address[INET_ADDRSTRLEN];
+        inet_ntop(AF_INET, &clientAddr.sin_addr, address, sizeof(address));
+        snprintf(peer, sizeof(peer), "%s:%d", address, ntohs(clientAddr.sin_port));
+
+        if (_clients.size() >= MAX_CLIENTS) {
+            LOGWARNING(1, "Refused connection from %s, maximum number of clients reached\n", peer);
+            close(fd);
+            continue;
+        }
+
+        int opt = 1;
+        SetNonBlocking(fd);
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &opt, sizeof(opt));
+#ifdef SO_NOSIGPIPE
+        setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &opt, sizeof(opt));
+#endif
+
+        SClient client = {fd, peer, {}, 0, 0, false, false, false, 0, 0};
+        _clients.push_back(std::move(client));
+        LOGNOTIFY(gVerbose, "Accepted connection from %s on socket %d (%zu clients)\n", peer, fd, _clients.size());
+    }
+}
+
+
+bool CTcpFanoutDevice::Flush(SClient &client) {
+    while (!client.queue.empty()) {
+        struct iovec iov[MAX_IOV];
+        int nIov = 0;
+        size_t offset = client.offset;
+
+        for (auto it = client.queue.begin(); it != client.queue.end() && nIov < MAX_IOV; ++it) {
+            iov[nIov].iov_base = const_cast<unsigned char *>((*it)->data()) + offset;
+            iov[nIov].iov_len = (*it)->size() - offset;
+            offset = 0;
+            nIov++;
+        }
+
+        // MSG_NOSIGNAL: a client which just disconnected must not raise SIGPIPE
+        struct msghdr msg = {};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = nIov;
+        ssize_t sent = sendmsg(client.fd, &msg, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+                return true; // socket buffer full, wait for POLLOUT
+            }
+            LOGERROR(1, "Error %d writing to client %s. %s\n", errno, client.peer.c_str(), strerror(errno));
+            return false;
+        }
+
+        // Drop completely sent packets
+        size_t left = static_cast<size_t>(sent);
+        while (left > 0) {
+            size_t packetLeft = client.queue.front()->size() - client.offset;
+            if (left < packetLeft) {
+                client.offset += left;
+                break;
+            }
+            left -= packetLeft;
+            client.queued -= client.queue.front()->size();
+            client.queue.pop_front();
+            client.offset = 0;
+            client.nSent++;
+        }
+    }
+    return true;
+}
+
+
+void CTcpFanoutDevice::CloseClient(SClient &client, const char *reason) {
+    if (client.fd >= 0) {
+        close(client.fd);
+        LOGNOTIFY(gVerbose, "Disconnected client %s (%s), %llu packets sent, %llu skipped\n", client.peer.c_str(),
+                  reason, static_cast<unsigned long long>(client.nSent),
+                  static_cast<unsigned long long>(client.nSkipped));
+        client.fd = -1;
+    }
+}
+
+
+void CTcpFanoutDevice::IoThread() {
+    std::vector<struct pollfd> fds;
+    char scratch[512];
+
+    while (!_stop.load()) {
+        fds.clear();
+        fds.push_back({_wakeup[0], POLLIN, 0});
+        fds.push_back({_socketDesc, POLLIN, 0});
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (auto &client : _clients) {
+                // POLLIN detects disconnection (clients are not expected to send anything)
+                fds.push_back({client.fd, static_cast<short>(POLLIN | (client.queue.empty() ? 0 : POLLOUT)), 0});
+            }
+        }
+
+        if (poll(fds.data(), fds.size(), 1000) < 0) {
+            if (errno != EINTR) {
+                LOGERROR(1, "Error %d during poll(). %s\n", errno, strerror(errno));
+            }
+            continue;
+        }
+
+        if (fds[0].revents & POLLIN) {
+            while (read(_wakeup[0], scratch, sizeof(scratch)) > 0);
+        }
+
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        // Only clients present when poll() was set up have an entry in fds
+        size_t i = 2;
+        for (auto it = _clients.begin(); it != _clients.end() && i < fds.size(); ++it, ++i) {
+            SClient &client = *it;
+            const short revents = fds[i].revents;
+
+            if (!client.closing && (revents & POLLIN)) {
+                ssize_t n = recv(client.fd, scratch, sizeof(scratch), MSG_DONTWAIT);
+                if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+                    client.closing = true;
+                }
+            }
+            if (!client.closing && (revents & (POLLERR | POLLHUP))) {
+                client.closing = true;
+            }
+            if (!client.closing && !client.queue.empty() && !Flush(client)) {
+                client.closing = true;
+            }
+        }
+
+        // Slow clients may also have been marked in Write()
+        for (auto it = _clients.begin(); it != _clients.end();) {
+            if (it->closing) {
+                CloseClient(*it, it->slow ? "too slow" : "connection closed");
+                it = _clients.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        if (fds[1].revents & POLLIN) {
+            AcceptPending();
+        }
+    }
+}
+
+
+bool CTcpFanoutDevice::IoCtrl(const unsigned int command, [[maybe_unused]] const void *data, [[maybe_unused]] size_t len) {
+    switch (command) {
+        case EReset: {
+            // Disconnect all clients, they may connect again
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (auto &client : _clients) {
+                client.closing = true;
+            }
+            Wakeup();
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+
+unsigned int CTcpFanoutDevice::GetNClients() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return static_cast<unsigned int>(_clients.size());
+}
+
+#endif
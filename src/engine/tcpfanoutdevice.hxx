@@ -0,0 +1,138 @@
+/*
+ *  Copyright (c) 2013 Croatia Control Ltd. (www.crocontrol.hr)
+ *
+ *  This file is part of Asterix.
+ *
+ *  Asterix is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Asterix is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Asterix.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef TCPFANOUTDEVICE_HXX__
+#define TCPFANOUTDEVICE_HXX__
+
+#include <netinet/in.h>
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "basedevice.hxx"
+#include "descriptor.hxx"
+
+#define MAX_TCPFANOUT_PACKET_SIZE   65536
+
+/**
+ * @class CTcpFanoutDevice
+ *
+ * @brief TCP server output device which serves many clients at once.
+ *
+ * Every written packet is queued to all connected clients. Clients use
+ * non-blocking sockets served by a dedicated I/O thread (poll + sendmsg),
+ * so Write() never blocks the engine. Each client has a bounded send
+ * queue; a client whose queue is full is either disconnected or
+ * down-sampled (packets are skipped until its queue drains to half).
+ * Packets are shared between the client queues, not copied.
+ *
+ * Descriptor format: address:port[:queueKB[:policy]]
+ *  - address  server interface (empty = INADDR_ANY)
+ *  - port     server port (0 = chosen by the system, see GetPort())
+ *  - queueKB  maximal send queue per client in kilobytes (default 1024)
+ *  - policy   D (disconnect slow clients, default) or S (down-sample slow clients)
+ *
+ * @see   <CDeviceFactory>
+ *        <CBaseDevice>
+ *        <CDescriptor>
+ */
+class CTcpFanoutDevice : public CBaseDevice {
+public:
+    static const unsigned int MAX_CLIENTS = 64;
+    static const unsigned int MAX_BACKLOG = 16;
+    static const unsigned int DEFAULT_QUEUE_KB = 1024;
+
+private:
+    typedef std::shared_ptr<const std::vector<unsigned char>> TPacket;
+
+    struct SClient {
+        int fd;
+        std::string peer;
+        std::deque<TPacket> queue;
+        size_t queued;      // bytes in queue
+        size_t offset;      // bytes of first packet already sent
+        bool skipping;      // down-sampling because queue was full
+        bool closing;       // disconnect requested
+        bool slow;          // disconnected because queue was full
+        uint64_t nSent;
+        uint64_t nSkipped;
+    };
+
+    int _socketDesc;
+    unsigned int _port;
+    int _wakeup[2]; // self-pipe waking the I/O thread
+    size_t _maxQueue;
+    bool _downSample;
+    std::list<SClient> _clients;
+    std::mutex _mutex;
+    std::atomic<bool> _stop;
+    std::thread _thread;
+
+private:
+    bool InitServer(const char *serverAddress, const int serverPort);
+
+    void IoThread();
+
+    void AcceptPending();
+
+    bool Flush(SClient &client);
+
+    void CloseClient(SClient &client, const char *reason);
+
+    void Wakeup();
+
+public:
+
+    /**
+     * Class constructor which uses descriptor
+     */
+    explicit CTcpFanoutDevice(CDescriptor &descriptor);
+
+    /**
+     * Class destructor.
+     */
+    ~CTcpFanoutDevice() override;
+
+    bool Read([[maybe_unused]] void *data, [[maybe_unused]] size_t len) override { return false; }
+
+    bool Write(const void *data, size_t len) override;
+
+    bool Select([[maybe_unused]] const unsigned int secondsToWait) override { return false; }
+
+    bool IoCtrl(const unsigned int command, const void *data = 0, size_t len = 0) override;
+
+    bool IsPacketDevice() override { return true; }
+
+    unsigned int MaxPacketSize() override { return MAX_TCPFANOUT_PACKET_SIZE; }
+
+    // Number of currently connected clients
+    unsigned int GetNClients();
+
+    // Port the server listens on
+    unsigned int GetPort() const { return _port; }
+};
+
+#endif
@@ -128,6 +128,7 @@ CUdpDevice::CUdpDevice(CDescriptor &descriptor) {
     const char *sourceAddress;
     const char *server;
     _countToRead = 0;
+    _packetTime = 0;
     _maxValSocketDesc = 0;
 
     element = descriptor.GetFirst();
@@ -266,8 +267,38 @@ bool CUdpDevice::Read(void *data, size_t *len) {
             _countToRead--;
             // _socketDesc is going to be read, clear bits
             FD_CLR(_socketDesc[i], &_descToRead);
+#ifdef SO_TIMESTAMPNS
+            // Use recvmsg() to get also the kernel receive timestamp
+            struct iovec iov;
+            iov.iov_base = data;
+            iov.iov_len = *len;
+            union {
+                char buf[CMSG_SPACE(sizeof(struct timespec))];
+                struct cmsghdr align;
+            } control;
+            struct msghdr msg = {};
+            msg.msg_name = &clientAddr;
+            msg.msg_namelen = clientLen;
+            msg.msg_iov = &iov;
+            msg.msg_iovlen = 1;
+            msg.msg_control = control.buf;
+            msg.msg_controllen = sizeof(control.buf);
+            ssize_t lenread = recvmsg(_socketDesc[i], &msg, MSG_DONTWAIT);
+
+            _packetTime = 0;
+            if (lenread >= 0) {
+                for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+                    if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+                        struct timespec ts;
+                        memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+                        _packetTime = ts.tv_sec + ts.tv_nsec / 1000000000.0;
+                    }
+                }
+            }
+#else
             ssize_t lenread = recvfrom(_socketDesc[i], RECVFROM_CAST(data), *len, MSG_DONTWAIT, reinterpret_cast<struct sockaddr *>(&clientAddr),
                                        &clientLen);
+#endif
             if (lenread < 0) {
                 // Don't use clientAddr in error - it may not be populated on failure
                 LOGERROR(1, "Error reading from UDP socket on multicast address %s.\n",
@@ -435,6 +466,14 @@ bool CUdpDevice::InitServer(int socketDesc) {
         }
     }
 
+#ifdef SO_TIMESTAMPNS
+    // Ask kernel to timestamp received packets (not fatal if unsupported)
+    int yes = 1;
+    if (setsockopt(socketDesc, SOL_SOCKET, SO_TIMESTAMPNS, SETSOCKOPT_CAST(&yes), sizeof(yes)) < 0) {
+        LOGWARNING(1, "Cannot enable receive timestamps on port %d\n", _port);
+    }
+#endif
+
     return true;
 }
 
@@ -77,6 +77,7 @@ private:
     fd_set _descToReadTemplate;  // PERFORMANCE: Persistent template to avoid rebuilding on every Select()
     int _countToRead;
     int _maxValSocketDesc;
+    double _packetTime; // kernel receive time of last read packet
 
 private:
     bool InitServer(int socketDesc);
@@ -110,6 +111,7 @@ public:
     unsigned int
     MaxPacketSize() override { return MAX_UDP_PACKET_SIZE; } // return maximal packet size (only for packet devices)
     unsigned int BytesLeftToRead() override { return 0; } // return number of bytes left to read or 0 if unknown
+    double GetPacketTime() override { return _packetTime; }
 
 private:
     void Init(const char *mcastAddress, const char *interfaceAddress, const char *srcAddress, const int port,
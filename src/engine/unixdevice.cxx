@@ -0,0 +1,402 @@
+/*
+ *  Copyright (c) 2013 Croatia Control Ltd. (www.crocontrol.hr)
+ *
+ *  This file is part of Asterix.
+ *
+ *  Asterix is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Asterix is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Asterix.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+// Unix domain sockets - POSIX only
+#ifndef _WIN32
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/select.h> // fd_set
+#include <sys/time.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+// Standard includes
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <errno.h>
+
+// Local includes
+#include "asterix.h"
+#include "unixdevice.hxx"
+
+
+CUnixDevice::CUnixDevice(CDescriptor &descriptor)
+        : _server(false), _stream(false), _acceptPending(false), _connected(false),
+          _socketDesc(-1), _socketDescSession(-1) {
+    const char *server = descriptor.GetFirst();
+    const char *path = descriptor.GetNext();
+    const char *type = descriptor.GetNext();
+
+    memset(&_addr, 0, sizeof(_addr));
+    _addr.sun_family = AF_UNIX;
+
+    // Server argument
+    if ((server == nullptr) || (server[0] == '\0')) {
+        LOGERROR(1, "Server flag not specified\n");
+        return;
+    }
+    if (toupper(server[0]) == 'S') {
+        _server = true;
+        _acceptPending = (toupper(server[1]) == 'P');
+        LOGINFO(gVerbose, "Server%s\n", _acceptPending ? " in pre-emptive mode" : "");
+    } else {
+        LOGINFO(gVerbose, "Client mode\n");
+    }
+
+    // Socket path argument
+    if ((path == nullptr) || (path[0] == '\0')) {
+        LOGERROR(1, "Socket path not specified\n");
+        return;
+    }
+    if (strlen(path) >= sizeof(_addr.sun_path)) {
+        LOGERROR(1, "Socket path '%s' too long\n", path);
+        return;
+    }
+    _path = path;
+    strncpy(_addr.sun_path, path, sizeof(_addr.sun_path) - 1);
+    LOGINFO(gVerbose, "Socket path: %s\n", path);
+
+    // Socket type argument
+    if ((type != nullptr) && (strcasecmp(type, "stream") == 0)) {
+        _stream = true;
+    } else if ((type != nullptr) && (type[0] != '\0') && (strcasecmp(type, "dgram") != 0)) {
+        LOGERROR(1, "Unknown socket type '%s' (dgram or stream)\n", type);
+        return;
+    }
+    LOGINFO(gVerbose, "Socket type: %s\n", _stream ? "stream" : "dgram");
+
+    if (_server) {
+        _opened = InitServer();
+    } else {
+        // Client connects on first use
+        _opened = true;
+    }
+}
+
+
+CUnixDevice::~CUnixDevice() {
+    if (_socketDescSession >= 0) {
+        close(_socketDescSession);
+    }
+
+    if (_socketDesc >= 0) {
+        close(_socketDesc);
+    }
+
+    if (_server && _opened) {
+        unlink(_path.c_str());
+    }
+}
+
+
+bool CUnixDevice::InitServer() {
+    _socketDesc = socket(AF_UNIX, _stream ? SOCK_STREAM : SOCK_DGRAM, 0);
+    if (_socketDesc < 0) {
+        LOGERROR(1, "Cannot open socket\n");
+        return false;
+    }
+
+    // Remove stale socket file left by previous server
+    unlink(_path.c_str());
+
+    if (bind(_socketDesc, reinterpret_cast<struct sockaddr *>(&_addr), sizeof(_addr)) < 0) {
+        LOGERROR(1, "Cannot bind socket %s. %s\n", _path.c_str(), strerror(errno));
+        return false;
+    }
+
+    if (_stream) {
+        // See CTcpDevice::InitServer() for backlog in single connection mode
+        int backlog = _acceptPending ? MAX_BACKLOG : 0;
+        listen(_socketDesc, backlog);
+    } else {
+        // Datagram server is always ready to receive
+        _connected = true;
+    }
+
+    return true;
+}
+
+
+bool CUnixDevice::Connect() {
+    if (_connected) {
+        return true;
+    }
+
+    if (_server) {
+        // Server will wait (BLOCKING) for a client to connect if there is no pending connection
+        _socketDescSession = accept(_socketDesc, nullptr, nullptr);
+        if (_socketDescSession < 0) {
+            LOGERROR(1, "Error %d accepting connection. %s\n", errno, strerror(errno));
+            return false;
+        }
+        LOGNOTIFY(gVerbose, "Accepted connection on %s (socket %d)\n", _path.c_str(), _socketDescSession);
+    } else {
+        // Client will open socket again
+        _socketDesc = socket(AF_UNIX, _stream ? SOCK_STREAM : SOCK_DGRAM, 0);
+        if (_socketDesc < 0) {
+            LOGERROR(1, "Cannot re-open socket\n");
+            return false;
+        }
+
+        // Connect to the server (for datagrams this only sets the default destination)
+        if (connect(_socketDesc, reinterpret_cast<struct sockaddr *>(&_addr), sizeof(_addr)) < 0) {
+            LOGERROR(1, "Cannot connect to server %s (error %d). %s\n", _path.c_str(), errno, strerror(errno));
+            close(_socketDesc);
+            _socketDesc = -1;
+            return false;
+        }
+        LOGNOTIFY(gVerbose, "Connected to server %s\n", _path.c_str());
+    }
+
+    _connected = true;
+    return true;
+}
+
+
+bool CUnixDevice::AcceptPending() {
+    int fd_flags = fcntl(_socketDesc, F_GETFL, 0);
+
+    // Accept (NON-BLOCKING) if there is a pending connection
+    fcntl(_socketDesc, F_SETFL, fd_flags | O_NONBLOCK);
+    int socketDescNewSession = accept(_socketDesc, nullptr, nullptr);
+    fcntl(_socketDesc, F_SETFL, fd_flags); // Get back to blocking mode
+
+    if (socketDescNewSession < 0) {
+        if (errno != EAGAIN && errno != EWOULDBLOCK) {
+            LOGERROR(1, "Error %d accepting pending connection. %s\n", errno, strerror(errno));
+        }
+        return false;
+    }
+    LOGINFO(gVerbose, "Accepted pending connection on %s (socket %d)\n", _path.c_str(), socketDescNewSession);
+
+    // if there is already an accepted connection - force its disconnection
+    if (_connected && (_socketDescSession >= 0)) {
+        close(_socketDescSession);
+        LOGINFO(gVerbose, "Closed connection on socket %d\n", _socketDescSession);
+    }
+    _socketDescSession = socketDescNewSession;
+
+    _connected = true;
+    return true;
+}
+
+
+bool CUnixDevice::Disconnect() {
+    if (!_connected) {
+        return false;
+    }
+
+    if (_server) {
+        if (!_stream) {
+            return false; // datagram server has no connection
+        }
+        close(_socketDescSession);
+        _socketDescSession = -1;
+        LOGNOTIFY(gVerbose, "Disconnected from client on %s\n", _path.c_str());
+    } else {
+        close(_socketDesc);
+        _socketDesc = -1;
+        LOGINFO(gVerbose, "Disconnected from server %s\n", _path.c_str());
+    }
+
+    _connected = false;
+    return true;
+}
+
+
+bool CUnixDevice::Read(void *data, size_t len) {
+    size_t bytesRead = len;
+    if (!Read(data, &bytesRead)) {
+        return false;
+    }
+
+    // Stream: read the rest of requested bytes
+    while (_stream && bytesRead < len) {
+        ssize_t n = recv(ActiveSocket(), static_cast<char *>(data) + bytesRead, len - bytesRead, MSG_WAITALL);
+        if (n <= 0) {
+            LOGERROR(n < 0, "Error %d reading from socket. %s\n", errno, strerror(errno));
+            Disconnect();
+            CountReadError();
+            return false;
+        }
+        bytesRead += n;
+    }
+
+    if (bytesRead != len) {
+        LOGWARNING(1, "Read only %zu bytes from %zu requested from %s.\n", bytesRead, len, _path.c_str());
+    }
+    return true;
+}
+
+
+bool CUnixDevice::Read(void *data, size_t *len) {
+    // Check if interface was set-up correctly
+    if (!_opened) {
+        LOGERROR(1, "Cannot read due to not properly initialized interface.\n");
+        CountReadError();
+        return false;
+    }
+
+    if (!_server && !_stream) {
+        LOGERROR(1, "Cannot read from datagram client.\n");
+        CountReadError();
+        return false;
+    }
+
+    // Connect or accept connection if necessary
+    if (!Connect()) {
+        LOGERROR(1, "Cannot read, could not establish connection.\n");
+        CountReadError();
+        return false;
+    }
+
+    // Datagram: one whole packet, stream: whatever is available
+    ssize_t bytesReceived = recv(ActiveSocket(), data, *len, 0);
+
+    if (bytesReceived < 0) {
+        LOGERROR(1, "Error %d reading from socket %s. %s\n", errno, _path.c_str(), strerror(errno));
+        Disconnect();
+        CountReadError();
+        return false;
+    } else if (bytesReceived == 0 && _stream) {
+        LOGNOTIFY(gVerbose, "Connection closed by remote host\n");
+        Disconnect();
+        return false;
+    }
+
+    *len = bytesReceived;
+
+    LOGDEBUG(ZONE_TCPDEVICE, "Read message from %s with length %zd.\n", _path.c_str(), bytesReceived);
+
+    ResetReadErrors(true);
+    return true;
+}
+
+
+bool CUnixDevice::Write(const void *data, size_t len) {
+    // Check if interface was set-up correctly
+    if (!_opened) {
+        LOGERROR(1, "Cannot write due to not properly initialized interface.\n");
+        CountWriteError();
+        return false;
+    }
+
+    if (_server && !_stream) {
+        LOGERROR(1, "Cannot write to datagram server.\n");
+        CountWriteError();
+        return false;
+    }
+
+    // Connect or accept connection if necessary
+    if (!Connect()) {
+        CountWriteError();
+        return false;
+    }
+
+    // Write the message (blocking, local peer applies back-pressure instead of dropping)
+    if (send(ActiveSocket(), static_cast<const char *>(data), len, MSG_NOSIGNAL) < 0) {
+        LOGERROR(1, "Error %d writing to socket %s. %s\n", errno, _path.c_str(), strerror(errno));
+
+        Disconnect(); // reconnect on next write
+        CountWriteError();
+        return false;
+    }
+
+    LOGDEBUG(ZONE_TCPDEVICE, "Wrote message to %s.\n", _path.c_str());
+
+    ResetWriteErrors(true);
+    return true;
+}
+
+
+bool CUnixDevice::Select(const unsigned int secondsToWait) {
+    // Check if interface was set-up correctly
+    if (!_opened) {
+        LOGERROR(1, "Cannot select() due to not properly initialized interface.\n");
+        return false;
+    }
+
+    // Connect or accept connection if necessary
+    if (!Connect()) {
+        return false;
+    }
+
+    int socketToSelect = ActiveSocket();
+    ASSERT(socketToSelect >= 0);
+
+    fd_set descToRead;
+    int maxDesc = socketToSelect;
+    FD_ZERO(&descToRead);
+    FD_SET(socketToSelect, &descToRead);
+    if (_server && _stream && _acceptPending) {
+        // Add also the listening socket to be able to accept pending connections
+        FD_SET(_socketDesc, &descToRead);
+        if (_socketDesc > maxDesc) {
+            maxDesc = _socketDesc;
+        }
+    }
+
+    int selectVal;
+    if (secondsToWait) {
+        struct timeval timeout;
+        timeout.tv_sec = secondsToWait;
+        timeout.tv_usec = 0;
+
+        selectVal = select(maxDesc + 1, &descToRead, nullptr, nullptr, &timeout);
+    } else {
+        // secondsToWait is zero => Wait indefinitely
+        selectVal = select(maxDesc + 1, &descToRead, nullptr, nullptr, nullptr);
+    }
+
+    if (selectVal < 0) {
+        LOGERROR(1, "Error %d during select(). %s\n", errno, strerror(errno));
+        return false;
+    }
+
+    // Check if there are connections to accept
+    if (_server && _stream && _acceptPending && FD_ISSET(_socketDesc, &descToRead)) {
+        AcceptPending();
+        return false;
+    }
+
+    return FD_ISSET(socketToSelect, &descToRead);
+}
+
+
+bool CUnixDevice::IoCtrl(const unsigned int command, [[maybe_unused]] const void *data, [[maybe_unused]] size_t len) {
+    if (!_stream) {
+        return false;
+    }
+
+    switch (command) {
+        case EReset:
+        case EAllDone:
+            Disconnect();
+            return !_connected;
+        case EIsLastPacket:
+            return !_connected;
+        default:
+            return false;
+    }
+}
+
+#endif
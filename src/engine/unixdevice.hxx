@@ -0,0 +1,110 @@
+/*
+ *  Copyright (c) 2013 Croatia Control Ltd. (www.crocontrol.hr)
+ *
+ *  This file is part of Asterix.
+ *
+ *  Asterix is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Asterix is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Asterix.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef UNIXDEVICE_HXX__
+#define UNIXDEVICE_HXX__
+
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include <string>
+
+#include "basedevice.hxx"
+#include "descriptor.hxx"
+
+#define MAX_UNIX_PACKET_SIZE    65536
+
+/**
+ * @class CUnixDevice
+ *
+ * @brief The Unix domain socket (AF_UNIX) device for same-host pipelines.
+ *
+ * Descriptor format: S|SP|C:path[:dgram|stream]
+ *  - S        server, single connection (stream) / receiver (dgram)
+ *  - SP       server in pre-emptive mode: accept any pending connection immediately (stream)
+ *  - C        client, connects to the server socket (reconnects when needed)
+ *  - path     socket file path
+ *  - dgram    datagram socket, keeps packet boundaries (default)
+ *  - stream   stream socket
+ *
+ * Connect/accept semantics follow <CTcpDevice>. In datagram mode the server
+ * only receives and the client only sends. The server removes a stale
+ * socket file before binding and removes its socket file when closed.
+ *
+ * @see   <CDeviceFactory>
+ *        <CBaseDevice>
+ *        <CDescriptor>
+ */
+class CUnixDevice : public CBaseDevice {
+public:
+    static const unsigned int MAX_BACKLOG = 5;
+
+private:
+    bool _server;
+    bool _stream;
+    bool _acceptPending;
+    bool _connected;
+    std::string _path;
+    struct sockaddr_un _addr;
+    int _socketDesc;
+    int _socketDescSession;
+
+private:
+    bool InitServer();
+
+    bool Connect();
+
+    bool AcceptPending();
+
+    bool Disconnect();
+
+    int ActiveSocket() const { return (_server && _stream) ? _socketDescSession : _socketDesc; }
+
+public:
+
+    /**
+     * Class constructor which uses descriptor
+     */
+    explicit CUnixDevice(CDescriptor &descriptor);
+
+    /**
+     * Class destructor.
+     */
+    ~CUnixDevice() override;
+
+    bool Read(void *data, size_t len) override;
+
+    bool Read(void *data, size_t *len) override;
+
+    bool Write(const void *data, size_t len) override;
+
+    bool Select(const unsigned int secondsToWait) override;
+
+    bool IoCtrl(const unsigned int command, const void *data = 0, size_t len = 0) override;
+
+    bool IsPacketDevice() override { return true; }
+
+    bool IsStreamDevice() override { return _stream; }
+
+    unsigned int MaxPacketSize() override { return MAX_UNIX_PACKET_SIZE; }
+
+    unsigned int BytesLeftToRead() override { return 0; }
+};
+
+#endif
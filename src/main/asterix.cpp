@@ -25,25 +25,45 @@
  */
 
 #include <string>
+#include <vector>
 #include <iostream>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <filesystem>
+#ifndef _WIN32
+  #include <glob.h>
+#endif
 
 #include "asterix.h"
 #include "version.h"
 #include "Tracer.h"
+#include "pcapindex.hxx"
+#include "replayscheduler.hxx"
+#include "definitionreloader.hxx"
 #include "../engine/converterengine.hxx"
 #include "../engine/channelfactory.hxx"
+#include "../engine/checkpoint.hxx"
+#include "../engine/inputmerger.hxx"
+#include "../engine/diskdevice.hxx"
+#include "../engine/splitdevice.hxx"
 
 // These globals are now defined in src/engine/globals.cpp (part of the library)
 // Declare them as extern to use the library definitions
 extern bool gVerbose;
 extern bool gSynchronous;
+extern double gReplaySpeed;
 extern bool gForceRouting;
 extern int gHeartbeat;
 extern const char *gAsterixDefinitionsFile;
+extern const char *gDefinitionsCacheFile;
+extern bool gEagerDefinitions;
 extern bool gFiltering;
+extern unsigned int gReceiveRing;
+extern double gStartTime;
+extern double gEndTime;
+extern unsigned long gFirstPacket;
+extern unsigned long gLastPacket;
 
 static void DisplayCopyright() {
     std::cerr << "Asterix " _VERSION_STR " " __DATE__;
@@ -106,12 +126,90 @@ static std::string parseOutputFormatArg(const std::string &arg, const std::strin
         return checkOutputFormatConflict(arg, currentFormat) ? "" : "ASTERIX_JSONE";
     } else if ((arg == "-k") || (arg == "--kml")) {
         return checkOutputFormatConflict(arg, currentFormat) ? "" : "ASTERIX_KML";
+    } else if (arg == "--write-pcap") {
+        return checkOutputFormatConflict(arg, currentFormat) ? "" : "ASTERIX_PCAP";
+    } else if (arg == "--write-raw") {
+        return checkOutputFormatConflict(arg, currentFormat) ? "" : "ASTERIX_RAW";
     }
     return currentFormat; // Not an output format arg
 }
 
+// Helper: Parse time argument HH:MM[:SS[.fff]] (UTC time of day) or seconds since epoch, returns negative on error
+static double parseTimeArg(const std::string &value) {
+    char *end = nullptr;
+    if (value.find(':') == std::string::npos) {
+        double t = strtod(value.c_str(), &end);
+        return (end != value.c_str() && *end == '\0' && t > 0) ? t : -1;
+    }
+
+    unsigned int hour = 0;
+    unsigned int min = 0;
+    double sec = 0;
+    int n = sscanf(value.c_str(), "%u:%u:%lf", &hour, &min, &sec);
+    if (n < 2 || hour > 23 || min > 59 || sec < 0 || sec >= 60) {
+        return -1;
+    }
+    return hour * 3600 + min * 60 + sec;
+}
+
+// Helper: Prepare checkpoint of file conversion. On resume the output is truncated to the size saved
+// with the checkpoint and input is read from the saved offset. Returns 1 on error, -1 if the
+// conversion was already complete, otherwise 0.
+static int prepareCheckpoint(CCheckpoint &checkpoint, bool bResume, const std::string &strFileInput,
+                             const std::string &strFileOutput) {
+    std::error_code ec;
+    const uint64_t inputSize = std::filesystem::file_size(strFileInput, ec);
+    if (ec) {
+        std::cerr << "Error: Cannot read input file " << strFileInput << "." << std::endl;
+        return 1;
+    }
+
+    if (!bResume) {
+        checkpoint.input = strFileInput;
+        checkpoint.inputSize = inputSize;
+        checkpoint.output = strFileOutput;
+        return checkpoint.Save() ? 0 : 1;
+    }
+
+    if (!checkpoint.Load()) {
+        return 1;
+    }
+    if (checkpoint.input != strFileInput || checkpoint.output != strFileOutput) {
+        std::cerr << "Error: Checkpoint " << checkpoint.GetPath() << " is for input " << checkpoint.input
+                  << " and output " << checkpoint.output << "." << std::endl;
+        return 1;
+    }
+    if (checkpoint.inputSize != inputSize) {
+        std::cerr << "Error: Input file " << strFileInput << " changed since the checkpoint." << std::endl;
+        return 1;
+    }
+    if (checkpoint.complete) {
+        LOGNOTIFY(gVerbose, "Conversion of %s already complete (%llu packets).\n", strFileInput.c_str(),
+                  static_cast<unsigned long long>(checkpoint.packets));
+        return -1;
+    }
+
+    const uint64_t outputSize = std::filesystem::file_size(strFileOutput, ec);
+    if (ec || outputSize < static_cast<uint64_t>(checkpoint.outputOffset)) {
+        std::cerr << "Error: Output file " << strFileOutput << " is missing or shorter than at the checkpoint." << std::endl;
+        return 1;
+    }
+    std::filesystem::resize_file(strFileOutput, static_cast<uint64_t>(checkpoint.outputOffset), ec);
+    if (ec) {
+        std::cerr << "Error: Cannot truncate output file " << strFileOutput << "." << std::endl;
+        return 1;
+    }
+
+    gResumeOffset = checkpoint.inputOffset;
+    LOGNOTIFY(gVerbose, "Resuming conversion after %llu packets (input offset %lld, output offset %lld).\n",
+              static_cast<unsigned long long>(checkpoint.packets), static_cast<long long>(checkpoint.inputOffset),
+              static_cast<long long>(checkpoint.outputOffset));
+    return 0;
+}
+
 // Helper: Build input channel string from configuration
 static std::string buildInputString(const std::string &strFileInput, const std::string &strIPInput,
+                                    const std::string &strShmInput, const std::string &strUnixInput,
                                     const std::string &strZMQInput, const std::string &strMQTTInput,
                                     const std::string &strGRPCInput, const std::string &strDDSInput,
                                     bool bLoopFile, const std::string &strInputFormat) {
@@ -125,6 +223,14 @@ static std::string buildInputString(const std::string &strFileInput, const std::
     } else if (!strIPInput.empty()) {
         strInput = "udp;" + strIPInput + ";";
     }
+#ifndef _WIN32
+    else if (!strShmInput.empty()) {
+        strInput = "shm;" + strShmInput + ":R;";
+    }
+    else if (!strUnixInput.empty()) {
+        strInput = "unix;S:" + strUnixInput + ";";
+    }
+#endif
 #ifdef HAVE_ZEROMQ
     else if (!strZMQInput.empty()) {
         strInput = "zmq;" + strZMQInput + ";";
@@ -153,6 +259,66 @@ static std::string buildInputString(const std::string &strFileInput, const std::
     return strInput;
 }
 
+// Helper: Build one input channel string per file (-f) and multicast (-i) source and
+// per other input option, used when more than one data source is given and inputs are merged
+static std::vector<std::string> buildInputList(const std::vector<std::string> &fileInputs,
+                                               const std::vector<std::string> &ipInputs,
+                                               const std::string &strShmInput, const std::string &strUnixInput,
+                                               const std::string &strZMQInput, const std::string &strMQTTInput,
+                                               const std::string &strGRPCInput, const std::string &strDDSInput,
+                                               bool bLoopFile, const std::string &strInputFormat) {
+    std::vector<std::string> inputs;
+
+    for (const auto &file : fileInputs) {
+        std::string strInput = "disk;" + file + "|0|";
+        strInput += bLoopFile ? "65;" : "1;";
+        inputs.push_back(strInput + strInputFormat);
+    }
+    for (const auto &ip : ipInputs) {
+        inputs.push_back("udp;" + ip + ";" + strInputFormat);
+    }
+    // options of inputs not compiled in are rejected when parsed, so these are empty
+    if (!strShmInput.empty()) {
+        inputs.push_back("shm;" + strShmInput + ":R;" + strInputFormat);
+    }
+    if (!strUnixInput.empty()) {
+        inputs.push_back("unix;S:" + strUnixInput + ";" + strInputFormat);
+    }
+    if (!strZMQInput.empty()) {
+        inputs.push_back("zmq;" + strZMQInput + ";" + strInputFormat);
+    }
+    if (!strMQTTInput.empty()) {
+        inputs.push_back("mqtt;" + strMQTTInput + ";" + strInputFormat);
+    }
+    if (!strGRPCInput.empty()) {
+        inputs.push_back("grpc;" + strGRPCInput + ";" + strInputFormat);
+    }
+    if (!strDDSInput.empty()) {
+        inputs.push_back("dds;" + strDDSInput + ";" + strInputFormat);
+    }
+    return inputs;
+}
+
+// Helper: Add file input(s), a name with wildcards is expanded to all matching files
+static bool addFileInputs(const char *pattern, std::vector<std::string> &fileInputs) {
+#ifndef _WIN32
+    if (strpbrk(pattern, "*?[") != nullptr) {
+        glob_t g;
+        if (glob(pattern, 0, nullptr, &g) != 0) {
+            std::cerr << "Error: No file matches '" << pattern << "'." << std::endl;
+            return false;
+        }
+        for (size_t i = 0; i < g.gl_pathc; i++) {
+            fileInputs.emplace_back(g.gl_pathv[i]);
+        }
+        globfree(&g);
+        return true;
+    }
+#endif
+    fileInputs.emplace_back(pattern);
+    return true;
+}
+
 // Helper: Process filter file and configure filtering
 static bool processFilterFile(const std::string &strFilterFile, CBaseFormatDescriptor *desc) {
     FILE *ff = fopen(strFilterFile.c_str(), "r");
@@ -220,19 +386,24 @@ static void show_usage(std::string name) {
             << "\nReads and parses ASTERIX data from stdin, file or network multicast stream\nand prints it in textual presentation on standard output.\n\n"
             << "Usage:\n"
             << name
-            << " [-h] [-V] [-v] [-L] [-o] [-s] [-P|-O|-R|-F|-H] [-l|-x|-j|-jh|-je] [-d filename] [-LF filename] -f filename|-i (mcastaddress:ipaddress:port[:srcaddress]@)+"
+            << " [-h] [-V] [-v] [-L] [-o] [-s] [-P|-O|-R|-F|-H] [-l|-x|-j|-jh|-je|--write-pcap|--write-raw] [--out filename] [--split template [--split-files n]] [--checkpoint file [--checkpoint-interval s] [--resume]] [--validate] [-d filename] [--eager-defs [--def-cache filename|--no-def-cache]] [-LF filename] [-w ms] [-r slots] -f filename|-i (mcastaddress:ipaddress:port[:srcaddress]@)+"
             << "\n\nOptions:"
             << "\n\t-h,--help\tShow this help message and exit."
             << "\n\t-V,--version\tShow version information and exit."
             << "\n\t-v,--verbose\tShow more information during program execution."
             << "\n\t-d,--def\tXML protocol definitions filenames are listed in specified filename. By default are listed in config/asterix.ini"
+            << "\n\t--eager-defs\tLoad all definitions at startup. By default a definition is loaded when its category is first received."
+            << "\n\t--def-cache\tBinary cache of the XML definitions for --eager-defs, rebuilt when they change. By default <def filename>.cache"
+            << "\n\t--no-def-cache\tAlways load definitions from XML files."
+            << "\n\t\t\tDefinitions are reloaded on SIGHUP, inputs switch to them between packets."
             << "\n\t-L,--list\tList all configured ASTERIX items. Mark which items are filtered."
             << "\n\t-LF,--filter\tPrintout only items listed in configured file."
             << "\n\t-o,--loop\tLoop the input file. Only relevant when file is data source."
             << "\n\t-s,--sync\tOutput will be printed synchronously with input file (with time delays between packets). This parameter is used only if input is from file."
+            << "\n\t--speed factor\tReplay synchronously at the given speed (0.1 - 100, e.g. 2 = twice real time), implies -s.\n\t\t\tWith -v achieved timing is reported at the end."
             << "\n\nInput format"
             << "\n------------"
-            << "\n\t-P,--pcap\tInput is from PCAP file."
+            << "\n\t-P,--pcap\tInput is from PCAP or pcapng file."
             << "\n\t-R,--oradispcap\tInput is from PCAP file and Asterix packet is encapsulated in ORADIS packet."
             << "\n\t-O,--oradis\tAsterix packet is encapsulated in ORADIS packet."
             << "\n\t-F,--final\tAsterix packet is encapsulated in FINAL packet."
@@ -246,10 +417,33 @@ static void show_usage(std::string name) {
             << "\n\t-j,--json\tOutput will be printed in compact line-delimited JSON format (one object per line, suitable for parsing)."
             << "\n\t-jh,--jsonh\tOutput will be printed in human readable JSON format (suitable for file storage)."
             << "\n\t-je,--json-extensive\tOutput will be printed in extensive JSON format (with both hex and scaled value and description of each item)."
+            << "\n\t--write-pcap\tOutput is written as PCAP file with capture time and network headers of the input packets\n\t\t\t(default headers if input is not PCAP). With -LF only data blocks and records containing\n\t\t\tfiltered items are written, e.g. -P -f day.pcap -LF sensor.txt --write-pcap --out sensor.pcap"
+            << "\n\t--write-raw\tOutput is written as raw ASTERIX data blocks, filtered as with --write-pcap."
+            << "\n\t--out filename\tWrite output to file instead of standard output (file is overwritten)."
+            << "\n\t--split template\tRead input once and write each category and/or sensor to its own file.\n\t\t\tIn the file name template {cat} is replaced with category, {sac} and {sic} with\n\t\t\tSAC/SIC of the first record of data block, e.g. -P -f day.pcap --split out_cat{cat}_{sac}_{sic}.pcap\n\t\t\tOutput is PCAP for PCAP input and raw ASTERIX otherwise (or as set with --write-pcap/--write-raw)."
+            << "\n\t--split-files n\tMaximum number of split output files kept open (default 64)."
+            << "\n\t--checkpoint file\tSave progress of conversion of a raw or PCAP file (-f) to a file (--out)\n\t\t\tto the checkpoint file every 10 seconds and when it is complete."
+            << "\n\t--checkpoint-interval s\tSeconds between checkpoints (default 10)."
+            << "\n\t--resume\tContinue interrupted conversion from the checkpoint: output is truncated to the\n\t\t\tcheckpoint and appended, input is read from the checkpoint offset.\n\t\t\tFor example: -P -f day.pcap -LF sensor.txt --write-pcap --out sensor.pcap --checkpoint day.ckp --resume"
+            << "\n\t--validate\tCheck structure of raw or PCAP input (blocks, FSPEC, item lengths) without\n\t\t\tdecoding items and print per category record counts, item presence, malformed\n\t\t\trecords with their position and throughput. Exit code is 4 if data is malformed."
             << "\n\nData source"
             << "\n------------"
-            << "\n\t-f filename\tFile generated from libpcap (tcpdump or Wireshark) or file in FINAL or HDLC format.\n\t\t\tFor example: -f filename.pcap"
+            << "\n\t-f filename\tFile generated from libpcap (tcpdump or Wireshark) or file in FINAL or HDLC format.\n\t\t\tFor example: -f filename.pcap\n\t\t\tA name with wildcards is expanded to all matching files, for example: -f 'radar*.pcap'"
             << "\n\t-i m:i:p[:s]\tMulticast UDP/IP address:Interface address:Port[:Source address].\n\t\t\tFor example: 232.1.1.12:10.17.58.37:21112:10.17.22.23\n\t\t\tMore than one multicast group could be defined, use @ as separator.\n\t\t\tFor example: 232.1.1.13:10.17.58.37:21112:10.17.22.23@232.1.1.14:10.17.58.37:21112:10.17.22.23"
+            << "\n\t\t\t-f and -i can be repeated and combined with the other inputs. Each source is then read\n\t\t\tand parsed in its own thread and all packets are merged to the same output."
+            << "\n\t-w,--merge-window ms\tWhen merging several sources, write packets arriving within this window\n\t\t\tin timestamp order (default 0 = arrival order).\n\t\t\tWhen only files are merged, packets are by default written in capture time order."
+#ifndef _WIN32
+            << "\n\t--shm name\tRead packets from shared memory ring written by another asterix process."
+            << "\n\t--shm-out name[:slots[:slotsize]]\n\t\t\tWrite output to shared memory ring instead of standard output.\n\t\t\tEach output packet is one ring entry (default 256 slots of 65536 bytes).\n\t\t\tFor example: --shm-out asterix:1024:8192"
+            << "\n\t--unix path[:dgram|stream]\n\t\t\tReceive packets on Unix domain socket (default dgram, which keeps packet boundaries)."
+            << "\n\t--unix-out path[:dgram|stream]\n\t\t\tSend output to Unix domain socket instead of standard output."
+            << "\n\t--tcp-out addr:port[:queueKB[:D|S]]\n\t\t\tServe output to any number of TCP clients instead of standard output.\n\t\t\tEach client has its own send queue (default 1024 KB); slow clients are\n\t\t\tdisconnected (D, default) or down-sampled (S). Empty addr listens on all interfaces.\n\t\t\tFor example: --tcp-out :2000:512:S"
+#endif
+            << "\n\t--start-time t\tRead PCAP input from capture time t, given as UTC time of day HH:MM[:SS[.fff]]\n\t\t\tor as seconds since epoch."
+            << "\n\t--end-time t\tRead PCAP input up to capture time t."
+            << "\n\t--packets n[:m]\tRead PCAP input from packet n (1 based) up to packet m."
+            << "\n\t--index\t\tBuild index file (<file>.idx) of the -f PCAP file(s) and print summary.\n\t\t\tWith an index --start-time and --packets seek directly instead of reading from the start."
+            << "\n\t-r,--rx-ring slots\tReceive network packets on a separate thread into a ring with the given\n\t\t\tnumber of slots and parse them on the main thread (default 0 = single thread)."
 #ifdef HAVE_ZEROMQ
             << "\n\t-z,--zmq\tZeroMQ endpoint. Format: type:endpoint[:bind]"
             << "\n\t\t\ttype: SUB (subscribe) or PULL (pull socket)"
@@ -289,8 +483,25 @@ static void show_usage(std::string name) {
 
 int main(int argc, const char *argv[]) {
     std::string strDefinitions = "config/asterix.ini";
+    std::string strDefinitionsCache;
+    bool bDefinitionsCache = true;
     std::string strFileInput;
     std::string strIPInput;
+    std::vector<std::string> fileInputs;
+    std::vector<std::string> ipInputs;
+    unsigned int nMergeWindow = 0;
+    bool bMergeWindowSet = false;
+    std::string strShmInput;
+    std::string strShmOutput;
+    std::string strUnixInput;
+    std::string strUnixOutput;
+    std::string strTcpOutput;
+    std::string strFileOutput;
+    std::string strSplitOutput;
+    unsigned int nSplitFiles = CSplitDevice::DEFAULT_MAX_OPEN;
+    std::string strCheckpointFile;
+    unsigned int nCheckpointInterval = CCheckpoint::DEFAULT_INTERVAL;
+    bool bResume = false;
     std::string strZMQInput;
     std::string strMQTTInput;
     std::string strGRPCInput;
@@ -301,6 +512,7 @@ int main(int argc, const char *argv[]) {
 
     bool bListDefinitions = false;
     bool bLoopFile = false;
+    bool bBuildIndex = false;
 
     for (int i = 1; i < argc; ++i) {
         std::string arg = argv[i];
@@ -314,6 +526,15 @@ int main(int argc, const char *argv[]) {
             gVerbose = true;
         } else if ((arg == "-s") || (arg == "--sync")) {
             gSynchronous = true;
+        } else if (arg == "--speed") {
+            if (!checkArgRequiresValue(arg, i, argc)) return 1;
+            gReplaySpeed = atof(argv[++i]);
+            if (gReplaySpeed < CReplayScheduler::MIN_SPEED || gReplaySpeed > CReplayScheduler::MAX_SPEED) {
+                std::cerr << "Error: Replay speed must be between " << CReplayScheduler::MIN_SPEED << " and "
+                          << CReplayScheduler::MAX_SPEED << "." << std::endl;
+                return 1;
+            }
+            gSynchronous = true;
         } else if ((arg == "-o") || (arg == "--loop")) {
             bLoopFile = true;
         } else if ((arg == "-L") || (arg == "--list")) {
@@ -339,7 +560,8 @@ int main(int argc, const char *argv[]) {
                    (arg == "-j") || (arg == "--json") ||
                    (arg == "-jh") || (arg == "--jsonh") ||
                    (arg == "-je") || (arg == "--json-extensive") ||
-                   (arg == "-k") || (arg == "--kml")) {
+                   (arg == "-k") || (arg == "--kml") ||
+                   (arg == "--write-pcap") || (arg == "--write-raw")) {
             std::string newFormat = parseOutputFormatArg(arg, strOutputFormat);
             if (newFormat.empty()) {
                 return 1;
@@ -348,12 +570,116 @@ int main(int argc, const char *argv[]) {
         } else if ((arg == "-d") || (arg == "--def") || (arg == "--definitions")) {
             if (!checkArgRequiresValue(arg, i, argc)) return 1;
             strDefinitions = argv[++i];
+        } else if (arg == "--def-cache") {
+            if (!checkArgRequiresValue(arg, i, argc)) return 1;
+            strDefinitionsCache = argv[++i];
+        } else if (arg == "--no-def-cache") {
+            bDefinitionsCache = false;
+        } else if (arg == "--eager-defs") {
+            gEagerDefinitions = true;
         } else if ((arg == "-f")) {
             if (!checkArgRequiresValue(arg, i, argc)) return 1;
-            strFileInput = argv[++i];
+            if (!addFileInputs(argv[++i], fileInputs)) return 1;
+            strFileInput = fileInputs.back();
         } else if ((arg == "-i")) {
             if (!checkArgRequiresValue(arg, i, argc)) return 1;
             strIPInput = argv[++i];
+            ipInputs.push_back(strIPInput);
+        } else if ((arg == "-w") || (arg == "--merge-window")) {
+            if (!checkArgRequiresValue(arg, i, argc)) return 1;
+            nMergeWindow = static_cast<unsigned int>(abs(atoi(argv[++i])));
+            bMergeWindowSet = true;
+        } else if ((arg == "--start-time") || (arg == "--end-time")) {
+            if (!checkArgRequiresValue(arg, i, argc)) return 1;
+            double t = parseTimeArg(argv[++i]);
+            if (t < 0) {
+                std::cerr << "Error: Invalid time " << argv[i] << " for option " << arg << std::endl;
+                return 1;
+            }
+            (arg == "--start-time" ? gStartTime : gEndTime) = t;
+        } else if (arg == "--packets") {
+            if (!checkArgRequiresValue(arg, i, argc)) return 1;
+            std::string range = argv[++i];
+            size_t colon = range.find(':');
+            gFirstPacket = strtoul(range.c_str(), nullptr, 10);
+            gLastPacket = (colon == std::string::npos) ? 0 : strtoul(range.c_str() + colon + 1, nullptr, 10);
+        } else if (arg == "--index") {
+            bBuildIndex = true;
+        } else if (arg == "--validate") {
+            gValidate = true;
+        } else if ((arg == "-r") || (arg == "--rx-ring")) {
+            if (!checkArgRequiresValue(arg, i, argc)) return 1;
+            gReceiveRing = static_cast<unsigned int>(abs(atoi(argv[++i])));
+        } else if (arg == "--shm") {
+#ifndef _WIN32
+            if (!checkArgRequiresValue(arg, i, argc)) return 1;
+            strShmInput = argv[++i];
+#else
+            std::cerr << "Error: Shared memory input not supported on this platform" << std::endl;
+            return 1;
+#endif
+        } else if (arg == "--shm-out") {
+#ifndef _WIN32
+            if (!checkArgRequiresValue(arg, i, argc)) return 1;
+            std::string shm = argv[++i];
+            // insert writer mode after the name
+            size_t colon = shm.find(':');
+            strShmOutput = (colon == std::string::npos) ? shm + ":W" : shm.substr(0, colon) + ":W" + shm.substr(colon);
+#else
+            std::cerr << "Error: Shared memory output not supported on this platform" << std::endl;
+            return 1;
+#endif
+        } else if ((arg == "--unix") || (arg == "--unix-out")) {
+#ifndef _WIN32
+            if (!checkArgRequiresValue(arg, i, argc)) return 1;
+            (arg == "--unix" ? strUnixInput : strUnixOutput) = argv[++i];
+#else
+            std::cerr << "Error: Unix domain sockets not supported on this platform" << std::endl;
+            return 1;
+#endif
+        } else if (arg == "--out") {
+            if (!checkArgRequiresValue(arg, i, argc)) return 1;
+            strFileOutput = argv[++i];
+            if (strFileOutput.find(' ') != std::string::npos) {
+                std::cerr << "Error: Output file name shall not contain spaces." << std::endl;
+                return 1;
+            }
+        } else if (arg == "--split") {
+            if (!checkArgRequiresValue(arg, i, argc)) return 1;
+            strSplitOutput = argv[++i];
+            if (strSplitOutput.find(' ') != std::string::npos || strSplitOutput.find('|') != std::string::npos) {
+                std::cerr << "Error: Split file name template shall not contain spaces or '|'." << std::endl;
+                return 1;
+            }
+        } else if (arg == "--split-files") {
+            if (!checkArgRequiresValue(arg, i, argc)) return 1;
+            const int n = atoi(argv[++i]);
+            if (n < 1) {
+                std::cerr << "Error: Number of open split files shall be at least 1." << std::endl;
+                return 1;
+            }
+            nSplitFiles = static_cast<unsigned int>(n);
+        } else if (arg == "--checkpoint") {
+            if (!checkArgRequiresValue(arg, i, argc)) return 1;
+            strCheckpointFile = argv[++i];
+        } else if (arg == "--checkpoint-interval") {
+            if (!checkArgRequiresValue(arg, i, argc)) return 1;
+            const int n = atoi(argv[++i]);
+            if (n < 1) {
+                std::cerr << "Error: Checkpoint interval shall be at least 1 second." << std::endl;
+                return 1;
+            }
+            nCheckpointInterval = static_cast<unsigned int>(n);
+        } else if (arg == "--resume") {
+            bResume = true;
+        } else if (arg == "--tcp-out") {
+#ifndef _WIN32
+            if (!checkArgRequiresValue(arg, i, argc)) return 1;
+            strTcpOutput = argv[++i];
+#else
+            std::cerr << "Error: TCP fan-out output not supported on this platform" << std::endl;
+            return 1;
+#endif
         } else if ((arg == "-z") || (arg == "--zmq") || (arg == "--zeromq")) {
 #ifdef HAVE_ZEROMQ
             if (!checkArgRequiresValue(arg, i, argc)) return 1;
@@ -389,8 +715,30 @@ int main(int argc, const char *argv[]) {
         }
     }
 
+    // build PCAP index files and exit
+    if (bBuildIndex) {
+        if (fileInputs.empty()) {
+            std::cerr << "Error: Option --index requires PCAP input file (-f)." << std::endl;
+            return 1;
+        }
+        for (const std::string &file : fileInputs) {
+            CPcapIndex index;
+            if (!index.Build(file.c_str()) || !index.Save()) {
+                return 1;
+            }
+            index.Print(stdout);
+        }
+        return 0;
+    }
+
     // definitions file
     gAsterixDefinitionsFile = strDefinitions.c_str();
+    if (bDefinitionsCache) {
+        if (strDefinitionsCache.empty()) {
+            strDefinitionsCache = strDefinitions + ".cache";
+        }
+        gDefinitionsCacheFile = strDefinitionsCache.c_str();
+    }
 
     // check for definitions file
     FILE *tmp = fopen(gAsterixDefinitionsFile, "r");
@@ -400,24 +748,108 @@ int main(int argc, const char *argv[]) {
     }
     fclose(tmp);
 
-    // Create input string using helper function
-    std::string strInput = buildInputString(strFileInput, strIPInput, strZMQInput,
-                                            strMQTTInput, strGRPCInput, strDDSInput,
-                                            bLoopFile, strInputFormat);
+    // One input channel per data source, merged when there are several
+    std::vector<std::string> inputs = buildInputList(fileInputs, ipInputs, strShmInput, strUnixInput, strZMQInput,
+                                                     strMQTTInput, strGRPCInput, strDDSInput,
+                                                     bLoopFile, strInputFormat);
+
+    // Checkpoint is supported for conversion of one raw or PCAP file to a file
+    CCheckpoint checkpoint(strCheckpointFile);
+    if (!strCheckpointFile.empty()) {
+        if (fileInputs.size() != 1 || inputs.size() != 1 || bLoopFile || strFileOutput.empty() ||
+            !strSplitOutput.empty() || !strTcpOutput.empty() || !strShmOutput.empty() || !strUnixOutput.empty() ||
+            (strInputFormat.find("RAW") == std::string::npos && strInputFormat.find("PCAP") == std::string::npos)) {
+            std::cerr << "Error: Option --checkpoint requires one raw or PCAP input file (-f) and output file (--out)." << std::endl;
+            return 1;
+        }
+        if (bResume && (gFirstPacket > 0 || gLastPacket > 0 || gStartTime > 0 || gEndTime > 0)) {
+            std::cerr << "Error: Option --resume cannot be used with --start-time, --end-time or --packets." << std::endl;
+            return 1;
+        }
+        const int sts = prepareCheckpoint(checkpoint, bResume, strFileInput, strFileOutput);
+        if (sts != 0) {
+            return sts > 0 ? 1 : 0;
+        }
+    } else if (bResume) {
+        std::cerr << "Error: Option --resume requires --checkpoint." << std::endl;
+        return 1;
+    }
+
+    // Validation walks raw or PCAP input without decoding items and writes only the report
+    if (gValidate) {
+        if (strInputFormat != "ASTERIX_RAW" && strInputFormat != "ASTERIX_PCAP") {
+            std::cerr << "Error: Option --validate requires raw or PCAP input." << std::endl;
+            return 1;
+        }
+        if (strOutputFormat != "ASTERIX_TXT" || !strFileOutput.empty() || !strSplitOutput.empty() ||
+            !strTcpOutput.empty() || !strShmOutput.empty() || !strUnixOutput.empty() || !strCheckpointFile.empty()) {
+            std::cerr << "Error: Option --validate cannot be used with output options." << std::endl;
+            return 1;
+        }
+        gDecodeInput = false;
+    }
+
+    // Create input string(s) using helper functions
+    if (inputs.size() > 1) {
+        if (inputs.size() == fileInputs.size() && !bMergeWindowSet) {
+            nMergeWindow = CInputMerger::WINDOW_UNBOUNDED; // recorded files only, merge in exact time order
+        }
+        if (inputs.size() > CChannelFactory::MAX_INPUT_CHANNELS) {
+            std::cerr << "Error: Too many input sources (maximum is " << CChannelFactory::MAX_INPUT_CHANNELS << ")." << std::endl;
+            return 1;
+        }
+    } else {
+        inputs.assign(1, buildInputString(strFileInput, strIPInput, strShmInput, strUnixInput, strZMQInput,
+                                          strMQTTInput, strGRPCInput, strDDSInput,
+                                          bLoopFile, strInputFormat));
+    }
+
+    // Split output is written as PCAP if input is PCAP, otherwise as raw ASTERIX
+    if (!strSplitOutput.empty()) {
+        if (strOutputFormat == "ASTERIX_TXT") {
+            strOutputFormat = strInputFormat.find("PCAP") != std::string::npos ? "ASTERIX_PCAP" : "ASTERIX_RAW";
+        } else if (strOutputFormat != "ASTERIX_PCAP" && strOutputFormat != "ASTERIX_RAW") {
+            std::cerr << "Error: Option --split can only be used with --write-pcap or --write-raw." << std::endl;
+            return 1;
+        }
+    }
+
+    // Packets only copied to output do not need to be decoded
+    if ((strOutputFormat == "ASTERIX_PCAP" || strOutputFormat == "ASTERIX_RAW") && strFilterFile.empty()) {
+        gDecodeInput = false;
+    }
 
     // Create output string
     std::string strOutput = "std 0 " + strOutputFormat;
+    if (!strShmOutput.empty()) {
+        strOutput = "shm " + strShmOutput + " " + strOutputFormat;
+    } else if (!strUnixOutput.empty()) {
+        strOutput = "unix C:" + strUnixOutput + " " + strOutputFormat;
+    } else if (!strTcpOutput.empty()) {
+        strOutput = "tcpfan " + strTcpOutput + " " + strOutputFormat;
+    } else if (!strSplitOutput.empty()) {
+        strOutput = "split " + strSplitOutput + "|" + std::to_string(nSplitFiles) + " " + strOutputFormat;
+    } else if (!strFileOutput.empty()) {
+        // resumed conversion appends to the output truncated to the checkpoint
+        strOutput = "disk " + strFileOutput + "||" + std::to_string(bResume ? 0 : DD_MODE_WRITENEW) + " " +
+                    strOutputFormat;
+    }
 
-    const char *inputChannel = nullptr;
+    const char *inputChannel[CChannelFactory::MAX_INPUT_CHANNELS];
     const char *outputChannel[CChannelFactory::MAX_OUTPUT_CHANNELS];
     unsigned int chFailover = 0;
-    unsigned int nOutput = 1; // Total number of output channels
+    unsigned int nInput = static_cast<unsigned int>(inputs.size()); // Total number of input channels
+    unsigned int nOutput = gValidate ? 0 : 1; // Total number of output channels
 
-    inputChannel = strInput.c_str();
+    for (unsigned int i = 0; i < nInput; i++) {
+        inputChannel[i] = inputs[i].c_str();
+    }
     outputChannel[0] = strOutput.c_str();
 
     // Print out options
-    LOGDEBUG(inputChannel, "Input channel description: %s\n", inputChannel);
+    for (unsigned int i = 0; i < nInput; i++) {
+        LOGDEBUG(inputChannel[i], "Input channel %d description: %s\n", i + 1, inputChannel[i]);
+    }
 
     for (unsigned int i = 0; i < nOutput; i++) {
         LOGDEBUG(outputChannel[i], "Output channel %d description: %s\n", i + 1, outputChannel[i]);
@@ -426,8 +858,12 @@ int main(int argc, const char *argv[]) {
     gHeartbeat = abs(gHeartbeat); // ignore negative values
     //    LOGDEBUG(1, "Heart-beat: %d\n", gHeartbeat);
 
+    // reload definitions on SIGHUP without stopping inputs
+    CDefinitionReloader::InstallSignalHandler();
+
     // Finally execute converter engine
-    if (CConverterEngine::Instance()->Initialize(inputChannel, outputChannel, nOutput, chFailover)) {
+    if (CConverterEngine::Instance()->Initialize(inputChannel, nInput, outputChannel, nOutput, chFailover,
+                                                 nMergeWindow)) {
         // Process filter file if specified
         if (!strFilterFile.empty()) {
             CBaseFormatDescriptor *desc = CChannelFactory::Instance()->GetInputChannel()->GetFormatDescriptor();
@@ -448,6 +884,9 @@ int main(int argc, const char *argv[]) {
             }
             std::cout << desc->printDescriptor();
         } else {
+            if (!strCheckpointFile.empty()) {
+                CConverterEngine::Instance()->SetCheckpoint(&checkpoint, nCheckpointInterval);
+            }
             CConverterEngine::Instance()->Start();
         }
     } else {
@@ -455,10 +894,12 @@ int main(int argc, const char *argv[]) {
         exit(1);
     }
 
-    CChannelFactory::DeleteInstance();
+    CChannelFactory::DeleteInstance(); // prints validation report
     CConverterEngine::DeleteInstance();
     CDeviceFactory::DeleteInstance();
     Tracer::Delete();
+
+    return (gValidate && gValidationErrors > 0) ? 4 : 0;
 }
 
 
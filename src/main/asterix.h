@@ -77,6 +77,7 @@ typedef unsigned char *PUINT8;
 
 #if _DEBUG_TIMESTAMP
 /* Print timestamp before each message */
+#include <stdint.h>
 #include <time.h>
 
 /* Thread-safe time function compatibility wrappers */
@@ -155,10 +156,22 @@ enum GlobalFormat {
 #define STS_NO_DATA     8  // no more data available
 
 extern const char *gAsterixDefinitionsFile;
+extern const char *gDefinitionsCacheFile;
+extern bool gEagerDefinitions;
 extern bool gVerbose;
 extern bool gTrace;
 extern bool gForceRouting;
 extern int gHeartbeat;
+extern bool gDecodeInput;
+extern int64_t gResumeOffset;
+extern bool gValidate;
+extern uint64_t gValidationErrors;
+extern unsigned int gReceiveRing;
+extern double gReplaySpeed;
+extern double gStartTime;
+extern double gEndTime;
+extern unsigned long gFirstPacket;
+extern unsigned long gLastPacket;
 
 /* Private ASSERT macro */
 #ifdef ASSERT
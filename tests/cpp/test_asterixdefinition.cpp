@@ -10,8 +10,16 @@
  */
 
 #include <gtest/gtest.h>
+#include <cstdio>
+#include <regex>
+#include <string>
+#include <vector>
+#include "AsterixData.h"
 #include "AsterixDefinition.h"
 #include "Category.h"
+#include "InputParser.h"
+#include "XMLParser.h"
+#include "asterixformat.hxx"
 
 /**
  * Test fixture for AsterixDefinition tests
@@ -490,3 +498,75 @@ TEST_F(AsterixDefinitionTest, GetDescriptionWithItemFieldValue) {
     // May return NULL if item not configured in category
     EXPECT_TRUE(desc == nullptr || desc != nullptr);
 }
+
+/**
+ * Test Case: TC-CPP-ADEF-028
+ * Requirement: REQ-HLR-CAT-002
+ * Description: Verify categories are frozen by setCategory unless disabled
+ */
+TEST_F(AsterixDefinitionTest, SetCategoryFreezes) {
+    def->setCategory(createTestCategory(48));
+    EXPECT_TRUE(def->getCategory(48)->m_bFrozen);
+
+    def->setFreezeCategories(false);
+    def->setCategory(createTestCategory(62));
+    EXPECT_FALSE(def->getCategory(62)->m_bFrozen);
+}
+
+/**
+ * Test Case: TC-CPP-ADEF-029
+ * Requirement: REQ-HLR-SYS-001
+ * Description: Verify sample data decodes to the same output with frozen and unfrozen definitions
+ */
+TEST_F(AsterixDefinitionTest, FrozenDefinitionSameOutput) {
+    AsterixDefinition unfrozen;
+    unfrozen.setFreezeCategories(false);
+
+    for (AsterixDefinition *pDefinition : {def, &unfrozen}) {
+        for (const char *file : {"../asterix/config/asterix_bds.xml",
+                                 "../asterix/config/asterix_cat021_2_6.xml",
+                                 "../asterix/config/asterix_cat034_1_29.xml",
+                                 "../asterix/config/asterix_cat048_1_30.xml",
+                                 "../asterix/config/asterix_cat062_1_19.xml",
+                                 "../asterix/config/asterix_cat065_1_5.xml"}) {
+            FILE *f = fopen(file, "r");
+            ASSERT_NE(f, nullptr) << file;
+            XMLParser parser;
+            EXPECT_TRUE(parser.Parse(f, pDefinition, file)) << file;
+            fclose(f);
+        }
+    }
+    ASSERT_TRUE(def->getCategory(62)->m_bFrozen);
+    ASSERT_FALSE(unfrozen.getCategory(62)->m_bFrozen);
+
+    // text output numbers data blocks across all AsterixData
+    const std::regex blockNumber("Data Block [0-9]+");
+    for (const char *file : {"../asterix/sample_data/cat034.raw", "../asterix/sample_data/cat048.raw",
+                             "../asterix/sample_data/cat062cat065.raw", "../asterix/sample_data/cat21_re.ast"}) {
+        std::vector<unsigned char> data;
+        FILE *f = fopen(file, "rb");
+        ASSERT_NE(f, nullptr) << file;
+        unsigned char buffer[4096];
+        size_t len;
+        while ((len = fread(buffer, 1, sizeof(buffer), f)) > 0) {
+            data.insert(data.end(), buffer, buffer + len);
+        }
+        fclose(f);
+
+        for (unsigned int formatType : {CAsterixFormat::ETxt, CAsterixFormat::EJSONE, CAsterixFormat::EXML}) {
+            std::string text[2];
+            AsterixDefinition *definitions[2] = {def, &unfrozen};
+            for (int i = 0; i < 2; i++) {
+                InputParser parser(definitions[i]);
+                parser.setGeneratedDecoders(false);
+                AsterixData *pData = parser.parsePacket(data.data(), static_cast<unsigned int>(data.size()), 0.0);
+                ASSERT_NE(pData, nullptr) << file;
+                pData->getText(text[i], formatType);
+                delete pData;
+                text[i] = std::regex_replace(text[i], blockNumber, "Data Block");
+            }
+            EXPECT_FALSE(text[0].empty()) << file;
+            EXPECT_EQ(text[0], text[1]) << file;
+        }
+    }
+}
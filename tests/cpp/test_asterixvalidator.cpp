@@ -0,0 +1,133 @@
+/**
+ * Unit tests for CAsterixValidator (structure validation of ASTERIX data, --validate)
+ *
+ * Requirements Traceability:
+ * - REQ-HLR-IO-005: Check whether recorded data is well-formed without decoding it
+ * - REQ-LLR-IO-VALID-001: Count blocks, records and item presence per category
+ * - REQ-LLR-IO-VALID-002: Report malformed records and blocks with their position
+ *
+ * DO-278A AL-3 Compliance Testing
+ */
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <vector>
+#include "AsterixDefinition.h"
+#include "DataItemDescription.h"
+#include "XMLParser.h"
+#include "asterixvalidator.hxx"
+
+namespace {
+    // CAT048 data block with one record (sample_data/cat048.raw)
+    const std::vector<unsigned char> block48 = {
+            0x30, 0x00, 0x30, 0xFD, 0xF7, 0x02, 0x19, 0xC9, 0x35, 0x6D, 0x4D, 0xA0, 0xC5, 0xAF, 0xF1, 0xE0,
+            0x02, 0x00, 0x05, 0x28, 0x3C, 0x66, 0x0C, 0x10, 0xC2, 0x36, 0xD4, 0x18, 0x20, 0x01, 0xC0, 0x78,
+            0x00, 0x31, 0xBC, 0x00, 0x00, 0x40, 0x0D, 0xEB, 0x07, 0xB9, 0x58, 0x2E, 0x41, 0x00, 0x20, 0xF5};
+    // CAT001 data block (category not loaded)
+    const std::vector<unsigned char> block01 = {0x01, 0x00, 0x05, 0x80, 0x01};
+
+    class AsterixValidatorTest : public ::testing::Test {
+    protected:
+        AsterixDefinition definition;
+
+        void SetUp() override {
+            ASSERT_TRUE(load("../asterix/config/asterix_bds.xml"));
+            ASSERT_TRUE(load("../asterix/config/asterix_cat048_1_30.xml"));
+        }
+
+        bool load(const char *filename) {
+            FILE *f = fopen(filename, "r");
+            if (f == nullptr) {
+                return false;
+            }
+            XMLParser parser;
+            const bool ok = parser.Parse(f, &definition, filename);
+            fclose(f);
+            return ok;
+        }
+
+        uint64_t presence(const CAsterixValidator &validator, int cat, const char *id) {
+            for (const auto &item : validator.GetCategory(cat).items) {
+                if (item.pDescription->m_strID == id) {
+                    return item.nPresent;
+                }
+            }
+            return 0;
+        }
+    };
+
+    std::vector<unsigned char> concat(std::initializer_list<std::vector<unsigned char>> blocks) {
+        std::vector<unsigned char> result;
+        for (const auto &block : blocks) {
+            result.insert(result.end(), block.begin(), block.end());
+        }
+        return result;
+    }
+}
+
+/**
+ * Test Case: TC-CPP-VALID-001
+ * Requirement: REQ-LLR-IO-VALID-001
+ * Description: Well-formed blocks are counted per category with item presence
+ */
+TEST_F(AsterixValidatorTest, CountsRecordsAndItems) {
+    CAsterixValidator validator(&definition);
+    EXPECT_EQ(validator.Validate(block48.data(), block48.size()), 0u);
+    const std::vector<unsigned char> data = concat({block48, block01, block48});
+    EXPECT_EQ(validator.Validate(data.data(), data.size()), 0u);
+
+    EXPECT_EQ(validator.GetNPackets(), 2u);
+    EXPECT_EQ(validator.GetNMalformed(), 0u);
+    EXPECT_EQ(validator.GetCategory(48).nBlocks, 3u);
+    EXPECT_EQ(validator.GetCategory(48).nRecords, 3u);
+    EXPECT_EQ(validator.GetCategory(48).nBytes, 3 * block48.size());
+    EXPECT_EQ(presence(validator, 48, "010"), 3u);
+    EXPECT_EQ(presence(validator, 48, "250"), 3u);
+    EXPECT_EQ(presence(validator, 48, "130"), 0u);
+
+    // undefined category is counted but not validated
+    EXPECT_EQ(validator.GetCategory(1).nBlocks, 1u);
+    EXPECT_EQ(validator.GetCategory(1).nRecords, 0u);
+}
+
+/**
+ * Test Case: TC-CPP-VALID-002
+ * Requirement: REQ-LLR-IO-VALID-002
+ * Description: Record with item exceeding the block is reported with its offset
+ */
+TEST_F(AsterixValidatorTest, MalformedRecord) {
+    CAsterixValidator validator(&definition);
+    std::vector<unsigned char> data = concat({block01, block48});
+    data[block01.size() + 2] = 0x20; // block length 32, record is cut inside I250
+    data.resize(block01.size() + 0x20);
+
+    EXPECT_EQ(validator.Validate(data.data(), data.size(), 7), 1u);
+    validator.SetInputOffset(1000);
+
+    ASSERT_EQ(validator.GetErrors().size(), 1u);
+    const auto &error = validator.GetErrors()[0];
+    EXPECT_EQ(error.packet, 7u);
+    EXPECT_EQ(error.category, 48);
+    EXPECT_EQ(error.packetOffset, block01.size() + 3);
+    EXPECT_EQ(error.inputOffset, static_cast<int64_t>(1000 + block01.size() + 3));
+    EXPECT_EQ(validator.GetCategory(48).nMalformed, 1u);
+    EXPECT_EQ(validator.GetCategory(48).nRecords, 0u);
+}
+
+/**
+ * Test Case: TC-CPP-VALID-003
+ * Requirement: REQ-LLR-IO-VALID-002
+ * Description: Wrong block length ends validation of the packet
+ */
+TEST_F(AsterixValidatorTest, MalformedBlock) {
+    CAsterixValidator validator(&definition);
+    std::vector<unsigned char> data = concat({block48, block48});
+    data[block48.size() + 2] = 0x02;
+
+    EXPECT_EQ(validator.Validate(data.data(), data.size()), 1u);
+    EXPECT_EQ(validator.GetCategory(48).nBlocks, 1u);
+    EXPECT_EQ(validator.GetCategory(48).nRecords, 1u);
+    ASSERT_EQ(validator.GetErrors().size(), 1u);
+    EXPECT_EQ(validator.GetErrors()[0].packetOffset, block48.size());
+    EXPECT_EQ(validator.GetErrors()[0].inputOffset, -1);
+}
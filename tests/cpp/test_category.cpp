@@ -12,6 +12,7 @@
 #include "Category.h"
 #include "DataItemDescription.h"
 #include "UAP.h"
+#include "UAPItem.h"
 
 /**
  * Test Case: TC-CPP-CAT-001
@@ -1053,6 +1054,87 @@ TEST(CategoryTest, CategoryFilteredFlagPersists) {
     EXPECT_TRUE(cat.m_bFiltered);
 }
 
+/**
+ * Test Case: TC-CPP-CAT-053
+ * Requirement: REQ-HLR-SYS-001
+ * Description: Verify findDataItemDescription does not create missing items
+ */
+TEST(CategoryTest, FindDataItemDescriptionDoesNotCreate) {
+    Category cat(48);
+
+    DataItemDescription* item = cat.getDataItemDescription("010");
+    ASSERT_NE(item, nullptr);
+
+    EXPECT_EQ(cat.findDataItemDescription("010"), item);
+    EXPECT_EQ(cat.findDataItemDescription("020"), nullptr);
+    EXPECT_EQ(cat.m_lDataItems.size(), 1u);
+}
+
+/**
+ * Test Case: TC-CPP-CAT-054
+ * Requirement: REQ-HLR-UAP-001
+ * Description: Verify frozen category resolves FRN to item description as unfrozen one
+ */
+TEST(CategoryTest, FreezeResolvesFRN) {
+    Category cat(48);
+    DataItemDescription* item010 = cat.getDataItemDescription("010");
+    DataItemDescription* item020 = cat.getDataItemDescription("020");
+
+    UAP* uap = cat.newUAP();
+    UAPItem* ui1 = uap->newUAPItem();
+    ui1->m_nFRN = 1;
+    ui1->m_strItemID = "010";
+    UAPItem* ui3 = uap->newUAPItem();
+    ui3->m_nFRN = 3;
+    ui3->m_strItemID = "020";
+    UAPItem* ui4 = uap->newUAPItem();
+    ui4->m_nFRN = 4;
+    ui4->m_strItemID = "999";
+
+    EXPECT_FALSE(cat.m_bFrozen);
+    EXPECT_EQ(cat.findDataItemDescription(uap, 1), item010);
+    EXPECT_EQ(cat.findDataItemDescription(uap, 2), nullptr);
+
+    cat.freeze();
+    EXPECT_TRUE(cat.m_bFrozen);
+    ASSERT_EQ(cat.m_vUAPs.size(), 1u);
+    EXPECT_EQ(cat.m_vUAPs[0], uap);
+    EXPECT_EQ(cat.findDataItemDescription(uap, 1), item010);
+    EXPECT_EQ(cat.findDataItemDescription(uap, 2), nullptr);
+    EXPECT_EQ(cat.findDataItemDescription(uap, 3), item020);
+    EXPECT_EQ(cat.findDataItemDescription(uap, 4), nullptr);
+    EXPECT_EQ(cat.findDataItemDescription(uap, 5), nullptr);
+    EXPECT_EQ(cat.findDataItemDescription(uap, 0), nullptr);
+
+    unsigned char data[] = {0x80};
+    EXPECT_EQ(cat.getUAP(data, 1), uap);
+}
+
+/**
+ * Test Case: TC-CPP-CAT-055
+ * Requirement: REQ-HLR-UAP-001
+ * Description: Verify changing a frozen category unfreezes it
+ */
+TEST(CategoryTest, ChangeUnfreezes) {
+    Category cat(48);
+    UAP* uap = cat.newUAP();
+    UAPItem* ui = uap->newUAPItem();
+    ui->m_nFRN = 1;
+    ui->m_strItemID = "010";
+
+    cat.freeze();
+    EXPECT_EQ(cat.findDataItemDescription(uap, 1), nullptr);
+
+    DataItemDescription* item010 = cat.getDataItemDescription("010");
+    EXPECT_FALSE(cat.m_bFrozen);
+    EXPECT_EQ(cat.findDataItemDescription(uap, 1), item010);
+
+    cat.freeze();
+    UAP* uap2 = cat.newUAP();
+    EXPECT_FALSE(cat.m_bFrozen);
+    EXPECT_NE(uap2, nullptr);
+}
+
 // Main function for running tests
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
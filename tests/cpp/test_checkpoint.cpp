@@ -0,0 +1,290 @@
+/**
+ * Unit tests for checkpointed file conversion (CCheckpoint, --checkpoint and --resume)
+ *
+ * Requirements Traceability:
+ * - REQ-HLR-IO-008: Resume an interrupted file conversion without losing or repeating packets
+ * - REQ-LLR-IO-CKP-001: A checkpoint is saved and loaded with all its fields
+ * - REQ-LLR-IO-CKP-002: Missing, incomplete or invalid checkpoint files are rejected
+ * - REQ-LLR-IO-CKP-003: A killed raw conversion resumed from its checkpoint gives the output of an uninterrupted one
+ * - REQ-LLR-IO-CKP-004: A killed PCAP conversion resumed from its checkpoint gives the output of an uninterrupted one
+ *
+ * DO-278A AL-3 Compliance Testing
+ */
+
+#include <gtest/gtest.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+#include "checkpoint.hxx"
+#include "converterengine.hxx"
+#include "test_helpers.h"
+
+extern const char *gAsterixDefinitionsFile;
+extern bool gDecodeInput;
+
+namespace {
+    using testutil::readFile;
+
+    const char *const DEFINITIONS = "../asterix/config/asterix.ini";
+
+    bool writeFile(const std::string &file, const std::vector<unsigned char> &data) {
+        FILE *f = fopen(file.c_str(), "wb");
+        if (f == nullptr) {
+            return false;
+        }
+        const bool ok = fwrite(data.data(), 1, data.size(), f) == data.size();
+        return fclose(f) == 0 && ok;
+    }
+
+    // Input large enough for several checkpoints (one every 256 packets): header, then records repeated
+    std::vector<unsigned char> repeat(const char *file, size_t headerLen, unsigned int n) {
+        const std::vector<unsigned char> data = readFile(file);
+        std::vector<unsigned char> result(data.begin(), data.begin() + headerLen);
+        for (unsigned int i = 0; i < n; i++) {
+            result.insert(result.end(), data.begin() + headerLen, data.end());
+        }
+        return result;
+    }
+
+    // Convert input to output in a child process with checkpoint after every 256 packets.
+    // The child is killed (SIGXFSZ) when the output grows over limit. Returns wait status.
+    int convertKilled(const std::string &input, const std::string &output, const std::string &format,
+                      const std::string &checkpointFile, size_t limit) {
+        const pid_t pid = fork();
+        if (pid != 0) {
+            int status = 0;
+            waitpid(pid, &status, 0);
+            return status;
+        }
+
+        struct rlimit fileLimit = {limit, limit};
+        struct rlimit coreLimit = {0, 0};
+        setrlimit(RLIMIT_FSIZE, &fileLimit);
+        setrlimit(RLIMIT_CORE, &coreLimit);
+        signal(SIGXFSZ, SIG_DFL);
+
+        gAsterixDefinitionsFile = DEFINITIONS;
+        gDecodeInput = false;
+
+        CCheckpoint checkpoint(checkpointFile);
+        checkpoint.input = input;
+        checkpoint.inputSize = readFile(input.c_str()).size();
+        checkpoint.output = output;
+        if (!checkpoint.Save()) {
+            _exit(1);
+        }
+
+        const std::string inputChannel = "disk;" + input + "|0|1;" + format;
+        const std::string outputChannel = "disk " + output + "||2 " + format;
+        const char *inputs[] = {inputChannel.c_str()};
+        const char *outputs[] = {outputChannel.c_str()};
+        if (!CConverterEngine::Instance()->Initialize(inputs, 1, outputs, 1, 0)) {
+            _exit(1);
+        }
+        CConverterEngine::Instance()->SetCheckpoint(&checkpoint, 0);
+        CConverterEngine::Instance()->Start();
+        _exit(0);
+    }
+
+    // Run the command line converter, returns its exit code
+    int runAsterix(std::vector<std::string> args) {
+#ifdef ASTERIX_EXE
+        args.insert(args.begin(), {ASTERIX_EXE, "-d", DEFINITIONS});
+        std::vector<char *> argv;
+        for (std::string &arg : args) {
+            argv.push_back(&arg[0]);
+        }
+        argv.push_back(nullptr);
+
+        const pid_t pid = fork();
+        if (pid == 0) {
+            const int null = open("/dev/null", O_WRONLY);
+            dup2(null, STDOUT_FILENO);
+            dup2(null, STDERR_FILENO);
+            execv(argv[0], argv.data());
+            _exit(127);
+        }
+        int status = 0;
+        waitpid(pid, &status, 0);
+        return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+#else
+        (void) args;
+        return -1;
+#endif
+    }
+
+    class CheckpointTest : public ::testing::Test {
+    protected:
+        // tests may run in parallel in the same directory
+        std::string checkpointFile;
+
+        void SetUp() override {
+            checkpointFile = std::string("test_checkpoint_") +
+                             ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".ckp";
+        }
+
+        void TearDown() override {
+            remove(checkpointFile.c_str());
+        }
+
+        // Interrupt conversion of input, resume it with the command line converter and
+        // compare with an uninterrupted conversion
+        void killAndResume(const std::string &input, const std::string &format, const std::string &inputOption,
+                           const std::string &outputOption) {
+#ifndef ASTERIX_EXE
+            GTEST_SKIP() << "built without command line converter";
+#endif
+            const std::string output = input + ".out";
+            const std::string reference = input + ".ref";
+            const size_t inputSize = readFile(input.c_str()).size();
+
+            std::vector<std::string> args = {"-f", input, outputOption, "--out", reference};
+            if (!inputOption.empty()) {
+                args.insert(args.begin(), inputOption);
+            }
+            ASSERT_EQ(runAsterix(args), 0);
+            const std::vector<unsigned char> expected = readFile(reference.c_str());
+            ASSERT_GT(expected.size(), inputSize / 2);
+
+            const int status = convertKilled(input, output, format, checkpointFile, inputSize / 2);
+            ASSERT_TRUE(WIFSIGNALED(status));
+            EXPECT_EQ(WTERMSIG(status), SIGXFSZ);
+
+            CCheckpoint killed(checkpointFile);
+            ASSERT_TRUE(killed.Load());
+            EXPECT_FALSE(killed.complete);
+            EXPECT_EQ(killed.inputSize, inputSize);
+            EXPECT_GT(killed.packets, 0u);
+            EXPECT_EQ(killed.packets % 256, 0u);
+            EXPECT_GT(killed.inputOffset, 0);
+            EXPECT_LT(killed.inputOffset, static_cast<int64_t>(inputSize));
+            EXPECT_GT(killed.outputOffset, 0);
+            EXPECT_GE(readFile(output.c_str()).size(), static_cast<size_t>(killed.outputOffset));
+
+            args[args.size() - 1] = output;
+            args.insert(args.end(), {"--checkpoint", checkpointFile, "--resume"});
+            ASSERT_EQ(runAsterix(args), 0);
+            EXPECT_EQ(readFile(output.c_str()), expected);
+
+            CCheckpoint resumed(checkpointFile);
+            ASSERT_TRUE(resumed.Load());
+            EXPECT_TRUE(resumed.complete);
+            EXPECT_EQ(resumed.outputOffset, static_cast<int64_t>(expected.size()));
+
+            // a complete conversion is not repeated
+            ASSERT_EQ(runAsterix(args), 0);
+            EXPECT_EQ(readFile(output.c_str()), expected);
+
+            remove(output.c_str());
+            remove(reference.c_str());
+        }
+    };
+}
+
+/**
+ * Test Case: TC-CPP-CKP-001
+ * Requirement: REQ-LLR-IO-CKP-001
+ * Description: Verify a saved checkpoint is loaded with the same values and no temporary file is left
+ */
+TEST_F(CheckpointTest, SaveLoad) {
+    CCheckpoint checkpoint(checkpointFile);
+    checkpoint.input = "day.pcap";
+    checkpoint.inputSize = 5000000000ULL;
+    checkpoint.inputOffset = 4000000000LL;
+    checkpoint.packets = 123456;
+    checkpoint.output = "out dir/sensor.pcap";
+    checkpoint.outputOffset = 3000000000LL;
+    ASSERT_TRUE(checkpoint.Save());
+    EXPECT_EQ(fopen((checkpointFile + ".tmp").c_str(), "r"), nullptr);
+
+    CCheckpoint loaded(checkpointFile);
+    ASSERT_TRUE(loaded.Load());
+    EXPECT_EQ(loaded.input, checkpoint.input);
+    EXPECT_EQ(loaded.inputSize, checkpoint.inputSize);
+    EXPECT_EQ(loaded.inputOffset, checkpoint.inputOffset);
+    EXPECT_EQ(loaded.packets, checkpoint.packets);
+    EXPECT_EQ(loaded.output, checkpoint.output);
+    EXPECT_EQ(loaded.outputOffset, checkpoint.outputOffset);
+    EXPECT_FALSE(loaded.complete);
+
+    checkpoint.complete = true;
+    ASSERT_TRUE(checkpoint.Save());
+    CCheckpoint complete(checkpointFile);
+    ASSERT_TRUE(complete.Load());
+    EXPECT_TRUE(complete.complete);
+}
+
+/**
+ * Test Case: TC-CPP-CKP-002
+ * Requirement: REQ-LLR-IO-CKP-002
+ * Description: Verify missing, partially written and invalid checkpoint files are rejected
+ */
+TEST_F(CheckpointTest, RejectInvalid) {
+    CCheckpoint missing("test_checkpoint_missing.ckp");
+    EXPECT_FALSE(missing.Load());
+
+    CCheckpoint checkpoint(checkpointFile);
+    checkpoint.input = "in.raw";
+    checkpoint.inputSize = 1000;
+    checkpoint.inputOffset = 500;
+    checkpoint.output = "out.raw";
+    checkpoint.outputOffset = 400;
+    ASSERT_TRUE(checkpoint.Save());
+    const std::vector<unsigned char> saved = readFile(checkpointFile.c_str());
+    ASSERT_FALSE(saved.empty());
+
+    // file cut at any position
+    for (size_t len = 0; len < saved.size(); len++) {
+        ASSERT_TRUE(writeFile(checkpointFile, std::vector<unsigned char>(saved.begin(), saved.begin() + len)));
+        CCheckpoint partial(checkpointFile);
+        EXPECT_FALSE(partial.Load()) << len;
+    }
+
+    const std::string text(saved.begin(), saved.end());
+    for (const auto &change : std::vector<std::pair<std::string, std::string>>{{"input=in.raw", "input="},
+                                                                               {"input_offset=500", "input_offset=-1"},
+                                                                               {"output=out.raw\n", ""},
+                                                                               {"output_offset=400", "output_offset=-1"},
+                                                                               {"complete=0\n", ""}}) {
+        std::string invalid = text;
+        invalid.replace(invalid.find(change.first), change.first.size(), change.second);
+        ASSERT_TRUE(writeFile(checkpointFile, std::vector<unsigned char>(invalid.begin(), invalid.end())));
+        CCheckpoint loaded(checkpointFile);
+        EXPECT_FALSE(loaded.Load()) << invalid;
+    }
+
+    ASSERT_TRUE(writeFile(checkpointFile, saved));
+    EXPECT_TRUE(checkpoint.Load());
+}
+
+/**
+ * Test Case: TC-CPP-CKP-003
+ * Requirement: REQ-LLR-IO-CKP-003
+ * Description: Verify a raw conversion killed while writing and resumed from its last
+ *              checkpoint gives output byte-identical to an uninterrupted conversion
+ */
+TEST_F(CheckpointTest, ResumeRaw) {
+    const std::string input = "test_checkpoint_in.raw";
+    ASSERT_TRUE(writeFile(input, repeat("../asterix/sample_data/cat048.raw", 0, 3000)));
+    killAndResume(input, "ASTERIX_RAW", "", "--write-raw");
+    remove(input.c_str());
+}
+
+/**
+ * Test Case: TC-CPP-CKP-004
+ * Requirement: REQ-LLR-IO-CKP-004
+ * Description: Verify a PCAP conversion killed while writing and resumed from its last
+ *              checkpoint gives output byte-identical to an uninterrupted conversion
+ */
+TEST_F(CheckpointTest, ResumePcap) {
+    const std::string input = "test_checkpoint_in.pcap";
+    ASSERT_TRUE(writeFile(input, repeat("../asterix/sample_data/cat_034_048.pcap", 24, 40)));
+    killAndResume(input, "ASTERIX_PCAP", "-P", "--write-pcap");
+    remove(input.c_str());
+}
@@ -7,6 +7,7 @@
  * 1. Constructor - lines 31-66 (parsing records from data block)
  * 2. Destructor - lines 68-75 (cleanup of DataRecords)
  * 3. getText() - lines 77-112 (all output formats)
+ * 4. getBinary() - binary output of records passing the filter
  *
  * ASTERIX DataBlock Format:
  * - Category (1 byte) - ASTERIX category number
@@ -548,3 +549,87 @@ TEST_F(DataBlockTest, GetTextWithMultipleRecords) {
     // Should contain category header
     EXPECT_NE(result.find("Category: 48"), std::string::npos);
 }
+
+/**
+ * Test Case: TC-CPP-BLOCK-021
+ * Test getBinary without filtering writes the block as received
+ */
+TEST_F(DataBlockTest, GetBinaryUnfiltered) {
+    pCategory = createTestCategory(48);
+    addDataItem(pCategory, "010", 2);
+    addDataItem(pCategory, "020", 1);
+    addUAPItem(pUAP, 1, "010");
+    addUAPItem(pUAP, 2, "020");
+
+    unsigned char data[] = {
+        0xC0, 0x11, 0x22, 0x01,
+        0x80, 0x33, 0x44
+    };
+    DataBlock block(pCategory, sizeof(data), data, 0.0);
+
+    std::vector<unsigned char> result = {0xAA};
+    EXPECT_TRUE(block.getBinary(result));
+
+    const unsigned char expected[] = {0xAA, 48, 0x00, 0x0A, 0xC0, 0x11, 0x22, 0x01, 0x80, 0x33, 0x44};
+    ASSERT_EQ(result.size(), sizeof(expected));
+    EXPECT_EQ(memcmp(result.data(), expected, sizeof(expected)), 0);
+}
+
+/**
+ * Test Case: TC-CPP-BLOCK-022
+ * Test getBinary with filtering keeps only records containing filtered items
+ */
+TEST_F(DataBlockTest, GetBinaryFilteredRecords) {
+    pCategory = createTestCategory(48);
+    addDataItem(pCategory, "010", 2);
+    DataItemDescription* desc020 = addDataItem(pCategory, "020", 1);
+    addUAPItem(pUAP, 1, "010");
+    addUAPItem(pUAP, 2, "020");
+
+    EXPECT_TRUE(pCategory->filterOutItem("020", "VALUE"));
+    EXPECT_TRUE(desc020->m_bFiltered);
+    EXPECT_FALSE(pCategory->getDataItemDescription("010")->m_bFiltered);
+
+    gFiltering = true;
+    unsigned char data[] = {
+        0x80, 0x11, 0x22,
+        0xC0, 0x33, 0x44, 0x02,
+        0x80, 0x55, 0x66
+    };
+    DataBlock block(pCategory, sizeof(data), data, 0.0);
+
+    std::vector<unsigned char> result;
+    EXPECT_TRUE(block.getBinary(result));
+
+    const unsigned char expected[] = {48, 0x00, 0x07, 0xC0, 0x33, 0x44, 0x02};
+    ASSERT_EQ(result.size(), sizeof(expected));
+    EXPECT_EQ(memcmp(result.data(), expected, sizeof(expected)), 0);
+}
+
+/**
+ * Test Case: TC-CPP-BLOCK-023
+ * Test getBinary writes nothing when category or all records are filtered out
+ */
+TEST_F(DataBlockTest, GetBinaryNothingPasses) {
+    pCategory = createTestCategory(48);
+    addDataItem(pCategory, "010", 2);
+    addDataItem(pCategory, "020", 1);
+    addUAPItem(pUAP, 1, "010");
+    addUAPItem(pUAP, 2, "020");
+
+    gFiltering = true;
+    unsigned char data[] = {0x80, 0x11, 0x22};
+    std::vector<unsigned char> result;
+
+    // Category not in filter
+    DataBlock notFiltered(pCategory, sizeof(data), data, 0.0);
+    EXPECT_FALSE(notFiltered.getBinary(result));
+    EXPECT_TRUE(result.empty());
+
+    // Category in filter, but the record does not contain the filtered item
+    EXPECT_TRUE(pCategory->filterOutItem("020", "VALUE"));
+    DataBlock noRecord(pCategory, sizeof(data), data, 0.0);
+    EXPECT_EQ(noRecord.m_lDataRecords.size(), 1);
+    EXPECT_FALSE(noRecord.getBinary(result));
+    EXPECT_TRUE(result.empty());
+}
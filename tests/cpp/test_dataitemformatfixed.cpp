@@ -26,6 +26,7 @@
  */
 
 #include <gtest/gtest.h>
+#include <vector>
 #include "../../src/asterix/DataItemFormatFixed.h"
 #include "../../src/asterix/DataItemBits.h"
 #include "../../src/asterix/Tracer.h"
@@ -882,6 +883,85 @@ TEST_F(DataItemFormatFixedTest, GetTextJSONTrailingCommaRemoval) {
     delete format;
 }
 
+/**
+ * Test Case: TC-CPP-FIXED-036
+ * Requirement: REQ-LLR-FIXED-004
+ *
+ * Test frozen FX and presence masks give same results as walking the bits
+ */
+TEST_F(DataItemFormatFixedTest, FreezeMasksMatchBits) {
+    DataItemFormatFixed format(13);
+    format.m_nLength = 2;
+
+    DataItemBits* present1 = new DataItemBits(1);
+    present1->m_nFrom = 16;
+    present1->m_nTo = 16;
+    present1->m_nPresenceOfField = 1;
+    format.m_lSubItems.push_back(present1);
+
+    DataItemBits* present2 = new DataItemBits(2);
+    present2->m_nFrom = 10;
+    present2->m_nTo = 10;
+    present2->m_nPresenceOfField = 2;
+    format.m_lSubItems.push_back(present2);
+
+    // second bit for part 1 is ignored, first definition wins
+    DataItemBits* duplicate = new DataItemBits(3);
+    duplicate->m_nFrom = 2;
+    duplicate->m_nTo = 2;
+    duplicate->m_nPresenceOfField = 1;
+    format.m_lSubItems.push_back(duplicate);
+
+    DataItemBits* fx = new DataItemBits(4);
+    fx->m_nFrom = 1;
+    fx->m_nTo = 1;
+    fx->m_bExtension = true;
+    format.m_lSubItems.push_back(fx);
+
+    std::vector<std::vector<bool>> expected;
+    for (unsigned int value = 0; value < 0x10000; value += 0x0101) {
+        unsigned char data[] = {static_cast<unsigned char>(value >> 8), static_cast<unsigned char>(value ^ 0x03)};
+        expected.push_back({format.isLastPart(data), format.isSecondaryPartPresent(data, 1),
+                            format.isSecondaryPartPresent(data, 2), format.isSecondaryPartPresent(data, 3)});
+    }
+
+    format.freeze();
+    EXPECT_TRUE(format.m_bFrozen);
+    ASSERT_EQ(format.m_vSubItems.size(), 4u);
+    EXPECT_EQ(format.m_vSubItems[3], fx);
+
+    size_t i = 0;
+    for (unsigned int value = 0; value < 0x10000; value += 0x0101, i++) {
+        unsigned char data[] = {static_cast<unsigned char>(value >> 8), static_cast<unsigned char>(value ^ 0x03)};
+        EXPECT_EQ(format.isLastPart(data), expected[i][0]);
+        EXPECT_EQ(format.isSecondaryPartPresent(data, 1), expected[i][1]);
+        EXPECT_EQ(format.isSecondaryPartPresent(data, 2), expected[i][2]);
+        EXPECT_EQ(format.isSecondaryPartPresent(data, 3), expected[i][3]);
+    }
+}
+
+/**
+ * Test Case: TC-CPP-FIXED-037
+ * Requirement: REQ-LLR-FIXED-004
+ *
+ * Test frozen format with FX bit outside of its length is still the last part
+ */
+TEST_F(DataItemFormatFixedTest, FreezeInvalidExtensionBit) {
+    DataItemFormatFixed format(14);
+    format.m_nLength = 1;
+
+    DataItemBits* fx = new DataItemBits(1);
+    fx->m_nFrom = 9;
+    fx->m_nTo = 9;
+    fx->m_bExtension = true;
+    format.m_lSubItems.push_back(fx);
+
+    format.freeze();
+
+    unsigned char data[] = {0xFF, 0xFF};
+    EXPECT_TRUE(format.isLastPart(data));
+}
+
 // Run all tests
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
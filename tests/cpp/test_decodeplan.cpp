@@ -0,0 +1,211 @@
+/**
+ * Unit tests for DecodePlanCache (decode plans of data records memoized by FSPEC)
+ *
+ * Requirements Traceability:
+ * - REQ-HLR-PERF-002: Resolve UAP and items once per FSPEC pattern of a feed
+ * - REQ-LLR-PERF-PLAN-001: Plan holds UAP, item descriptions and leading fixed item offsets
+ * - REQ-LLR-PERF-PLAN-002: Records decode the same with and without plans
+ *
+ * DO-278A AL-3 Compliance Testing
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "AsterixDefinition.h"
+#include "DataItemDescription.h"
+#include "DecodePlan.h"
+#include "InputParser.h"
+#include "UAPItem.h"
+#include "asterixformat.hxx"
+#include "test_helpers.h"
+
+namespace {
+    using testutil::readFile;
+
+    class DecodePlanTest : public ::testing::Test {
+    protected:
+        AsterixDefinition definition;
+
+        void SetUp() override {
+            ASSERT_TRUE(testutil::parseFiles(definition, {"../asterix/config/asterix_bds.xml",
+                                                          "../asterix/config/asterix_cat021_2_6.xml",
+                                                          "../asterix/config/asterix_cat034_1_29.xml",
+                                                          "../asterix/config/asterix_cat048_1_30.xml",
+                                                          "../asterix/config/asterix_cat062_1_19.xml",
+                                                          "../asterix/config/asterix_cat065_1_5.xml"}));
+        }
+
+        std::string decode(bool bPlans, bool bGenerated, const std::vector<unsigned char> &data,
+                           unsigned int formatType) {
+            InputParser parser(&definition);
+            parser.setDecodePlans(bPlans);
+            parser.setGeneratedDecoders(bGenerated);
+            return testutil::getText(parser, data, formatType);
+        }
+    };
+}
+
+/**
+ * Test Case: TC-CPP-PLAN-001
+ * Requirement: REQ-LLR-PERF-PLAN-001
+ * Description: Verify plan resolves UAP, items and offsets of leading fixed items
+ */
+TEST_F(DecodePlanTest, PlanResolvesItems) {
+    Category *pCategory = definition.getCategory(48);
+    ASSERT_TRUE(pCategory->m_bFrozen);
+    DecodePlanCache cache(pCategory);
+
+    // FRN 1-4: I048/010 (2 bytes), I048/140 (3 bytes), I048/020 (variable), I048/040
+    const unsigned char record[] = {0xF0, 0x01, 0x02, 0x00, 0x00, 0x01, 0x20, 0x00, 0x01, 0x00, 0x01};
+    const DecodePlan *pPlan = cache.find(record, sizeof(record));
+    ASSERT_NE(pPlan, nullptr);
+    EXPECT_EQ(pPlan->m_pUAP, pCategory->m_vUAPs[0]);
+    EXPECT_EQ(pPlan->m_nFSPECLength, 1u);
+    ASSERT_EQ(pPlan->m_vItems.size(), 4u);
+    EXPECT_EQ(pPlan->m_vItems[0]->m_strID, "010");
+    EXPECT_EQ(pPlan->m_vItems[1]->m_strID, "140");
+    EXPECT_EQ(pPlan->m_vItems[2]->m_strID, "020");
+    EXPECT_EQ(pPlan->m_vItems[3]->m_strID, "040");
+    EXPECT_EQ(pPlan->m_vFRNs, (std::vector<int>{1, 2, 3, 4}));
+    EXPECT_EQ(pPlan->m_vFixedOffsets, (std::vector<long>{0, 2, 5}));
+    EXPECT_EQ(pPlan->getNFixedItems(), 2u);
+
+    // same FSPEC reuses the plan
+    EXPECT_EQ(cache.find(record, sizeof(record)), pPlan);
+    EXPECT_EQ(cache.size(), 1u);
+}
+
+/**
+ * Test Case: TC-CPP-PLAN-002
+ * Requirement: REQ-LLR-PERF-PLAN-001
+ * Description: Verify plans are keyed by the FSPEC bytes and unplannable FSPECs are rejected
+ */
+TEST_F(DecodePlanTest, PlanKeyedByFSPEC) {
+    DecodePlanCache cache(definition.getCategory(48));
+
+    const unsigned char oneByte[] = {0x80, 0x01, 0x02};
+    const unsigned char twoBytes[] = {0x81, 0x80, 0x01, 0x02, 0x00};
+    const DecodePlan *pPlan = cache.find(oneByte, sizeof(oneByte));
+    ASSERT_NE(pPlan, nullptr);
+    EXPECT_EQ(pPlan->m_nFSPECLength, 1u);
+    EXPECT_EQ(pPlan->m_vFRNs, (std::vector<int>{1}));
+
+    pPlan = cache.find(twoBytes, sizeof(twoBytes));
+    ASSERT_NE(pPlan, nullptr);
+    EXPECT_EQ(pPlan->m_nFSPECLength, 2u);
+    EXPECT_EQ(pPlan->m_vFRNs, (std::vector<int>{1, 8}));
+    EXPECT_EQ(cache.size(), 2u);
+
+    // FSPEC not terminated within data
+    const unsigned char truncated[] = {0x81, 0x81};
+    EXPECT_EQ(cache.find(truncated, sizeof(truncated)), nullptr);
+
+    // FSPEC longer than cached
+    std::vector<unsigned char> longFSPEC(DecodePlanCache::MAX_FSPEC_LENGTH, 0x01);
+    longFSPEC.push_back(0x00);
+    EXPECT_EQ(cache.find(longFSPEC.data(), longFSPEC.size()), nullptr);
+    EXPECT_EQ(cache.size(), 2u);
+}
+
+/**
+ * Test Case: TC-CPP-PLAN-003
+ * Requirement: REQ-LLR-PERF-PLAN-001
+ * Description: Verify conditional UAPs get a plan each for the same FSPEC
+ */
+TEST(DecodePlanCacheTest, ConditionalUAP) {
+    Category cat(1);
+    DataItemDescription *item010 = cat.getDataItemDescription("010");
+    DataItemDescription *item020 = cat.getDataItemDescription("020");
+
+    UAP *uapSet = cat.newUAP();
+    uapSet->m_nUseIfBitSet = 1;
+    UAPItem *ui = uapSet->newUAPItem();
+    ui->m_nFRN = 1;
+    ui->m_strItemID = "010";
+
+    UAP *uapDefault = cat.newUAP();
+    ui = uapDefault->newUAPItem();
+    ui->m_nFRN = 1;
+    ui->m_strItemID = "020";
+
+    cat.freeze();
+    DecodePlanCache cache(&cat);
+
+    const unsigned char set[] = {0x80, 0x80};
+    const unsigned char notSet[] = {0x80, 0x00};
+    const DecodePlan *pPlan = cache.find(set, sizeof(set));
+    ASSERT_NE(pPlan, nullptr);
+    EXPECT_EQ(pPlan->m_pUAP, uapSet);
+    ASSERT_EQ(pPlan->m_vItems.size(), 1u);
+    EXPECT_EQ(pPlan->m_vItems[0], item010);
+
+    pPlan = cache.find(notSet, sizeof(notSet));
+    ASSERT_NE(pPlan, nullptr);
+    EXPECT_EQ(pPlan->m_pUAP, uapDefault);
+    ASSERT_EQ(pPlan->m_vItems.size(), 1u);
+    EXPECT_EQ(pPlan->m_vItems[0], item020);
+    EXPECT_EQ(cache.size(), 2u);
+
+    EXPECT_EQ(cache.find(set, sizeof(set))->m_pUAP, uapSet);
+    EXPECT_EQ(cache.size(), 2u);
+}
+
+/**
+ * Test Case: TC-CPP-PLAN-004
+ * Requirement: REQ-LLR-PERF-PLAN-001
+ * Description: Verify FSPEC with an FRN without item description is not planned
+ */
+TEST(DecodePlanCacheTest, MissingDescriptionNotPlanned) {
+    Category cat(48);
+    cat.getDataItemDescription("010");
+    UAP *uap = cat.newUAP();
+    UAPItem *ui = uap->newUAPItem();
+    ui->m_nFRN = 1;
+    ui->m_strItemID = "010";
+    cat.freeze();
+
+    DecodePlanCache cache(&cat);
+    const unsigned char record[] = {0xC0, 0x00, 0x00};
+    EXPECT_EQ(cache.find(record, sizeof(record)), nullptr);
+    EXPECT_EQ(cache.size(), 0u);
+}
+
+/**
+ * Test Case: TC-CPP-PLAN-005
+ * Requirement: REQ-LLR-PERF-PLAN-001
+ * Description: Verify cache is cleared and refilled when it holds MAX_PLANS plans
+ */
+TEST_F(DecodePlanTest, CacheClearedWhenFull) {
+    DecodePlanCache cache(definition.getCategory(48));
+
+    const size_t nPatterns = DecodePlanCache::MAX_PLANS + 44;
+    for (size_t i = 0; i < nPatterns; i++) {
+        // two byte FSPECs with FRN 1-14, all defined in CAT048
+        const unsigned char record[] = {static_cast<unsigned char>(((i & 0x3F) << 2) | 0x01),
+                                        static_cast<unsigned char>((i >> 6) << 1), 0x00};
+        ASSERT_NE(cache.find(record, sizeof(record)), nullptr) << i;
+        EXPECT_LE(cache.size(), DecodePlanCache::MAX_PLANS);
+    }
+    EXPECT_EQ(cache.size(), 44u);
+}
+
+/**
+ * Test Case: TC-CPP-PLAN-006
+ * Requirement: REQ-LLR-PERF-PLAN-002
+ * Description: Verify sample data decodes to the same output with and without decode plans
+ */
+TEST_F(DecodePlanTest, SameOutputWithAndWithoutPlans) {
+    for (const char *file : {"../asterix/sample_data/cat034.raw", "../asterix/sample_data/cat048.raw",
+                             "../asterix/sample_data/cat062cat065.raw", "../asterix/sample_data/cat21_re.ast"}) {
+        const std::vector<unsigned char> data = readFile(file);
+        ASSERT_FALSE(data.empty()) << file;
+        for (bool bGenerated : {false, true}) {
+            for (unsigned int formatType : {CAsterixFormat::ETxt, CAsterixFormat::EJSONE, CAsterixFormat::EXML}) {
+                const std::string planned = decode(true, bGenerated, data, formatType);
+                EXPECT_FALSE(planned.empty()) << file;
+                EXPECT_EQ(planned, decode(false, bGenerated, data, formatType)) << file;
+            }
+        }
+    }
+}
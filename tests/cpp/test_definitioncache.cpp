@@ -0,0 +1,141 @@
+/**
+ * Unit tests for CDefinitionCache (binary cache of XML category definitions)
+ *
+ * Requirements Traceability:
+ * - REQ-HLR-CFG-002: Load category definitions without parsing XML files when they are unchanged
+ * - REQ-LLR-CFG-CACHE-001: Definitions loaded from cache decode data as definitions parsed from XML
+ * - REQ-LLR-CFG-CACHE-002: Cache is rejected when XML files change or the cache is damaged
+ *
+ * DO-278A AL-3 Compliance Testing
+ */
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "AsterixDefinition.h"
+#include "InputParser.h"
+#include "asterixformat.hxx"
+#include "definitioncache.hxx"
+#include "test_helpers.h"
+
+namespace {
+    using testutil::readFile;
+
+    const std::vector<std::string> definitionFiles = {
+            "../asterix/config/asterix_bds.xml",
+            "../asterix/config/asterix_cat048_1_30.xml",
+            "../asterix/config/asterix_cat062_1_19.xml",
+            "../asterix/config/asterix_cat065_1_5.xml"};
+
+    // decode sample files with definition
+    std::string decode(AsterixDefinition &definition) {
+        InputParser parser(&definition);
+        std::string text;
+        for (const char *file : {"../asterix/sample_data/cat048.raw", "../asterix/sample_data/cat062cat065.raw"}) {
+            text += testutil::getText(parser, readFile(file), CAsterixFormat::EJSONE);
+        }
+        return text;
+    }
+
+    class DefinitionCacheTest : public ::testing::Test {
+    protected:
+        // tests may run in parallel in the same directory
+        std::string cacheFileName;
+        const char *cacheFile = nullptr;
+
+        void SetUp() override {
+            cacheFileName = std::string("test_definitioncache_") +
+                            ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".cache";
+            cacheFile = cacheFileName.c_str();
+        }
+
+        void TearDown() override {
+            remove(cacheFile);
+        }
+    };
+}
+
+/**
+ * Test Case: TC-CPP-DEFCACHE-001
+ * Requirement: REQ-LLR-CFG-CACHE-001
+ * Description: Definitions saved to and loaded from cache decode samples as XML definitions
+ */
+TEST_F(DefinitionCacheTest, RoundTrip) {
+    uint64_t key = 0;
+    ASSERT_TRUE(CDefinitionCache::ComputeKey(definitionFiles, key));
+
+    AsterixDefinition xml;
+    ASSERT_TRUE(testutil::parseFiles(xml, definitionFiles));
+    ASSERT_TRUE(CDefinitionCache::Save(cacheFile, key, &xml));
+
+    AsterixDefinition cached;
+    ASSERT_TRUE(CDefinitionCache::Load(cacheFile, key, &cached));
+
+    EXPECT_TRUE(cached.CategoryDefined(48));
+    EXPECT_TRUE(cached.CategoryDefined(62));
+    EXPECT_TRUE(cached.CategoryDefined(BDS_CAT_ID));
+    EXPECT_FALSE(cached.CategoryDefined(1));
+    EXPECT_EQ(cached.printDescriptors(), xml.printDescriptors());
+    EXPECT_EQ(cached.getCategory(62)->m_strVer, xml.getCategory(62)->m_strVer);
+    EXPECT_STREQ(cached.getDescription(48, "I020", "TYP", "5"), xml.getDescription(48, "I020", "TYP", "5"));
+
+    const std::string expected = decode(xml);
+    EXPECT_FALSE(expected.empty());
+    EXPECT_EQ(decode(cached), expected);
+}
+
+/**
+ * Test Case: TC-CPP-DEFCACHE-002
+ * Requirement: REQ-LLR-CFG-CACHE-002
+ * Description: Key changes with contents of definition files
+ */
+TEST_F(DefinitionCacheTest, KeyFollowsContents) {
+    const char *xmlFile = "test_definitioncache.xml";
+    uint64_t key1 = 0, key2 = 0, key3 = 0;
+
+    FILE *f = fopen(xmlFile, "w");
+    ASSERT_NE(f, nullptr);
+    fputs("<Category id=\"1\"/>", f);
+    fclose(f);
+    ASSERT_TRUE(CDefinitionCache::ComputeKey({xmlFile}, key1));
+    ASSERT_TRUE(CDefinitionCache::ComputeKey({xmlFile}, key2));
+
+    f = fopen(xmlFile, "a");
+    ASSERT_NE(f, nullptr);
+    fputs(" ", f);
+    fclose(f);
+    ASSERT_TRUE(CDefinitionCache::ComputeKey({xmlFile}, key3));
+    remove(xmlFile);
+
+    EXPECT_EQ(key1, key2);
+    EXPECT_NE(key1, key3);
+    EXPECT_FALSE(CDefinitionCache::ComputeKey({xmlFile}, key1));
+}
+
+/**
+ * Test Case: TC-CPP-DEFCACHE-003
+ * Requirement: REQ-LLR-CFG-CACHE-002
+ * Description: Cache with other key, truncated or missing cache is not loaded
+ */
+TEST_F(DefinitionCacheTest, RejectInvalidCache) {
+    AsterixDefinition xml;
+    ASSERT_TRUE(testutil::parseFiles(xml, definitionFiles));
+    ASSERT_TRUE(CDefinitionCache::Save(cacheFile, 1234, &xml));
+
+    AsterixDefinition other;
+    EXPECT_FALSE(CDefinitionCache::Load(cacheFile, 1235, &other));
+    EXPECT_FALSE(other.CategoryDefined(48));
+
+    std::vector<unsigned char> data = readFile(cacheFile);
+    ASSERT_GT(data.size(), 1000u);
+    FILE *f = fopen(cacheFile, "wb");
+    ASSERT_NE(f, nullptr);
+    fwrite(data.data(), 1, data.size() / 2, f);
+    fclose(f);
+    EXPECT_FALSE(CDefinitionCache::Load(cacheFile, 1234, &other));
+    EXPECT_FALSE(other.CategoryDefined(48));
+
+    remove(cacheFile);
+    EXPECT_FALSE(CDefinitionCache::Load(cacheFile, 1234, &other));
+}
@@ -0,0 +1,268 @@
+/**
+ * Unit tests for CDefinitionReloader (replacing definitions of running inputs)
+ *
+ * Requirements Traceability:
+ * - REQ-HLR-CFG-005: Definitions are reloaded without stopping inputs
+ * - REQ-LLR-CFG-RELOAD-001: Readers switch to a published definition between packets
+ * - REQ-LLR-CFG-RELOAD-002: Replaced definitions are deleted after all readers switched
+ * - REQ-LLR-CFG-RELOAD-003: Failed reloads keep the definition, loaded categories and filters carry over
+ * - REQ-LLR-CFG-RELOAD-004: Statistics of the validator are kept across a reload
+ *
+ * DO-278A AL-3 Compliance Testing
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AsterixDefinition.h"
+#include "InputParser.h"
+#include "asterixformat.hxx"
+#include "asterixvalidator.hxx"
+#include "definitionreloader.hxx"
+#include "test_helpers.h"
+
+namespace {
+    using testutil::readFile;
+
+    // definitions listed in asterix.ini, loaded on first use
+    AsterixDefinition *loadDefinitions() {
+        auto *pDefinition = new AsterixDefinition();
+        testutil::registerFiles(*pDefinition, testutil::definitionFiles());
+        return pDefinition;
+    }
+}
+
+/**
+ * Test Case: TC-CPP-RELOAD-001
+ * Requirement: REQ-LLR-CFG-RELOAD-001
+ * Description: Verify readers keep their definition until they update after a reload
+ */
+TEST(DefinitionReloaderTest, ReadersSwitchOnUpdate) {
+    CDefinitionReloader reloader(loadDefinitions(), loadDefinitions);
+    AsterixDefinition *pFirst = nullptr;
+    AsterixDefinition *pSecond = nullptr;
+    CDefinitionReloader::CReader *pReader1 = reloader.AddReader(pFirst);
+    CDefinitionReloader::CReader *pReader2 = reloader.AddReader(pSecond);
+    ASSERT_NE(pFirst, nullptr);
+    EXPECT_EQ(pFirst, pSecond);
+    EXPECT_EQ(reloader.GetGeneration(), 0u);
+
+    int nSwitched = 0;
+    auto switchTo = [&nSwitched](AsterixDefinition *&pUsed) {
+        return [&nSwitched, &pUsed](AsterixDefinition *pDefinition) {
+            pUsed = pDefinition;
+            nSwitched++;
+        };
+    };
+    EXPECT_FALSE(reloader.Update(*pReader1, switchTo(pFirst)));
+    EXPECT_EQ(nSwitched, 0);
+
+    ASSERT_TRUE(reloader.Reload());
+    EXPECT_EQ(reloader.GetGeneration(), 1u);
+    AsterixDefinition *pOld = pSecond;
+    EXPECT_TRUE(reloader.Update(*pReader1, switchTo(pFirst)));
+    EXPECT_NE(pFirst, pOld);
+    EXPECT_FALSE(reloader.Update(*pReader1, switchTo(pFirst)));
+    EXPECT_EQ(nSwitched, 1);
+
+    // reader registered after the reload gets the new definition
+    AsterixDefinition *pThird = nullptr;
+    CDefinitionReloader::CReader *pReader3 = reloader.AddReader(pThird);
+    EXPECT_EQ(pThird, pFirst);
+    EXPECT_FALSE(reloader.Update(*pReader3, switchTo(pThird)));
+
+    EXPECT_TRUE(reloader.Update(*pReader2, switchTo(pSecond)));
+    EXPECT_EQ(pSecond, pFirst);
+    EXPECT_EQ(nSwitched, 2);
+    reloader.RemoveReader(pReader1);
+    reloader.RemoveReader(pReader2);
+    reloader.RemoveReader(pReader3);
+}
+
+/**
+ * Test Case: TC-CPP-RELOAD-002
+ * Requirement: REQ-LLR-CFG-RELOAD-002
+ * Description: Verify a replaced definition is kept while a reader uses it
+ */
+TEST(DefinitionReloaderTest, ReclaimAfterAllReadersSwitched) {
+    CDefinitionReloader reloader(loadDefinitions(), loadDefinitions);
+    AsterixDefinition *pActive = nullptr;
+    AsterixDefinition *pIdle = nullptr;
+    CDefinitionReloader::CReader *pActiveReader = reloader.AddReader(pActive);
+    CDefinitionReloader::CReader *pIdleReader = reloader.AddReader(pIdle);
+    auto switchTo = [](AsterixDefinition *&pUsed) {
+        return [&pUsed](AsterixDefinition *pDefinition) { pUsed = pDefinition; };
+    };
+
+    ASSERT_TRUE(reloader.Reload());
+    ASSERT_TRUE(reloader.Reload());
+    reloader.Update(*pActiveReader, switchTo(pActive));
+    // both replaced definitions wait for the idle reader, which still decodes with the first
+    EXPECT_EQ(reloader.Reclaim(), 2u);
+    EXPECT_TRUE(pIdle->CategoryDefined(48));
+
+    ASSERT_TRUE(reloader.Update(*pIdleReader, switchTo(pIdle)));
+    EXPECT_EQ(pIdle, pActive);
+    EXPECT_EQ(reloader.Reclaim(), 0u);
+
+    // readers removed do not hold definitions
+    ASSERT_TRUE(reloader.Reload());
+    reloader.RemoveReader(pIdleReader);
+    EXPECT_EQ(reloader.Reclaim(), 1u);
+    reloader.RemoveReader(pActiveReader);
+    EXPECT_EQ(reloader.Reclaim(), 0u);
+}
+
+/**
+ * Test Case: TC-CPP-RELOAD-003
+ * Requirement: REQ-LLR-CFG-RELOAD-003
+ * Description: Verify failed reloads, preloading of categories in use and filters of reloaded definitions
+ */
+TEST(DefinitionReloaderTest, ReloadContents) {
+    bool bFail = false;
+    CDefinitionReloader reloader(loadDefinitions(), [&bFail]() { return bFail ? nullptr : loadDefinitions(); });
+    AsterixDefinition *pDefinition = nullptr;
+    CDefinitionReloader::CReader *pReader = reloader.AddReader(pDefinition);
+    auto switchTo = [&pDefinition](AsterixDefinition *pNew) { pDefinition = pNew; };
+
+    ASSERT_TRUE(pDefinition->CategoryDefined(48));
+    EXPECT_TRUE(reloader.FilterOutItem(48, "010", "SAC"));
+    EXPECT_FALSE(reloader.FilterOutItem(48, "999", "SAC"));
+    EXPECT_TRUE(pDefinition->isFiltered(48, "010", "SAC"));
+
+    bFail = true;
+    EXPECT_FALSE(reloader.Reload());
+    EXPECT_EQ(reloader.GetGeneration(), 0u);
+    EXPECT_FALSE(reloader.Update(*pReader, switchTo));
+
+    bFail = false;
+    ASSERT_TRUE(reloader.Reload());
+    ASSERT_TRUE(reloader.Update(*pReader, switchTo));
+    // CAT048 was in use and is loaded, the others still wait for their data
+    EXPECT_TRUE(pDefinition->CategoryLoaded(48));
+    EXPECT_FALSE(pDefinition->CategoryLoaded(62));
+    EXPECT_TRUE(pDefinition->CategoryAvailable(62));
+    EXPECT_TRUE(pDefinition->isFiltered(48, "010", "SAC"));
+    EXPECT_FALSE(pDefinition->isFiltered(48, "020", "TYP"));
+    reloader.RemoveReader(pReader);
+}
+
+/**
+ * Test Case: TC-CPP-RELOAD-004
+ * Requirement: REQ-LLR-CFG-RELOAD-001, REQ-LLR-CFG-RELOAD-002
+ * Description: Verify inputs decoding while the background thread reloads get unchanged output
+ */
+TEST(DefinitionReloaderTest, ReloadWhileDecoding) {
+    const std::vector<unsigned char> data = readFile("../asterix/sample_data/cat062cat065.raw");
+    ASSERT_FALSE(data.empty());
+    std::unique_ptr<AsterixDefinition> pExpected(loadDefinitions());
+    InputParser expectedParser(pExpected.get());
+    const std::string expected = testutil::getText(expectedParser, data, CAsterixFormat::ETxt);
+    ASSERT_FALSE(expected.empty());
+
+    auto reloader = std::make_shared<CDefinitionReloader>(loadDefinitions(), loadDefinitions);
+    reloader->Start();
+
+    constexpr int N_THREADS = 4;
+    constexpr int N_RELOADS = 5;
+    std::atomic<bool> bStop{false};
+    std::atomic<int> nReaders{0};
+    std::atomic<int> nSwitched[N_THREADS] = {};
+    std::vector<int> nWrong(N_THREADS, 0);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < N_THREADS; i++) {
+        threads.emplace_back([&, i]() {
+            AsterixDefinition *pDefinition = nullptr;
+            CDefinitionReloader::CReader *pReader = reloader->AddReader(pDefinition);
+            nReaders++;
+            InputParser parser(pDefinition);
+            do {
+                reloader->Update(*pReader, [&](AsterixDefinition *pNew) {
+                    pDefinition = pNew;
+                    parser.setDefinition(pNew);
+                    nSwitched[i]++;
+                });
+                if (testutil::getText(parser, data, CAsterixFormat::ETxt) != expected) {
+                    nWrong[i]++;
+                }
+            } while (!bStop.load());
+            reloader->RemoveReader(pReader);
+        });
+    }
+
+    // readers registered after the reloads would start on the last generation
+    auto waitFor = [](const std::function<bool()> &done) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (!done() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return done();
+    };
+    EXPECT_TRUE(waitFor([&]() { return nReaders.load() == N_THREADS; }));
+
+    for (int n = 1; n <= N_RELOADS; n++) {
+        reloader->RequestReload();
+        const bool reloaded = waitFor([&]() { return reloader->GetGeneration() >= static_cast<uint64_t>(n); });
+        EXPECT_EQ(reloader->GetGeneration(), static_cast<uint64_t>(n));
+        if (!reloaded) {
+            break;
+        }
+    }
+    // every reader switches at least once
+    EXPECT_TRUE(waitFor([&]() {
+        for (int i = 0; i < N_THREADS; i++) {
+            if (nSwitched[i].load() == 0) {
+                return false;
+            }
+        }
+        return true;
+    }));
+    bStop = true;
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    for (int i = 0; i < N_THREADS; i++) {
+        EXPECT_EQ(nWrong[i], 0) << "thread " << i;
+        EXPECT_GE(nSwitched[i].load(), 1) << "thread " << i;
+    }
+    EXPECT_EQ(reloader->Reclaim(), 0u);
+}
+
+/**
+ * Test Case: TC-CPP-RELOAD-005
+ * Requirement: REQ-LLR-CFG-RELOAD-004
+ * Description: Verify validator counts continue on the reloaded definition after the old one is deleted
+ */
+TEST(DefinitionReloaderTest, ValidatorKeepsStatistics) {
+    const std::vector<unsigned char> data = readFile("../asterix/sample_data/cat048.raw");
+    ASSERT_FALSE(data.empty());
+
+    AsterixDefinition *pOld = loadDefinitions();
+    CAsterixValidator validator(pOld);
+    validator.Validate(data.data(), static_cast<unsigned int>(data.size()));
+    const CAsterixValidator::SCategory first = validator.GetCategory(48);
+    ASSERT_FALSE(first.items.empty());
+
+    AsterixDefinition *pNew = loadDefinitions();
+    validator.SetDefinition(pNew);
+    delete pOld;
+    validator.Validate(data.data(), static_cast<unsigned int>(data.size()));
+
+    const CAsterixValidator::SCategory &second = validator.GetCategory(48);
+    EXPECT_EQ(second.nRecords, 2 * first.nRecords);
+    EXPECT_EQ(second.nMalformed, 0u);
+    ASSERT_EQ(second.items.size(), first.items.size());
+    for (size_t i = 0; i < first.items.size(); i++) {
+        EXPECT_EQ(second.items[i].pDescription, pNew->getCategory(48)->findDataItemDescription(
+                second.items[i].pDescription->m_strID));
+        EXPECT_EQ(second.items[i].nPresent, 2 * first.items[i].nPresent);
+    }
+    EXPECT_EQ(validator.GetNMalformed(), 0u);
+    delete pNew;
+}
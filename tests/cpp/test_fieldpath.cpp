@@ -0,0 +1,193 @@
+/**
+ * Unit tests for FieldPath (AsterixDefinition::compile() and DataRecord::get())
+ *
+ * Requirements Traceability:
+ * - REQ-HLR-API-005: Read numeric field values of records without text conversion
+ * - REQ-LLR-API-FIELD-001: Field names are resolved to item and field definitions
+ * - REQ-LLR-API-FIELD-002: Raw and scaled values are read from the item bytes
+ * - REQ-LLR-API-FIELD-003: Absent items and fields give the default value
+ *
+ * DO-278A AL-3 Compliance Testing
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+#include "AsterixData.h"
+#include "AsterixDefinition.h"
+#include "DataBlock.h"
+#include "DataItem.h"
+#include "DataItemBits.h"
+#include "DataRecord.h"
+#include "InputParser.h"
+#include "test_helpers.h"
+
+namespace {
+    using testutil::readFile;
+
+    class FieldPathTest : public ::testing::Test {
+    protected:
+        AsterixDefinition definition;
+
+        void SetUp() override {
+            ASSERT_TRUE(testutil::parseFiles(definition, {"../asterix/config/asterix_bds.xml",
+                                                          "../asterix/config/asterix_cat048_1_30.xml",
+                                                          "../asterix/config/asterix_cat062_1_19.xml",
+                                                          "../asterix/config/asterix_cat065_1_5.xml"}));
+        }
+    };
+
+    // I048/010 SAC=25 SIC=201, I048/140 1 s, I048/020 TYP=1 with extension ME=1, I048/040 RHO=16 NM THETA=45 deg
+    const unsigned char CAT048_RECORD[] = {0xF0, 0x19, 0xC9, 0x00, 0x00, 0x80, 0x21, 0x10, 0x10, 0x00, 0x20, 0x00};
+}
+
+/**
+ * Test Case: TC-CPP-FIELD-001
+ * Requirement: REQ-LLR-API-FIELD-001
+ * Description: Verify paths resolve to their field, constant positions are detected
+ */
+TEST_F(FieldPathTest, Compile) {
+    const FieldPath lat = definition.compile("062/105.LAT");
+    ASSERT_TRUE(lat.isValid());
+    EXPECT_EQ(lat.m_nCategory, 62);
+    EXPECT_EQ(lat.m_pDescription, definition.getCategory(62)->findDataItemDescription("105"));
+    EXPECT_EQ(lat.m_pBits->m_strShortName, "LAT");
+    EXPECT_EQ(lat.m_nPartLength, 8);
+    EXPECT_EQ(lat.m_nFrom, 33);
+    EXPECT_EQ(lat.m_nTo, 64);
+
+    // first part of a Variable item at constant position, extensions are not
+    const FieldPath typ = definition.compile("048/020.TYP");
+    ASSERT_TRUE(typ.isValid());
+    EXPECT_EQ(typ.m_nPartLength, 1);
+    const FieldPath me = definition.compile("048/020.ME");
+    ASSERT_TRUE(me.isValid());
+    EXPECT_EQ(me.m_nPartLength, 0);
+
+    // compound sub-item by presence bit name, or first secondary part field of that name
+    const FieldPath adr = definition.compile("062/380.ADR.ADR");
+    ASSERT_TRUE(adr.isValid());
+    EXPECT_EQ(adr.m_nPartLength, 0);
+    EXPECT_EQ(adr.m_pBits->m_nPresenceOfField, 0);
+    EXPECT_EQ(definition.compile("062/380.ADR").m_pBits, adr.m_pBits);
+
+    for (const char *invalid : {"", "062", "062/105", "062/105.", "062/105.XXX", "062/999.LAT", "063/105.LAT",
+                                "62x/105.LAT", "/105.LAT", "300/105.LAT", "062/380.XXX.ADR", "062/105.LAT.LAT"}) {
+        EXPECT_FALSE(definition.compile(invalid).isValid()) << invalid;
+    }
+}
+
+/**
+ * Test Case: TC-CPP-FIELD-002
+ * Requirement: REQ-LLR-API-FIELD-002
+ * Description: Verify raw values for integral types and scaled values for floating-point types
+ */
+TEST_F(FieldPathTest, Values) {
+    DataRecord record(definition.getCategory(48), 0, sizeof(CAT048_RECORD), CAT048_RECORD, 0.0);
+    ASSERT_TRUE(record.m_bFormatOK);
+
+    EXPECT_EQ(record.get<uint32_t>(definition.compile("048/010.SAC")), 25u);
+    EXPECT_EQ(record.get<int>(definition.compile("048/010.SIC")), 201);
+    EXPECT_DOUBLE_EQ(record.get<double>(definition.compile("048/140.ToD")), 1.0);
+    EXPECT_EQ(record.get<uint32_t>(definition.compile("048/140.ToD")), 128u);
+    EXPECT_EQ(record.get<int>(definition.compile("048/020.TYP")), 1);
+    EXPECT_EQ(record.get<int>(definition.compile("048/020.ME")), 1);
+    EXPECT_EQ(record.get<int>(definition.compile("048/020.MI")), 0);
+    EXPECT_DOUBLE_EQ(record.get<double>(definition.compile("048/040.RHO")), 16.0);
+    EXPECT_FLOAT_EQ(record.get<float>(definition.compile("048/040.THETA")), 45.0f);
+
+    ItemField field{};
+    ASSERT_TRUE(record.getField(definition.compile("048/020.TYP"), field));
+    ASSERT_NE(field.getMeaning(), nullptr);
+    EXPECT_STREQ(field.getMeaning(), "Single PSR detection");
+}
+
+/**
+ * Test Case: TC-CPP-FIELD-003
+ * Requirement: REQ-LLR-API-FIELD-003
+ * Description: Verify absent items, absent extensions and foreign paths give the default value
+ */
+TEST_F(FieldPathTest, Absent) {
+    // I048/020 without extension
+    const unsigned char data[] = {0xF0, 0x19, 0xC9, 0x00, 0x00, 0x80, 0x20, 0x10, 0x00, 0x20, 0x00};
+    DataRecord record(definition.getCategory(48), 0, sizeof(data), data, 0.0);
+    ASSERT_TRUE(record.m_bFormatOK);
+
+    EXPECT_EQ(record.get<int>(definition.compile("048/020.ME"), -1), -1);
+    EXPECT_EQ(record.get<int>(definition.compile("048/070.MODE3A"), -1), -1);
+    EXPECT_EQ(record.get<int>(definition.compile("062/010.SAC"), -1), -1);
+    EXPECT_EQ(record.get<int>(FieldPath(), -1), -1);
+    EXPECT_DOUBLE_EQ(record.get<double>(definition.compile("048/090.FL"), -1000.0), -1000.0);
+}
+
+/**
+ * Test Case: TC-CPP-FIELD-004
+ * Requirement: REQ-LLR-API-FIELD-002
+ * Description: Verify sample CAT062 positions and compound fields against the item bytes
+ */
+TEST_F(FieldPathTest, SampleTracks) {
+    const std::vector<unsigned char> data = readFile("../asterix/sample_data/cat062cat065.raw");
+    ASSERT_FALSE(data.empty());
+    InputParser parser(&definition);
+    AsterixData *pData = parser.parsePacket(data.data(), static_cast<unsigned int>(data.size()), 0.0);
+    ASSERT_NE(pData, nullptr);
+
+    const FieldPath lat = definition.compile("062/105.LAT");
+    const FieldPath lon = definition.compile("062/105.LON");
+    const FieldPath trackNumber = definition.compile("062/040.TN");
+    const FieldPath adr = definition.compile("062/380.ADR.ADR");
+    ASSERT_TRUE(lat.isValid() && lon.isValid() && trackNumber.isValid() && adr.isValid());
+
+    int nPositions = 0;
+    int nAddresses = 0;
+    for (auto *dataBlock : pData->m_lDataBlocks) {
+        for (auto *record : dataBlock->m_lDataRecords) {
+            if (record->getCategory() != 62) {
+                EXPECT_EQ(record->get<int>(lat, -1), -1);
+                continue;
+            }
+            DataItem *position = record->getItem("105");
+            if (position != nullptr) {
+                std::vector<unsigned char> bytes;
+                position->getBinary(bytes);
+                ASSERT_EQ(bytes.size(), 8u);
+                const auto rawLat = static_cast<int32_t>(
+                        (static_cast<uint32_t>(bytes[0]) << 24) | (bytes[1] << 16) | (bytes[2] << 8) | bytes[3]);
+                const auto rawLon = static_cast<int32_t>(
+                        (static_cast<uint32_t>(bytes[4]) << 24) | (bytes[5] << 16) | (bytes[6] << 8) | bytes[7]);
+                EXPECT_EQ(record->get<int32_t>(lat), rawLat);
+                EXPECT_DOUBLE_EQ(record->get<double>(lat), rawLat * 180.0 / 33554432.0);
+                EXPECT_DOUBLE_EQ(record->get<double>(lon), rawLon * 180.0 / 33554432.0);
+                nPositions++;
+            }
+
+            DataItem *track = record->getItem("040");
+            if (track != nullptr) {
+                std::vector<unsigned char> bytes;
+                track->getBinary(bytes);
+                EXPECT_EQ(record->get<uint32_t>(trackNumber), (bytes[0] << 8u) | bytes[1]);
+            }
+
+            // I062/380 starts with the primary part, ADR is the first sub-item when present
+            DataItem *aircraft = record->getItem("380");
+            if (aircraft != nullptr && aircraft->getLength() >= 4) {
+                std::vector<unsigned char> bytes;
+                aircraft->getBinary(bytes);
+                size_t primary = 1;
+                while (primary < bytes.size() && (bytes[primary - 1] & 0x01)) {
+                    primary++;
+                }
+                if ((bytes[0] & 0x80) && primary + 3 <= bytes.size()) {
+                    EXPECT_EQ(record->get<uint32_t>(adr), (static_cast<uint32_t>(bytes[primary]) << 16) |
+                                                          (bytes[primary + 1] << 8) | bytes[primary + 2]);
+                    nAddresses++;
+                } else {
+                    EXPECT_EQ(record->get<int>(adr, -1), -1);
+                }
+            }
+        }
+    }
+    delete pData;
+    EXPECT_GT(nPositions, 0);
+    EXPECT_GT(nAddresses, 0);
+}
@@ -0,0 +1,94 @@
+/**
+ * Helpers shared by the definition and decoder unit tests
+ *
+ * Tests run in the build directory, so the configuration and sample data
+ * of the repository are found under ../asterix.
+ */
+
+#ifndef TEST_HELPERS_H_
+#define TEST_HELPERS_H_
+
+#include <cstdio>
+#include <fstream>
+#include <regex>
+#include <string>
+#include <vector>
+#include "AsterixData.h"
+#include "AsterixDefinition.h"
+#include "InputParser.h"
+#include "XMLParser.h"
+
+namespace testutil {
+    // Contents of a file, empty if it cannot be read
+    inline std::vector<unsigned char> readFile(const char *file) {
+        std::vector<unsigned char> data;
+        FILE *f = fopen(file, "rb");
+        if (f != nullptr) {
+            unsigned char buffer[4096];
+            size_t len;
+            while ((len = fread(buffer, 1, sizeof(buffer), f)) > 0) {
+                data.insert(data.end(), buffer, buffer + len);
+            }
+            fclose(f);
+        }
+        return data;
+    }
+
+    // Definition files listed in asterix.ini
+    inline std::vector<std::string> definitionFiles() {
+        std::vector<std::string> files;
+        std::ifstream ini("../asterix/config/asterix.ini");
+        std::string line;
+        while (std::getline(ini, line)) {
+            line.erase(line.find_last_not_of(" \t\r\n") + 1);
+            if (!line.empty() && line[0] != '#') {
+                files.push_back("../asterix/config/" + line);
+            }
+        }
+        return files;
+    }
+
+    // Parse definition files one after another, false if one cannot be opened or parsed
+    inline bool parseFiles(AsterixDefinition &definition, const std::vector<std::string> &files) {
+        for (const std::string &file : files) {
+            FILE *f = fopen(file.c_str(), "r");
+            if (f == nullptr) {
+                return false;
+            }
+            XMLParser parser;
+            const bool ok = parser.Parse(f, &definition, file.c_str());
+            fclose(f);
+            if (!ok) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Register definition files to be parsed on first use, false if the category of one cannot be read
+    inline bool registerFiles(AsterixDefinition &definition, const std::vector<std::string> &files) {
+        for (const std::string &file : files) {
+            const int nCategory = XMLParser::ReadCategoryId(file.c_str());
+            if (nCategory < 0) {
+                return false;
+            }
+            definition.registerCategoryFile(nCategory, file);
+        }
+        return true;
+    }
+
+    // Text of a decoded packet, without data block numbers (counted across all AsterixData)
+    inline std::string getText(InputParser &parser, const std::vector<unsigned char> &data,
+                               unsigned int formatType) {
+        std::string text;
+        AsterixData *pData = parser.parsePacket(data.data(), static_cast<unsigned int>(data.size()), 0.0);
+        if (pData != nullptr) {
+            pData->getText(text, formatType);
+            delete pData;
+        }
+        static const std::regex blockNumber("Data Block [0-9]+");
+        return std::regex_replace(text, blockNumber, "Data Block");
+    }
+}
+
+#endif
@@ -0,0 +1,139 @@
+/**
+ * Unit tests for CIpReassembly (IPv4 fragment reassembly)
+ *
+ * Requirements Traceability:
+ * - REQ-HLR-FMT-001: Support PCAP encapsulation format
+ * - REQ-LLR-FMT-PCAP-005: Reassemble fragmented IPv4 datagrams with bounded memory
+ *
+ * DO-278A AL-3 Compliance Testing
+ */
+
+#include <gtest/gtest.h>
+#include "ipreassembly.hxx"
+#include <cstring>
+#include <vector>
+
+namespace {
+    const uint32_t SRC = 0x0A000001;
+    const uint32_t DST = 0xE0000001;
+
+    std::vector<unsigned char> makePayload(unsigned int len) {
+        std::vector<unsigned char> data(len);
+        for (unsigned int i = 0; i < len; i++) {
+            data[i] = static_cast<unsigned char>(i * 7);
+        }
+        return data;
+    }
+}
+
+/**
+ * Test Case: TC-CPP-IPREASM-001
+ * Requirement: REQ-LLR-FMT-PCAP-005
+ * Description: Fragments received in order are reassembled
+ */
+TEST(IpReassemblyTest, InOrder) {
+    CIpReassembly table;
+    const auto payload = makePayload(3000);
+    unsigned int totalLen = 0;
+
+    EXPECT_EQ(table.AddFragment(SRC, DST, 17, 1, 0, true, payload.data(), 1480, 0.0, totalLen), nullptr);
+    EXPECT_EQ(table.AddFragment(SRC, DST, 17, 1, 1480, true, payload.data() + 1480, 1480, 0.1, totalLen), nullptr);
+    EXPECT_EQ(table.GetNPending(), 1u);
+
+    const unsigned char *result = table.AddFragment(SRC, DST, 17, 1, 2960, false, payload.data() + 2960, 40, 0.2,
+                                                    totalLen);
+    ASSERT_NE(result, nullptr);
+    EXPECT_EQ(totalLen, 3000u);
+    EXPECT_EQ(memcmp(result, payload.data(), payload.size()), 0);
+    EXPECT_EQ(table.GetNPending(), 0u);
+    EXPECT_EQ(table.GetMemory(), 0u);
+    EXPECT_EQ(table.GetNReassembled(), 1u);
+}
+
+/**
+ * Test Case: TC-CPP-IPREASM-002
+ * Requirement: REQ-LLR-FMT-PCAP-005
+ * Description: Out of order, duplicated and interleaved fragments are reassembled
+ */
+TEST(IpReassemblyTest, OutOfOrderAndInterleaved) {
+    CIpReassembly table;
+    const auto payload = makePayload(2000);
+    unsigned int totalLen = 0;
+
+    EXPECT_EQ(table.AddFragment(SRC, DST, 17, 7, 1600, false, payload.data() + 1600, 400, 0.0, totalLen), nullptr);
+    EXPECT_EQ(table.AddFragment(SRC, DST, 17, 8, 800, false, payload.data() + 800, 200, 0.0, totalLen), nullptr);
+    EXPECT_EQ(table.AddFragment(SRC, DST, 17, 7, 800, true, payload.data() + 800, 800, 0.0, totalLen), nullptr);
+    EXPECT_EQ(table.AddFragment(SRC, DST, 17, 7, 800, true, payload.data() + 800, 800, 0.0, totalLen), nullptr);
+    EXPECT_EQ(table.GetNPending(), 2u);
+
+    const unsigned char *result = table.AddFragment(SRC, DST, 17, 7, 0, true, payload.data(), 800, 0.0, totalLen);
+    ASSERT_NE(result, nullptr);
+    EXPECT_EQ(totalLen, 2000u);
+    EXPECT_EQ(memcmp(result, payload.data(), payload.size()), 0);
+
+    // Other datagram is still pending
+    EXPECT_EQ(table.GetNPending(), 1u);
+    result = table.AddFragment(SRC, DST, 17, 8, 0, true, payload.data(), 800, 0.0, totalLen);
+    ASSERT_NE(result, nullptr);
+    EXPECT_EQ(totalLen, 1000u);
+    EXPECT_EQ(memcmp(result, payload.data(), totalLen), 0);
+}
+
+/**
+ * Test Case: TC-CPP-IPREASM-003
+ * Requirement: REQ-LLR-FMT-PCAP-005
+ * Description: Fragments of different sources with the same id are kept apart
+ */
+TEST(IpReassemblyTest, KeyIncludesAddresses) {
+    CIpReassembly table;
+    const auto payload = makePayload(100);
+    unsigned int totalLen = 0;
+
+    EXPECT_EQ(table.AddFragment(SRC, DST, 17, 3, 0, true, payload.data(), 64, 0.0, totalLen), nullptr);
+    EXPECT_EQ(table.AddFragment(SRC + 1, DST, 17, 3, 64, false, payload.data() + 64, 36, 0.0, totalLen), nullptr);
+    EXPECT_EQ(table.GetNPending(), 2u);
+}
+
+/**
+ * Test Case: TC-CPP-IPREASM-004
+ * Requirement: REQ-LLR-FMT-PCAP-005
+ * Description: Incomplete datagrams expire after the timeout in capture time
+ */
+TEST(IpReassemblyTest, Timeout) {
+    CIpReassembly table(64, 1024 * 1024, 5.0);
+    const auto payload = makePayload(200);
+    unsigned int totalLen = 0;
+
+    EXPECT_EQ(table.AddFragment(SRC, DST, 17, 1, 0, true, payload.data(), 104, 100.0, totalLen), nullptr);
+    EXPECT_EQ(table.AddFragment(SRC, DST, 17, 2, 0, true, payload.data(), 104, 110.0, totalLen), nullptr);
+    EXPECT_EQ(table.GetNPending(), 1u);
+    EXPECT_EQ(table.GetNDropped(), 1u);
+
+    // Last fragment of the expired datagram does not complete it
+    EXPECT_EQ(table.AddFragment(SRC, DST, 17, 1, 104, false, payload.data() + 104, 96, 110.0, totalLen), nullptr);
+}
+
+/**
+ * Test Case: TC-CPP-IPREASM-005
+ * Requirement: REQ-LLR-FMT-PCAP-005
+ * Description: Number of datagrams and memory stay within the configured limits
+ */
+TEST(IpReassemblyTest, BoundedMemory) {
+    CIpReassembly table(4, 4096, 30.0);
+    const auto payload = makePayload(2000);
+    unsigned int totalLen = 0;
+
+    for (uint16_t id = 0; id < 10; id++) {
+        EXPECT_EQ(table.AddFragment(SRC, DST, 17, id, 0, true, payload.data(), 1000, 0.0, totalLen), nullptr);
+        EXPECT_LE(table.GetNPending(), 4u);
+        EXPECT_LE(table.GetMemory(), 4096u);
+    }
+    EXPECT_EQ(table.GetNDropped(), 6u);
+
+    // Newest datagrams are kept
+    const unsigned char *result = table.AddFragment(SRC, DST, 17, 9, 1000, false, payload.data() + 1000, 1000, 0.0,
+                                                    totalLen);
+    ASSERT_NE(result, nullptr);
+    EXPECT_EQ(totalLen, 2000u);
+    EXPECT_EQ(memcmp(result, payload.data(), payload.size()), 0);
+}
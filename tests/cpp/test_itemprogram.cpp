@@ -0,0 +1,380 @@
+/**
+ * Unit tests for ItemProgram (data item definitions compiled into linear programs)
+ *
+ * Requirements Traceability:
+ * - REQ-HLR-PERF-003: Decode items without virtual dispatch or recursion over the format tree
+ * - REQ-LLR-PERF-PROG-001: Program lengths equal DataItemFormat::getLength()
+ * - REQ-LLR-PERF-PROG-002: Program fields and values equal those of the format classes
+ * - REQ-LLR-PERF-PROG-003: Programs do not read beyond the data passed
+ *
+ * DO-278A AL-3 Compliance Testing
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "AsterixData.h"
+#include "AsterixDefinition.h"
+#include "DataBlock.h"
+#include "DataItem.h"
+#include "DataItemBits.h"
+#include "DataItemDescription.h"
+#include "DataItemFormatFixed.h"
+#include "DataRecord.h"
+#include "InputParser.h"
+#include "ItemProgram.h"
+#include "asterixformat.hxx"
+#include "test_helpers.h"
+
+namespace {
+    using testutil::readFile;
+
+    const char *const SAMPLE_FILES[] = {"../asterix/sample_data/cat034.raw", "../asterix/sample_data/cat048.raw",
+                                        "../asterix/sample_data/cat062cat065.raw",
+                                        "../asterix/sample_data/cat21_re.ast"};
+
+    const char *const SAMPLE_PCAP_FILES[] = {"../asterix/sample_data/asterix.pcap",
+                                             "../asterix/sample_data/cat_001_002.pcap",
+                                             "../asterix/sample_data/cat_034_048.pcap",
+                                             "../asterix/sample_data/cat_062_065.pcap"};
+
+    // UDP payloads of a little endian pcap file with Ethernet/IPv4 frames
+    std::vector<std::vector<unsigned char>> readPcapPayloads(const char *file) {
+        const std::vector<unsigned char> data = readFile(file);
+        std::vector<std::vector<unsigned char>> payloads;
+        size_t pos = 24;
+        while (pos + 16 <= data.size()) {
+            const size_t inclLength = data[pos + 8] | (data[pos + 9] << 8) | (data[pos + 10] << 16) |
+                                      (static_cast<size_t>(data[pos + 11]) << 24);
+            const unsigned char *frame = data.data() + pos + 16;
+            pos += 16 + inclLength;
+            if (pos > data.size() || inclLength < 42 || frame[12] != 0x08 || frame[13] != 0x00 ||
+                frame[23] != 17) {
+                continue;
+            }
+            const size_t ipHeader = (frame[14] & 0x0F) * 4;
+            if (14 + ipHeader + 8 <= inclLength) {
+                payloads.emplace_back(frame + 14 + ipHeader + 8, frame + inclLength);
+            }
+        }
+        return payloads;
+    }
+
+    // ASTERIX data blocks of raw data, by their length field
+    std::vector<std::vector<unsigned char>> splitBlocks(const std::vector<unsigned char> &data) {
+        std::vector<std::vector<unsigned char>> blocks;
+        size_t pos = 0;
+        while (pos + 3 <= data.size()) {
+            const size_t length = (data[pos + 1] << 8) | data[pos + 2];
+            if (length < 3 || pos + length > data.size()) {
+                break;
+            }
+            blocks.emplace_back(data.begin() + pos, data.begin() + pos + length);
+            pos += length;
+        }
+        return blocks;
+    }
+
+    struct Item {
+        DataItemDescription *m_pDescription;
+        std::vector<unsigned char> m_vData;
+    };
+
+    /*
+     * Walks an item as the format classes do, collecting the fields in data order
+     */
+    void walk(DataItemFormat *pFormat, const unsigned char *pData, std::vector<ItemField> &fields);
+
+    void walkFixed(const DataItemFormatFixed *pFixed, const unsigned char *pData, int partLength,
+                   std::vector<ItemField> &fields) {
+        for (auto *subItem : pFixed->m_lSubItems) {
+            const auto *bits = static_cast<const DataItemBits *>(subItem);
+            const int from = std::min(bits->m_nFrom, bits->m_nTo);
+            const int to = std::max(bits->m_nFrom, bits->m_nTo);
+            if (from >= 1 && to <= partLength * 8) {
+                fields.push_back({bits, pData, partLength, from, to});
+            }
+        }
+    }
+
+    long walkVariable(DataItemFormat *pFormat, const unsigned char *pData, std::vector<ItemField> &fields) {
+        std::vector<DataItemFormat *> parts(pFormat->m_lSubItems.begin(), pFormat->m_lSubItems.end());
+        long length = 0;
+        size_t nPart = 0;
+        bool lastPart;
+        do {
+            auto *pFixed = static_cast<DataItemFormatFixed *>(parts[nPart]);
+            lastPart = pFixed->isLastPart(pData + length);
+            walkFixed(pFixed, pData + length, pFixed->m_nLength, fields);
+            length += pFixed->m_nLength;
+            if (nPart + 1 < parts.size()) {
+                nPart++;
+            }
+        } while (!lastPart);
+        return length;
+    }
+
+    void walk(DataItemFormat *pFormat, const unsigned char *pData, std::vector<ItemField> &fields) {
+        std::vector<DataItemFormat *> subItems(pFormat->m_lSubItems.begin(), pFormat->m_lSubItems.end());
+        if (pFormat->isFixed()) {
+            auto *pFixed = static_cast<DataItemFormatFixed *>(pFormat);
+            walkFixed(pFixed, pData, pFixed->m_nLength, fields);
+        } else if (pFormat->isVariable()) {
+            walkVariable(pFormat, pData, fields);
+        } else if (pFormat->isCompound()) {
+            const unsigned char *pSecData = pData + walkVariable(subItems[0], pData, fields);
+            for (auto *part : subItems[0]->m_lSubItems) {
+                auto *pFixed = static_cast<DataItemFormatFixed *>(part);
+                for (size_t secondaryPart = 1; secondaryPart < subItems.size(); secondaryPart++) {
+                    if (pFixed->isSecondaryPartPresent(pData, static_cast<int>(secondaryPart))) {
+                        walk(subItems[secondaryPart], pSecData, fields);
+                        pSecData += subItems[secondaryPart]->getLength(pSecData);
+                    }
+                }
+                const bool lastPart = pFixed->isLastPart(pData);
+                pData += pFixed->m_nLength;
+                if (lastPart) {
+                    break;
+                }
+            }
+        } else if (pFormat->isRepetitive()) {
+            const long elementLength = subItems[0]->getLength(pData + 1);
+            for (int i = 0; i < pData[0]; i++) {
+                walk(subItems[0], pData + 1 + i * elementLength, fields);
+            }
+        } else if (pFormat->isExplicit()) {
+            const unsigned char *pEnd = pData + pData[0];
+            pData++;
+            while (pData < pEnd) {
+                for (auto *subItem : subItems) {
+                    walk(subItem, pData, fields);
+                    pData += subItem->getLength(pData);
+                }
+            }
+        } else if (pFormat->isBDS()) {
+            for (auto *subItem : subItems) {
+                auto *pFixed = static_cast<DataItemFormatFixed *>(subItem);
+                if (pFixed->m_nID == pData[7] || pFixed->m_nID == 0) {
+                    walkFixed(pFixed, pData, 8, fields);
+                    break;
+                }
+            }
+        }
+    }
+
+    class ItemProgramTest : public ::testing::Test {
+    protected:
+        AsterixDefinition definition;
+
+        void SetUp() override {
+            ASSERT_TRUE(testutil::parseFiles(definition, testutil::definitionFiles()));
+        }
+
+        // items of all records in the sample files
+        std::vector<Item> sampleItems() {
+            std::vector<std::vector<unsigned char>> blocks;
+            for (const char *file : SAMPLE_FILES) {
+                const std::vector<std::vector<unsigned char>> fileBlocks = splitBlocks(readFile(file));
+                EXPECT_FALSE(fileBlocks.empty()) << file;
+                blocks.insert(blocks.end(), fileBlocks.begin(), fileBlocks.end());
+            }
+            for (const char *file : SAMPLE_PCAP_FILES) {
+                const std::vector<std::vector<unsigned char>> payloads = readPcapPayloads(file);
+                EXPECT_FALSE(payloads.empty()) << file;
+                for (const auto &payload : payloads) {
+                    const std::vector<std::vector<unsigned char>> payloadBlocks = splitBlocks(payload);
+                    blocks.insert(blocks.end(), payloadBlocks.begin(), payloadBlocks.end());
+                }
+            }
+
+            std::vector<Item> items;
+            InputParser parser(&definition);
+            for (const auto &block : blocks) {
+                AsterixData *pData = parser.parsePacket(block.data(), static_cast<unsigned int>(block.size()), 0.0);
+                if (pData == nullptr) {
+                    continue;
+                }
+                for (auto *dataBlock : pData->m_lDataBlocks) {
+                    for (auto *record : dataBlock->m_lDataRecords) {
+                        for (auto *item : record->m_lDataItems) {
+                            if (item->getLength() > 0) {
+                                items.push_back({item->m_pDescription, {}});
+                                item->getBinary(items.back().m_vData);
+                            }
+                        }
+                    }
+                }
+                delete pData;
+            }
+            return items;
+        }
+    };
+
+    std::string decode(AsterixDefinition &definition, const std::vector<unsigned char> &data,
+                       unsigned int formatType) {
+        InputParser parser(&definition);
+        parser.setGeneratedDecoders(false);
+        return testutil::getText(parser, data, formatType);
+    }
+}
+
+/**
+ * Test Case: TC-CPP-PROG-001
+ * Requirement: REQ-HLR-PERF-003
+ * Description: Verify items of all loaded categories are compiled
+ */
+TEST_F(ItemProgramTest, AllItemsCompiled) {
+    size_t nItems = 0;
+    for (int i = 0; i < 256; i++) {
+        if (!definition.CategoryDefined(i)) {
+            continue;
+        }
+        Category *pCategory = definition.getCategory(i);
+        for (auto *di : pCategory->m_lDataItems) {
+            if (di->m_pFormat == nullptr) {
+                continue;
+            }
+            EXPECT_NE(di->m_pProgram, nullptr) << "CAT" << i << "/I" << di->m_strID;
+            nItems++;
+        }
+    }
+    EXPECT_GT(nItems, 500u);
+}
+
+/**
+ * Test Case: TC-CPP-PROG-002
+ * Requirement: REQ-LLR-PERF-PROG-001
+ * Description: Verify program lengths equal format lengths for all items of the sample data
+ */
+TEST_F(ItemProgramTest, LengthsMatchFormats) {
+    const std::vector<Item> items = sampleItems();
+    ASSERT_GT(items.size(), 1000u);
+    for (const Item &item : items) {
+        ASSERT_NE(item.m_pDescription->m_pProgram, nullptr);
+        const long len = static_cast<long>(item.m_vData.size());
+        const long expected = item.m_pDescription->m_pFormat->getLength(item.m_vData.data());
+        EXPECT_EQ(expected, len) << "I" << item.m_pDescription->m_strID;
+        EXPECT_EQ(item.m_pDescription->m_pProgram->getLength(item.m_vData.data(), len), expected)
+                            << "I" << item.m_pDescription->m_strID;
+    }
+}
+
+/**
+ * Test Case: TC-CPP-PROG-003
+ * Requirement: REQ-LLR-PERF-PROG-002
+ * Description: Verify decoded fields and values equal those of the format classes for the sample data
+ */
+TEST_F(ItemProgramTest, FieldsMatchFormats) {
+    std::vector<ItemField> fields;
+    std::vector<ItemField> expected;
+    size_t nFields = 0;
+    for (const Item &item : sampleItems()) {
+        const std::string name = "I" + item.m_pDescription->m_strID;
+        const long len = static_cast<long>(item.m_vData.size());
+        unsigned char *pData = const_cast<unsigned char *>(item.m_vData.data());
+        fields.clear();
+        expected.clear();
+        EXPECT_EQ(item.m_pDescription->m_pProgram->decode(pData, len, fields), len) << name;
+        walk(item.m_pDescription->m_pFormat, pData, expected);
+        ASSERT_EQ(fields.size(), expected.size()) << name;
+
+        for (size_t i = 0; i < fields.size(); i++) {
+            const ItemField &field = fields[i];
+            ASSERT_EQ(field.m_pBits, expected[i].m_pBits) << name << " field " << i;
+            ASSERT_EQ(field.m_pPart, expected[i].m_pPart) << name << " field " << i;
+            ASSERT_EQ(field.m_nPartLength, expected[i].m_nPartLength) << name << " field " << i;
+            ASSERT_EQ(field.m_nFrom, expected[i].m_nFrom);
+            ASSERT_EQ(field.m_nTo, expected[i].m_nTo);
+
+            unsigned char *pPart = const_cast<unsigned char *>(field.m_pPart);
+            auto *bits = const_cast<DataItemBits *>(field.m_pBits);
+            if (field.getNBits() <= 32) {
+                EXPECT_EQ(field.getUnsigned(),
+                          bits->getUnsigned(pPart, field.m_nPartLength, field.m_nFrom, field.m_nTo))
+                                    << name << " " << bits->m_strShortName;
+                EXPECT_EQ(field.getSigned(),
+                          bits->getSigned(pPart, field.m_nPartLength, field.m_nFrom, field.m_nTo))
+                                    << name << " " << bits->m_strShortName;
+            } else if (field.getNBits() <= 64) {
+                EXPECT_EQ(field.getUnsigned(),
+                          bits->getUnsigned64(pPart, field.m_nPartLength, field.m_nFrom, field.m_nTo))
+                                    << name << " " << bits->m_strShortName;
+            }
+            nFields++;
+        }
+    }
+    EXPECT_GT(nFields, 10000u);
+}
+
+/**
+ * Test Case: TC-CPP-PROG-004
+ * Requirement: REQ-LLR-PERF-PROG-003
+ * Description: Verify truncated items report the length needed instead of reading beyond the data
+ */
+TEST_F(ItemProgramTest, TruncatedData) {
+    Category *pCategory = definition.getCategory(48);
+    // I048/020 variable: 1 byte with FX, then 1 byte without
+    const ItemProgram *pVariable = pCategory->getDataItemDescription("020")->m_pProgram.get();
+    ASSERT_NE(pVariable, nullptr);
+    const unsigned char variable[] = {0x01, 0x00};
+    EXPECT_EQ(pVariable->getLength(variable, 2), 2);
+    EXPECT_EQ(pVariable->getLength(variable, 1), 2);
+
+    // I048/250 repetitive: count, 8 byte Mode S MB data
+    const ItemProgram *pRepetitive = pCategory->getDataItemDescription("250")->m_pProgram.get();
+    ASSERT_NE(pRepetitive, nullptr);
+    const unsigned char repetitive[] = {0x02, 0, 0, 0, 0, 0, 0, 0, 0x40, 0, 0, 0, 0, 0, 0, 0, 0x50};
+    std::vector<ItemField> fields;
+    EXPECT_EQ(pRepetitive->getLength(repetitive, sizeof(repetitive)), 17);
+    EXPECT_EQ(pRepetitive->decode(repetitive, sizeof(repetitive), fields), 17);
+    EXPECT_FALSE(fields.empty());
+    EXPECT_EQ(pRepetitive->getLength(repetitive, 0), 1);
+    EXPECT_EQ(pRepetitive->getLength(repetitive, 10), 17);
+    fields.clear();
+    EXPECT_EQ(pRepetitive->decode(repetitive, 10, fields), 17);
+
+    // I048/130 compound: primary announces a secondary part beyond the data
+    const ItemProgram *pCompound = pCategory->getDataItemDescription("130")->m_pProgram.get();
+    ASSERT_NE(pCompound, nullptr);
+    const unsigned char compound[] = {0x80};
+    EXPECT_EQ(pCompound->getLength(compound, 1), 2);
+}
+
+/**
+ * Test Case: TC-CPP-PROG-005
+ * Requirement: REQ-LLR-PERF-PROG-001
+ * Description: Verify lengths the program cannot tell are left to the format classes
+ */
+TEST_F(ItemProgramTest, ZeroExplicitLength) {
+    // I021/RE explicit
+    DataItemDescription *pDescription = definition.getCategory(21)->getDataItemDescription("RE");
+    ASSERT_NE(pDescription->m_pProgram, nullptr);
+    const unsigned char data[] = {0x00, 0x00};
+    std::vector<ItemField> fields;
+    EXPECT_EQ(pDescription->m_pProgram->getLength(data, sizeof(data)), 0);
+    EXPECT_EQ(pDescription->m_pProgram->decode(data, sizeof(data), fields), 0);
+    EXPECT_EQ(pDescription->m_pFormat->getLength(data), 0);
+}
+
+/**
+ * Test Case: TC-CPP-PROG-006
+ * Requirement: REQ-LLR-PERF-PROG-002
+ * Description: Verify sample data decodes to the same output with and without item programs
+ */
+TEST_F(ItemProgramTest, SameOutputWithAndWithoutPrograms) {
+    AsterixDefinition formats;
+    formats.setItemPrograms(false);
+    ASSERT_TRUE(testutil::parseFiles(formats, testutil::definitionFiles()));
+    ASSERT_EQ(formats.getCategory(48)->getDataItemDescription("020")->m_pProgram, nullptr);
+
+    for (const char *file : SAMPLE_FILES) {
+        const std::vector<unsigned char> data = readFile(file);
+        ASSERT_FALSE(data.empty()) << file;
+        for (unsigned int formatType : {CAsterixFormat::ETxt, CAsterixFormat::EJSONE, CAsterixFormat::EXML}) {
+            const std::string compiled = decode(definition, data, formatType);
+            EXPECT_FALSE(compiled.empty()) << file;
+            EXPECT_EQ(compiled, decode(formats, data, formatType)) << file;
+        }
+    }
+}
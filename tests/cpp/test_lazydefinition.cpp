@@ -0,0 +1,143 @@
+/**
+ * Unit tests for loading category definitions on first use
+ * (AsterixDefinition::registerCategoryFile())
+ *
+ * Requirements Traceability:
+ * - REQ-HLR-PERF-004: Only categories present in the data are loaded
+ * - REQ-LLR-PERF-LAZY-001: The category of a definition file is read without parsing it
+ * - REQ-LLR-PERF-LAZY-002: Registered categories are loaded by the first lookup
+ * - REQ-LLR-PERF-LAZY-003: Lazily loaded definitions decode as eagerly loaded ones
+ * - REQ-LLR-PERF-LAZY-004: Concurrent lookups load a category once
+ *
+ * DO-278A AL-3 Compliance Testing
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AsterixDefinition.h"
+#include "XMLParser.h"
+#include "asterixformat.hxx"
+#include "test_helpers.h"
+
+namespace {
+    using testutil::definitionFiles;
+    using testutil::readFile;
+
+    std::string decode(AsterixDefinition &definition, const std::vector<unsigned char> &data,
+                       unsigned int formatType) {
+        InputParser parser(&definition);
+        return testutil::getText(parser, data, formatType);
+    }
+}
+
+/**
+ * Test Case: TC-CPP-LAZY-001
+ * Requirement: REQ-LLR-PERF-LAZY-001
+ * Description: Verify the category number is read from definition files
+ */
+TEST(LazyDefinitionTest, ReadCategoryId) {
+    EXPECT_EQ(XMLParser::ReadCategoryId("../asterix/config/asterix_cat048_1_30.xml"), 48);
+    EXPECT_EQ(XMLParser::ReadCategoryId("../asterix/config/asterix_cat001_1_4.xml"), 1);
+    EXPECT_EQ(XMLParser::ReadCategoryId("../asterix/config/asterix_bds.xml"), BDS_CAT_ID);
+    EXPECT_EQ(XMLParser::ReadCategoryId("../asterix/config/missing.xml"), -1);
+    EXPECT_EQ(XMLParser::ReadCategoryId("../asterix/sample_data/cat048.raw"), -1);
+    EXPECT_EQ(XMLParser::ReadCategoryId("../asterix/config/asterix.ini"), -1);
+}
+
+/**
+ * Test Case: TC-CPP-LAZY-002
+ * Requirement: REQ-LLR-PERF-LAZY-002
+ * Description: Verify registered categories are loaded only when looked up, with BDS on demand
+ */
+TEST(LazyDefinitionTest, LoadOnFirstUse) {
+    AsterixDefinition definition;
+    ASSERT_TRUE(testutil::registerFiles(definition, definitionFiles()));
+
+    // every setCategory() increments the revision
+    EXPECT_EQ(definition.getRevision(), 0u);
+    EXPECT_TRUE(definition.CategoryAvailable(48));
+    EXPECT_TRUE(definition.CategoryAvailable(62));
+    EXPECT_FALSE(definition.CategoryAvailable(99));
+    EXPECT_EQ(definition.getRevision(), 0u);
+
+    EXPECT_TRUE(definition.CategoryDefined(48));
+    EXPECT_EQ(definition.getRevision(), 1u);
+    EXPECT_EQ(definition.getCategory(48)->m_id, 48);
+    EXPECT_EQ(definition.getRevision(), 1u);
+
+    // CAT062 refers to BDS registers, loaded with it
+    Category *pCategory = definition.getCategory(62);
+    ASSERT_NE(pCategory, nullptr);
+    EXPECT_FALSE(pCategory->m_lDataItems.empty());
+    EXPECT_EQ(definition.getRevision(), 3u);
+    EXPECT_TRUE(definition.CategoryDefined(BDS_CAT_ID));
+    EXPECT_EQ(definition.getRevision(), 3u);
+
+    EXPECT_FALSE(definition.CategoryDefined(99));
+    EXPECT_TRUE(definition.compile("048/040.RHO").isValid());
+    EXPECT_EQ(definition.getRevision(), 3u);
+    EXPECT_TRUE(definition.compile("034/010.SAC").isValid());
+    EXPECT_EQ(definition.getRevision(), 4u);
+
+    definition.loadAllCategories();
+    EXPECT_EQ(definition.getRevision(), definitionFiles().size());
+}
+
+/**
+ * Test Case: TC-CPP-LAZY-003
+ * Requirement: REQ-LLR-PERF-LAZY-003
+ * Description: Verify sample data decodes the same with lazily and eagerly loaded definitions
+ */
+TEST(LazyDefinitionTest, SameOutputAsEager) {
+    AsterixDefinition eager;
+    ASSERT_TRUE(testutil::parseFiles(eager, definitionFiles()));
+
+    for (const char *file : {"../asterix/sample_data/cat034.raw", "../asterix/sample_data/cat048.raw",
+                             "../asterix/sample_data/cat062cat065.raw", "../asterix/sample_data/cat21_re.ast"}) {
+        const std::vector<unsigned char> data = readFile(file);
+        ASSERT_FALSE(data.empty()) << file;
+        AsterixDefinition lazy;
+        ASSERT_TRUE(testutil::registerFiles(lazy, definitionFiles()));
+        for (unsigned int formatType : {CAsterixFormat::ETxt, CAsterixFormat::EJSONE}) {
+            const std::string expected = decode(eager, data, formatType);
+            EXPECT_FALSE(expected.empty()) << file;
+            EXPECT_EQ(decode(lazy, data, formatType), expected) << file;
+        }
+        EXPECT_LT(lazy.getRevision(), 4u) << file;
+    }
+}
+
+/**
+ * Test Case: TC-CPP-LAZY-004
+ * Requirement: REQ-LLR-PERF-LAZY-004
+ * Description: Verify concurrent first lookups load the category once and agree on it
+ */
+TEST(LazyDefinitionTest, ConcurrentFirstUse) {
+    AsterixDefinition definition;
+    ASSERT_TRUE(testutil::registerFiles(definition, definitionFiles()));
+
+    constexpr int N_THREADS = 8;
+    std::vector<Category *> categories(N_THREADS, nullptr);
+    std::vector<char> defined(N_THREADS, 0);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < N_THREADS; i++) {
+        threads.emplace_back([&definition, &categories, &defined, i]() {
+            defined[i] = definition.CategoryDefined(62);
+            categories[i] = definition.getCategory(62);
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    for (int i = 0; i < N_THREADS; i++) {
+        EXPECT_TRUE(defined[i]);
+        EXPECT_EQ(categories[i], categories[0]);
+    }
+    ASSERT_NE(categories[0], nullptr);
+    EXPECT_FALSE(categories[0]->m_lDataItems.empty());
+    // BDS and CAT062, each once
+    EXPECT_EQ(definition.getRevision(), 2u);
+}
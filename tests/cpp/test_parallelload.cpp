@@ -0,0 +1,101 @@
+/**
+ * Unit tests for parsing definition files in parallel (XMLParser::ParseFiles())
+ *
+ * Requirements Traceability:
+ * - REQ-HLR-PERF-005: Definition files are parsed concurrently at startup
+ * - REQ-LLR-PERF-PARLOAD-001: Files parsed in parallel give the definitions of files parsed serially
+ * - REQ-LLR-PERF-PARLOAD-002: BDS registers are available to categories parsed in parallel
+ * - REQ-LLR-PERF-PARLOAD-003: Files which cannot be parsed are reported without losing the others
+ *
+ * DO-278A AL-3 Compliance Testing
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "AsterixDefinition.h"
+#include "XMLParser.h"
+#include "asterixformat.hxx"
+#include "test_helpers.h"
+
+namespace {
+    using testutil::definitionFiles;
+    using testutil::readFile;
+
+    std::string decode(AsterixDefinition &definition, const std::vector<unsigned char> &data,
+                       unsigned int formatType) {
+        InputParser parser(&definition);
+        return testutil::getText(parser, data, formatType);
+    }
+}
+
+/**
+ * Test Case: TC-CPP-PARLOAD-001
+ * Requirement: REQ-LLR-PERF-PARLOAD-001
+ * Description: Verify sample data decodes the same with files parsed in parallel and serially
+ */
+TEST(ParallelLoadTest, SameOutputAsSerial) {
+    AsterixDefinition serial;
+    ASSERT_TRUE(testutil::parseFiles(serial, definitionFiles()));
+
+    for (unsigned int nThreads : {1u, 4u, 0u}) {
+        AsterixDefinition parallel;
+        ASSERT_TRUE(XMLParser::ParseFiles(definitionFiles(), &parallel, nThreads));
+        // one setCategory() per file
+        EXPECT_EQ(parallel.getRevision(), serial.getRevision());
+        for (int i = 0; i < MAX_CATEGORIES; i++) {
+            EXPECT_EQ(parallel.CategoryDefined(i), serial.CategoryDefined(i)) << i;
+        }
+
+        for (const char *file : {"../asterix/sample_data/cat034.raw", "../asterix/sample_data/cat048.raw",
+                                 "../asterix/sample_data/cat062cat065.raw", "../asterix/sample_data/cat21_re.ast"}) {
+            const std::vector<unsigned char> data = readFile(file);
+            ASSERT_FALSE(data.empty()) << file;
+            for (unsigned int formatType : {CAsterixFormat::ETxt, CAsterixFormat::EJSONE}) {
+                const std::string expected = decode(serial, data, formatType);
+                EXPECT_FALSE(expected.empty()) << file;
+                EXPECT_EQ(decode(parallel, data, formatType), expected) << file << " threads " << nThreads;
+            }
+        }
+    }
+}
+
+/**
+ * Test Case: TC-CPP-PARLOAD-002
+ * Requirement: REQ-LLR-PERF-PARLOAD-002
+ * Description: Verify BDS registers are parsed before categories using them, wherever listed
+ */
+TEST(ParallelLoadTest, BDSParsedFirst) {
+    const std::string bds = "../asterix/config/asterix_bds.xml";
+    const std::vector<std::string> files = {"../asterix/config/asterix_cat062_1_19.xml", bds};
+
+    AsterixDefinition definition;
+    ASSERT_TRUE(XMLParser::ParseFiles(files, &definition, 2));
+    EXPECT_EQ(definition.getRevision(), 2u);
+    ASSERT_TRUE(definition.CategoryDefined(BDS_CAT_ID));
+    ASSERT_TRUE(definition.CategoryDefined(62));
+    EXPECT_TRUE(definition.getCategory(62)->m_bFrozen);
+    EXPECT_TRUE(definition.compile("062/380.ADR").isValid());
+}
+
+/**
+ * Test Case: TC-CPP-PARLOAD-003
+ * Requirement: REQ-LLR-PERF-PARLOAD-003
+ * Description: Verify a missing or invalid file fails the load and the other files are still parsed
+ */
+TEST(ParallelLoadTest, FailedFile) {
+    const std::vector<std::string> files = {"../asterix/config/asterix_cat048_1_30.xml",
+                                            "../asterix/config/missing.xml",
+                                            "../asterix/config/asterix.ini",
+                                            "../asterix/config/asterix_cat034_1_29.xml"};
+
+    AsterixDefinition definition;
+    EXPECT_FALSE(XMLParser::ParseFiles(files, &definition, 4));
+    EXPECT_TRUE(definition.CategoryDefined(48));
+    EXPECT_TRUE(definition.CategoryDefined(34));
+    EXPECT_EQ(definition.getRevision(), 2u);
+
+    AsterixDefinition empty;
+    EXPECT_TRUE(XMLParser::ParseFiles({}, &empty));
+    EXPECT_EQ(empty.getRevision(), 0u);
+}
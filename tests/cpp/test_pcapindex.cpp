@@ -0,0 +1,196 @@
+/**
+ * Unit tests for CPcapIndex (PCAP sidecar index)
+ *
+ * Requirements Traceability:
+ * - REQ-HLR-FMT-001: Support PCAP encapsulation format
+ * - REQ-LLR-FMT-PCAP-004: Seek in PCAP file by capture time or packet number
+ *
+ * DO-278A AL-3 Compliance Testing
+ */
+
+#include <gtest/gtest.h>
+#include "pcapindex.hxx"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+class PcapIndexTest : public ::testing::Test {
+protected:
+    // Index is written next to the capture, so work on a copy (one per test, tests may run in parallel)
+    std::string pcapFile;
+
+    void SetUp() override {
+        pcapFile = std::string("test_pcapindex_") +
+                   ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".pcap";
+        std::ifstream in("../asterix/sample_data/cat_034_048.pcap", std::ios::binary);
+        ASSERT_TRUE(in.is_open());
+        std::vector<char> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::ofstream out(pcapFile, std::ios::binary);
+        out.write(data.data(), static_cast<std::streamsize>(data.size()));
+    }
+
+    void TearDown() override {
+        std::remove(pcapFile.c_str());
+        std::remove(CPcapIndex::IndexFileName(pcapFile.c_str()).c_str());
+    }
+};
+
+/**
+ * Test Case: TC-CPP-PCAPIDX-001
+ * Requirement: REQ-LLR-FMT-PCAP-004
+ * Description: Build index and count packets and data blocks per category
+ */
+TEST_F(PcapIndexTest, BuildCountsPacketsAndCategories) {
+    CPcapIndex index;
+    ASSERT_TRUE(index.Build(pcapFile.c_str(), 10));
+
+    EXPECT_EQ(index.GetNPackets(), 100u);
+    EXPECT_EQ(index.GetCheckpoints().size(), 10u);
+    EXPECT_EQ(index.GetCategoryCount(34), 34u);
+    EXPECT_EQ(index.GetCategoryCount(48), 86u);
+    EXPECT_EQ(index.GetCategoryCount(62), 0u);
+    EXPECT_LE(index.GetFirstTime(), index.GetLastTime());
+
+    // First checkpoint is the first record, just after the file header
+    EXPECT_EQ(index.GetCheckpoints()[0].packetNo, 0u);
+    EXPECT_EQ(index.GetCheckpoints()[0].offset, 24u);
+}
+
+/**
+ * Test Case: TC-CPP-PCAPIDX-002
+ * Requirement: REQ-LLR-FMT-PCAP-004
+ * Description: Saved index is loaded back unchanged
+ */
+TEST_F(PcapIndexTest, SaveAndLoad) {
+    CPcapIndex built;
+    ASSERT_TRUE(built.Build(pcapFile.c_str(), 10));
+    ASSERT_TRUE(built.Save());
+
+    CPcapIndex loaded;
+    ASSERT_TRUE(loaded.Load(pcapFile.c_str()));
+    EXPECT_EQ(loaded.GetNPackets(), built.GetNPackets());
+    EXPECT_DOUBLE_EQ(loaded.GetFirstTime(), built.GetFirstTime());
+    EXPECT_DOUBLE_EQ(loaded.GetLastTime(), built.GetLastTime());
+    EXPECT_EQ(loaded.GetCategoryCount(48), built.GetCategoryCount(48));
+    ASSERT_EQ(loaded.GetCheckpoints().size(), built.GetCheckpoints().size());
+    for (size_t i = 0; i < loaded.GetCheckpoints().size(); i++) {
+        EXPECT_EQ(loaded.GetCheckpoints()[i].offset, built.GetCheckpoints()[i].offset);
+    }
+}
+
+/**
+ * Test Case: TC-CPP-PCAPIDX-003
+ * Requirement: REQ-LLR-FMT-PCAP-004
+ * Description: Index is rejected when missing or when the capture has changed
+ */
+TEST_F(PcapIndexTest, LoadRejectsMissingOrStaleIndex) {
+    CPcapIndex index;
+    EXPECT_FALSE(index.Load(pcapFile.c_str()));
+
+    ASSERT_TRUE(index.Build(pcapFile.c_str()));
+    ASSERT_TRUE(index.Save());
+
+    std::ofstream out(pcapFile, std::ios::binary | std::ios::app);
+    out.write("\0\0\0\0", 4);
+    out.close();
+
+    CPcapIndex stale;
+    EXPECT_FALSE(stale.Load(pcapFile.c_str()));
+}
+
+/**
+ * Test Case: TC-CPP-PCAPIDX-004
+ * Requirement: REQ-LLR-FMT-PCAP-004
+ * Description: Lookup returns checkpoint at or before requested packet and time
+ */
+TEST_F(PcapIndexTest, Lookup) {
+    CPcapIndex index;
+    ASSERT_TRUE(index.Build(pcapFile.c_str(), 10));
+
+    const CPcapIndex::SCheckpoint *cp = index.LookupPacket(0);
+    ASSERT_NE(cp, nullptr);
+    EXPECT_EQ(cp->packetNo, 0u);
+
+    cp = index.LookupPacket(57);
+    ASSERT_NE(cp, nullptr);
+    EXPECT_EQ(cp->packetNo, 50u);
+
+    cp = index.LookupPacket(1000);
+    ASSERT_NE(cp, nullptr);
+    EXPECT_EQ(cp->packetNo, 90u);
+
+    for (const auto &checkpoint : index.GetCheckpoints()) {
+        cp = index.LookupTime(checkpoint.time);
+        ASSERT_NE(cp, nullptr);
+        EXPECT_LE(cp->time, checkpoint.time);
+        EXPECT_LE(cp->packetNo, checkpoint.packetNo);
+    }
+
+    cp = index.LookupTime(index.GetFirstTime() - 3600);
+    ASSERT_NE(cp, nullptr);
+    EXPECT_EQ(cp->packetNo, 0u);
+}
+
+/**
+ * Test Case: TC-CPP-PCAPIDX-005
+ * Requirement: REQ-HLR-ERR-001
+ * Description: Building index of a non-PCAP file fails
+ */
+TEST_F(PcapIndexTest, BuildRejectsNonPcap) {
+    std::ofstream out(pcapFile, std::ios::binary | std::ios::trunc);
+    out << "this is not a pcap file at all";
+    out.close();
+
+    CPcapIndex index;
+    EXPECT_FALSE(index.Build(pcapFile.c_str()));
+    EXPECT_FALSE(index.Build("no_such_file.pcap"));
+}
+
+/**
+ * Test Case: TC-CPP-PCAPIDX-006
+ * Requirement: REQ-LLR-FMT-PCAP-004
+ * Description: Index with a valid header but damaged checkpoint interval or table is rejected
+ */
+TEST_F(PcapIndexTest, LoadRejectsDamagedIndex) {
+    CPcapIndex index;
+    ASSERT_TRUE(index.Build(pcapFile.c_str(), 10));
+    ASSERT_TRUE(index.Save());
+
+    const std::string indexFile = CPcapIndex::IndexFileName(pcapFile.c_str());
+    std::ifstream in(indexFile, std::ios::binary);
+    const std::vector<char> saved((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+
+    auto writeIndex = [&indexFile](const std::vector<char> &data) {
+        std::ofstream out(indexFile, std::ios::binary | std::ios::trunc);
+        out.write(data.data(), static_cast<std::streamsize>(data.size()));
+    };
+
+    // header layout: interval at offset 24, number of checkpoints at offset 56
+    std::vector<char> damaged = saved;
+    std::fill(damaged.begin() + 24, damaged.begin() + 28, 0);
+    writeIndex(damaged);
+    EXPECT_FALSE(CPcapIndex().Load(pcapFile.c_str()));
+
+    damaged = saved;
+    std::fill(damaged.begin() + 56, damaged.begin() + 64, static_cast<char>(0x7F));
+    writeIndex(damaged);
+    EXPECT_FALSE(CPcapIndex().Load(pcapFile.c_str()));
+
+    damaged.assign(saved.begin(), saved.end() - 1);
+    writeIndex(damaged);
+    EXPECT_FALSE(CPcapIndex().Load(pcapFile.c_str()));
+
+    damaged = saved;
+    damaged.insert(damaged.end(), 24, 0);
+    writeIndex(damaged);
+    EXPECT_FALSE(CPcapIndex().Load(pcapFile.c_str()));
+
+    writeIndex(saved);
+    CPcapIndex loaded;
+    ASSERT_TRUE(loaded.Load(pcapFile.c_str()));
+    EXPECT_EQ(loaded.GetCheckpoints().size(), 10u);
+}
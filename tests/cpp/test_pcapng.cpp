@@ -0,0 +1,157 @@
+/**
+ * Unit tests for reading pcapng captures in the PCAP subformat
+ *
+ * Requirements Traceability:
+ * - REQ-HLR-FMT-001: Support PCAP encapsulation format
+ * - REQ-LLR-FMT-PCAP-005: Read capture time of pcapng packets in any interface time resolution
+ *
+ * DO-278A AL-3 Compliance Testing
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "AsterixData.h"
+#include "AsterixDefinition.h"
+#include "DataBlock.h"
+#include "XMLParser.h"
+#include "asterixformatdescriptor.hxx"
+#include "asterixpcapsubformat.hxx"
+#include "descriptor.hxx"
+#include "diskdevice.hxx"
+
+namespace {
+    // tests may run in parallel in the same directory
+    std::string captureFile() {
+        return std::string("test_pcapng_") + ::testing::UnitTest::GetInstance()->current_test_info()->name() +
+               ".pcapng";
+    }
+
+    void put16(std::vector<unsigned char> &out, uint16_t v) {
+        out.push_back(static_cast<unsigned char>(v));
+        out.push_back(static_cast<unsigned char>(v >> 8));
+    }
+
+    void put32(std::vector<unsigned char> &out, uint32_t v) {
+        put16(out, static_cast<uint16_t>(v));
+        put16(out, static_cast<uint16_t>(v >> 16));
+    }
+
+    void putBlock(std::vector<unsigned char> &out, uint32_t type, std::vector<unsigned char> body) {
+        body.resize((body.size() + 3) & ~static_cast<size_t>(3), 0);
+        const auto len = static_cast<uint32_t>(body.size() + 12);
+        put32(out, type);
+        put32(out, len);
+        out.insert(out.end(), body.begin(), body.end());
+        put32(out, len);
+    }
+
+    // Section with one Ethernet interface of given if_tsresol and one UDP packet with a CAT048 block
+    void writeCapture(unsigned char tsresol, uint64_t ts) {
+        std::vector<unsigned char> file;
+
+        std::vector<unsigned char> shb;
+        put32(shb, 0x1A2B3C4D);
+        put16(shb, 1);
+        put16(shb, 0);
+        put32(shb, 0xFFFFFFFF);
+        put32(shb, 0xFFFFFFFF);
+        putBlock(file, 0x0A0D0D0A, shb);
+
+        std::vector<unsigned char> idb;
+        put16(idb, 1); // Ethernet
+        put16(idb, 0);
+        put32(idb, 65535);
+        put16(idb, 9); // if_tsresol
+        put16(idb, 1);
+        idb.insert(idb.end(), {tsresol, 0, 0, 0});
+        put32(idb, 0); // opt_endofopt
+        putBlock(file, 1, idb);
+
+        const std::vector<unsigned char> asterix = {0x30, 0x00, 0x06, 0x80, 0x19, 0x0C};
+        std::vector<unsigned char> packet = {
+                0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x08, 0x00,
+                0x45, 0, 0, static_cast<unsigned char>(28 + asterix.size()), 0, 0, 0x40, 0, 64, 17, 0, 0,
+                127, 0, 0, 1, 127, 0, 0, 1,
+                0x21, 0x98, 0x21, 0x98, 0, static_cast<unsigned char>(8 + asterix.size()), 0, 0};
+        packet.insert(packet.end(), asterix.begin(), asterix.end());
+
+        std::vector<unsigned char> epb;
+        put32(epb, 0);
+        put32(epb, static_cast<uint32_t>(ts >> 32));
+        put32(epb, static_cast<uint32_t>(ts));
+        put32(epb, static_cast<uint32_t>(packet.size()));
+        put32(epb, static_cast<uint32_t>(packet.size()));
+        epb.insert(epb.end(), packet.begin(), packet.end());
+        putBlock(file, 6, epb);
+
+        FILE *f = fopen(captureFile().c_str(), "wb");
+        ASSERT_NE(f, nullptr);
+        fwrite(file.data(), 1, file.size(), f);
+        fclose(f);
+    }
+
+    // Capture time and data block timestamp (milliseconds since midnight) of the packet
+    void readCapture(double &packetTime, double &blockTime) {
+        auto *pDefinition = new AsterixDefinition();
+        FILE *f = fopen("../asterix/config/asterix_cat048_1_30.xml", "r");
+        ASSERT_NE(f, nullptr);
+        XMLParser parser;
+        ASSERT_TRUE(parser.Parse(f, pDefinition, "asterix_cat048_1_30.xml"));
+        fclose(f);
+        CAsterixFormatDescriptor descriptor(pDefinition);
+
+        const std::string input = captureFile() + "|0|";
+        CDescriptor deviceDescriptor(input.c_str(), "|");
+        CDiskDevice device(deviceDescriptor);
+        ASSERT_TRUE(device.IsOpened());
+
+        bool discard = false;
+        ASSERT_TRUE(CAsterixPcapSubformat::ReadPacket(descriptor, device, discard));
+        packetTime = descriptor.GetTimeStamp();
+        ASSERT_NE(descriptor.m_pAsterixData, nullptr);
+        ASSERT_EQ(descriptor.m_pAsterixData->m_lDataBlocks.size(), 1u);
+        blockTime = descriptor.m_pAsterixData->m_lDataBlocks.front()->m_nTimestamp;
+    }
+}
+
+/**
+ * Test Case: TC-CPP-PCAPNG-001
+ * Requirement: REQ-LLR-FMT-PCAP-005
+ * Description: Verify capture time of a 2^-20 s resolution interface, fraction just below a second
+ */
+TEST(PcapNgTest, BinaryResolution20) {
+    const uint64_t rate = 1ULL << 20;
+    writeCapture(0x80 | 20, 1000 * rate + rate - 1);
+
+    double packetTime = 0;
+    double blockTime = 0;
+    readCapture(packetTime, blockTime);
+    EXPECT_NEAR(packetTime, 1000.999999, 1e-6);
+    // 1000 s and 999 ms since midnight, not 1001.048 s
+    EXPECT_EQ(blockTime, 1000999.0);
+    std::remove(captureFile().c_str());
+}
+
+/**
+ * Test Case: TC-CPP-PCAPNG-002
+ * Requirement: REQ-LLR-FMT-PCAP-005
+ * Description: Verify capture time of 2^-30 s and 10^-9 s resolution interfaces
+ */
+TEST(PcapNgTest, HighResolutions) {
+    const uint64_t binaryRate = 1ULL << 30;
+    writeCapture(0x80 | 30, 2000 * binaryRate + binaryRate / 2);
+    double packetTime = 0;
+    double blockTime = 0;
+    readCapture(packetTime, blockTime);
+    EXPECT_NEAR(packetTime, 2000.5, 1e-6);
+    EXPECT_EQ(blockTime, 2000500.0);
+
+    writeCapture(9, 3000ULL * 1000000000 + 250000000);
+    readCapture(packetTime, blockTime);
+    EXPECT_NEAR(packetTime, 3000.25, 1e-6);
+    EXPECT_EQ(blockTime, 3000250.0);
+    std::remove(captureFile().c_str());
+}
@@ -0,0 +1,154 @@
+/**
+ * Unit tests for CRecordDecoder (record decoders generated from category definitions)
+ *
+ * Requirements Traceability:
+ * - REQ-HLR-PERF-001: Decode high-volume categories with decoders generated at build time
+ * - REQ-LLR-PERF-GEN-001: Generated decoder is used only when it matches the loaded definition
+ * - REQ-LLR-PERF-GEN-002: Generated decoder decodes records as the interpreter does
+ *
+ * DO-278A AL-3 Compliance Testing
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "AsterixData.h"
+#include "AsterixDefinition.h"
+#include "DataItemDescription.h"
+#include "DataItemFormatFixed.h"
+#include "InputParser.h"
+#include "asterixformat.hxx"
+#include "recorddecoder.hxx"
+#include "test_helpers.h"
+
+namespace {
+    using testutil::readFile;
+
+    class RecordDecoderTest : public ::testing::Test {
+    protected:
+        AsterixDefinition definition;
+
+        void SetUp() override {
+            if (CRecordDecoder::GetNGenerated() == 0) {
+                GTEST_SKIP() << "built without generated decoders";
+            }
+            ASSERT_TRUE(testutil::parseFiles(definition, {"../asterix/config/asterix_bds.xml",
+                                                          "../asterix/config/asterix_cat021_2_6.xml",
+                                                          "../asterix/config/asterix_cat048_1_30.xml",
+                                                          "../asterix/config/asterix_cat062_1_19.xml",
+                                                          "../asterix/config/asterix_cat065_1_5.xml"}));
+        }
+
+        std::string decode(bool bGenerated, const std::vector<unsigned char> &data, unsigned int formatType) {
+            InputParser parser(&definition);
+            parser.setGeneratedDecoders(bGenerated);
+            return testutil::getText(parser, data, formatType);
+        }
+    };
+}
+
+/**
+ * Test Case: TC-CPP-RECDEC-001
+ * Requirement: REQ-LLR-PERF-GEN-001
+ * Description: Decoders are bound to shipped CAT021/048/062 definitions only
+ */
+TEST_F(RecordDecoderTest, MatchesShippedDefinitions) {
+    for (int cat : {21, 48, 62}) {
+        CRecordDecoder *pDecoder = CRecordDecoder::Create(definition.getCategory(cat));
+        ASSERT_NE(pDecoder, nullptr) << "CAT" << cat;
+        EXPECT_EQ(pDecoder->GetCategory(), definition.getCategory(cat));
+        EXPECT_EQ(pDecoder->GetVersion(), definition.getCategory(cat)->m_strVer);
+        delete pDecoder;
+    }
+    EXPECT_EQ(CRecordDecoder::Create(definition.getCategory(65)), nullptr);
+    EXPECT_EQ(CRecordDecoder::Create(definition.getCategory(1)), nullptr);
+    EXPECT_EQ(CRecordDecoder::Create(nullptr), nullptr);
+
+    CRecordDecoder *pDecoder = CRecordDecoder::Create(definition.getCategory(48));
+    ASSERT_NE(pDecoder, nullptr);
+    const UAP *pUAP = definition.getCategory(48)->m_lUAPs.front();
+    EXPECT_EQ(pDecoder->GetUAPIndex(pUAP), 0);
+    EXPECT_EQ(pDecoder->GetUAPIndex(nullptr), -1);
+    ASSERT_NE(pDecoder->GetDescription(0, 1), nullptr);
+    EXPECT_EQ(pDecoder->GetDescription(0, 1)->m_strID, "010");
+    EXPECT_EQ(pDecoder->GetDescription(0, 0), nullptr);
+    EXPECT_EQ(pDecoder->GetDescription(0, 100), nullptr);
+
+    // I020 Target Report Descriptor, FX extends item to 2 octets
+    const unsigned char i020[] = {0xA1, 0x40};
+    EXPECT_EQ(pDecoder->ItemLength(0, 3, i020, 2), 2);
+    EXPECT_GT(pDecoder->ItemLength(0, 3, i020, 1), 1);
+    delete pDecoder;
+}
+
+/**
+ * Test Case: TC-CPP-RECDEC-002
+ * Requirement: REQ-LLR-PERF-GEN-001
+ * Description: Changed definition no longer matches and is decoded by the interpreter
+ */
+TEST_F(RecordDecoderTest, ChangedDefinitionNotMatched) {
+    Category *pCategory = definition.getCategory(48);
+    const std::string signature = CRecordDecoder::Signature(pCategory);
+    EXPECT_EQ(signature.compare(0, 7, "U0,0,0["), 0);
+
+    DataItemDescription *pDescription = pCategory->findDataItemDescription("040");
+    ASSERT_NE(pDescription, nullptr);
+    ASSERT_TRUE(pDescription->m_pFormat->isFixed());
+    auto *pFixed = static_cast<DataItemFormatFixed *>(pDescription->m_pFormat);
+    pFixed->m_nLength++;
+    EXPECT_NE(CRecordDecoder::Signature(pCategory), signature);
+    EXPECT_EQ(CRecordDecoder::Create(pCategory), nullptr);
+    pFixed->m_nLength--;
+    EXPECT_EQ(CRecordDecoder::Signature(pCategory), signature);
+
+    // reloading a category replaces it, decoders bound before are released
+    const unsigned int revision = definition.getRevision();
+    ASSERT_TRUE(testutil::parseFiles(definition, {"../asterix/config/asterix_cat048_1_30.xml"}));
+    EXPECT_NE(definition.getRevision(), revision);
+    EXPECT_NE(definition.getCategory(48), nullptr);
+}
+
+/**
+ * Test Case: TC-CPP-RECDEC-003
+ * Requirement: REQ-LLR-PERF-GEN-002
+ * Description: Sample data decodes to the same output with generated decoders and interpreter
+ */
+TEST_F(RecordDecoderTest, SameOutputAsInterpreter) {
+    for (const char *file : {"../asterix/sample_data/cat048.raw", "../asterix/sample_data/cat062cat065.raw",
+                             "../asterix/sample_data/cat21_re.ast"}) {
+        const std::vector<unsigned char> data = readFile(file);
+        ASSERT_FALSE(data.empty()) << file;
+        for (unsigned int formatType : {CAsterixFormat::ETxt, CAsterixFormat::EJSONE, CAsterixFormat::EXML}) {
+            const std::string expected = decode(false, data, formatType);
+            EXPECT_FALSE(expected.empty()) << file;
+            EXPECT_EQ(decode(true, data, formatType), expected) << file;
+        }
+    }
+}
+
+/**
+ * Test Case: TC-CPP-RECDEC-004
+ * Requirement: REQ-LLR-PERF-GEN-002
+ * Description: Record cut inside an item is rejected by generated decoder as by interpreter
+ */
+TEST_F(RecordDecoderTest, TruncatedRecord) {
+    std::vector<unsigned char> data = readFile("../asterix/sample_data/cat048.raw");
+    ASSERT_GT(data.size(), 0x20u);
+    data[1] = 0x00;
+    data[2] = 0x20; // block length 32, record is cut inside I250
+    data.resize(0x20);
+
+    std::vector<size_t> nRecords;
+    for (bool bGenerated : {false, true}) {
+        InputParser parser(&definition);
+        parser.setGeneratedDecoders(bGenerated);
+        AsterixData *pData = parser.parsePacket(data.data(), static_cast<unsigned int>(data.size()), 0.0);
+        ASSERT_NE(pData, nullptr);
+        ASSERT_EQ(pData->m_lDataBlocks.size(), 1u);
+        ASSERT_FALSE(pData->m_lDataBlocks.front()->m_lDataRecords.empty());
+        EXPECT_FALSE(pData->m_lDataBlocks.front()->m_lDataRecords.front()->m_bFormatOK);
+        nRecords.push_back(pData->m_lDataBlocks.front()->m_lDataRecords.size());
+        delete pData;
+    }
+    EXPECT_EQ(nRecords[0], nRecords[1]);
+}
@@ -0,0 +1,98 @@
+/**
+ * Unit tests for CReplayScheduler (synchronous replay pacing)
+ *
+ * Requirements Traceability:
+ * - REQ-HLR-IO-002: Replay recorded data with original timing
+ * - REQ-LLR-IO-REPLAY-001: Replay at configurable speed without drift
+ *
+ * DO-278A AL-3 Compliance Testing
+ */
+
+#include <gtest/gtest.h>
+#include "replayscheduler.hxx"
+
+namespace {
+    double elapsed(int64_t start) {
+        return (CReplayScheduler::Now() - start) / 1e9;
+    }
+}
+
+/**
+ * Test Case: TC-CPP-REPLAY-001
+ * Requirement: REQ-LLR-IO-REPLAY-001
+ * Description: Packets are released at capture time offsets divided by speed
+ */
+TEST(ReplaySchedulerTest, PacesBySpeed) {
+    CReplayScheduler scheduler(10.0);
+    const double base = 1700000000.0;
+
+    const int64_t start = CReplayScheduler::Now();
+    for (int i = 0; i <= 10; i++) {
+        scheduler.WaitFor(base + i * 0.1); // 1 s of capture time
+    }
+    const double wall = elapsed(start);
+
+    EXPECT_GE(wall, 0.099);
+    EXPECT_LT(wall, 0.5);
+    EXPECT_EQ(scheduler.GetStats().nPackets, 11u);
+    EXPECT_DOUBLE_EQ(scheduler.GetStats().captureSpan, 1.0);
+    EXPECT_GT(scheduler.GetAchievedSpeed(), 2.0);
+    EXPECT_LE(scheduler.GetAchievedSpeed(), 10.1);
+}
+
+/**
+ * Test Case: TC-CPP-REPLAY-002
+ * Requirement: REQ-LLR-IO-REPLAY-001
+ * Description: Packets of a burst and late packets are released without waiting
+ */
+TEST(ReplaySchedulerTest, BurstIsNotDelayed) {
+    CReplayScheduler scheduler(1.0);
+    const double base = 1700000000.0;
+
+    const int64_t start = CReplayScheduler::Now();
+    for (int i = 0; i < 100; i++) {
+        scheduler.WaitFor(base);
+    }
+    scheduler.WaitFor(base - 0.5); // out of order
+    EXPECT_LT(elapsed(start), 0.1);
+}
+
+/**
+ * Test Case: TC-CPP-REPLAY-003
+ * Requirement: REQ-LLR-IO-REPLAY-001
+ * Description: Capture time jumping back (loop) or Reset() starts new schedule
+ */
+TEST(ReplaySchedulerTest, Reanchor) {
+    CReplayScheduler scheduler(100.0);
+    const double base = 1700000000.0;
+
+    scheduler.WaitFor(base);
+    scheduler.WaitFor(base + 1.0);
+
+    // Without re-anchoring this packet would be due 1 s (10 ms at 100x) in the past
+    // and the next one 2 s after it
+    const int64_t start = CReplayScheduler::Now();
+    scheduler.WaitFor(base - 3600);
+    scheduler.WaitFor(base - 3600 + 1.0);
+    const double wall = elapsed(start);
+    EXPECT_GE(wall, 0.0099);
+    EXPECT_LT(wall, 0.5);
+    EXPECT_DOUBLE_EQ(scheduler.GetStats().captureSpan, 1.0);
+
+    scheduler.Reset();
+    const int64_t again = CReplayScheduler::Now();
+    scheduler.WaitFor(base + 7200);
+    EXPECT_LT(elapsed(again), 0.1);
+    EXPECT_EQ(scheduler.GetStats().nPackets, 5u);
+}
+
+/**
+ * Test Case: TC-CPP-REPLAY-004
+ * Requirement: REQ-LLR-IO-REPLAY-001
+ * Description: Speed factor is limited to the supported range
+ */
+TEST(ReplaySchedulerTest, SpeedLimits) {
+    EXPECT_DOUBLE_EQ(CReplayScheduler(0.001).GetSpeed(), CReplayScheduler::MIN_SPEED);
+    EXPECT_DOUBLE_EQ(CReplayScheduler(1000).GetSpeed(), CReplayScheduler::MAX_SPEED);
+    EXPECT_DOUBLE_EQ(CReplayScheduler(2.5).GetSpeed(), 2.5);
+}
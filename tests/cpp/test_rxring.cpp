@@ -0,0 +1,234 @@
+/**
+ * Unit tests for CRxRingDevice (receive thread with lock-free SPSC ring)
+ *
+ * Requirements Traceability:
+ * - REQ-HLR-IO-003: Receive packets in a dedicated thread decoupled from parsing
+ * - REQ-LLR-IO-RXRING-001: Packets are delivered in order across ring wrap-around
+ * - REQ-LLR-IO-RXRING-002: Packets arriving at a full ring are dropped and counted
+ * - REQ-LLR-IO-RXRING-003: Ring occupancy and high watermark are reported
+ *
+ * DO-278A AL-3 Compliance Testing
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "rxringdevice.hxx"
+
+namespace {
+    constexpr unsigned int PACKET_SIZE = 64;
+
+    // Packet device fed by the test
+    class CQueueDevice : public CBaseDevice {
+    public:
+        CQueueDevice() { _opened = true; }
+
+        void Push(const std::vector<unsigned char> &packet) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _packets.push_back(packet);
+            _cond.notify_one();
+        }
+
+        bool Read(void *data, size_t len) override { return Read(data, &len); }
+
+        bool Read(void *data, size_t *len) override {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_packets.empty() || _packets.front().size() > *len) {
+                return false;
+            }
+            *len = _packets.front().size();
+            memcpy(data, _packets.front().data(), *len);
+            _packets.pop_front();
+            return true;
+        }
+
+        bool Write(const void *, size_t) override { return false; }
+
+        bool Select(const unsigned int secondsToWait) override {
+            std::unique_lock<std::mutex> lock(_mutex);
+            return _cond.wait_for(lock, std::chrono::seconds(secondsToWait), [this] { return !_packets.empty(); });
+        }
+
+        bool IoCtrl(const unsigned int, const void *, size_t) override { return false; }
+
+        bool IsPacketDevice() override { return true; }
+
+        unsigned int MaxPacketSize() override { return PACKET_SIZE; }
+
+    private:
+        std::mutex _mutex;
+        std::condition_variable _cond;
+        std::deque<std::vector<unsigned char>> _packets;
+    };
+
+    std::vector<unsigned char> packet(unsigned int n) {
+        return std::vector<unsigned char>(1 + n % PACKET_SIZE, static_cast<unsigned char>(n));
+    }
+
+    bool waitForReceived(CRxRingDevice &ring, uint64_t nReceived) {
+        for (int i = 0; i < 500; i++) {
+            if (ring.GetNReceived() == nReceived) {
+                return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return false;
+    }
+
+    bool readPacket(CRxRingDevice &ring, std::vector<unsigned char> &data) {
+        data.resize(PACKET_SIZE);
+        size_t len = data.size();
+        if (!ring.Select(1) || !ring.Read(data.data(), &len)) {
+            return false;
+        }
+        data.resize(len);
+        return true;
+    }
+
+    class RxRingTest : public ::testing::Test {
+    protected:
+        CQueueDevice *pDevice = nullptr;
+        std::unique_ptr<CRxRingDevice> pRing;
+
+        void open(unsigned int nSlots) {
+            auto device = std::make_unique<CQueueDevice>();
+            pDevice = device.get();
+            pRing = std::make_unique<CRxRingDevice>(std::move(device), nSlots);
+        }
+    };
+}
+
+/**
+ * Test Case: TC-CPP-RXRING-001
+ * Requirement: REQ-LLR-IO-RXRING-001
+ * Description: Verify packets and their lengths are delivered in order while the ring wraps many times
+ */
+TEST_F(RxRingTest, InOrderAcrossWrapAround) {
+    open(3);
+    ASSERT_TRUE(pRing->IsOpened());
+    EXPECT_EQ(pRing->GetNSlots(), 4u);
+    EXPECT_EQ(pRing->MaxPacketSize(), PACKET_SIZE);
+
+    const unsigned int nPackets = 1000;
+    std::atomic<unsigned int> nRead{0};
+    std::thread producer([this, &nRead]() {
+        for (unsigned int n = 0; n < nPackets; n++) {
+            // never more unread packets than slots, drops are covered by TC-CPP-RXRING-002
+            while (n - nRead.load() >= pRing->GetNSlots()) {
+                std::this_thread::yield();
+            }
+            pDevice->Push(packet(n));
+        }
+    });
+
+    std::vector<unsigned char> data;
+    while (nRead.load() < nPackets && readPacket(*pRing, data)) {
+        EXPECT_EQ(data, packet(nRead.load())) << nRead.load();
+        EXPECT_GT(pRing->GetPacketTime(), 0.0);
+        nRead++;
+    }
+    producer.join();
+
+    EXPECT_EQ(nRead.load(), nPackets);
+    EXPECT_EQ(pRing->GetNReceived(), nPackets);
+    EXPECT_EQ(pRing->GetNDropped(), 0u);
+    EXPECT_EQ(pRing->GetOccupancy(), 0u);
+    EXPECT_LE(pRing->GetHighWatermark(), 4u);
+}
+
+/**
+ * Test Case: TC-CPP-RXRING-002
+ * Requirement: REQ-LLR-IO-RXRING-002, REQ-LLR-IO-RXRING-003
+ * Description: Verify the newest packets are dropped and counted while the ring is full,
+ *              and the ring accepts packets again once drained
+ */
+TEST_F(RxRingTest, FullRingDropsNewest) {
+    open(4);
+    for (unsigned int n = 0; n < 10; n++) {
+        pDevice->Push(packet(n));
+    }
+    ASSERT_TRUE(waitForReceived(*pRing, 10));
+    EXPECT_EQ(pRing->GetOccupancy(), 4u);
+    EXPECT_EQ(pRing->GetNDropped(), 6u);
+    EXPECT_EQ(pRing->GetHighWatermark(), 4u);
+
+    std::vector<unsigned char> data;
+    for (unsigned int n = 0; n < 4; n++) {
+        ASSERT_TRUE(readPacket(*pRing, data));
+        EXPECT_EQ(data, packet(n));
+    }
+    EXPECT_EQ(pRing->GetOccupancy(), 0u);
+    EXPECT_FALSE(pRing->Select(1));
+
+    pDevice->Push(packet(10));
+    ASSERT_TRUE(readPacket(*pRing, data));
+    EXPECT_EQ(data, packet(10));
+    EXPECT_EQ(pRing->GetNReceived(), 11u);
+    EXPECT_EQ(pRing->GetNDropped(), 6u);
+}
+
+/**
+ * Test Case: TC-CPP-RXRING-003
+ * Requirement: REQ-LLR-IO-RXRING-003
+ * Description: Verify occupancy follows the ring and the high watermark keeps its maximum
+ */
+TEST_F(RxRingTest, HighWatermark) {
+    open(8);
+    EXPECT_EQ(pRing->GetHighWatermark(), 0u);
+
+    for (unsigned int n = 0; n < 3; n++) {
+        pDevice->Push(packet(n));
+    }
+    ASSERT_TRUE(waitForReceived(*pRing, 3));
+    EXPECT_EQ(pRing->GetOccupancy(), 3u);
+    EXPECT_EQ(pRing->GetHighWatermark(), 3u);
+
+    std::vector<unsigned char> data;
+    ASSERT_TRUE(readPacket(*pRing, data));
+    EXPECT_EQ(pRing->GetOccupancy(), 2u);
+    ASSERT_TRUE(readPacket(*pRing, data));
+    ASSERT_TRUE(readPacket(*pRing, data));
+    EXPECT_EQ(pRing->GetOccupancy(), 0u);
+
+    pDevice->Push(packet(3));
+    ASSERT_TRUE(waitForReceived(*pRing, 4));
+    EXPECT_EQ(pRing->GetOccupancy(), 1u);
+    EXPECT_EQ(pRing->GetHighWatermark(), 3u);
+
+    for (unsigned int n = 4; n < 9; n++) {
+        pDevice->Push(packet(n));
+    }
+    ASSERT_TRUE(waitForReceived(*pRing, 9));
+    EXPECT_EQ(pRing->GetOccupancy(), 6u);
+    EXPECT_EQ(pRing->GetHighWatermark(), 6u);
+    EXPECT_EQ(pRing->GetNDropped(), 0u);
+}
+
+/**
+ * Test Case: TC-CPP-RXRING-004
+ * Requirement: REQ-LLR-IO-RXRING-001
+ * Description: Verify a packet larger than the read buffer is reported and released from the ring
+ */
+TEST_F(RxRingTest, BufferTooSmall) {
+    open(4);
+    pDevice->Push(packet(40));
+    pDevice->Push(packet(1));
+    ASSERT_TRUE(waitForReceived(*pRing, 2));
+
+    unsigned char buffer[PACKET_SIZE];
+    size_t len = 8;
+    EXPECT_FALSE(pRing->Read(buffer, &len));
+    EXPECT_EQ(pRing->GetNReadErrors(), 1u);
+    EXPECT_EQ(pRing->GetOccupancy(), 1u);
+
+    std::vector<unsigned char> data;
+    ASSERT_TRUE(readPacket(*pRing, data));
+    EXPECT_EQ(data, packet(1));
+}
@@ -0,0 +1,215 @@
+/**
+ * Unit tests for CShmDevice (POSIX shared memory ring)
+ *
+ * Requirements Traceability:
+ * - REQ-HLR-IO-004: Exchange packets with processes on the same host through shared memory
+ * - REQ-LLR-IO-SHM-001: Every reader follows the ring with its own cursor
+ * - REQ-LLR-IO-SHM-002: A reader overtaken by the writer skips and counts the lost packets
+ * - REQ-LLR-IO-SHM-003: Packets larger than a slot or the read buffer are rejected
+ * - REQ-LLR-IO-SHM-004: A reader never returns a packet torn by a concurrent write
+ *
+ * DO-278A AL-3 Compliance Testing
+ */
+
+#include <gtest/gtest.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "descriptor.hxx"
+#include "shmdevice.hxx"
+
+namespace {
+    constexpr unsigned int SLOT_SIZE = 64;
+
+    std::vector<unsigned char> packet(unsigned int n) {
+        return std::vector<unsigned char>(1 + n % SLOT_SIZE, static_cast<unsigned char>(n));
+    }
+
+    bool readPacket(CShmDevice &reader, std::vector<unsigned char> &data) {
+        data.resize(SLOT_SIZE);
+        size_t len = data.size();
+        if (!reader.Select(1) || !reader.Read(data.data(), &len)) {
+            return false;
+        }
+        data.resize(len);
+        return true;
+    }
+
+    class ShmDeviceTest : public ::testing::Test {
+    protected:
+        std::string name;
+
+        void SetUp() override {
+            name = "asterix_test_shm_" + std::to_string(getpid());
+            shm_unlink(("/" + name).c_str());
+        }
+
+        void TearDown() override {
+            shm_unlink(("/" + name).c_str());
+        }
+
+        std::unique_ptr<CShmDevice> open(const std::string &mode) {
+            CDescriptor descriptor((name + ":" + mode).c_str(), ":");
+            return std::make_unique<CShmDevice>(descriptor);
+        }
+    };
+}
+
+/**
+ * Test Case: TC-CPP-SHM-001
+ * Requirement: REQ-LLR-IO-SHM-001
+ * Description: Verify two readers receive all packets written after they attached,
+ *              each at its own pace
+ */
+TEST_F(ShmDeviceTest, ReadersWithOwnCursor) {
+    std::unique_ptr<CShmDevice> writer = open("W:16:64");
+    ASSERT_TRUE(writer->IsOpened());
+    EXPECT_EQ(writer->MaxPacketSize(), SLOT_SIZE);
+
+    // packets written before a reader attaches are not delivered to it
+    ASSERT_TRUE(writer->Write(packet(100).data(), packet(100).size()));
+
+    std::unique_ptr<CShmDevice> reader1 = open("R");
+    std::unique_ptr<CShmDevice> reader2 = open("R");
+    ASSERT_TRUE(reader1->IsOpened());
+    EXPECT_EQ(reader1->MaxPacketSize(), SLOT_SIZE);
+
+    for (unsigned int n = 0; n < 6; n++) {
+        ASSERT_TRUE(writer->Write(packet(n).data(), packet(n).size()));
+    }
+
+    std::vector<unsigned char> data;
+    for (unsigned int n = 0; n < 3; n++) {
+        ASSERT_TRUE(readPacket(*reader1, data));
+        EXPECT_EQ(data, packet(n));
+        EXPECT_GT(reader1->GetPacketTime(), 0.0);
+    }
+    for (unsigned int n = 0; n < 6; n++) {
+        ASSERT_TRUE(readPacket(*reader2, data));
+        EXPECT_EQ(data, packet(n));
+    }
+    for (unsigned int n = 3; n < 6; n++) {
+        ASSERT_TRUE(readPacket(*reader1, data));
+        EXPECT_EQ(data, packet(n));
+    }
+    EXPECT_FALSE(reader1->Select(1));
+    EXPECT_EQ(reader1->GetNLost(), 0u);
+    EXPECT_EQ(reader2->GetNLost(), 0u);
+}
+
+/**
+ * Test Case: TC-CPP-SHM-002
+ * Requirement: REQ-LLR-IO-SHM-002
+ * Description: Verify a reader lapped by the writer continues with the oldest packet
+ *              still in the ring and counts the packets it missed
+ */
+TEST_F(ShmDeviceTest, ReaderLapped) {
+    std::unique_ptr<CShmDevice> writer = open("W:4:64");
+    ASSERT_TRUE(writer->IsOpened());
+    std::unique_ptr<CShmDevice> reader = open("R");
+
+    for (unsigned int n = 0; n < 10; n++) {
+        ASSERT_TRUE(writer->Write(packet(n).data(), packet(n).size()));
+    }
+
+    std::vector<unsigned char> data;
+    for (unsigned int n = 6; n < 10; n++) {
+        ASSERT_TRUE(readPacket(*reader, data));
+        EXPECT_EQ(data, packet(n));
+    }
+    EXPECT_EQ(reader->GetNLost(), 6u);
+
+    // a restarted writer continues the sequence of the segment
+    writer.reset();
+    writer = open("W:4:64");
+    ASSERT_TRUE(writer->IsOpened());
+    ASSERT_TRUE(writer->Write(packet(10).data(), packet(10).size()));
+    ASSERT_TRUE(readPacket(*reader, data));
+    EXPECT_EQ(data, packet(10));
+    EXPECT_EQ(reader->GetNLost(), 6u);
+}
+
+/**
+ * Test Case: TC-CPP-SHM-003
+ * Requirement: REQ-LLR-IO-SHM-003
+ * Description: Verify a packet larger than the slot is not written, and a packet larger
+ *              than the read buffer is reported and skipped
+ */
+TEST_F(ShmDeviceTest, SlotSizeOverflow) {
+    std::unique_ptr<CShmDevice> writer = open("W:4:64");
+    ASSERT_TRUE(writer->IsOpened());
+    std::unique_ptr<CShmDevice> reader = open("R");
+
+    const std::vector<unsigned char> big(SLOT_SIZE + 1, 0x30);
+    EXPECT_FALSE(writer->Write(big.data(), big.size()));
+    EXPECT_EQ(writer->GetNWriteErrors(), 1u);
+
+    const std::vector<unsigned char> full(SLOT_SIZE, 0x3E);
+    EXPECT_TRUE(writer->Write(full.data(), full.size()));
+    EXPECT_TRUE(writer->Write(packet(1).data(), packet(1).size()));
+
+    unsigned char buffer[SLOT_SIZE];
+    size_t len = 8;
+    ASSERT_TRUE(reader->Select(1));
+    EXPECT_FALSE(reader->Read(buffer, &len));
+    EXPECT_EQ(reader->GetNReadErrors(), 1u);
+
+    std::vector<unsigned char> data;
+    ASSERT_TRUE(readPacket(*reader, data));
+    EXPECT_EQ(data, packet(1));
+    EXPECT_EQ(reader->GetNLost(), 0u);
+
+    // a segment cannot be reused with another layout
+    writer.reset();
+    EXPECT_FALSE(open("W:4:128")->IsOpened());
+}
+
+/**
+ * Test Case: TC-CPP-SHM-004
+ * Requirement: REQ-LLR-IO-SHM-004
+ * Description: Verify packets read while the writer keeps overwriting the ring are complete
+ *              and in order, and every packet is either read or counted as lost
+ */
+TEST_F(ShmDeviceTest, ConcurrentWriter) {
+    std::unique_ptr<CShmDevice> writer = open("W:8:64");
+    ASSERT_TRUE(writer->IsOpened());
+    std::unique_ptr<CShmDevice> reader = open("R");
+
+    const unsigned int nPackets = 100000;
+    std::atomic<bool> done{false};
+    std::thread writerThread([&writer, &done]() {
+        for (unsigned int n = 0; n < nPackets; n++) {
+            // every byte of a packet holds its number
+            const std::vector<unsigned char> data(SLOT_SIZE, static_cast<unsigned char>(n));
+            writer->Write(data.data(), data.size());
+        }
+        done.store(true);
+    });
+
+    uint64_t nRead = 0;
+    unsigned int last = 0;
+    bool torn = false;
+    std::vector<unsigned char> data;
+    while (!done.load() || reader->Select(1)) {
+        if (!readPacket(*reader, data)) {
+            continue;
+        }
+        for (unsigned char byte : data) {
+            torn |= byte != data[0];
+        }
+        // packet numbers modulo 256 advance by 1 + lost packets
+        const unsigned int expected = static_cast<unsigned int>(nRead + reader->GetNLost()) & 0xFF;
+        EXPECT_EQ(data[0], expected) << nRead;
+        last = data[0];
+        nRead++;
+    }
+    writerThread.join();
+
+    EXPECT_FALSE(torn);
+    EXPECT_EQ(last, (nPackets - 1) & 0xFF);
+    EXPECT_EQ(nRead + reader->GetNLost(), nPackets);
+}
@@ -0,0 +1,124 @@
+/**
+ * Unit tests for split output of raw and PCAP formats (CAsterixRawSubformat::WriteSplit)
+ *
+ * Requirements Traceability:
+ * - REQ-HLR-IO-003: Write recorded data per category and sensor in one pass
+ * - REQ-LLR-IO-SPLIT-001: Group data blocks by category and SAC/SIC without decoding
+ *
+ * DO-278A AL-3 Compliance Testing
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "basedevice.hxx"
+#include "baseformatdescriptor.hxx"
+#include "asterixrawsubformat.hxx"
+
+namespace {
+    // Device recording selected keys and written data
+    class CTestDevice : public CBaseDevice {
+    public:
+        explicit CTestDevice(bool split) : _split(split) { _opened = true; }
+
+        bool Read(void *, size_t) override { return false; }
+
+        bool Write(const void *data, size_t len) override {
+            const unsigned char *p = static_cast<const unsigned char *>(data);
+            writes.emplace_back(selected, std::vector<unsigned char>(p, p + len));
+            return true;
+        }
+
+        bool Select(const unsigned int) override { return false; }
+
+        bool IoCtrl(const unsigned int command, const void *data = 0, size_t = 0) override {
+            if (!_split || command != ESelectOutput) {
+                return false;
+            }
+            const SSplitKey *key = static_cast<const SSplitKey *>(data);
+            selected = std::to_string(key->cat) + "_" + std::to_string(key->sac) + "_" + std::to_string(key->sic);
+            return true;
+        }
+
+        bool IsPacketDevice() override { return false; }
+
+        std::string selected;
+        std::vector<std::pair<std::string, std::vector<unsigned char>>> writes;
+
+    private:
+        bool _split;
+    };
+
+    bool write(CBaseDevice &device, const std::vector<unsigned char> &data) {
+        return CAsterixRawSubformat::WriteSplit(device, data.data(), data.size(),
+                                                [&device](const unsigned char *p, size_t n) {
+                                                    return device.Write(p, n);
+                                                });
+    }
+
+    // CAT048 block: record with FSPEC 0xF0 (I010 present), SAC/SIC
+    const std::vector<unsigned char> block48a = {0x30, 0x00, 0x06, 0xF0, 0x19, 0x0C};
+    const std::vector<unsigned char> block48b = {0x30, 0x00, 0x06, 0xF0, 0x19, 0xC9};
+    // CAT034 block with two FSPEC bytes before SAC/SIC
+    const std::vector<unsigned char> block34 = {0x22, 0x00, 0x07, 0xF1, 0x02, 0x19, 0x0C};
+    // CAT001 block without I010 in first record
+    const std::vector<unsigned char> block01 = {0x01, 0x00, 0x05, 0x40, 0x01};
+
+    std::vector<unsigned char> concat(std::initializer_list<std::vector<unsigned char>> blocks) {
+        std::vector<unsigned char> result;
+        for (const auto &block : blocks) {
+            result.insert(result.end(), block.begin(), block.end());
+        }
+        return result;
+    }
+}
+
+/**
+ * Test Case: TC-CPP-SPLIT-001
+ * Requirement: REQ-LLR-IO-SPLIT-001
+ * Description: Data blocks are grouped by key in order of first appearance
+ */
+TEST(SplitOutputTest, GroupsBlocksByKey) {
+    CTestDevice device(true);
+    ASSERT_TRUE(write(device, concat({block48a, block34, block48b, block48a, block01})));
+
+    ASSERT_EQ(device.writes.size(), 4u);
+    EXPECT_EQ(device.writes[0].first, "48_25_12");
+    EXPECT_EQ(device.writes[0].second, concat({block48a, block48a}));
+    EXPECT_EQ(device.writes[1].first, "34_25_12");
+    EXPECT_EQ(device.writes[1].second, block34);
+    EXPECT_EQ(device.writes[2].first, "48_25_201");
+    EXPECT_EQ(device.writes[2].second, block48b);
+    EXPECT_EQ(device.writes[3].first, "1_-1_-1");
+    EXPECT_EQ(device.writes[3].second, block01);
+}
+
+/**
+ * Test Case: TC-CPP-SPLIT-002
+ * Requirement: REQ-LLR-IO-SPLIT-001
+ * Description: Packet with a single key is written at once
+ */
+TEST(SplitOutputTest, SingleKeyWrittenAtOnce) {
+    CTestDevice device(true);
+    const std::vector<unsigned char> data = concat({block48a, block48a});
+    ASSERT_TRUE(write(device, data));
+
+    ASSERT_EQ(device.writes.size(), 1u);
+    EXPECT_EQ(device.writes[0].first, "48_25_12");
+    EXPECT_EQ(device.writes[0].second, data);
+}
+
+/**
+ * Test Case: TC-CPP-SPLIT-003
+ * Requirement: REQ-LLR-IO-SPLIT-001
+ * Description: Devices not selecting outputs get the whole packet, truncated block is kept
+ */
+TEST(SplitOutputTest, NonSplitDevice) {
+    CTestDevice device(false);
+    std::vector<unsigned char> data = concat({block48a, block34});
+    data[block48a.size() + 1] = 0x10; // CAT034 length beyond end of data
+    ASSERT_TRUE(write(device, data));
+
+    ASSERT_EQ(device.writes.size(), 1u);
+    EXPECT_EQ(device.writes[0].second, data);
+}
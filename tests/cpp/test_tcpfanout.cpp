@@ -0,0 +1,176 @@
+/**
+ * Unit tests for CTcpFanoutDevice (TCP server output to many clients)
+ *
+ * Requirements Traceability:
+ * - REQ-HLR-IO-005: Serve converted data to several TCP clients at once
+ * - REQ-LLR-IO-FANOUT-001: Every client receives all written packets
+ * - REQ-LLR-IO-FANOUT-002: A client disconnecting mid-stream does not stop the others
+ *
+ * DO-278A AL-3 Compliance Testing
+ */
+
+#include <gtest/gtest.h>
+#include <signal.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "descriptor.hxx"
+#include "tcpfanoutdevice.hxx"
+
+namespace {
+    volatile sig_atomic_t gSigPipes = 0;
+
+    extern "C" void onSigPipe(int) {
+        gSigPipes = gSigPipes + 1;
+    }
+
+    int connectClient(unsigned int port) {
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        struct sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (connect(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0) {
+            close(fd);
+            return -1;
+        }
+        struct timeval timeout = {5, 0};
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        return fd;
+    }
+
+    bool waitForClients(CTcpFanoutDevice &device, unsigned int nClients) {
+        for (int i = 0; i < 500; i++) {
+            if (device.GetNClients() == nClients) {
+                return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return false;
+    }
+
+    bool receive(int fd, size_t len, std::vector<unsigned char> &data) {
+        data.resize(len);
+        size_t received = 0;
+        while (received < len) {
+            ssize_t n = recv(fd, data.data() + received, len - received, 0);
+            if (n <= 0) {
+                return false;
+            }
+            received += static_cast<size_t>(n);
+        }
+        return true;
+    }
+}
+
+/**
+ * Test Case: TC-CPP-FANOUT-001
+ * Requirement: REQ-LLR-IO-FANOUT-001
+ * Description: Verify all connected clients receive the written packets in order
+ */
+TEST(TcpFanoutTest, AllClientsReceive) {
+    // port chosen by the system, tests may run in parallel
+    CDescriptor descriptor("127.0.0.1:0", ":");
+    CTcpFanoutDevice device(descriptor);
+    ASSERT_TRUE(device.IsOpened());
+    ASSERT_NE(device.GetPort(), 0u);
+
+    int fd1 = connectClient(device.GetPort());
+    int fd2 = connectClient(device.GetPort());
+    ASSERT_GE(fd1, 0);
+    ASSERT_GE(fd2, 0);
+    ASSERT_TRUE(waitForClients(device, 2));
+
+    const std::vector<unsigned char> packet1 = {0x30, 0x00, 0x06, 0x80, 0x19, 0x0C};
+    const std::vector<unsigned char> packet2 = {0x3E, 0x00, 0x07, 0x80, 0x19, 0x0C, 0x00};
+    EXPECT_TRUE(device.Write(packet1.data(), packet1.size()));
+    EXPECT_TRUE(device.Write(packet2.data(), packet2.size()));
+
+    std::vector<unsigned char> expected = packet1;
+    expected.insert(expected.end(), packet2.begin(), packet2.end());
+    for (int fd : {fd1, fd2}) {
+        std::vector<unsigned char> data;
+        ASSERT_TRUE(receive(fd, expected.size(), data));
+        EXPECT_EQ(data, expected);
+        close(fd);
+    }
+    EXPECT_TRUE(waitForClients(device, 0));
+}
+
+/**
+ * Test Case: TC-CPP-FANOUT-002
+ * Requirement: REQ-LLR-IO-FANOUT-002
+ * Description: Verify clients closing their socket mid-stream neither kill the
+ *              server (SIGPIPE) nor interrupt the data sent to the other clients
+ */
+TEST(TcpFanoutTest, ClientClosesMidStream) {
+    // SIGPIPE kills the process by default, count it instead
+    struct sigaction action = {};
+    struct sigaction oldAction = {};
+    action.sa_handler = onSigPipe;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGPIPE, &action, &oldAction);
+    gSigPipes = 0;
+
+    CDescriptor descriptor("127.0.0.1:0:8192", ":");
+    CTcpFanoutDevice device(descriptor);
+    ASSERT_TRUE(device.IsOpened());
+
+    int stable = connectClient(device.GetPort());
+    ASSERT_GE(stable, 0);
+    ASSERT_TRUE(waitForClients(device, 1));
+
+    std::atomic<size_t> nReceived{0};
+    std::thread reader([stable, &nReceived]() {
+        unsigned char buffer[65536];
+        ssize_t n;
+        while ((n = recv(stable, buffer, sizeof(buffer), 0)) > 0) {
+            nReceived += static_cast<size_t>(n);
+        }
+    });
+
+    std::atomic<bool> stop{false};
+    std::thread writer([&device, &stop]() {
+        const std::vector<unsigned char> packet(1400, 0x30);
+        while (!stop.load()) {
+            device.Write(packet.data(), packet.size());
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    });
+
+    for (int i = 0; i < 100; i++) {
+        // no ASSERT while the threads run, they must be joined
+        int fd = connectClient(device.GetPort());
+        EXPECT_GE(fd, 0);
+        if (fd < 0) {
+            break;
+        }
+        std::vector<unsigned char> data;
+        EXPECT_TRUE(receive(fd, 4096, data));
+        if (i % 2) {
+            // reset the connection while the server is sending
+            struct linger lingerOpt = {1, 0};
+            setsockopt(fd, SOL_SOCKET, SO_LINGER, &lingerOpt, sizeof(lingerOpt));
+        }
+        close(fd);
+    }
+    EXPECT_TRUE(waitForClients(device, 1));
+
+    const size_t nBefore = nReceived.load();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    stop.store(true);
+    writer.join();
+    EXPECT_GT(nReceived.load(), nBefore);
+    EXPECT_EQ(device.GetNClients(), 1u);
+    EXPECT_EQ(gSigPipes, 0);
+
+    shutdown(stable, SHUT_RDWR);
+    reader.join();
+    close(stable);
+    sigaction(SIGPIPE, &oldAction, nullptr);
+}
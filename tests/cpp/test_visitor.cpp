@@ -0,0 +1,268 @@
+/**
+ * Unit tests for InputParser::visit() (decoding into AsterixVisitor callbacks)
+ *
+ * Requirements Traceability:
+ * - REQ-HLR-API-004: Decode values without building the AsterixData tree
+ * - REQ-LLR-API-VISIT-001: Visitor gets the same blocks, records and items as parsePacket()
+ * - REQ-LLR-API-VISIT-002: Fields carry raw and scaled value, encoding and meaning
+ * - REQ-LLR-API-VISIT-003: Callbacks can skip nested data, undecodable records end their block
+ *
+ * DO-278A AL-3 Compliance Testing
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "AsterixData.h"
+#include "AsterixDefinition.h"
+#include "AsterixVisitor.h"
+#include "DataBlock.h"
+#include "DataItem.h"
+#include "DataItemBits.h"
+#include "DataItemDescription.h"
+#include "DataRecord.h"
+#include "InputParser.h"
+#include "test_helpers.h"
+
+namespace {
+    using testutil::readFile;
+
+    struct VisitedItem {
+        const DataItemDescription *m_pDescription;
+        std::vector<unsigned char> m_vData;
+    };
+
+    struct VisitedField {
+        std::string m_strItem;
+        std::string m_strName;
+        uint64_t m_nRaw;
+        double m_dValue;
+        const char *m_pMeaning;
+    };
+
+    class RecordingVisitor : public AsterixVisitor {
+    public:
+        bool bBlocks = true;
+        bool bRecords = true;
+        bool bItems = true;
+
+        std::vector<int> blocks;
+        int nBlockEnds = 0;
+        int nRecords = 0;
+        int nRecordEnds = 0;
+        std::vector<VisitedItem> items;
+        std::vector<VisitedField> fields;
+
+        bool onBlock(const Category &category, const unsigned char *, unsigned long, double) override {
+            blocks.push_back(category.m_id);
+            return bBlocks;
+        }
+
+        void onBlockEnd(const Category &) override { nBlockEnds++; }
+
+        bool onRecord(const Category &, const unsigned char *, unsigned long) override {
+            nRecords++;
+            return bRecords;
+        }
+
+        void onRecordEnd(const Category &) override { nRecordEnds++; }
+
+        bool onItem(const DataItemDescription &item, const unsigned char *pData, long nLength) override {
+            items.push_back({&item, std::vector<unsigned char>(pData, pData + nLength)});
+            return bItems;
+        }
+
+        void onField(const DataItemDescription &item, const ItemField &field) override {
+            fields.push_back({item.m_strID, field.m_pBits->m_strShortName, field.getUnsigned(), field.getValue(),
+                              field.getMeaning()});
+        }
+
+        const VisitedField *findField(const std::string &item, const std::string &name) const {
+            for (const auto &field : fields) {
+                if (field.m_strItem == item && field.m_strName == name) {
+                    return &field;
+                }
+            }
+            return nullptr;
+        }
+    };
+
+    class VisitorTest : public ::testing::Test {
+    protected:
+        AsterixDefinition definition;
+
+        void SetUp() override {
+            ASSERT_TRUE(testutil::parseFiles(definition, {"../asterix/config/asterix_bds.xml",
+                                                          "../asterix/config/asterix_cat021_2_6.xml",
+                                                          "../asterix/config/asterix_cat034_1_29.xml",
+                                                          "../asterix/config/asterix_cat048_1_30.xml",
+                                                          "../asterix/config/asterix_cat062_1_19.xml",
+                                                          "../asterix/config/asterix_cat065_1_5.xml"}));
+        }
+    };
+
+    // CAT048 record: I048/010 SAC=25 SIC=201, I048/140 1 s, I048/020 TYP=1, I048/040 RHO=16 NM THETA=45 deg
+    const unsigned char CAT048_RECORD[] = {0xF0, 0x19, 0xC9, 0x00, 0x00, 0x80, 0x20, 0x10, 0x00, 0x20, 0x00};
+
+    std::vector<unsigned char> block(int category, const std::vector<unsigned char> &records) {
+        std::vector<unsigned char> data = {static_cast<unsigned char>(category),
+                                           static_cast<unsigned char>((records.size() + 3) >> 8),
+                                           static_cast<unsigned char>(records.size() + 3)};
+        data.insert(data.end(), records.begin(), records.end());
+        return data;
+    }
+
+    std::vector<unsigned char> records(int nRecords) {
+        std::vector<unsigned char> data;
+        for (int i = 0; i < nRecords; i++) {
+            data.insert(data.end(), CAT048_RECORD, CAT048_RECORD + sizeof(CAT048_RECORD));
+        }
+        return data;
+    }
+}
+
+/**
+ * Test Case: TC-CPP-VISIT-001
+ * Requirement: REQ-LLR-API-VISIT-001
+ * Description: Verify sample data visits the same blocks, records and items as parsePacket() builds
+ */
+TEST_F(VisitorTest, SameItemsAsParsePacket) {
+    for (const char *file : {"../asterix/sample_data/cat034.raw", "../asterix/sample_data/cat048.raw",
+                             "../asterix/sample_data/cat062cat065.raw", "../asterix/sample_data/cat21_re.ast"}) {
+        const std::vector<unsigned char> data = readFile(file);
+        ASSERT_FALSE(data.empty()) << file;
+        InputParser parser(&definition);
+
+        std::vector<int> blocks;
+        int nRecords = 0;
+        std::vector<VisitedItem> items;
+        AsterixData *pData = parser.parsePacket(data.data(), static_cast<unsigned int>(data.size()), 0.0);
+        ASSERT_NE(pData, nullptr);
+        for (auto *dataBlock : pData->m_lDataBlocks) {
+            blocks.push_back(dataBlock->m_pCategory->m_id);
+            for (auto *record : dataBlock->m_lDataRecords) {
+                ASSERT_TRUE(record->m_bFormatOK) << file;
+                nRecords++;
+                for (auto *item : record->m_lDataItems) {
+                    items.push_back({item->m_pDescription, {}});
+                    item->getBinary(items.back().m_vData);
+                }
+            }
+        }
+        delete pData;
+
+        RecordingVisitor visitor;
+        EXPECT_EQ(parser.visit(data.data(), static_cast<unsigned int>(data.size()), visitor),
+                  static_cast<unsigned long>(nRecords)) << file;
+        EXPECT_EQ(visitor.blocks, blocks) << file;
+        EXPECT_EQ(visitor.nBlockEnds, static_cast<int>(blocks.size())) << file;
+        EXPECT_EQ(visitor.nRecords, nRecords) << file;
+        EXPECT_EQ(visitor.nRecordEnds, nRecords) << file;
+        ASSERT_EQ(visitor.items.size(), items.size()) << file;
+        for (size_t i = 0; i < items.size(); i++) {
+            EXPECT_EQ(visitor.items[i].m_pDescription, items[i].m_pDescription) << file << " item " << i;
+            EXPECT_EQ(visitor.items[i].m_vData, items[i].m_vData) << file << " item " << i;
+        }
+        EXPECT_FALSE(visitor.fields.empty()) << file;
+    }
+}
+
+/**
+ * Test Case: TC-CPP-VISIT-002
+ * Requirement: REQ-LLR-API-VISIT-002
+ * Description: Verify field raw and scaled values and value meanings
+ */
+TEST_F(VisitorTest, FieldValues) {
+    const std::vector<unsigned char> data = block(48, records(1));
+    InputParser parser(&definition);
+    RecordingVisitor visitor;
+    ASSERT_EQ(parser.visit(data.data(), static_cast<unsigned int>(data.size()), visitor, 12.5), 1u);
+    ASSERT_EQ(visitor.items.size(), 4u);
+
+    const VisitedField *sac = visitor.findField("010", "SAC");
+    ASSERT_NE(sac, nullptr);
+    EXPECT_EQ(sac->m_nRaw, 25u);
+    EXPECT_EQ(sac->m_pMeaning, nullptr);
+    const VisitedField *sic = visitor.findField("010", "SIC");
+    ASSERT_NE(sic, nullptr);
+    EXPECT_EQ(sic->m_nRaw, 201u);
+
+    const VisitedField *tod = visitor.findField("140", "ToD");
+    ASSERT_NE(tod, nullptr);
+    EXPECT_DOUBLE_EQ(tod->m_dValue, 1.0);
+
+    const VisitedField *typ = visitor.findField("020", "TYP");
+    ASSERT_NE(typ, nullptr);
+    EXPECT_EQ(typ->m_nRaw, 1u);
+    ASSERT_NE(typ->m_pMeaning, nullptr);
+    EXPECT_STREQ(typ->m_pMeaning, "Single PSR detection");
+
+    const VisitedField *rho = visitor.findField("040", "RHO");
+    ASSERT_NE(rho, nullptr);
+    EXPECT_EQ(rho->m_nRaw, 0x1000u);
+    EXPECT_DOUBLE_EQ(rho->m_dValue, 16.0);
+    const VisitedField *theta = visitor.findField("040", "THETA");
+    ASSERT_NE(theta, nullptr);
+    EXPECT_DOUBLE_EQ(theta->m_dValue, 45.0);
+}
+
+/**
+ * Test Case: TC-CPP-VISIT-003
+ * Requirement: REQ-LLR-API-VISIT-003
+ * Description: Verify callbacks returning false skip the blocks, records and items they announce
+ */
+TEST_F(VisitorTest, SkipNested) {
+    const std::vector<unsigned char> data = block(48, records(3));
+    InputParser parser(&definition);
+
+    RecordingVisitor skipBlocks;
+    skipBlocks.bBlocks = false;
+    EXPECT_EQ(parser.visit(data.data(), static_cast<unsigned int>(data.size()), skipBlocks), 0u);
+    EXPECT_EQ(skipBlocks.blocks.size(), 1u);
+    EXPECT_EQ(skipBlocks.nBlockEnds, 0);
+    EXPECT_EQ(skipBlocks.nRecords, 0);
+
+    RecordingVisitor skipRecords;
+    skipRecords.bRecords = false;
+    EXPECT_EQ(parser.visit(data.data(), static_cast<unsigned int>(data.size()), skipRecords), 3u);
+    EXPECT_EQ(skipRecords.nRecords, 3);
+    EXPECT_EQ(skipRecords.nRecordEnds, 0);
+    EXPECT_TRUE(skipRecords.items.empty());
+
+    RecordingVisitor skipItems;
+    skipItems.bItems = false;
+    EXPECT_EQ(parser.visit(data.data(), static_cast<unsigned int>(data.size()), skipItems), 3u);
+    EXPECT_EQ(skipItems.items.size(), 12u);
+    EXPECT_EQ(skipItems.nRecordEnds, 3);
+    EXPECT_TRUE(skipItems.fields.empty());
+}
+
+/**
+ * Test Case: TC-CPP-VISIT-004
+ * Requirement: REQ-LLR-API-VISIT-003
+ * Description: Verify a record which cannot be decoded ends its block and following blocks are visited
+ */
+TEST_F(VisitorTest, UndecodableRecordEndsBlock) {
+    // second record misses the last byte of I048/040
+    std::vector<unsigned char> truncated = records(2);
+    truncated.pop_back();
+    std::vector<unsigned char> data = block(48, truncated);
+    const std::vector<unsigned char> next = block(48, records(1));
+    data.insert(data.end(), next.begin(), next.end());
+
+    InputParser parser(&definition);
+    RecordingVisitor visitor;
+    EXPECT_EQ(parser.visit(data.data(), static_cast<unsigned int>(data.size()), visitor), 2u);
+    EXPECT_EQ(visitor.blocks, (std::vector<int>{48, 48}));
+    EXPECT_EQ(visitor.nBlockEnds, 2);
+    EXPECT_EQ(visitor.nRecords, 2);
+    EXPECT_EQ(visitor.items.size(), 8u);
+
+    // undefined category is skipped, header beyond buffer stops
+    std::vector<unsigned char> undefined = block(250, records(1));
+    undefined.insert(undefined.end(), next.begin(), next.end());
+    undefined.insert(undefined.end(), {48, 0x00, 0x20, 0xF0});
+    RecordingVisitor skipped;
+    EXPECT_EQ(parser.visit(undefined.data(), static_cast<unsigned int>(undefined.size()), skipped), 1u);
+    EXPECT_EQ(skipped.blocks, (std::vector<int>{48}));
+}